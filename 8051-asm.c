@@ -0,0 +1,615 @@
+/* 8051/8052 assembler, accepts the syntax of the disassembler */
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-render.h"
+#include "8051-asm.h"
+
+/* keyword kinds */
+#define KW_MNEM 1  /* value: enum dis8051_mnem or KW_CALL */
+#define KW_REG  2  /* value: enum dis8051_opnd | register<<8 */
+#define KW_SFR  3  /* value: SFR address */
+#define KW_BIT  4  /* value: bit address */
+
+/* generic call, becomes lcall */
+#define KW_CALL DIS8051_MNEM_COUNT
+
+struct keyword {
+	const char *name;
+	uint8_t len;
+	uint8_t kind;
+	uint16_t value;
+};
+
+/* perfect hash of the SFR and bit names of a derivative or SFR page:
+ * its buckets and slots in 'names_disp' and 'names_slots' */
+struct names_set {
+	uint16_t disp, nbuckets;
+	uint16_t slot, nslots;
+};
+
+#include "8051-keywords.h"
+
+/* parsed operand kinds */
+#define P_REG  1  /* a, r0, @dptr, ... */
+#define P_IMM  2  /* #value */
+#define P_VAL  3  /* address, SFR or bit name */
+#define P_NBIT 4  /* /bit */
+
+/* code labels of a block, see 'dis8051_assemble_block' */
+struct label {
+	const char *name;
+	size_t len;
+	uint16_t addr;
+};
+
+struct env {
+	uint16_t pc;
+	const struct label *labels;
+	int nlabels;
+	const struct dis8051_derivative *deriv;  /* NULL for the default */
+	const struct dis8051_sfr_page *page;     /* NULL for page 0 */
+	const struct names_set *names;           /* of 'deriv', NULL if it */
+	const struct names_set *page_names;      /* is not a built in one */
+};
+
+struct operand {
+	uint8_t kind;
+	uint8_t opnd;    /* P_REG: enum dis8051_opnd */
+	uint8_t reg;     /* P_REG: register number */
+	uint8_t is_sfr;  /* P_VAL: SFR name */
+	uint8_t is_bit;  /* P_VAL, P_NBIT: bit name or byte.bit */
+	long value;
+};
+
+static uint32_t kw_hash(const char *s, size_t n, uint32_t seed)
+{
+	uint32_t h = 2166136261u ^ seed;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		h ^= (uint8_t)tolower((unsigned char)s[i]);
+		h *= 16777619u;
+	}
+	return h;
+}
+
+/* perfect hash lookup: the bucket picks the displacement,
+ * the displaced hash the only slot the keyword can be in */
+static const struct keyword *kw_lookup(const char *s, size_t n)
+{
+	const struct keyword *k;
+	uint32_t d;
+
+	d = kw_disp[kw_hash(s, n, 0) % KW_BUCKETS];
+	k = &kw_table[kw_hash(s, n, d) % KW_SLOTS];
+
+	if (!k->name || k->len != n || strncasecmp(k->name, s, n))
+		return NULL;
+	return k;
+}
+
+/* SFR (KW_SFR) or bit (KW_BIT) name in the tables 'sfr' and 'bit' of a
+ * derivative other than the default, whose names are keywords; found
+ * through 'set' like 'kw_lookup' or, without one, one by one */
+static int names_lookup(const struct names_set *set, const char *const *sfr,
+                        const char *const *bit, int kind, const char *s,
+                        size_t n, long *v)
+{
+	const char *const *names = kind == KW_SFR ? sfr : bit;
+	unsigned e;
+	int i;
+
+	if (!set) {
+		for (i = 0; i < 128; i++)
+			if (!strncasecmp(names[i], s, n) && names[i][n] == '\0')
+				break;
+		if (i == 128)
+			return -1;
+		*v = 0x80 + i;
+		return 0;
+	}
+
+	e = names_disp[set->disp + kw_hash(s, n, 0) % set->nbuckets];
+	e = names_slots[set->slot + kw_hash(s, n, e) % set->nslots];
+	/* 0 for none, else 1 + bit<<7 + address - 0x80 */
+	if (!e-- || (e >> 7) != (kind == KW_BIT))
+		return -1;
+	i = e & 0x7f;
+	if (strncasecmp(names[i], s, n) || names[i][n] != '\0')
+		return -1;
+	*v = 0x80 + i;
+	return 0;
+}
+
+static int deriv_lookup(const struct env *env, int kind, const char *s,
+                        size_t n, long *v)
+{
+	/* unnamed slots are "", which an empty name would match */
+	if (!env->deriv || n == 0)
+		return -1;
+	/* the names of the SFR page first, as they are rendered */
+	if (env->page && !names_lookup(env->page_names, env->page->sfr,
+	                               env->page->bit, kind, s, n, v))
+		return 0;
+	return names_lookup(env->names, env->deriv->sfr, env->deriv->bit,
+	                    kind, s, n, v);
+}
+
+/* 0x1f, 1fh or 31 */
+static int parse_num(const char *s, size_t n, long *v)
+{
+	int neg = 0, base = 10;
+	char *end, tmp[24];
+
+	if (n > 0 && *s == '-') {
+		neg = 1;
+		s++;
+		n--;
+	}
+	if (n == 0 || n >= sizeof(tmp) || !isdigit((unsigned char)*s))
+		return -1;
+
+	memcpy(tmp, s, n);
+	tmp[n] = '\0';
+	if (n > 2 && tmp[0] == '0' && (tmp[1] == 'x' || tmp[1] == 'X')) {
+		base = 16;
+	} else if (tmp[n-1] == 'h' || tmp[n-1] == 'H') {
+		tmp[n-1] = '\0';
+		base = 16;
+	}
+
+	*v = strtol(tmp, &end, base);
+	if (*end != '\0')
+		return -1;
+	if (neg)
+		*v = -*v;
+	return 0;
+}
+
+/* bit name, byte.bit with a number or SFR name, or plain bit address */
+static int parse_bit(const char *s, size_t n, const struct env *env,
+                     struct operand *o)
+{
+	const struct keyword *k;
+	const char *dot;
+	long byte, bit;
+
+	if (!deriv_lookup(env, KW_BIT, s, n, &o->value)) {
+		o->is_bit = 1;
+		return 0;
+	}
+	/* the names of the default only for it, another part would have
+	 * found them above if it named the same bit */
+	if (!env->deriv && (k = kw_lookup(s, n)) && k->kind == KW_BIT) {
+		o->is_bit = 1;
+		o->value = k->value;
+		return 0;
+	}
+
+	if (!(dot = memchr(s, '.', n)))
+		return parse_num(s, n, &o->value);
+
+	if (parse_num(dot + 1, n - (dot - s) - 1, &bit) || bit < 0 || bit > 7)
+		return -1;
+	if (deriv_lookup(env, KW_SFR, s, dot - s, &byte)) {
+		if (!env->deriv && (k = kw_lookup(s, dot - s)) &&
+		    k->kind == KW_SFR)
+			byte = k->value;
+		else if (parse_num(s, dot - s, &byte))
+			return -1;
+	}
+
+	/* bit addressable RAM 0x20 -- 0x2f, SFRs at multiples of 8 */
+	if (byte >= 0x20 && byte <= 0x2f)
+		o->value = (byte - 0x20)*8 + bit;
+	else if (byte >= 0x80 && byte <= 0xff && !(byte & 0x7))
+		o->value = byte + bit;
+	else
+		return -1;
+
+	o->is_bit = 1;
+	return 0;
+}
+
+/* $ for the current instruction, or a label */
+static int parse_symbol(const char *s, size_t n, const struct env *env,
+                        long *v)
+{
+	int i;
+
+	if (n == 1 && *s == '$') {
+		*v = env->pc;
+		return 0;
+	}
+
+	for (i = 0; i < env->nlabels; i++) {
+		if (env->labels[i].len == n &&
+		    !strncmp(env->labels[i].name, s, n)) {
+			*v = env->labels[i].addr;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+static int parse_operand(const char *s, size_t n, const struct env *env,
+                         struct operand *o)
+{
+	const struct keyword *k;
+
+	memset(o, 0, sizeof(*o));
+
+	if (*s == '#') {
+		o->kind = P_IMM;
+		return parse_num(s + 1, n - 1, &o->value);
+	}
+
+	if (*s == '/') {
+		o->kind = P_NBIT;
+		return parse_bit(s + 1, n - 1, env, o);
+	}
+
+	if (!deriv_lookup(env, KW_SFR, s, n, &o->value)) {
+		o->kind = P_VAL;
+		o->is_sfr = 1;
+		return 0;
+	}
+	if ((k = kw_lookup(s, n))) {
+		switch (k->kind) {
+		case KW_REG:
+			o->kind = P_REG;
+			o->opnd = k->value & 0xff;
+			o->reg = k->value >> 8;
+			return 0;
+		case KW_SFR:
+			if (env->deriv)
+				break;
+			o->kind = P_VAL;
+			o->is_sfr = 1;
+			o->value = k->value;
+			return 0;
+		}
+	}
+
+	o->kind = P_VAL;
+	if (!parse_symbol(s, n, env, &o->value))
+		return 0;
+	return parse_bit(s, n, env, o);
+}
+
+/* encode operand 'o' as operand kind 'kind' of the opcode in out[0],
+ * appending operand bytes to 'out' at '*p' */
+static int encode(uint8_t kind, const struct operand *o, uint16_t pc,
+                  uint8_t size, uint8_t *out, int *p)
+{
+	uint16_t next = pc + size;
+	long v = o->value, rel;
+
+	switch (kind) {
+	case DIS8051_OPND_A:
+	case DIS8051_OPND_AB:
+	case DIS8051_OPND_C:
+	case DIS8051_OPND_DPTR:
+	case DIS8051_OPND_IDPTR:
+	case DIS8051_OPND_IADPTR:
+	case DIS8051_OPND_IAPC:
+		return o->kind == P_REG && o->opnd == kind;
+
+	case DIS8051_OPND_RN:
+		return o->kind == P_REG && o->opnd == kind &&
+		       o->reg == (out[0] & 0x7);
+
+	case DIS8051_OPND_IRI:
+		return o->kind == P_REG && o->opnd == kind &&
+		       o->reg == (out[0] & 0x1);
+
+	case DIS8051_OPND_DIRECT:
+		if (o->kind != P_VAL || o->is_bit || v < 0 || v > 0xff)
+			return 0;
+		out[(*p)++] = v;
+		return 1;
+
+	case DIS8051_OPND_BIT:
+	case DIS8051_OPND_NBIT:
+		if (o->kind != (kind == DIS8051_OPND_BIT ? P_VAL : P_NBIT) ||
+		    o->is_sfr || v < 0 || v > 0xff)
+			return 0;
+		out[(*p)++] = v;
+		return 1;
+
+	case DIS8051_OPND_IMM8:
+		if (o->kind != P_IMM || v < -0x80 || v > 0xff)
+			return 0;
+		out[(*p)++] = v & 0xff;
+		return 1;
+
+	case DIS8051_OPND_IMM16:
+		if (o->kind != P_IMM || v < -0x8000 || v > 0xffff)
+			return 0;
+		out[(*p)++] = (v >> 8) & 0xff;
+		out[(*p)++] = v & 0xff;
+		return 1;
+
+	case DIS8051_OPND_REL:
+		if (o->kind != P_VAL || o->is_sfr || o->is_bit ||
+		    v < 0 || v > 0xffff)
+			return 0;
+		/* the code address space wraps around */
+		rel = (int16_t)(v - next);
+		if (rel < -0x80 || rel > 0x7f)
+			return 0;
+		out[(*p)++] = rel & 0xff;
+		return 1;
+
+	/* same 2 KiB page as the next instruction,
+	 * address bits 8 -- 10 go into the opcode */
+	case DIS8051_OPND_ADDR11:
+		if (o->kind != P_VAL || o->is_sfr || o->is_bit ||
+		    v < 0 || v > 0xffff || (v & 0xf800) != (next & 0xf800) ||
+		    ((v >> 8) & 0x7) != out[0] >> 5)
+			return 0;
+		out[(*p)++] = v & 0xff;
+		return 1;
+
+	case DIS8051_OPND_ADDR16:
+		if (o->kind != P_VAL || o->is_sfr || o->is_bit ||
+		    v < 0 || v > 0xffff)
+			return 0;
+		out[(*p)++] = (v >> 8) & 0xff;
+		out[(*p)++] = v & 0xff;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* encode operands 'o' for opcode 'out[0]' described by 'op' */
+static int fits(const struct dis8051_opcode *op, const struct operand *o,
+                int n, uint16_t pc, int min, uint8_t *out)
+{
+	uint8_t tmp;
+	int k, p;
+
+	if (op->size < min)
+		return 0;
+
+	for (k = 0; k < 3 && op->opnd[k] != DIS8051_OPND_NONE; k++)
+		;
+	if (k != n)
+		return 0;
+
+	for (k = 0, p = 1; k < n; k++)
+		if (!encode(op->opnd[k], &o[k], pc, op->size, out, &p))
+			return 0;
+
+	/* mov data addr., data addr.: source byte first */
+	if (out[0] == 0x85) {
+		tmp = out[1];
+		out[1] = out[2];
+		out[2] = tmp;
+	}
+	return op->size;
+}
+
+/* first opcode of 'mnem' the operands fit, at least 'min' bytes long,
+ * then the extra opcodes of derivative 'd' */
+static int match(const struct dis8051_derivative *d, int mnem,
+                 const struct operand *o, int n, uint16_t pc, int min,
+                 uint8_t *out)
+{
+	int i, size;
+
+	for (i = mnem_first[mnem]; i < mnem_first[mnem + 1]; i++) {
+		out[0] = mnem_opcodes[i];
+		if ((size = fits(&dis8051_opcodes[out[0]], o, n, pc, min, out)))
+			return size;
+	}
+
+	for (i = 0; d && i < d->next; i++) {
+		if (d->ext[i].op.mnem != mnem)
+			continue;
+		out[0] = d->ext[i].opcode;
+		if ((size = fits(&d->ext[i].op, o, n, pc, min, out)))
+			return size;
+	}
+
+	return 0;
+}
+
+/* shortest forms first, ajmp/acall within the 2 KiB page of the
+ * next instruction, as decoded by 'dis8051_decode' */
+static const uint8_t jmp_forms[] = {DIS8051_SJMP, DIS8051_AJMP,
+                                    DIS8051_LJMP};
+static const uint8_t call_forms[] = {DIS8051_ACALL, DIS8051_LCALL};
+
+/* assemble one instruction, 'min' forces longer forms of generic
+ * jmp and call for branch relaxation */
+static int assemble(const struct env *env, const char *s, int min,
+                    uint8_t *out)
+{
+	const struct keyword *k;
+	const uint8_t *forms;
+	struct operand o[3];
+	const char *e, *end;
+	int n = 0, i, size, nforms, mnem;
+
+	while (isspace((unsigned char)*s))
+		s++;
+	for (e = s; *e && !isspace((unsigned char)*e); e++)
+		;
+	if (!(k = kw_lookup(s, e - s)) || k->kind != KW_MNEM)
+		return 0;
+	mnem = k->value;
+
+	/* comma separated operands */
+	for (s = e; *s; s = *e ? e + 1 : e) {
+		while (isspace((unsigned char)*s))
+			s++;
+		if (!*s && n == 0)
+			break;
+		if (n == 3)
+			return 0;
+		for (e = s; *e && *e != ','; e++)
+			;
+		for (end = e; end > s && isspace((unsigned char)end[-1]); end--)
+			;
+		if (end == s || parse_operand(s, end - s, env, &o[n++]))
+			return 0;
+	}
+
+	/* generic jmp / call take the shortest form that reaches */
+	if (mnem == KW_CALL) {
+		forms = call_forms;
+		nforms = sizeof(call_forms);
+	} else if (mnem == DIS8051_JMP && n == 1 && o[0].kind == P_VAL) {
+		forms = jmp_forms;
+		nforms = sizeof(jmp_forms);
+	} else {
+		return match(env->deriv, mnem, o, n, env->pc, min, out);
+	}
+
+	for (i = 0; i < nforms; i++)
+		if ((size = match(env->deriv, forms[i], o, n, env->pc, min,
+		                  out)) > 0)
+			return size;
+	return 0;
+}
+
+/* the derivative whose names and extra opcodes are not keywords, if any */
+static const struct dis8051_derivative *env_deriv(
+	const struct dis8051_ctx *ctx)
+{
+	if (!ctx || !ctx->deriv || ctx->deriv == &dis8051_derivatives[0])
+		return NULL;
+	return ctx->deriv;
+}
+
+/* the names of the SFR page of 'ctx' other than 0, if any */
+static const struct dis8051_sfr_page *env_page(
+	const struct dis8051_ctx *ctx)
+{
+	const struct dis8051_derivative *d = env_deriv(ctx);
+	int i;
+
+	for (i = 0; d && ctx->page > 0 && i < d->npages; i++)
+		if (d->pages[i].page == ctx->page)
+			return &d->pages[i];
+	return NULL;
+}
+
+static void env_init(struct env *env, const struct dis8051_ctx *ctx,
+                     uint16_t pc)
+{
+	int i;
+
+	env->pc = pc;
+	env->labels = NULL;
+	env->nlabels = 0;
+	env->deriv = env_deriv(ctx);
+	env->page = env_page(ctx);
+	env->names = env->page_names = NULL;
+	/* the pages of a set follow it, in the order of 'pages' */
+	for (i = 1; env->deriv && i < DIS8051_DERIVS; i++) {
+		if (env->deriv != &dis8051_derivatives[i])
+			continue;
+		env->names = &names_sets[names_first[i]];
+		if (env->page)
+			env->page_names = env->names + 1 +
+			                  (env->page - env->deriv->pages);
+	}
+}
+
+int dis8051_assemble(const struct dis8051_ctx *ctx, uint16_t pc,
+                     const char *s, uint8_t *out)
+{
+	struct env env;
+
+	env_init(&env, ctx, pc);
+	return assemble(&env, s, 0, out);
+}
+
+/* longest statement of a block */
+#define STMT_MAX 128
+
+struct stmt {
+	char text[STMT_MAX];
+	uint8_t size;
+};
+
+int dis8051_assemble_block(const struct dis8051_ctx *ctx, uint16_t pc,
+                           const char *s, uint8_t *out, int max)
+{
+	struct stmt stmts[DIS8051_BLOCK_MAX];
+	struct label labels[DIS8051_BLOCK_MAX];
+	int stmt_of[DIS8051_BLOCK_MAX];  /* statement each label is at */
+	struct env env;
+	uint8_t tmp[DIS8051_MAX_INSN];
+	const char *e, *colon;
+	int n = 0, i, k, pass, size, changed = 1, failed, total;
+
+	env_init(&env, ctx, pc);
+	env.labels = labels;
+	/* split into statements and labels */
+	for (; *s; s = *e ? e + 1 : e) {
+		for (e = s; *e && *e != ';' && *e != '\n'; e++)
+			;
+		while (s < e && isspace((unsigned char)*s))
+			s++;
+		if ((colon = memchr(s, ':', e - s))) {
+			if (env.nlabels == DIS8051_BLOCK_MAX)
+				return -1;
+			labels[env.nlabels].name = s;
+			labels[env.nlabels].len = colon - s;
+			stmt_of[env.nlabels++] = n;
+			for (s = colon + 1; s < e && isspace((unsigned char)*s);
+			     s++)
+				;
+		}
+		if (s == e)
+			continue;
+		if (n == DIS8051_BLOCK_MAX || e - s >= STMT_MAX)
+			return -1;
+		memcpy(stmts[n].text, s, e - s);
+		stmts[n].text[e - s] = '\0';
+		stmts[n++].size = 0;
+	}
+
+	/* start from the shortest forms and grow the generic jumps and
+	 * calls that don't reach until no size changes, as sizes only
+	 * grow this takes at most one pass per byte of growth */
+	for (pass = 0; changed && pass <= DIS8051_MAX_INSN*n; pass++) {
+		for (i = 0; i < env.nlabels; i++)
+			for (k = 0, labels[i].addr = pc; k < stmt_of[i]; k++)
+				labels[i].addr += stmts[k].size;
+
+		changed = failed = 0;
+		for (i = 0, env.pc = pc; i < n; i++) {
+			if (!(size = assemble(&env, stmts[i].text,
+			                      stmts[i].size, tmp))) {
+				failed = 1;
+			} else if (size != stmts[i].size) {
+				stmts[i].size = size;
+				changed = 1;
+			}
+			env.pc += stmts[i].size;
+		}
+	}
+	if (changed || failed)
+		return -1;
+
+	/* emit */
+	for (i = 0, total = 0, env.pc = pc; i < n; i++) {
+		if (total + stmts[i].size > max)
+			return -1;
+		assemble(&env, stmts[i].text, stmts[i].size, out + total);
+		total += stmts[i].size;
+		env.pc += stmts[i].size;
+	}
+
+	return total;
+}
@@ -0,0 +1,32 @@
+/* 8051/8052 assembler, accepts the syntax of the disassembler */
+
+#ifndef DIS8051_ASM_H
+#define DIS8051_ASM_H
+
+#include <stdint.h>
+#include "8051-render.h"
+
+/* longest encoding */
+#define DIS8051_MAX_INSN 3
+
+/* most statements of a block */
+#define DIS8051_BLOCK_MAX 64
+
+/* assemble one instruction at 'pc' into 'out', generic jmp and call
+ * take the shortest form that reaches: sjmp, ajmp, ljmp / acall, lcall;
+ * SFR and bit names and extra opcodes are those of the derivative of
+ * 'ctx', names of its SFR page before those of page 0; 'ctx' may be
+ * NULL for the default,
+ * returns its size or 0 on error */
+int dis8051_assemble(const struct dis8051_ctx *ctx, uint16_t pc,
+                     const char *s, uint8_t *out);
+
+/* assemble statements separated by ';' or newlines into at most 'max'
+ * bytes of 'out', statements may start with a 'name:' label usable as
+ * code address, '$' is the address of the current statement; generic
+ * jmp and call are relaxed until all sizes are stable,
+ * returns the total size or -1 on error */
+int dis8051_assemble_block(const struct dis8051_ctx *ctx, uint16_t pc,
+                           const char *s, uint8_t *out, int max);
+
+#endif
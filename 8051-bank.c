@@ -0,0 +1,286 @@
+/* 8051/8052 register bank tracking through PSW RS0/RS1 */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-xref.h"
+#include "8051-flow.h"
+#include "8051-bank.h"
+
+#define BANK_UNVISITED 0xff
+
+/* bit addresses of RS0, RS1 */
+#define BIT_RS0 0xd3
+#define BIT_RS1 0xd4
+
+/* depth of saved PSW values followed along a path */
+#define PSW_STACK 8
+
+struct bstate {
+	uint8_t bank;
+	uint8_t depth;
+	uint8_t stack[PSW_STACK];
+};
+
+struct bwork {
+	uint16_t pc;
+	struct bstate s;
+};
+
+struct bpass {
+	const struct dis8051_flow *f;
+	uint8_t *bank;
+	struct bwork *work;
+	size_t nwork, awork;
+};
+
+static int queue(struct bpass *p, uint16_t pc, const struct bstate *s)
+{
+	struct bwork *w;
+
+	if (pc < p->f->base || pc - p->f->base >= p->f->len)
+		return 0;
+
+	if (p->nwork == p->awork) {
+		size_t n = p->awork ? p->awork*2 : 64;
+
+		if (!(w = realloc(p->work, n*sizeof(*w))))
+			return -1;
+		p->work = w;
+		p->awork = n;
+	}
+	p->work[p->nwork].pc = pc;
+	p->work[p->nwork++].s = *s;
+	return 0;
+}
+
+/* effect of 'in' on the bank */
+static void step(struct bstate *s, const struct dis8051_insn *in)
+{
+	uint8_t rs;
+	int i;
+
+	switch (in->opcode) {
+	/* setb / clr / cpl RS0, RS1 */
+	case 0xd2:
+	case 0xc2:
+	case 0xb2:
+		if (in->val[0] != BIT_RS0 && in->val[0] != BIT_RS1)
+			return;
+		if (s->bank == DIS8051_BANK_UNKNOWN)
+			return;
+		rs = in->val[0] == BIT_RS0 ? 0x1 : 0x2;
+		if (in->opcode == 0xd2)
+			s->bank |= rs;
+		else if (in->opcode == 0xc2)
+			s->bank &= ~rs;
+		else
+			s->bank ^= rs;
+		return;
+
+	/* mov / orl / anl psw, #imm */
+	case 0x75:
+	case 0x43:
+	case 0x53:
+		if (in->val[0] != DIS8051_SFR_PSW)
+			return;
+		rs = (in->val[1] >> 3) & 0x3;
+		if (in->opcode == 0x75)
+			s->bank = rs;
+		else if (s->bank != DIS8051_BANK_UNKNOWN)
+			s->bank = in->opcode == 0x43 ? s->bank | rs :
+			          s->bank & rs;
+		return;
+
+	/* push psw */
+	case 0xc0:
+		if (in->val[0] == DIS8051_SFR_PSW && s->depth < PSW_STACK)
+			s->stack[s->depth++] = s->bank;
+		return;
+
+	/* pop psw */
+	case 0xd0:
+		if (in->val[0] == DIS8051_SFR_PSW)
+			s->bank = s->depth > 0 ? s->stack[--s->depth] :
+			          DIS8051_BANK_UNKNOWN;
+		return;
+	}
+
+	/* any other write to PSW or its bank select bits */
+	for (i = 0; i < 3 && in->opnd[i] != DIS8051_OPND_NONE; i++) {
+		if (!(dis8051_access(in, i) & DIS8051_WRITE))
+			continue;
+		if ((in->opnd[i] == DIS8051_OPND_DIRECT &&
+		     in->val[i] == DIS8051_SFR_PSW) ||
+		    (in->opnd[i] == DIS8051_OPND_BIT &&
+		     (in->val[i] == BIT_RS0 || in->val[i] == BIT_RS1)))
+			s->bank = DIS8051_BANK_UNKNOWN;
+	}
+}
+
+/* follow one path while it changes the recorded banks */
+static int walk(struct bpass *p, uint16_t pc, struct bstate s)
+{
+	const struct dis8051_flow *f = p->f;
+	const struct dis8051_jtab *j;
+	struct dis8051_insn in;
+	uint8_t *b;
+	int off, i;
+
+	for (;;) {
+		if (pc < f->base || pc - f->base >= f->len)
+			return 0;
+		off = pc - f->base;
+		if (!(f->map[off] & DIS8051_MAP_CODE))
+			return 0;
+
+		/* merge: stop once nothing changes */
+		b = &p->bank[off];
+		if (*b == BANK_UNVISITED)
+			*b = s.bank;
+		else if (*b == s.bank || *b == DIS8051_BANK_UNKNOWN)
+			return 0;
+		else
+			*b = DIS8051_BANK_UNKNOWN;
+		s.bank = *b;
+
+		if (!dis8051_decode(pc, f->buf + off, f->len - off, &in))
+			return 0;
+		step(&s, &in);
+
+		switch (in.flow) {
+		case DIS8051_FLOW_JMP:
+			return queue(p, in.target, &s);
+
+		case DIS8051_FLOW_CJMP:
+		case DIS8051_FLOW_CALL:
+			/* callees run in the caller's bank */
+			if (queue(p, in.target, &s))
+				return -1;
+			break;
+
+		case DIS8051_FLOW_IJMP:
+		case DIS8051_FLOW_RET:
+			if ((j = dis8051_flow_jtab(f, pc)))
+				for (i = 0; i < j->entries; i++)
+					if (queue(p, dis8051_jtab_target(f, j, i),
+					          &s))
+						return -1;
+			return 0;
+
+		case DIS8051_FLOW_RETI:
+		case DIS8051_FLOW_ILL:
+			return 0;
+		}
+
+		pc += in.size;
+	}
+}
+
+static int drain(struct bpass *p)
+{
+	struct bwork w;
+
+	while (p->nwork > 0) {
+		w = p->work[--p->nwork];
+		if (walk(p, w.pc, w.s))
+			return -1;
+	}
+	return 0;
+}
+
+int dis8051_bank_run(const struct dis8051_flow *f, uint8_t *bank)
+{
+	struct bpass p = {f, bank, NULL, 0, 0};
+	struct bstate s;
+	int off, ret;
+
+	memset(bank, BANK_UNVISITED, f->len);
+	memset(&s, 0, sizeof(s));
+
+	/* PSW is 0 after reset */
+	if ((ret = queue(&p, 0x0000, &s)) == 0)
+		ret = drain(&p);
+
+	/* interrupt handlers and entries nobody calls */
+	s.bank = DIS8051_BANK_UNKNOWN;
+	for (off = 0; off < f->len && !ret; off++) {
+		if ((f->map[off] & DIS8051_MAP_FUNC) &&
+		    bank[off] == BANK_UNVISITED) {
+			if ((ret = queue(&p, f->base + off, &s)) == 0)
+				ret = drain(&p);
+		}
+	}
+
+	free(p.work);
+
+	/* code only reachable through unresolved jumps */
+	for (off = 0; off < f->len; off++)
+		if (bank[off] == BANK_UNVISITED)
+			bank[off] = DIS8051_BANK_UNKNOWN;
+
+	return ret;
+}
+
+int dis8051_bank_reg(const struct dis8051_insn *in, int n, uint8_t bank)
+{
+	if (bank >= DIS8051_BANK_UNKNOWN)
+		return -1;
+	if (in->opnd[n] != DIS8051_OPND_RN && in->opnd[n] != DIS8051_OPND_IRI)
+		return -1;
+	return bank*8 + in->val[n];
+}
+
+int dis8051_bank_xrefs(const struct dis8051_flow *f, const uint8_t *bank,
+                       struct dis8051_xrefs *x)
+{
+	struct dis8051_insn in;
+	int off, i, addr, added = 0;
+
+	for (off = 0; off < f->len; off++) {
+		if (!(f->map[off] & DIS8051_MAP_CODE) ||
+		    bank[off] >= DIS8051_BANK_UNKNOWN ||
+		    !dis8051_decode(f->base + off, f->buf + off, f->len - off,
+		                    &in))
+			continue;
+
+		for (i = 0; i < 3 && in.opnd[i] != DIS8051_OPND_NONE; i++) {
+			if ((addr = dis8051_bank_reg(&in, i, bank[off])) < 0)
+				continue;
+			/* @rN only reads the pointer register */
+			if (dis8051_xrefs_add(x, in.pc, addr, DIS8051_SPACE_IRAM,
+			                      in.opnd[i] == DIS8051_OPND_IRI ?
+			                      DIS8051_READ :
+			                      dis8051_access(&in, i)))
+				return -1;
+			added++;
+		}
+	}
+
+	if (added)
+		dis8051_xrefs_sort(x);
+	return 0;
+}
+
+int dis8051_bank_comment(const struct dis8051_flow *f, const uint8_t *bank,
+                         uint16_t pc, char *s, int n)
+{
+	struct dis8051_insn in;
+	int off = pc - f->base, i, addr, len = 0;
+
+	if (pc < f->base || off >= f->len ||
+	    !(f->map[off] & DIS8051_MAP_CODE) ||
+	    !dis8051_decode(pc, f->buf + off, f->len - off, &in))
+		return 0;
+
+	for (i = 0; i < 3 && in.opnd[i] != DIS8051_OPND_NONE && len < n; i++) {
+		if ((addr = dis8051_bank_reg(&in, i, bank[off])) < 0)
+			continue;
+		len += snprintf(s + len, n - len, "%sr%i=0x%02x",
+		                len ? " " : "", in.val[i], addr);
+	}
+
+	return len > 0;
+}
@@ -0,0 +1,35 @@
+/* 8051/8052 register bank tracking through PSW RS0/RS1 */
+
+#ifndef DIS8051_BANK_H
+#define DIS8051_BANK_H
+
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-xref.h"
+#include "8051-flow.h"
+
+/* banks 0 -- 3, or ... */
+#define DIS8051_BANK_UNKNOWN 4
+
+/* active bank at each instruction found by 'f', 'bank' holds f->len
+ * entries and is only meaningful where f->map has DIS8051_MAP_CODE,
+ * the reset entry starts in bank 0, interrupt handlers and other
+ * entries that aren't called in an unknown bank,
+ * returns 0 on success, -1 if out of memory */
+int dis8051_bank_run(const struct dis8051_flow *f, uint8_t *bank);
+
+/* IRAM address of register operand 'n' of 'in' (rN, or the pointer
+ * register of @rN), -1 if there is none or the bank is unknown */
+int dis8051_bank_reg(const struct dis8051_insn *in, int n, uint8_t bank);
+
+/* add the register accesses of all instructions with a known bank
+ * to 'x' as IRAM references, returns 0 on success, -1 if out of memory */
+int dis8051_bank_xrefs(const struct dis8051_flow *f, const uint8_t *bank,
+                       struct dis8051_xrefs *x);
+
+/* comment for the instruction at 'pc', e.g. "r7=0x0f",
+ * returns 0 if there is none */
+int dis8051_bank_comment(const struct dis8051_flow *f, const uint8_t *bank,
+                         uint16_t pc, char *s, int n);
+
+#endif
@@ -0,0 +1,333 @@
+/* analysis cache files */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "8051-flow.h"
+#include "8051-xref.h"
+#include "8051-cache.h"
+
+/* file layout, little endian:
+ *   "D8CACHE1", u32 version, u32 base, u32 len, u64 key,
+ *   u32 jump tables, u32 xrefs, u32 matches, u32 names size,
+ *   the map, a byte per byte of code,
+ *   jump tables: u16 pc, table, table_hi, entries, u8 entry_size, kind,
+ *   xrefs by from then by to: u16 from, to, u8 space, kind,
+ *   matches: u32 address, u32 name offset,
+ *   names, each ending in '\0' */
+#define MAGIC "D8CACHE1"
+#define HEADER 44
+#define JTAB_SIZE 10
+#define XREF_SIZE 6
+#define MATCH_SIZE 8
+
+uint64_t dis8051_cache_hash(uint64_t h, const void *p, size_t n)
+{
+	const uint8_t *b = p;
+
+	if (!h)
+		h = 0xcbf29ce484222325ULL;
+	while (n--) {
+		h ^= *b++;
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+uint64_t dis8051_cache_key(uint16_t base, const uint8_t *code, int len,
+                           uint64_t salt)
+{
+	uint8_t v[16] = {
+		DIS8051_CACHE_VERSION, base, base >> 8,
+		len, len >> 8, len >> 16,
+		salt, salt >> 8, salt >> 16, salt >> 24,
+		salt >> 32, salt >> 40, salt >> 48, salt >> 56
+	};
+
+	return dis8051_cache_hash(dis8051_cache_hash(0, v, sizeof(v)),
+	                          code, len);
+}
+
+/* --- writing --- */
+
+static void put32(FILE *f, uint32_t v)
+{
+	uint8_t b[4] = {v, v >> 8, v >> 16, v >> 24};
+
+	fwrite(b, 1, 4, f);
+}
+
+static void put16(FILE *f, uint16_t v)
+{
+	uint8_t b[2] = {v, v >> 8};
+
+	fwrite(b, 1, 2, f);
+}
+
+static void put_xref(FILE *f, const struct dis8051_xref *r)
+{
+	put16(f, r->from);
+	put16(f, r->to);
+	fputc(r->space, f);
+	fputc(r->kind, f);
+}
+
+static void put_all(FILE *out, uint64_t key, const struct dis8051_flow *f,
+                    const struct dis8051_xrefs *x,
+                    const struct dis8051_cache_match *m, size_t nm)
+{
+	const struct dis8051_jtab *j;
+	size_t nx = x ? x->count : 0, names = 0, i;
+
+	for (i = 0; i < nm; i++)
+		names += strlen(m[i].name) + 1;
+	fwrite(MAGIC, 1, 8, out);
+	put32(out, DIS8051_CACHE_VERSION);
+	put32(out, f->base);
+	put32(out, f->len);
+	put32(out, key);
+	put32(out, key >> 32);
+	put32(out, f->njtabs);
+	put32(out, nx);
+	put32(out, nm);
+	put32(out, names);
+
+	fwrite(f->map, 1, f->len, out);
+	for (i = 0; i < f->njtabs; i++) {
+		j = &f->jtabs[i];
+		put16(out, j->pc);
+		put16(out, j->table);
+		put16(out, j->table_hi);
+		put16(out, j->entries);
+		fputc(j->entry_size, out);
+		fputc(j->kind, out);
+	}
+	for (i = 0; i < nx; i++)
+		put_xref(out, &x->by_from[i]);
+	for (i = 0; i < nx; i++)
+		put_xref(out, &x->by_to[i]);
+	for (i = 0, names = 0; i < nm; i++) {
+		put32(out, m[i].addr);
+		put32(out, names);
+		names += strlen(m[i].name) + 1;
+	}
+	for (i = 0; i < nm; i++)
+		fwrite(m[i].name, 1, strlen(m[i].name) + 1, out);
+}
+
+int dis8051_cache_write(const char *path, uint64_t key,
+                        const struct dis8051_flow *f,
+                        const struct dis8051_xrefs *x,
+                        const struct dis8051_cache_match *m, size_t nm)
+{
+	size_t n = strlen(path);
+	char *tmp;
+	FILE *out;
+	int fd, err;
+
+	/* written next to it and renamed over it */
+	if (!(tmp = malloc(n + 8))) {
+		errno = ENOMEM;
+		return -1;
+	}
+	memcpy(tmp, path, n);
+	memcpy(tmp + n, ".XXXXXX", 8);
+	if ((fd = mkstemp(tmp)) < 0) {
+		err = errno;
+		free(tmp);
+		errno = err;
+		return -1;
+	}
+	fchmod(fd, 0644);
+	if (!(out = fdopen(fd, "wb"))) {
+		err = errno;
+		close(fd);
+		goto fail;
+	}
+	put_all(out, key, f, x, m, nm);
+	if (ferror(out)) {
+		fclose(out);
+		err = EIO;
+		goto fail;
+	}
+	if (fclose(out) || rename(tmp, path)) {
+		err = errno;
+		goto fail;
+	}
+	free(tmp);
+	return 0;
+
+fail:
+	unlink(tmp);
+	free(tmp);
+	errno = err;
+	return -1;
+}
+
+/* --- reading --- */
+
+static uint32_t get32(const uint8_t *p)
+{
+	return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+	return p[0] | p[1] << 8;
+}
+
+int dis8051_cache_open(struct dis8051_cache *c, const char *path,
+                       uint64_t key)
+{
+	const uint8_t *p;
+	struct stat st;
+	uint64_t need;
+	uint32_t len, i;
+	int fd, err;
+
+	memset(c, 0, sizeof(*c));
+	if ((fd = open(path, O_RDONLY)) < 0)
+		return -1;
+	if (fstat(fd, &st) < 0) {
+		err = errno;
+		close(fd);
+		errno = err;
+		return -1;
+	}
+	if (st.st_size < HEADER) {
+		close(fd);
+		errno = EINVAL;
+		return -1;
+	}
+	c->size = st.st_size;
+	c->map = mmap(NULL, c->size, PROT_READ, MAP_SHARED, fd, 0);
+	err = errno;
+	close(fd);
+	if (c->map == MAP_FAILED) {
+		c->map = NULL;
+		errno = err;
+		return -1;
+	}
+
+	p = c->map;
+	if (memcmp(p, MAGIC, 8))
+		goto bad;
+	if (get32(p + 8) != DIS8051_CACHE_VERSION ||
+	    get32(p + 20) != (uint32_t)key ||
+	    get32(p + 24) != (uint32_t)(key >> 32)) {
+		dis8051_cache_close(c);
+		errno = ESTALE;
+		return -1;
+	}
+	c->base = get32(p + 12);
+	len = get32(p + 16);
+	c->njtabs = get32(p + 28);
+	c->nxrefs = get32(p + 32);
+	c->nmatches = get32(p + 36);
+	c->nnames = get32(p + 40);
+	need = HEADER + (uint64_t)len + (uint64_t)c->njtabs*JTAB_SIZE +
+	       (uint64_t)c->nxrefs*2*XREF_SIZE +
+	       (uint64_t)c->nmatches*MATCH_SIZE + c->nnames;
+	if (get32(p + 12) > 0xffff || c->base + (uint64_t)len > 0x10000 ||
+	    need != c->size ||
+	    (c->nnames && p[c->size - 1] != '\0'))
+		goto bad;
+	c->len = len;
+	c->code_map = p + HEADER;
+	c->jtabs = c->code_map + len;
+	c->by_from = c->jtabs + (size_t)c->njtabs*JTAB_SIZE;
+	c->by_to = c->by_from + (size_t)c->nxrefs*XREF_SIZE;
+	c->matches = c->by_to + (size_t)c->nxrefs*XREF_SIZE;
+	c->names = (const char *)c->matches +
+	           (size_t)c->nmatches*MATCH_SIZE;
+	for (i = 0; i < c->nmatches; i++)
+		if (get32(c->matches + (size_t)i*MATCH_SIZE + 4) >= c->nnames)
+			goto bad;
+	return 0;
+
+bad:
+	dis8051_cache_close(c);
+	errno = EINVAL;
+	return -1;
+}
+
+void dis8051_cache_close(struct dis8051_cache *c)
+{
+	if (c->map)
+		munmap(c->map, c->size);
+	memset(c, 0, sizeof(*c));
+}
+
+int dis8051_cache_flow(const struct dis8051_cache *c,
+                       struct dis8051_flow *f, const uint8_t *buf)
+{
+	struct dis8051_jtab *j;
+	const uint8_t *q;
+	uint32_t i;
+
+	if (dis8051_flow_init(f, c->base, buf, c->len, NULL) < 0)
+		return -1;
+	memcpy(f->map, c->code_map, c->len);
+	if (c->njtabs &&
+	    !(f->jtabs = malloc(c->njtabs*sizeof(*f->jtabs)))) {
+		dis8051_flow_free(f);
+		return -1;
+	}
+	f->njtabs = f->ajtabs = c->njtabs;
+	for (i = 0; i < c->njtabs; i++) {
+		q = c->jtabs + (size_t)i*JTAB_SIZE;
+		j = &f->jtabs[i];
+		j->pc = get16(q);
+		j->table = get16(q + 2);
+		j->table_hi = get16(q + 4);
+		j->entries = get16(q + 6);
+		j->entry_size = q[8];
+		j->kind = q[9];
+	}
+	return 0;
+}
+
+static void get_xrefs(struct dis8051_xref *r, const uint8_t *q, uint32_t n)
+{
+	for (; n--; r++, q += XREF_SIZE) {
+		r->from = get16(q);
+		r->to = get16(q + 2);
+		r->space = q[4];
+		r->kind = q[5];
+	}
+}
+
+int dis8051_cache_xrefs(const struct dis8051_cache *c,
+                        struct dis8051_xrefs *x)
+{
+	size_t n = c->nxrefs ? c->nxrefs : 1;
+
+	memset(x, 0, sizeof(*x));
+	x->by_from = malloc(n*sizeof(*x->by_from));
+	x->by_to = malloc(n*sizeof(*x->by_to));
+	if (!x->by_from || !x->by_to) {
+		dis8051_xrefs_free(x);
+		return -1;
+	}
+	/* stored in both orders, nothing to sort */
+	get_xrefs(x->by_from, c->by_from, c->nxrefs);
+	get_xrefs(x->by_to, c->by_to, c->nxrefs);
+	x->count = c->nxrefs;
+	x->alloc = n;
+	return 0;
+}
+
+const char *dis8051_cache_match(const struct dis8051_cache *c, uint32_t i,
+                                uint32_t *addr)
+{
+	const uint8_t *q = c->matches + (size_t)i*MATCH_SIZE;
+
+	*addr = get32(q);
+	return c->names + get32(q + 4);
+}
@@ -0,0 +1,72 @@
+/* analysis cache: the code map, jump tables, cross references with the
+ * resolved DPTR targets and register accesses in their banks, and the
+ * signature matches of an image in a file, keyed by a hash of the code
+ * and the analysis version, and read back through a read only mapping */
+
+#ifndef DIS8051_CACHE_H
+#define DIS8051_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-flow.h"
+#include "8051-xref.h"
+
+/* of the results, a cache written by another version is stale */
+#define DIS8051_CACHE_VERSION 2
+
+/* FNV-1a, start with 0 */
+uint64_t dis8051_cache_hash(uint64_t h, const void *p, size_t n);
+
+/* key of 'len' bytes of code at 'base', 'salt' the hash of anything
+ * else the results depend on, e.g. the signature file, or 0 */
+uint64_t dis8051_cache_key(uint16_t base, const uint8_t *code, int len,
+                           uint64_t salt);
+
+/* a signature match, see dis8051_sigs_scan() */
+struct dis8051_cache_match {
+	uint32_t addr;
+	const char *name;
+};
+
+/* write the results for 'key': the map and jump tables of 'f', 'x'
+ * unless NULL and 'nm' matches; the file is replaced at once, so
+ * readers see the old one or the new one;
+ * returns 0 on success, -1 with errno set */
+int dis8051_cache_write(const char *path, uint64_t key,
+                        const struct dis8051_flow *f,
+                        const struct dis8051_xrefs *x,
+                        const struct dis8051_cache_match *m, size_t nm);
+
+/* a cache file mapped for reading */
+struct dis8051_cache {
+	void *map;
+	size_t size;
+	uint16_t base;
+	int len;
+	const uint8_t *code_map;   /* DIS8051_MAP_* for each byte */
+	uint32_t njtabs, nxrefs, nmatches, nnames;
+	const uint8_t *jtabs, *by_from, *by_to, *matches;
+	const char *names;
+};
+
+/* returns 0 on success, -1 with errno set: ESTALE if the file is for
+ * another key or version, EINVAL if it is no cache */
+int dis8051_cache_open(struct dis8051_cache *c, const char *path,
+                       uint64_t key);
+void dis8051_cache_close(struct dis8051_cache *c);
+
+/* 'f' as the traversal over 'buf' left it, 'buf' being the code the
+ * key was made of; returns 0 on success, -1 if out of memory */
+int dis8051_cache_flow(const struct dis8051_cache *c,
+                       struct dis8051_flow *f, const uint8_t *buf);
+
+/* the cross references, or none if none were written;
+ * returns 0 on success, -1 if out of memory */
+int dis8051_cache_xrefs(const struct dis8051_cache *c,
+                        struct dis8051_xrefs *x);
+
+/* name and address of match 'i' of 'nmatches' */
+const char *dis8051_cache_match(const struct dis8051_cache *c, uint32_t i,
+                                uint32_t *addr);
+
+#endif
@@ -0,0 +1,472 @@
+/* 8051 code banking: images larger than 64 KiB behind a bank window */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-flow.h"
+#include "8051-codebank.h"
+
+/* instructions followed into a trampoline */
+#define TRAMP_STEPS 32
+
+/* depth of pushed bytes followed in a trampoline */
+#define TRAMP_STACK 8
+
+/* what a trampoline has set so far, 'known' has a bit per register
+ * and per select bit */
+#define K_A   0x1
+#define K_DPL 0x2
+#define K_DPH 0x4
+
+struct tstate {
+	uint8_t a, dpl, dph, sel;
+	uint8_t known, sel_known;
+	int depth;
+	uint8_t stack[TRAMP_STACK];
+	uint8_t stack_known[TRAMP_STACK];
+};
+
+void dis8051_codebank_layout_init(struct dis8051_codebank_layout *l)
+{
+	l->window = 0x8000;
+	l->first = 0x8000;
+	l->stride = 0x10000;
+	l->sel_sfr = 0x90;   /* P1 */
+	l->sel_mask = 0x0f;
+}
+
+/* bank number in select SFR value 'v' */
+static int sel_bank(const struct dis8051_codebank_layout *l, uint8_t v)
+{
+	uint8_t m = l->sel_mask;
+
+	v &= m;
+	for (; !(m & 1); m >>= 1)
+		v >>= 1;
+	return v;
+}
+
+static int view_fill(struct dis8051_codebank *cb, int bank)
+{
+	const struct dis8051_codebank_layout *l = &cb->layout;
+	uint8_t *v;
+	size_t off, n;
+
+	if (!(v = malloc(0x10000)))
+		return -1;
+	memset(v, 0xff, 0x10000);
+
+	n = cb->len < l->window ? cb->len : l->window;
+	memcpy(v, cb->img, n);
+	off = l->first + (size_t)bank*l->stride;
+	if (off < cb->len) {
+		n = cb->len - off;
+		if (n > 0x10000u - l->window)
+			n = 0x10000u - l->window;
+		memcpy(v + l->window, cb->img + off, n);
+	}
+
+	cb->views[bank].buf = v;
+	return dis8051_flow_init(&cb->views[bank].flow, 0x0000, v, 0x10000,
+	                         NULL);
+}
+
+int dis8051_codebank_init(struct dis8051_codebank *cb,
+                          const struct dis8051_codebank_layout *l,
+                          const uint8_t *img, size_t len)
+{
+	size_t n;
+	int b;
+
+	memset(cb, 0, sizeof(*cb));
+	if (!l->window || !l->stride || !l->sel_mask ||
+	    l->stride < 0x10000u - l->window || l->first < l->window)
+		return -1;
+
+	cb->layout = *l;
+	cb->img = img;
+	cb->len = len;
+
+	/* the banks the image has room for, at least bank 0 */
+	n = len > l->first ? (len - l->first + l->stride - 1) / l->stride : 1;
+	cb->nbanks = n < DIS8051_CODEBANK_MAX ? (int)n : DIS8051_CODEBANK_MAX;
+	if (cb->nbanks > sel_bank(l, 0xff) + 1)
+		cb->nbanks = sel_bank(l, 0xff) + 1;
+
+	if (!(cb->views = calloc(cb->nbanks, sizeof(*cb->views))))
+		return -1;
+	for (b = 0; b < cb->nbanks; b++) {
+		if (view_fill(cb, b)) {
+			dis8051_codebank_free(cb);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+void dis8051_codebank_free(struct dis8051_codebank *cb)
+{
+	int b;
+
+	for (b = 0; cb->views && b < cb->nbanks; b++) {
+		dis8051_flow_free(&cb->views[b].flow);
+		free(cb->views[b].buf);
+	}
+	free(cb->views);
+	free(cb->calls);
+	memset(cb, 0, sizeof(*cb));
+}
+
+uint32_t dis8051_codebank_addr(const struct dis8051_codebank *cb,
+                               unsigned bank, uint16_t addr)
+{
+	return addr < cb->layout.window ? DIS8051_BADDR(0, addr) :
+	       DIS8051_BADDR(bank, addr);
+}
+
+long dis8051_codebank_offset(const struct dis8051_codebank *cb, uint32_t b)
+{
+	const struct dis8051_codebank_layout *l = &cb->layout;
+	unsigned bank = DIS8051_BADDR_BANK(b);
+	uint16_t addr = DIS8051_BADDR_ADDR(b);
+	size_t off;
+
+	if (addr < l->window)
+		off = addr;
+	else if (bank < (unsigned)cb->nbanks)
+		off = l->first + (size_t)bank*l->stride + (addr - l->window);
+	else
+		return -1;
+	return off < cb->len ? (long)off : -1;
+}
+
+/* value of direct address 'addr', 0 if unknown */
+static int t_get(const struct dis8051_codebank *cb, const struct tstate *t,
+                 uint8_t addr, uint8_t *v)
+{
+	switch (addr) {
+	case DIS8051_SFR_ACC: *v = t->a;   return t->known & K_A;
+	case DIS8051_SFR_DPL: *v = t->dpl; return t->known & K_DPL;
+	case DIS8051_SFR_DPH: *v = t->dph; return t->known & K_DPH;
+	}
+	if (addr == cb->layout.sel_sfr) {
+		*v = t->sel;
+		return t->sel_known == 0xff;
+	}
+	return 0;
+}
+
+/* set direct address 'addr' to 'v', or to unknown if '!known' */
+static void t_set(const struct dis8051_codebank *cb, struct tstate *t,
+                  uint8_t addr, uint8_t v, int known)
+{
+	uint8_t k = 0;
+
+	switch (addr) {
+	case DIS8051_SFR_ACC: t->a = v;   k = K_A; break;
+	case DIS8051_SFR_DPL: t->dpl = v; k = K_DPL; break;
+	case DIS8051_SFR_DPH: t->dph = v; k = K_DPH; break;
+	}
+	if (k) {
+		t->known = known ? t->known | k : t->known & ~k;
+	} else if (addr == cb->layout.sel_sfr) {
+		t->sel = v;
+		t->sel_known = known ? 0xff : 0;
+	}
+}
+
+/* orl / anl of known bits into the select SFR */
+static void t_sel_logic(struct tstate *t, int orl, uint8_t v)
+{
+	if (orl) {
+		t->sel |= v;
+		t->sel_known |= v;
+	} else {
+		t->sel &= v;
+		t->sel_known |= (uint8_t)~v;
+	}
+}
+
+/* effect of 'in' on 't', returns 0 for anything a trampoline doesn't do */
+static int t_step(const struct dis8051_codebank *cb, struct tstate *t,
+                  const struct dis8051_insn *in)
+{
+	uint8_t v = 0, sel = cb->layout.sel_sfr;
+	int i;
+
+	switch (in->opcode) {
+	case 0x90: /* mov dptr, #imm16 */
+		t->dpl = in->val[1] & 0xff;
+		t->dph = in->val[1] >> 8;
+		t->known |= K_DPL | K_DPH;
+		return 1;
+	case 0xa3: /* inc dptr */
+		if ((t->known & (K_DPL | K_DPH)) == (K_DPL | K_DPH)) {
+			if (++t->dpl == 0)
+				t->dph++;
+		} else {
+			t->known &= ~(K_DPL | K_DPH);
+		}
+		return 1;
+	case 0xe4: /* clr a */
+		t_set(cb, t, DIS8051_SFR_ACC, 0, 1);
+		return 1;
+	case 0x74: /* mov a, #imm */
+		t_set(cb, t, DIS8051_SFR_ACC, in->val[1], 1);
+		return 1;
+	case 0xe5: /* mov a, direct */
+		i = t_get(cb, t, in->val[1], &v);
+		t_set(cb, t, DIS8051_SFR_ACC, v, i);
+		return 1;
+	case 0x75: /* mov direct, #imm */
+		t_set(cb, t, in->val[0], in->val[1], 1);
+		return 1;
+	case 0xf5: /* mov direct, a */
+		t_set(cb, t, in->val[0], t->a, t->known & K_A);
+		return 1;
+	case 0x42: /* orl direct, a */
+	case 0x52: /* anl direct, a */
+	case 0x43: /* orl direct, #imm */
+	case 0x53: /* anl direct, #imm */
+		if (in->val[0] != sel)
+			break;
+		if (in->opcode & 0x1)
+			t_sel_logic(t, in->opcode < 0x50, in->val[1]);
+		else if (t->known & K_A)
+			t_sel_logic(t, in->opcode < 0x50, t->a);
+		else
+			t->sel_known = 0;
+		return 1;
+	case 0xd2: /* setb bit */
+	case 0xc2: /* clr bit */
+		if ((in->val[0] & 0xf8) != sel || sel & 0x7)
+			break;
+		v = 1 << (in->val[0] & 0x7);
+		t_sel_logic(t, in->opcode == 0xd2,
+		            in->opcode == 0xd2 ? v : (uint8_t)~v);
+		return 1;
+	case 0xc0: /* push direct */
+		if (t->depth == TRAMP_STACK)
+			return 0;
+		t->stack_known[t->depth] = t_get(cb, t, in->val[0], &v) != 0;
+		t->stack[t->depth++] = v;
+		return 1;
+	case 0xd0: /* pop direct */
+		if (t->depth == 0)
+			return 0;
+		t->depth--;
+		t_set(cb, t, in->val[0], t->stack[t->depth],
+		      t->stack_known[t->depth]);
+		return 1;
+	}
+
+	/* the rest may only change what a trampoline doesn't use */
+	if (in->flow != DIS8051_FLOW_NONE)
+		return 0;
+	for (i = 0; i < 3 && in->opnd[i] != DIS8051_OPND_NONE; i++) {
+		if (!(dis8051_access(in, i) & DIS8051_WRITE))
+			continue;
+		switch (in->opnd[i]) {
+		case DIS8051_OPND_A:
+			t->known &= ~K_A;
+			break;
+		case DIS8051_OPND_DPTR:
+			t->known &= ~(K_DPL | K_DPH);
+			break;
+		case DIS8051_OPND_DIRECT:
+			t_set(cb, t, in->val[i], 0, 0);
+			break;
+		case DIS8051_OPND_BIT:
+			if ((in->val[i] & 0xf8) == sel && !(sel & 0x7))
+				t->sel_known &= ~(1 << (in->val[i] & 0x7));
+			break;
+		}
+	}
+	return 1;
+}
+
+/* bank number from the select bits, -1 if not all of them are known */
+static int t_bank(const struct dis8051_codebank *cb, const struct tstate *t)
+{
+	uint8_t m = cb->layout.sel_mask;
+
+	if ((t->sel_known & m) != m)
+		return -1;
+	return sel_bank(&cb->layout, t->sel);
+}
+
+int dis8051_codebank_trampoline(const struct dis8051_codebank *cb,
+                                const uint8_t *view, uint16_t addr,
+                                uint32_t *target)
+{
+	struct dis8051_insn in;
+	struct tstate t;
+	uint16_t pc = addr, to;
+	int n, bank;
+
+	/* the trampoline itself is in the common area */
+	if (addr >= cb->layout.window)
+		return 0;
+
+	memset(&t, 0, sizeof(t));
+	for (n = 0; n < TRAMP_STEPS; n++) {
+		if (pc >= cb->layout.window ||
+		    !dis8051_decode(pc, view + pc, 0x10000 - pc, &in))
+			return 0;
+
+		switch (in.flow) {
+		case DIS8051_FLOW_JMP:
+			pc = in.target;
+			continue;
+
+		/* jmp @a+dptr */
+		case DIS8051_FLOW_IJMP:
+			if ((t.known & (K_A | K_DPL | K_DPH)) !=
+			    (K_A | K_DPL | K_DPH))
+				return 0;
+			to = (t.dph << 8 | t.dpl) + t.a;
+			break;
+
+		/* ret to a pushed address */
+		case DIS8051_FLOW_RET:
+			if (t.depth < 2 || !t.stack_known[t.depth-1] ||
+			    !t.stack_known[t.depth-2])
+				return 0;
+			to = t.stack[t.depth-1] << 8 | t.stack[t.depth-2];
+			break;
+
+		default:
+			if (!t_step(cb, &t, &in))
+				return 0;
+			pc += in.size;
+			continue;
+		}
+
+		/* a jump that doesn't switch banks is no trampoline */
+		if (to < cb->layout.window || (bank = t_bank(cb, &t)) < 0 ||
+		    bank >= cb->nbanks)
+			return 0;
+		*target = DIS8051_BADDR(bank, to);
+		return 1;
+	}
+	return 0;
+}
+
+static int far_cmp(const void *a, const void *b)
+{
+	const struct dis8051_farcall *x = a, *y = b;
+
+	return x->site < y->site ? -1 : x->site > y->site;
+}
+
+const struct dis8051_farcall *
+dis8051_codebank_far(const struct dis8051_codebank *cb, uint32_t site)
+{
+	struct dis8051_farcall key;
+
+	key.site = site;
+	return cb->ncalls ? bsearch(&key, cb->calls, cb->ncalls,
+	                            sizeof(*cb->calls), far_cmp) : NULL;
+}
+
+/* insert in site order */
+static int far_add(struct dis8051_codebank *cb, uint32_t site, uint16_t via,
+                   uint32_t target)
+{
+	struct dis8051_farcall *c;
+	size_t lo = 0, hi = cb->ncalls, mid;
+
+	if (cb->ncalls == cb->acalls) {
+		size_t n = cb->acalls ? cb->acalls*2 : 64;
+
+		if (!(c = realloc(cb->calls, n*sizeof(*c))))
+			return -1;
+		cb->calls = c;
+		cb->acalls = n;
+	}
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (cb->calls[mid].site < site)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	c = &cb->calls[lo];
+	memmove(c + 1, c, (cb->ncalls++ - lo)*sizeof(*c));
+	c->site = site;
+	c->via = via;
+	c->target = target;
+	return 0;
+}
+
+/* record the far calls of 'bank' and queue their targets,
+ * returns the number of new entries or -1 if out of memory */
+static int scan(struct dis8051_codebank *cb, int bank)
+{
+	const struct dis8051_codebank_view *v = &cb->views[bank];
+	struct dis8051_flow *to;
+	struct dis8051_insn in;
+	uint32_t site, target;
+	int pc, added = 0;
+
+	for (pc = 0; pc < 0x10000; pc++) {
+		if (!(v->flow.map[pc] & DIS8051_MAP_CODE) ||
+		    !dis8051_decode(pc, v->buf + pc, 0x10000 - pc, &in) ||
+		    (in.flow != DIS8051_FLOW_CALL &&
+		     in.flow != DIS8051_FLOW_JMP))
+			continue;
+
+		/* common code is the same in every view */
+		site = dis8051_codebank_addr(cb, bank, pc);
+		if (dis8051_codebank_far(cb, site) ||
+		    !dis8051_codebank_trampoline(cb, v->buf, in.target,
+		                                 &target))
+			continue;
+		if (far_add(cb, site, in.target, target))
+			return -1;
+
+		to = &cb->views[DIS8051_BADDR_BANK(target)].flow;
+		if (to->map[DIS8051_BADDR_ADDR(target)] & DIS8051_MAP_FUNC)
+			continue;
+		if (dis8051_flow_add_entry(to, DIS8051_BADDR_ADDR(target)))
+			return -1;
+		added++;
+	}
+	return added;
+}
+
+int dis8051_codebank_run(struct dis8051_codebank *cb)
+{
+	int b, n, added;
+
+	if (dis8051_flow_add_vectors(&cb->views[0].flow))
+		return -1;
+
+	do {
+		for (b = 0; b < cb->nbanks; b++)
+			if (dis8051_flow_run(&cb->views[b].flow))
+				return -1;
+		added = 0;
+		for (b = 0; b < cb->nbanks; b++) {
+			if ((n = scan(cb, b)) < 0)
+				return -1;
+			added += n;
+		}
+	} while (added);
+
+	return 0;
+}
+
+int dis8051_codebank_comment(const struct dis8051_codebank *cb,
+                             uint32_t site, char *s, int n)
+{
+	const struct dis8051_farcall *c = dis8051_codebank_far(cb, site);
+
+	if (!c)
+		return 0;
+	snprintf(s, n, "far %x:0x%04x", DIS8051_BADDR_BANK(c->target),
+	         DIS8051_BADDR_ADDR(c->target));
+	return 1;
+}
@@ -0,0 +1,91 @@
+/* 8051 code banking: images larger than 64 KiB behind a bank window */
+
+#ifndef DIS8051_CODEBANK_H
+#define DIS8051_CODEBANK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-flow.h"
+
+/* bank:address, addresses below the window are in the common area and
+ * always have bank 0; r2 addresses of a banked image are the same */
+#define DIS8051_BADDR(bank, addr) ((uint32_t)(bank) << 16 | (uint16_t)(addr))
+#define DIS8051_BADDR_BANK(b)     ((unsigned)((b) >> 16))
+#define DIS8051_BADDR_ADDR(b)     ((uint16_t)(b))
+
+#define DIS8051_CODEBANK_MAX 256
+
+/* where the banks are in the image and how code selects them */
+struct dis8051_codebank_layout {
+	uint16_t window;   /* first banked address */
+	uint32_t first;    /* image offset of the window of bank 0 */
+	uint32_t stride;   /* image offset from one bank to the next */
+	uint8_t sel_sfr;   /* SFR selecting the bank */
+	uint8_t sel_mask;  /* its bits holding the bank number */
+};
+
+/* a call or jump into a bank switch trampoline */
+struct dis8051_farcall {
+	uint32_t site;     /* bank:address of the call */
+	uint16_t via;      /* trampoline, in the common area */
+	uint32_t target;   /* bank:address it switches to */
+};
+
+/* 64 KiB as the CPU sees it with one bank selected */
+struct dis8051_codebank_view {
+	uint8_t *buf;
+	struct dis8051_flow flow;
+};
+
+struct dis8051_codebank {
+	struct dis8051_codebank_layout layout;
+	const uint8_t *img;
+	size_t len;
+	int nbanks;
+	struct dis8051_codebank_view *views;  /* one per bank */
+	struct dis8051_farcall *calls;        /* sorted by site */
+	size_t ncalls, acalls;
+};
+
+/* Keil BL51 style: 32 KiB banks at 0x8000, bank n at image offset
+ * n*0x10000 + 0x8000 (as in banked HEX files), selected by P1.0 -- P1.3 */
+void dis8051_codebank_layout_init(struct dis8051_codebank_layout *l);
+
+/* 'len' bytes of banked image 'img', kept by reference,
+ * returns 0 on success, -1 if out of memory or the layout is invalid */
+int dis8051_codebank_init(struct dis8051_codebank *cb,
+                          const struct dis8051_codebank_layout *l,
+                          const uint8_t *img, size_t len);
+void dis8051_codebank_free(struct dis8051_codebank *cb);
+
+/* follow the reset and interrupt vectors in bank 0 and every far call
+ * found through trampolines into the other banks, until no new code
+ * turns up; each view's flow is then ready for the other passes,
+ * returns 0 on success, -1 if out of memory */
+int dis8051_codebank_run(struct dis8051_codebank *cb);
+
+/* 'addr' seen with 'bank' selected as bank:address */
+uint32_t dis8051_codebank_addr(const struct dis8051_codebank *cb,
+                               unsigned bank, uint16_t addr);
+
+/* image offset of bank:address 'b', -1 if outside the image */
+long dis8051_codebank_offset(const struct dis8051_codebank *cb, uint32_t b);
+
+/* bank:address and target of the trampoline at 'addr' in 'view', which
+ * loads DPTR or pushes a return address, sets the select bits and jumps
+ * there with ljmp / ajmp / sjmp in between, as ?B_SWITCHn does,
+ * returns 0 if there is none */
+int dis8051_codebank_trampoline(const struct dis8051_codebank *cb,
+                                const uint8_t *view, uint16_t addr,
+                                uint32_t *target);
+
+/* far call at bank:address 'site', or NULL */
+const struct dis8051_farcall *
+dis8051_codebank_far(const struct dis8051_codebank *cb, uint32_t site);
+
+/* comment for the instruction at 'site', e.g. "far 3:0x8123",
+ * returns 0 if there is none */
+int dis8051_codebank_comment(const struct dis8051_codebank *cb,
+                             uint32_t site, char *s, int n);
+
+#endif
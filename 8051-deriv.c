@@ -0,0 +1,1119 @@
+/* generated by tools/gen-isa.py from 8051.sfr and 8051.isa, do not edit */
+
+#include <stddef.h>
+#include "8051-render.h"
+
+#define OP(m, f, s, c, fl, o1, o2, o3) \
+	{DIS8051_##m, DIS8051_FLOW_##f, s, c, fl, \
+	 {DIS8051_OPND_##o1, DIS8051_OPND_##o2, DIS8051_OPND_##o3}}
+
+static const char *const sfr_8052[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "", "", "", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "", "",
+/* 0x90 -- 0x97 */
+	"P1", "", "", "", "", "", "", "",
+/* 0x98 -- 0x9f */
+	"SCON", "SBUF", "", "", "", "", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "", "", "", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "", "", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "",
+/* 0xb8 -- 0xbf */
+	"IP", "", "", "", "", "", "", "",
+/* 0xc0 -- 0xc7 */
+	"", "", "", "", "", "", "", "",
+/* 0xc8 -- 0xcf */
+	"T2CON", "", "RCAP2L", "RCAP2H", "TL2", "TH2", "", "",
+/* 0xd0 -- 0xd7 */
+	"PSW", "", "", "", "", "", "", "",
+/* 0xd8 -- 0xdf */
+	"", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "", "",
+/* 0xe8 -- 0xef */
+	"", "", "", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "", "",
+/* 0xf8 -- 0xff */
+	"", "", "", "", "", "", "", "",
+};
+
+static const char *const bit_8052[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI", "TI", "RB8", "TB8", "REN", "SM2", "SM1", "SM0",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS", "PT2", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"", "", "", "", "", "", "", "",
+/* 0xc8 -- 0xcf */
+	"CP/RL2", "CP/T2", "TR2", "EXEN2", "TLCK", "RCLK", "EXF2", "TF2",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"", "", "", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"", "", "", "", "", "", "", "",
+};
+
+static const char *const sfr_8051[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "", "", "", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "", "",
+/* 0x90 -- 0x97 */
+	"P1", "", "", "", "", "", "", "",
+/* 0x98 -- 0x9f */
+	"SCON", "SBUF", "", "", "", "", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "", "", "", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "", "", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "",
+/* 0xb8 -- 0xbf */
+	"IP", "", "", "", "", "", "", "",
+/* 0xc0 -- 0xc7 */
+	"", "", "", "", "", "", "", "",
+/* 0xc8 -- 0xcf */
+	"", "", "", "", "", "", "", "",
+/* 0xd0 -- 0xd7 */
+	"PSW", "", "", "", "", "", "", "",
+/* 0xd8 -- 0xdf */
+	"", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "", "",
+/* 0xe8 -- 0xef */
+	"", "", "", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "", "",
+/* 0xf8 -- 0xff */
+	"", "", "", "", "", "", "", "",
+};
+
+static const char *const bit_8051[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI", "TI", "RB8", "TB8", "REN", "SM2", "SM1", "SM0",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES", "IE.5", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS", "IP.5", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"", "", "", "", "", "", "", "",
+/* 0xc8 -- 0xcf */
+	"", "", "", "", "", "", "", "",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"", "", "", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"", "", "", "", "", "", "", "",
+};
+
+static const char *const sfr_at89s52[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DP0L", "DP0H", "DP1L", "DP1H", "", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "AUXR", "",
+/* 0x90 -- 0x97 */
+	"P1", "", "", "", "", "", "", "",
+/* 0x98 -- 0x9f */
+	"SCON", "SBUF", "", "", "", "", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "", "AUXR1", "", "", "", "WDTRST", "",
+/* 0xa8 -- 0xaf */
+	"IE", "", "", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "",
+/* 0xb8 -- 0xbf */
+	"IP", "", "", "", "", "", "", "",
+/* 0xc0 -- 0xc7 */
+	"", "", "", "", "", "", "", "",
+/* 0xc8 -- 0xcf */
+	"T2CON", "T2MOD", "RCAP2L", "RCAP2H", "TL2", "TH2", "", "",
+/* 0xd0 -- 0xd7 */
+	"PSW", "", "", "", "", "", "", "",
+/* 0xd8 -- 0xdf */
+	"", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "", "",
+/* 0xe8 -- 0xef */
+	"", "", "", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "", "",
+/* 0xf8 -- 0xff */
+	"", "", "", "", "", "", "", "",
+};
+
+static const char *const bit_at89s52[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI", "TI", "RB8", "TB8", "REN", "SM2", "SM1", "SM0",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS", "PT2", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"", "", "", "", "", "", "", "",
+/* 0xc8 -- 0xcf */
+	"CP/RL2", "CP/T2", "TR2", "EXEN2", "TLCK", "RCLK", "EXF2", "TF2",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"", "", "", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"", "", "", "", "", "", "", "",
+};
+
+static const char *const sfr_ds89c450[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "DPL1", "DPH1", "DPS", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "CKCON", "",
+/* 0x90 -- 0x97 */
+	"P1", "EXIF", "", "", "", "", "CKMOD", "",
+/* 0x98 -- 0x9f */
+	"SCON0", "SBUF0", "", "", "", "ACON", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "", "", "", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR0", "SADDR1", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "IP1", "", "", "", "", "", "",
+/* 0xb8 -- 0xbf */
+	"IP0", "SADEN0", "SADEN1", "", "", "", "", "",
+/* 0xc0 -- 0xc7 */
+	"SCON1", "SBUF1", "ROMSIZE", "", "PMR", "STATUS", "", "TA",
+/* 0xc8 -- 0xcf */
+	"T2CON", "T2MOD", "RCAP2L", "RCAP2H", "TL2", "TH2", "", "",
+/* 0xd0 -- 0xd7 */
+	"PSW", "", "", "", "", "FCNTL", "FDATA", "",
+/* 0xd8 -- 0xdf */
+	"WDCON", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "", "",
+/* 0xe8 -- 0xef */
+	"EIE", "", "", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "EIP1", "", "", "", "", "", "",
+/* 0xf8 -- 0xff */
+	"EIP0", "", "", "", "", "", "", "",
+};
+
+static const char *const bit_ds89c450[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI_0", "TI_0", "RB8_0", "TB8_0", "REN_0", "SM2_0", "SM1_0", "SM0/FE_0",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS0", "PT2", "PS1", "IP0.7",
+/* 0xc0 -- 0xc7 */
+	"RI_1", "TI_1", "RB8_1", "TB8_1", "REN_1", "SM2_1", "SM1_1", "SM0/FE_1",
+/* 0xc8 -- 0xcf */
+	"CP/RL2", "CP/T2", "TR2", "EXEN2", "TLCK", "RCLK", "EXF2", "TF2",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"RWT", "EWT", "WTRF", "WDIF", "PFI", "EPFI", "POR", "SMOD_1",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"EX2", "EX3", "EX4", "EX5", "EWDI", "EIE.5", "EIE.6", "EIE.7",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"PX2", "PX3", "PX4", "PX5", "PWDI", "EIP0.5", "EIP0.6", "EIP0.7",
+};
+
+static const char *const sfr_c8051f3xx[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "", "", "", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "CKCON", "PSCTL",
+/* 0x90 -- 0x97 */
+	"P1", "TMR3CN", "TMR3RLL", "TMR3RLH", "TMR3L", "TMR3H", "IDA0L", "IDA0H",
+/* 0x98 -- 0x9f */
+	"SCON0", "SBUF0", "", "CPT0CN", "", "CPT0MD", "", "CPT0MX",
+/* 0xa0 -- 0xa7 */
+	"P2", "", "", "", "P0MDOUT", "P1MDOUT", "P2MDOUT", "",
+/* 0xa8 -- 0xaf */
+	"IE", "CLKSEL", "EMI0CN", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"", "OSCXCN", "OSCICN", "OSCICL", "", "", "FLSCL", "FLKEY",
+/* 0xb8 -- 0xbf */
+	"IP", "", "ADC0TK", "ADC0MX", "ADC0CF", "ADC0L", "ADC0H", "",
+/* 0xc0 -- 0xc7 */
+	"SMB0CN", "SMB0CF", "SMB0DAT", "ADC0GTL", "ADC0GTH", "ADC0LTL", "ADC0LTH", "",
+/* 0xc8 -- 0xcf */
+	"TMR2CN", "", "TMR2RLL", "TMR2RLH", "TMR2L", "TMR2H", "", "",
+/* 0xd0 -- 0xd7 */
+	"PSW", "REF0CN", "", "", "P0SKIP", "P1SKIP", "", "",
+/* 0xd8 -- 0xdf */
+	"PCA0CN", "PCA0MD", "PCA0CPM0", "PCA0CPM1", "PCA0CPM2", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC", "XBR0", "XBR1", "", "IT01CF", "", "EIE1", "",
+/* 0xe8 -- 0xef */
+	"ADC0CN", "PCA0CPL1", "PCA0CPH1", "PCA0CPL2", "PCA0CPH2", "", "", "RSTSRC",
+/* 0xf0 -- 0xf7 */
+	"B", "P0MDIN", "P1MDIN", "", "", "", "EIP1", "",
+/* 0xf8 -- 0xff */
+	"SPI0CN", "PCA0L", "PCA0H", "PCA0CPL0", "PCA0CPH0", "", "", "VDM0CN",
+};
+
+static const char *const bit_c8051f3xx[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI0", "TI0", "RB80", "TB80", "REN0", "SCON0.5", "MCE0", "S0MODE",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES0", "ET2", "ESPI0", "EA",
+/* 0xb0 -- 0xb7 */
+	"", "", "", "", "", "", "", "",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS0", "PT2", "PSPI0", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"SI", "ACK", "ARBLOST", "ACKRQ", "STO", "STA", "TXMODE", "MASTER",
+/* 0xc8 -- 0xcf */
+	"T2XCLK", "TMR2CN.1", "TR2", "TMR2CN.3", "TF2CEN", "TF2LEN", "TF2L", "TF2H",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"CCF0", "CCF1", "CCF2", "PCA0CN.3", "PCA0CN.4", "PCA0CN.5", "CR", "CF",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"AD0CM0", "AD0CM1", "AD0CM2", "AD0WINT", "AD0BUSY", "AD0INT", "AD0TM", "AD0EN",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"SPIEN", "TXBMT", "NSSMD0", "NSSMD1", "RXOVRN", "MODF", "WCOL", "SPIF",
+};
+
+static const struct dis8051_ext ext_cc2530[1] = {
+	{0xa5, OP(TRAP, NONE, 1, 1, 0, NONE, NONE, NONE), ""},
+};
+
+static const char *const sfr_cc2530[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL0", "DPH0", "DPL1", "DPH1", "U0CSR", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "P0IFG", "P1IFG", "P2IFG", "PICTL", "P1IEN", "", "P0INP",
+/* 0x90 -- 0x97 */
+	"P1", "RFIRQF1", "DPS", "MPAGE", "T2CTRL", "ST0", "ST1", "ST2",
+/* 0x98 -- 0x9f */
+	"S0CON", "", "IEN2", "S1CON", "T2EVTCFG", "SLEEPSTA", "CLKCONSTA", "FMAP",
+/* 0xa0 -- 0xa7 */
+	"P2", "T2IRQF", "T2M0", "T2M1", "T2MOVF0", "T2MOVF1", "T2MOVF2", "T2IRQM",
+/* 0xa8 -- 0xaf */
+	"IEN0", "IP0", "", "P0IEN", "P2IEN", "STLOAD", "PMUX", "T1STAT",
+/* 0xb0 -- 0xb7 */
+	"", "ENCDI", "ENCDO", "ENCCS", "ADCCON1", "ADCCON2", "ADCCON3", "",
+/* 0xb8 -- 0xbf */
+	"IEN1", "IP1", "ADCL", "ADCH", "RNDL", "RNDH", "SLEEPCMD", "RFERRF",
+/* 0xc0 -- 0xc7 */
+	"IRCON", "U0DBUF", "U0BAUD", "T2MSEL", "U0UCR", "U0GCR", "CLKCONCMD", "MEMCTR",
+/* 0xc8 -- 0xcf */
+	"", "WDCTL", "T3CNT", "T3CTL", "T3CCTL0", "T3CC0", "T3CCTL1", "T3CC1",
+/* 0xd0 -- 0xd7 */
+	"PSW", "DMAIRQ", "DMA1CFGL", "DMA1CFGH", "DMA0CFGL", "DMA0CFGH", "DMAARM", "DMAREQ",
+/* 0xd8 -- 0xdf */
+	"TIMIF", "RFD", "T1CC0L", "T1CC0H", "T1CC1L", "T1CC1H", "T1CC2L", "T1CC2H",
+/* 0xe0 -- 0xe7 */
+	"ACC", "RFST", "T1CNTL", "T1CNTH", "T1CTL", "T1CCTL0", "T1CCTL1", "T1CCTL2",
+/* 0xe8 -- 0xef */
+	"IRCON2", "RFIRQF0", "T4CNT", "T4CTL", "T4CCTL0", "T4CC0", "T4CCTL1", "T4CC1",
+/* 0xf0 -- 0xf7 */
+	"B", "PERCFG", "APCFG", "P0SEL", "P1SEL", "P2SEL", "P1INP", "P2INP",
+/* 0xf8 -- 0xff */
+	"U1CSR", "U1DBUF", "U1BAUD", "U1UCR", "U1GCR", "P0DIR", "P1DIR", "P2DIR",
+};
+
+static const char *const bit_cc2530[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "RFERRIF", "IT1", "URX0IF", "TCON.4", "ADCIF", "TCON.6", "URX1IF",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"ENCIF_0", "ENCIF_1", "S0CON.2", "S0CON.3", "S0CON.4", "S0CON.5", "S0CON.6", "S0CON.7",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"RFERRIE", "ADCIE", "URX0IE", "URX1IE", "ENCIE", "STIE", "IEN0.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"", "", "", "", "", "", "", "",
+/* 0xb8 -- 0xbf */
+	"DMAIE", "T1IE", "T2IE", "T3IE", "T4IE", "P0IE", "IEN1.6", "IEN1.7",
+/* 0xc0 -- 0xc7 */
+	"DMAIF", "T1IF", "T2IF", "T3IF", "T4IF", "P0IF", "IRCON.6", "STIF",
+/* 0xc8 -- 0xcf */
+	"", "", "", "", "", "", "", "",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"T3OVFIF", "T3CH0IF", "T3CH1IF", "T4OVFIF", "T4CH0IF", "T4CH1IF", "T1OVFIM", "TIMIF.7",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"P2IF", "UTX0IF", "UTX1IF", "P1IF", "WDTIF", "IRCON2.5", "IRCON2.6", "IRCON2.7",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"ACTIVE", "TX_BYTE", "RX_BYTE", "ERR", "FE", "SLAVE", "RE", "MODE",
+};
+
+static const char *const sfr_nrf24le1[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "DPL1", "DPH1", "", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "", "",
+/* 0x90 -- 0x97 */
+	"P1", "", "DPS", "P0DIR", "P1DIR", "P2DIR", "P3DIR", "P2CON",
+/* 0x98 -- 0x9f */
+	"S0CON", "S0BUF", "", "", "", "", "P0CON", "P1CON",
+/* 0xa0 -- 0xa7 */
+	"P2", "PWMDC0", "PWMDC1", "CLKCTRL", "PWRDWN", "WUCON", "INTEXP", "MEMCON",
+/* 0xa8 -- 0xaf */
+	"IEN0", "IP0", "S0RELL", "RTC2CPT01", "RTC2CPT10", "CLKLFCTRL", "OPMCON", "WDSV",
+/* 0xb0 -- 0xb7 */
+	"P3", "RSTREAS", "PWMCON", "RTC2CON", "RTC2CMP0", "RTC2CMP1", "RTC2CPT00", "",
+/* 0xb8 -- 0xbf */
+	"IEN1", "IP1", "S0RELH", "", "SPISCON0", "", "SPISSTAT", "SPISDAT",
+/* 0xc0 -- 0xc7 */
+	"IRCON", "CCEN", "CCL1", "CCH1", "CCL2", "CCH2", "CCL3", "CCH3",
+/* 0xc8 -- 0xcf */
+	"T2CON", "MPAGE", "CRCL", "CRCH", "TL2", "TH2", "WUOPC1", "WUOPC0",
+/* 0xd0 -- 0xd7 */
+	"PSW", "ADCCON3", "ADCCON2", "ADCCON1", "ADCDATH", "ADCDATL", "RNGCTL", "RNGDAT",
+/* 0xd8 -- 0xdf */
+	"ADCON", "W2SADR", "W2DAT", "COMPCON", "POFCON", "CCPDATIA", "CCPDATIB", "CCPDATO",
+/* 0xe0 -- 0xe7 */
+	"ACC", "W2CON1", "W2CON0", "", "SPIRCON0", "SPIRCON1", "SPIRSTAT", "SPIRDAT",
+/* 0xe8 -- 0xef */
+	"RFCON", "MD0", "MD1", "MD2", "MD3", "MD4", "MD5", "ARCON",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "", "",
+/* 0xf8 -- 0xff */
+	"FSR", "FPCR", "FCR", "", "SPIMCON0", "SPIMCON1", "SPIMSTAT", "SPIMDAT",
+};
+
+static const char *const bit_nrf24le1[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"S0CON.0", "S0CON.1", "S0CON.2", "S0CON.3", "S0CON.4", "S0CON.5", "S0CON.6", "S0CON.7",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"IEN0.0", "IEN0.1", "IEN0.2", "IEN0.3", "IEN0.4", "IEN0.5", "IEN0.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"IEN1.0", "IEN1.1", "IEN1.2", "IEN1.3", "IEN1.4", "IEN1.5", "IEN1.6", "IEN1.7",
+/* 0xc0 -- 0xc7 */
+	"IRCON.0", "IRCON.1", "IRCON.2", "IRCON.3", "IRCON.4", "IRCON.5", "IRCON.6", "IRCON.7",
+/* 0xc8 -- 0xcf */
+	"T2I0", "T2I1", "T2CM", "T2R0", "T2R1", "I2FR", "I3FR", "T2PS",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"ADCON.0", "ADCON.1", "ADCON.2", "ADCON.3", "ADCON.4", "ADCON.5", "ADCON.6", "ADCON.7",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"RFCE", "RFCSN", "RFCKEN", "RFCON.3", "RFCON.4", "RFCON.5", "RFCON.6", "RFCON.7",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"FSR.0", "FSR.1", "FSR.2", "FSR.3", "FSR.4", "FSR.5", "FSR.6", "FSR.7",
+};
+
+static const char *const sfr_n76e003[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "RCTRIM0", "RCTRIM1", "RWK", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "CKCON", "WKCON",
+/* 0x90 -- 0x97 */
+	"P1", "SFRS", "CAPCON0", "CAPCON1", "CAPCON2", "CKDIV", "CKSWT", "CKEN",
+/* 0x98 -- 0x9f */
+	"SCON", "SBUF", "SBUF_1", "EIE", "EIE1", "", "", "CHPCON",
+/* 0xa0 -- 0xa7 */
+	"P2", "", "AUXR1", "BODCON0", "IAPTRG", "IAPUEN", "IAPAL", "IAPAH",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR", "WDCON", "BODCON1", "P3M1", "P3M2", "IAPFD", "IAPCN",
+/* 0xb0 -- 0xb7 */
+	"P3", "P0M1", "P0M2", "P1M1", "P1M2", "P2S", "", "IPH",
+/* 0xb8 -- 0xbf */
+	"IP", "SADDR_1", "SADEN", "SADEN_1", "", "", "", "",
+/* 0xc0 -- 0xc7 */
+	"I2CON", "I2ADDR", "ADCRL", "ADCRH", "T3CON", "RL3", "RH3", "TA",
+/* 0xc8 -- 0xcf */
+	"T2CON", "T2MOD", "RCMP2L", "RCMP2H", "TL2", "TH2", "ADCMPL", "ADCMPH",
+/* 0xd0 -- 0xd7 */
+	"PSW", "PWMPH", "PWM0H", "PWM1H", "PWM2H", "PWM3H", "PNP", "FBD",
+/* 0xd8 -- 0xdf */
+	"PWMCON0", "PWMPL", "PWM0L", "PWM1L", "PWM2L", "PWM3L", "PIOCON0", "PWMCON1",
+/* 0xe0 -- 0xe7 */
+	"ACC", "ADCCON1", "ADCCON2", "ADCDLY", "C0L", "C0H", "C1L", "C1H",
+/* 0xe8 -- 0xef */
+	"ADCCON0", "PICON", "PINEN", "PIPEN", "PIF", "C2L", "C2H", "EIP",
+/* 0xf0 -- 0xf7 */
+	"B", "CAPCON3", "CAPCON4", "SPCR", "SPSR", "SPDR", "AINDIDS", "EIPH",
+/* 0xf8 -- 0xff */
+	"SCON_1", "PDTEN", "PDTCNT", "PMEN", "PMD", "", "EIP1", "EIPH1",
+};
+
+static const char *const bit_n76e003[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI", "TI", "RB8", "TB8", "REN", "SM2", "SM1", "SM0",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES", "EBOD", "EADC", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS", "PBOD", "PADC", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"I2CON.0", "I2CON.1", "AA", "SI", "STO", "STA", "I2CEN", "I2CON.7",
+/* 0xc8 -- 0xcf */
+	"CM/RL2", "T2CON.1", "TR2", "T2CON.3", "T2CON.4", "T2CON.5", "T2CON.6", "TF2",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"PWMCON0.0", "PWMCON0.1", "PWMCON0.2", "PWMCON0.3", "CLRPWM", "PWMF", "LOAD", "PWMRUN",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"ADCHS0", "ADCHS1", "ADCHS2", "ADCHS3", "ETGSEL0", "ETGSEL1", "ADCS", "ADCF",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"RI_1", "TI_1", "RB8_1", "TB8_1", "REN_1", "SM2_1", "SM1_1", "SM0_1",
+};
+
+static const char *const sfr_n76e003_1[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "RCTRIM0", "RCTRIM1", "RWK", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "CKCON", "WKCON",
+/* 0x90 -- 0x97 */
+	"P1", "SFRS", "CAPCON0", "CAPCON1", "CAPCON2", "CKDIV", "CKSWT", "CKEN",
+/* 0x98 -- 0x9f */
+	"SCON", "P0S", "P0SR", "EIE", "EIE1", "", "", "CHPCON",
+/* 0xa0 -- 0xa7 */
+	"P2", "", "AUXR1", "BODCON0", "IAPTRG", "IAPUEN", "IAPAL", "IAPAH",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR", "WDCON", "BODCON1", "P3S", "P3SR", "IAPFD", "IAPCN",
+/* 0xb0 -- 0xb7 */
+	"P3", "P0M1", "P0M2", "P1S", "P1SR", "P2S", "", "IPH",
+/* 0xb8 -- 0xbf */
+	"IP", "SADDR_1", "SADEN", "SADEN_1", "", "", "", "",
+/* 0xc0 -- 0xc7 */
+	"I2CON", "I2ADDR", "ADCRL", "ADCRH", "PWM4H", "PWM5H", "RH3", "TA",
+/* 0xc8 -- 0xcf */
+	"T2CON", "T2MOD", "RCMP2L", "RCMP2H", "PWM4L", "PWM5L", "ADCMPL", "ADCMPH",
+/* 0xd0 -- 0xd7 */
+	"PSW", "PWMPH", "PWM0H", "PWM1H", "PWM2H", "PWM3H", "PNP", "FBD",
+/* 0xd8 -- 0xdf */
+	"PWMCON0", "PWMPL", "PWM0L", "PWM1L", "PWM2L", "PWM3L", "PIOCON0", "PWMCON1",
+/* 0xe0 -- 0xe7 */
+	"ACC", "ADCCON1", "ADCCON2", "ADCDLY", "C0L", "C0H", "C1L", "C1H",
+/* 0xe8 -- 0xef */
+	"ADCCON0", "PICON", "PINEN", "PIPEN", "PIF", "C2L", "C2H", "EIP",
+/* 0xf0 -- 0xf7 */
+	"B", "CAPCON3", "CAPCON4", "SPCR", "SPSR", "SPDR", "AINDIDS", "EIPH",
+/* 0xf8 -- 0xff */
+	"SCON_1", "PDTEN", "PDTCNT", "PMEN", "PMD", "", "EIP1", "EIPH1",
+};
+
+static const char *const bit_n76e003_1[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI", "TI", "RB8", "TB8", "REN", "SM2", "SM1", "SM0",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES", "EBOD", "EADC", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS", "PBOD", "PADC", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"I2CON.0", "I2CON.1", "AA", "SI", "STO", "STA", "I2CEN", "I2CON.7",
+/* 0xc8 -- 0xcf */
+	"CM/RL2", "T2CON.1", "TR2", "T2CON.3", "T2CON.4", "T2CON.5", "T2CON.6", "TF2",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"PWMCON0.0", "PWMCON0.1", "PWMCON0.2", "PWMCON0.3", "CLRPWM", "PWMF", "LOAD", "PWMRUN",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"ADCHS0", "ADCHS1", "ADCHS2", "ADCHS3", "ETGSEL0", "ETGSEL1", "ADCS", "ADCF",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"RI_1", "TI_1", "RB8_1", "TB8_1", "REN_1", "SM2_1", "SM1_1", "SM0_1",
+};
+
+static const struct dis8051_sfr_page pages_n76e003[1] = {
+	{0x01, sfr_n76e003_1, bit_n76e003_1},
+};
+
+static const char *const sfr_stc15[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "", "", "", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "AUXR", "INT_CLKO",
+/* 0x90 -- 0x97 */
+	"P1", "P1M1", "P1M0", "P0M1", "P0M0", "P2M1", "P2M0", "CLK_DIV",
+/* 0x98 -- 0x9f */
+	"SCON", "SBUF", "S2CON", "S2BUF", "", "P1ASF", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "BUS_SPEED", "AUXR1", "", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR", "WKTCL", "WKTCH", "S3CON", "S3BUF", "", "IE2",
+/* 0xb0 -- 0xb7 */
+	"P3", "P3M1", "P3M0", "P4M1", "P4M0", "IP2", "", "",
+/* 0xb8 -- 0xbf */
+	"IP", "SADEN", "P_SW2", "", "ADC_CONTR", "ADC_RES", "ADC_RESL", "",
+/* 0xc0 -- 0xc7 */
+	"P4", "WDT_CONTR", "IAP_DATA", "IAP_ADDRH", "IAP_ADDRL", "IAP_CMD", "IAP_TRIG", "IAP_CONTR",
+/* 0xc8 -- 0xcf */
+	"P5", "P5M1", "P5M0", "P6M1", "P6M0", "SPSTAT", "SPCTL", "SPDAT",
+/* 0xd0 -- 0xd7 */
+	"PSW", "T4T3M", "T4H", "T4L", "T3H", "T3L", "T2H", "T2L",
+/* 0xd8 -- 0xdf */
+	"CCON", "CMOD", "CCAPM0", "CCAPM1", "CCAPM2", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC", "P7M1", "P7M0", "", "", "", "", "",
+/* 0xe8 -- 0xef */
+	"P6", "CL", "CCAP0L", "CCAP1L", "CCAP2L", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "PCA_PWM0", "PCA_PWM1", "PCA_PWM2", "", "", "",
+/* 0xf8 -- 0xff */
+	"P7", "CH", "CCAP0H", "CCAP1H", "CCAP2H", "", "", "",
+};
+
+static const char *const bit_stc15[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI", "TI", "RB8", "TB8", "REN", "SM2", "SM1", "SM0",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES", "EADC", "ELVD", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS", "PADC", "PLVD", "PPCA",
+/* 0xc0 -- 0xc7 */
+	"P4.0", "P4.1", "P4.2", "P4.3", "P4.4", "P4.5", "P4.6", "P4.7",
+/* 0xc8 -- 0xcf */
+	"P5.0", "P5.1", "P5.2", "P5.3", "P5.4", "P5.5", "P5.6", "P5.7",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"CCF0", "CCF1", "CCF2", "CCON.3", "CCON.4", "CCON.5", "CR", "CF",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"P6.0", "P6.1", "P6.2", "P6.3", "P6.4", "P6.5", "P6.6", "P6.7",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"P7.0", "P7.1", "P7.2", "P7.3", "P7.4", "P7.5", "P7.6", "P7.7",
+};
+
+static const char *const sfr_c8051f12x[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "SFRPAGE", "SFRNEXT", "SFRLAST", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "CKCON", "PSCTL",
+/* 0x90 -- 0x97 */
+	"P1", "SSTA0", "", "", "", "", "", "",
+/* 0x98 -- 0x9f */
+	"SCON0", "SBUF0", "SPI0CFG", "SPI0DAT", "", "SPI0CKR", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "EMI0TC", "EMI0CN", "EMI0CF", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR0", "", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "FLSCL",
+/* 0xb8 -- 0xbf */
+	"IP", "SADEN0", "AMX0CF", "AMX0SL", "ADC0CF", "", "ADC0L", "ADC0H",
+/* 0xc0 -- 0xc7 */
+	"SMB0CN", "SMB0STA", "SMB0DAT", "SMB0ADR", "ADC0GTL", "ADC0GTH", "ADC0LTL", "ADC0LTH",
+/* 0xc8 -- 0xcf */
+	"TMR2CN", "TMR2CF", "RCAP2L", "RCAP2H", "TMR2L", "TMR2H", "", "SMB0CR",
+/* 0xd0 -- 0xd7 */
+	"PSW", "REF0CN", "DAC0L", "DAC0H", "DAC0CN", "", "", "",
+/* 0xd8 -- 0xdf */
+	"PCA0CN", "PCA0MD", "PCA0CPM0", "PCA0CPM1", "PCA0CPM2", "PCA0CPM3", "PCA0CPM4", "PCA0CPM5",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "EIE1", "EIE2",
+/* 0xe8 -- 0xef */
+	"ADC0CN", "PCA0L", "PCA0H", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "EIP1", "EIP2",
+/* 0xf8 -- 0xff */
+	"SPI0CN", "", "", "", "", "", "", "WDTCN",
+};
+
+static const char *const bit_c8051f12x[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI0", "TI0", "RB80", "TB80", "REN0", "SM20", "SM10", "SM00",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES0", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS0", "PT2", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"SMBTOE", "SMBFTE", "AA", "SI", "STO", "STA", "ENSMB", "BUSY",
+/* 0xc8 -- 0xcf */
+	"CPRL2", "CT2", "TR2", "EXEN2", "TMR2CN.4", "TMR2CN.5", "EXF2", "TF2",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"CCF0", "CCF1", "CCF2", "CCF3", "CCF4", "CCF5", "CR", "CF",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"AD0LJST", "AD0WINT", "AD0CM0", "AD0CM1", "AD0BUSY", "AD0INT", "AD0TM", "AD0EN",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"SPIEN", "TXBMT", "NSSMD0", "NSSMD1", "RXOVRN", "MODF", "WCOL", "SPIF",
+};
+
+static const char *const sfr_c8051f12x_1[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "SFRPAGE", "SFRNEXT", "SFRLAST", "PCON",
+/* 0x88 -- 0x8f */
+	"CPT0CN", "CPT0MD", "TL0", "TL1", "TH0", "TH1", "CKCON", "PSCTL",
+/* 0x90 -- 0x97 */
+	"P1", "SSTA0", "", "", "", "", "", "",
+/* 0x98 -- 0x9f */
+	"SCON1", "SBUF1", "SPI0CFG", "SPI0DAT", "", "SPI0CKR", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "EMI0TC", "EMI0CN", "EMI0CF", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR0", "", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "FLSCL",
+/* 0xb8 -- 0xbf */
+	"IP", "SADEN0", "AMX0CF", "AMX0SL", "ADC0CF", "", "ADC0L", "ADC0H",
+/* 0xc0 -- 0xc7 */
+	"SMB0CN", "SMB0STA", "SMB0DAT", "SMB0ADR", "ADC0GTL", "ADC0GTH", "ADC0LTL", "ADC0LTH",
+/* 0xc8 -- 0xcf */
+	"TMR3CN", "TMR3CF", "RCAP3L", "RCAP3H", "TMR3L", "TMR3H", "", "SMB0CR",
+/* 0xd0 -- 0xd7 */
+	"PSW", "REF0CN", "DAC1L", "DAC1H", "DAC1CN", "", "", "",
+/* 0xd8 -- 0xdf */
+	"PCA0CN", "PCA0MD", "PCA0CPM0", "PCA0CPM1", "PCA0CPM2", "PCA0CPM3", "PCA0CPM4", "PCA0CPM5",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "EIE1", "EIE2",
+/* 0xe8 -- 0xef */
+	"ADC0CN", "PCA0L", "PCA0H", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "EIP1", "EIP2",
+/* 0xf8 -- 0xff */
+	"SPI0CN", "", "", "", "", "", "", "WDTCN",
+};
+
+static const char *const bit_c8051f12x_1[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"CPT0CN.0", "CPT0CN.1", "CPT0CN.2", "CPT0CN.3", "CPT0CN.4", "CPT0CN.5", "CPT0CN.6", "CPT0CN.7",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI1", "TI1", "RB81", "TB81", "REN1", "MCE1", "SCON1.6", "S1MODE",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES0", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS0", "PT2", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"SMBTOE", "SMBFTE", "AA", "SI", "STO", "STA", "ENSMB", "BUSY",
+/* 0xc8 -- 0xcf */
+	"CPRL3", "CT3", "TR3", "EXEN3", "TMR3CN.4", "TMR3CN.5", "EXF3", "TF3",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"CCF0", "CCF1", "CCF2", "CCF3", "CCF4", "CCF5", "CR", "CF",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"AD0LJST", "AD0WINT", "AD0CM0", "AD0CM1", "AD0BUSY", "AD0INT", "AD0TM", "AD0EN",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"SPIEN", "TXBMT", "NSSMD0", "NSSMD1", "RXOVRN", "MODF", "WCOL", "SPIF",
+};
+
+static const char *const sfr_c8051f12x_2[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "SFRPAGE", "SFRNEXT", "SFRLAST", "PCON",
+/* 0x88 -- 0x8f */
+	"CPT1CN", "CPT1MD", "TL0", "TL1", "TH0", "TH1", "CKCON", "PSCTL",
+/* 0x90 -- 0x97 */
+	"P1", "SSTA0", "", "", "", "", "", "",
+/* 0x98 -- 0x9f */
+	"SCON0", "SBUF0", "SPI0CFG", "SPI0DAT", "", "SPI0CKR", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "EMI0TC", "EMI0CN", "EMI0CF", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR0", "", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "FLSCL",
+/* 0xb8 -- 0xbf */
+	"IP", "SADEN0", "AMX2CF", "AMX2SL", "ADC2CF", "", "ADC2", "ADC0H",
+/* 0xc0 -- 0xc7 */
+	"SMB0CN", "SMB0STA", "SMB0DAT", "SMB0ADR", "ADC2GT", "ADC0GTH", "ADC2LT", "ADC0LTH",
+/* 0xc8 -- 0xcf */
+	"TMR4CN", "TMR4CF", "RCAP4L", "RCAP4H", "TMR4L", "TMR4H", "", "SMB0CR",
+/* 0xd0 -- 0xd7 */
+	"PSW", "REF0CN", "DAC0L", "DAC0H", "DAC0CN", "", "", "",
+/* 0xd8 -- 0xdf */
+	"PCA0CN", "PCA0MD", "PCA0CPM0", "PCA0CPM1", "PCA0CPM2", "PCA0CPM3", "PCA0CPM4", "PCA0CPM5",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "EIE1", "EIE2",
+/* 0xe8 -- 0xef */
+	"ADC2CN", "PCA0L", "PCA0H", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "EIP1", "EIP2",
+/* 0xf8 -- 0xff */
+	"SPI0CN", "", "", "", "", "", "", "WDTCN",
+};
+
+static const char *const bit_c8051f12x_2[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"CPT1CN.0", "CPT1CN.1", "CPT1CN.2", "CPT1CN.3", "CPT1CN.4", "CPT1CN.5", "CPT1CN.6", "CPT1CN.7",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI0", "TI0", "RB80", "TB80", "REN0", "SM20", "SM10", "SM00",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES0", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS0", "PT2", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"SMBTOE", "SMBFTE", "AA", "SI", "STO", "STA", "ENSMB", "BUSY",
+/* 0xc8 -- 0xcf */
+	"CPRL4", "CT4", "TR4", "EXEN4", "TMR4CN.4", "TMR4CN.5", "EXF4", "TF4",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"CCF0", "CCF1", "CCF2", "CCF3", "CCF4", "CCF5", "CR", "CF",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"AD2LJST", "AD2WINT", "AD2CM0", "AD2CM1", "AD2BUSY", "AD2INT", "AD2TM", "AD2EN",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"SPIEN", "TXBMT", "NSSMD0", "NSSMD1", "RXOVRN", "MODF", "WCOL", "SPIF",
+};
+
+static const char *const sfr_c8051f12x_3[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "SFRPAGE", "SFRNEXT", "SFRLAST", "PCON",
+/* 0x88 -- 0x8f */
+	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "CKCON", "PSCTL",
+/* 0x90 -- 0x97 */
+	"P1", "SSTA0", "", "", "", "", "", "",
+/* 0x98 -- 0x9f */
+	"SCON0", "SBUF0", "SPI0CFG", "SPI0DAT", "", "SPI0CKR", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "EMI0TC", "EMI0CN", "EMI0CF", "", "", "", "",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR0", "", "", "", "", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "FLSCL",
+/* 0xb8 -- 0xbf */
+	"IP", "SADEN0", "AMX0CF", "AMX0SL", "ADC0CF", "", "ADC0L", "ADC0H",
+/* 0xc0 -- 0xc7 */
+	"MAC0STA", "MAC0AL", "MAC0AH", "MAC0BL", "MAC0BH", "MAC0CF", "MAC0ACC0", "MAC0ACC1",
+/* 0xc8 -- 0xcf */
+	"TMR2CN", "TMR2CF", "RCAP2L", "RCAP2H", "TMR2L", "TMR2H", "MAC0ACC2", "MAC0ACC3",
+/* 0xd0 -- 0xd7 */
+	"PSW", "REF0CN", "DAC0L", "DAC0H", "DAC0CN", "", "MAC0OVR", "MAC0RNDL",
+/* 0xd8 -- 0xdf */
+	"", "PCA0MD", "PCA0CPM0", "PCA0CPM1", "PCA0CPM2", "PCA0CPM3", "PCA0CPM4", "PCA0CPM5",
+/* 0xe0 -- 0xe7 */
+	"ACC", "", "", "", "", "", "EIE1", "EIE2",
+/* 0xe8 -- 0xef */
+	"ADC0CN", "PCA0L", "PCA0H", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "EIP1", "EIP2",
+/* 0xf8 -- 0xff */
+	"SPI0CN", "", "", "", "", "", "", "WDTCN",
+};
+
+static const char *const bit_c8051f12x_3[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI0", "TI0", "RB80", "TB80", "REN0", "SM20", "SM10", "SM00",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES0", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS0", "PT2", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"MAC0STA.0", "MAC0STA.1", "MAC0STA.2", "MAC0STA.3", "MAC0STA.4", "MAC0STA.5", "MAC0STA.6", "MAC0STA.7",
+/* 0xc8 -- 0xcf */
+	"CPRL2", "CT2", "TR2", "EXEN2", "TMR2CN.4", "TMR2CN.5", "EXF2", "TF2",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"", "", "", "", "", "", "", "",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"AD0LJST", "AD0WINT", "AD0CM0", "AD0CM1", "AD0BUSY", "AD0INT", "AD0TM", "AD0EN",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"SPIEN", "TXBMT", "NSSMD0", "NSSMD1", "RXOVRN", "MODF", "WCOL", "SPIF",
+};
+
+static const char *const sfr_c8051f12x_f[128] = {
+/* 0x80 -- 0x87 */
+	"P0", "SP", "DPL", "DPH", "SFRPAGE", "SFRNEXT", "SFRLAST", "PCON",
+/* 0x88 -- 0x8f */
+	"", "TMOD", "OSCICN", "OSCICL", "OSCXCN", "TH1", "CKCON", "PSCTL",
+/* 0x90 -- 0x97 */
+	"P1", "SSTA0", "", "", "", "", "SFRPGCN", "CLKSEL",
+/* 0x98 -- 0x9f */
+	"SCON0", "SBUF0", "SPI0CFG", "SPI0DAT", "", "SPI0CKR", "", "",
+/* 0xa0 -- 0xa7 */
+	"P2", "EMI0TC", "EMI0CN", "EMI0CF", "P0MDOUT", "P1MDOUT", "P2MDOUT", "P3MDOUT",
+/* 0xa8 -- 0xaf */
+	"IE", "SADDR0", "", "", "", "P1MDIN", "", "",
+/* 0xb0 -- 0xb7 */
+	"P3", "", "", "", "", "", "", "FLSCL",
+/* 0xb8 -- 0xbf */
+	"IP", "SADEN0", "AMX0CF", "AMX0SL", "ADC0CF", "", "ADC0L", "ADC0H",
+/* 0xc0 -- 0xc7 */
+	"SMB0CN", "SMB0STA", "SMB0DAT", "SMB0ADR", "ADC0GTL", "ADC0GTH", "ADC0LTL", "ADC0LTH",
+/* 0xc8 -- 0xcf */
+	"P4", "TMR2CF", "RCAP2L", "RCAP2H", "TMR2L", "TMR2H", "", "SMB0CR",
+/* 0xd0 -- 0xd7 */
+	"PSW", "REF0CN", "DAC0L", "DAC0H", "DAC0CN", "", "", "",
+/* 0xd8 -- 0xdf */
+	"P5", "PCA0MD", "PCA0CPM0", "PCA0CPM1", "PCA0CPM2", "PCA0CPM3", "PCA0CPM4", "PCA0CPM5",
+/* 0xe0 -- 0xe7 */
+	"ACC", "XBR0", "XBR1", "XBR2", "", "", "EIE1", "EIE2",
+/* 0xe8 -- 0xef */
+	"P6", "PCA0L", "PCA0H", "", "", "", "", "",
+/* 0xf0 -- 0xf7 */
+	"B", "", "", "", "", "", "EIP1", "EIP2",
+/* 0xf8 -- 0xff */
+	"P7", "", "", "", "", "", "", "WDTCN",
+};
+
+static const char *const bit_c8051f12x_f[128] = {
+/* 0x80 -- 0x87 */
+	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
+/* 0x88 -- 0x8f */
+	"", "", "", "", "", "", "", "",
+/* 0x90 -- 0x97 */
+	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
+/* 0x98 -- 0x9f */
+	"RI0", "TI0", "RB80", "TB80", "REN0", "SM20", "SM10", "SM00",
+/* 0xa0 -- 0xa7 */
+	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
+/* 0xa8 -- 0xaf */
+	"EX0", "ET0", "EX1", "ET1", "ES0", "ET2", "IE.6", "EA",
+/* 0xb0 -- 0xb7 */
+	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
+/* 0xb8 -- 0xbf */
+	"PX0", "PT0", "PX1", "PT1", "PS0", "PT2", "IP.6", "IP.7",
+/* 0xc0 -- 0xc7 */
+	"SMBTOE", "SMBFTE", "AA", "SI", "STO", "STA", "ENSMB", "BUSY",
+/* 0xc8 -- 0xcf */
+	"P4.0", "P4.1", "P4.2", "P4.3", "P4.4", "P4.5", "P4.6", "P4.7",
+/* 0xd0 -- 0xd7 */
+	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
+/* 0xd8 -- 0xdf */
+	"P5.0", "P5.1", "P5.2", "P5.3", "P5.4", "P5.5", "P5.6", "P5.7",
+/* 0xe0 -- 0xe7 */
+	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
+/* 0xe8 -- 0xef */
+	"P6.0", "P6.1", "P6.2", "P6.3", "P6.4", "P6.5", "P6.6", "P6.7",
+/* 0xf0 -- 0xf7 */
+	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
+/* 0xf8 -- 0xff */
+	"P7.0", "P7.1", "P7.2", "P7.3", "P7.4", "P7.5", "P7.6", "P7.7",
+};
+
+static const struct dis8051_sfr_page pages_c8051f12x[4] = {
+	{0x01, sfr_c8051f12x_1, bit_c8051f12x_1},
+	{0x02, sfr_c8051f12x_2, bit_c8051f12x_2},
+	{0x03, sfr_c8051f12x_3, bit_c8051f12x_3},
+	{0x0f, sfr_c8051f12x_f, bit_c8051f12x_f},
+};
+
+/* the first is the default */
+const struct dis8051_derivative dis8051_derivatives[DIS8051_DERIVS] = {
+	{"8052", sfr_8052, bit_8052,
+	 0x00, 0x00, 0, NULL,
+	 0x00, 0x00, 0x00, {0x00, 0x00}, 0x00,
+	 0, NULL},
+	{"8051", sfr_8051, bit_8051,
+	 0x00, 0x00, 0, NULL,
+	 0x00, 0x00, 0x00, {0x00, 0x00}, 0x00,
+	 0, NULL},
+	{"at89s52", sfr_at89s52, bit_at89s52,
+	 0x00, 0x00, 0, NULL,
+	 0xa2, 0x01, 0x00, {0x00, 0x00}, 0x84,
+	 0, NULL},
+	{"ds89c450", sfr_ds89c450, bit_ds89c450,
+	 0x00, 0x00, 0, NULL,
+	 0x86, 0x01, 0x10, {0x40, 0x80}, 0x84,
+	 0, NULL},
+	{"c8051f3xx", sfr_c8051f3xx, bit_c8051f3xx,
+	 0x00, 0x00, 0, NULL,
+	 0x00, 0x00, 0x00, {0x00, 0x00}, 0x00,
+	 0, NULL},
+	{"cc2530", sfr_cc2530, bit_cc2530,
+	 0x00, 0x00, 0, NULL,
+	 0x92, 0x01, 0x00, {0x00, 0x00}, 0x84,
+	 1, ext_cc2530},
+	{"nrf24le1", sfr_nrf24le1, bit_nrf24le1,
+	 0x00, 0x00, 0, NULL,
+	 0x92, 0x01, 0x00, {0x00, 0x00}, 0x84,
+	 0, NULL},
+	{"n76e003", sfr_n76e003, bit_n76e003,
+	 0x91, 0x01, 1, pages_n76e003,
+	 0xa2, 0x01, 0x00, {0x00, 0x00}, 0x00,
+	 0, NULL},
+	{"stc15", sfr_stc15, bit_stc15,
+	 0x00, 0x00, 0, NULL,
+	 0xa2, 0x01, 0x00, {0x00, 0x00}, 0x00,
+	 0, NULL},
+	{"c8051f12x", sfr_c8051f12x, bit_c8051f12x,
+	 0x84, 0xff, 4, pages_c8051f12x,
+	 0x00, 0x00, 0x00, {0x00, 0x00}, 0x00,
+	 0, NULL},
+};
+
+#undef OP
@@ -0,0 +1,300 @@
+/* likelihood that a blob is 8051 code, and where the code is */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-render.h"
+#include "8051-detect.h"
+
+/* opcode weights: compiled and hand written code is mostly made of a
+ * few dozen opcodes, uses some others, rarely the rest and never 0xa5;
+ * operations on registers are neutral as random data has as many */
+static const uint8_t frequent[] = {
+	0x02, 0x12, 0x22, 0x60, 0x70, 0x74, 0x75, 0x80, 0x90, 0xa3, 0xe0,
+	0xe4, 0xe5, 0xf0, 0xf5,
+};
+static const uint8_t common[] = {
+	0x04, 0x05, 0x13, 0x14, 0x15, 0x20, 0x24, 0x25, 0x30, 0x33, 0x34,
+	0x35, 0x40, 0x43, 0x44, 0x50, 0x53, 0x54, 0x64, 0x85, 0x92, 0x93,
+	0x94, 0x95, 0xa2, 0xb4, 0xc0, 0xc2, 0xc3, 0xc4, 0xd0, 0xd2, 0xd5,
+	0xe2, 0xe6, 0xe7, 0xf2, 0xf4, 0xf6, 0xf7,
+};
+static const uint8_t rare[] = {
+	0x10, 0x72, 0x82, 0x83, 0xa0, 0xb0, 0xc6, 0xc7, 0xd4, 0xd6, 0xd7,
+};
+#define FREQUENT  4
+#define COMMON    1
+#define OTHER    -1
+#define RARE     -3
+#define RESERVED -8
+#define BAD_SFR  -3
+#define BAD_JUMP -3
+#define GOOD_JUMP 1
+
+/* average weight per instruction, times 16, that maps to 0 and to
+ * 1000 per mille; random data and x86 code average 0.25 -- 0.5 */
+#define SCORE_LO 4
+#define SCORE_HI 36
+
+/* per plausible interrupt vector */
+#define VECTOR_BONUS 25
+
+/* shortest run of 0x00 or 0xff that is fill rather than code */
+#define FILL 4
+
+void dis8051_detect_init(struct dis8051_detect *d)
+{
+	const struct dis8051_opcode *op;
+	uint8_t named[128] = {0};
+	unsigned i, k, n, off;
+
+	memset(d, 0, sizeof(*d));
+	for (i = 0; i < 256; i++) {
+		op = &dis8051_opcodes[i];
+		d->size[i] = op->size;
+		if (op->mnem == DIS8051_RESERVED)
+			d->weight[i] = RESERVED;
+		else if ((i & 0xf8) == 0xe8 || (i & 0xf8) == 0xf8 ||
+		         (i & 0xf8) == 0x78)
+			d->weight[i] = FREQUENT;   /* mov a,rN; mov rN,a / #imm */
+		else if (op->opnd[0] != DIS8051_OPND_RN &&
+		         op->opnd[1] != DIS8051_OPND_RN &&
+		         op->opnd[0] != DIS8051_OPND_ADDR11)
+			d->weight[i] = OTHER;
+
+		for (k = 0, n = 0, off = 1; k < 3 && op->opnd[k]; k++) {
+			switch (op->opnd[k]) {
+			case DIS8051_OPND_DIRECT:
+				d->direct[i][n++] = off++;
+				break;
+			case DIS8051_OPND_ADDR16:
+				d->jump[i] = DIS8051_DETECT_ADDR16;
+				off += 2;
+				break;
+			case DIS8051_OPND_ADDR11:
+				d->jump[i] = DIS8051_DETECT_ADDR11;
+				off++;
+				break;
+			case DIS8051_OPND_IMM16:
+				off += 2;
+				break;
+			case DIS8051_OPND_BIT:
+			case DIS8051_OPND_NBIT:
+			case DIS8051_OPND_IMM8:
+			case DIS8051_OPND_REL:
+				off++;
+				break;
+			}
+		}
+	}
+	for (i = 0; i < sizeof(frequent); i++)
+		d->weight[frequent[i]] = FREQUENT;
+	for (i = 0; i < sizeof(common); i++)
+		d->weight[common[i]] = COMMON;
+	for (i = 0; i < sizeof(rare); i++)
+		d->weight[rare[i]] = RARE;
+
+	/* SFRs named by at least half of the parts, as some name all */
+	for (k = 0; k < DIS8051_DERIVS; k++)
+		for (i = 0; i < 128; i++)
+			named[i] += *dis8051_derivatives[k].sfr[i] != '\0';
+	for (i = 0; i < 128; i++)
+		d->sfr[0x80 + i] = named[i]*2 >= DIS8051_DERIVS ? 0 : BAD_SFR;
+}
+
+/* length of the run of fill at 'pc', 0 if there is none */
+static size_t fill(const uint8_t *buf, size_t len, size_t pc)
+{
+	size_t n;
+
+	if (buf[pc] != 0x00 && buf[pc] != 0xff)
+		return 0;
+	for (n = 1; pc + n < len && buf[pc + n] == buf[pc]; n++)
+		;
+	return n >= FILL ? n : 0;
+}
+
+/* weight of the instruction at 'pc', which fits into 'len'; without
+ * branches but for jumps, which are few in random data too */
+static int weigh(const struct dis8051_detect *d, const uint8_t *buf,
+                 size_t len, size_t pc)
+{
+	uint8_t op = buf[pc];
+	const uint8_t *dir = d->direct[op];
+	int s = d->weight[op];
+	size_t t;
+
+	/* an offset of 0 adds the sfr entry of the opcode, masked out */
+	s += d->sfr[buf[pc + dir[0]]] & -(dir[0] != 0);
+	s += d->sfr[buf[pc + dir[1]]] & -(dir[1] != 0);
+	if (d->jump[op]) {
+		if (d->jump[op] == DIS8051_DETECT_ADDR16)
+			t = buf[pc+1] << 8 | buf[pc+2];
+		else
+			t = ((pc + 2) & ~(size_t)0x7ff) | (op & 0xe0) << 3 |
+			    buf[pc+1];
+		s += t < len ? GOOD_JUMP : BAD_JUMP;
+	}
+	return s;
+}
+
+static int per_mille(long sum, size_t n)
+{
+	long v;
+
+	if (n == 0)
+		return 0;
+	v = (sum*16/(long)n - SCORE_LO) * 1000 / (SCORE_HI - SCORE_LO);
+	return v < 0 ? 0 : v > 1000 ? 1000 : v;
+}
+
+int dis8051_detect_vectors(const uint8_t *buf, size_t len)
+{
+	size_t v;
+	int n = 0;
+
+	for (v = 0; v <= 0x23 && v + 3 <= len; v = v ? v + 8 : 3)
+		if (buf[v] == 0x02 || (buf[v] & 0x1f) == 0x01 ||
+		    buf[v] == 0x32 || (buf[v] == 0xff && v > 0))
+			n++;
+	return n;
+}
+
+/* one step of a linear sweep at '*pc': skips fill or weighs an
+ * instruction, which is counted in 'n' */
+static long step(const struct dis8051_detect *d, const uint8_t *buf,
+                 size_t len, size_t *pc, size_t *n)
+{
+	size_t f = fill(buf, len, *pc);
+	int s;
+
+	if (f) {
+		*pc += f;
+		return 0;
+	}
+	s = weigh(d, buf, len, *pc);
+	*pc += d->size[buf[*pc]];
+	++*n;
+	return s;
+}
+
+int dis8051_detect_score(const struct dis8051_detect *d, const uint8_t *buf,
+                         size_t len)
+{
+	size_t pc = 0, n = 0;
+	long sum = 0;
+	int s;
+
+	while (pc < len && pc + d->size[buf[pc]] <= len)
+		sum += step(d, buf, len, &pc, &n);
+	s = per_mille(sum, n);
+	if (s > 0)
+		s += dis8051_detect_vectors(buf, len) * VECTOR_BONUS;
+	return s > 1000 ? 1000 : s;
+}
+
+/* stores the region if there is room, its end moved back to where it
+ * is furthest above 'bar', which drops the data the window dragged
+ * along; returns 0 if nothing is left of it */
+static int add_region(const struct dis8051_detect *d, const uint8_t *buf,
+                       size_t len, long bar, struct dis8051_region *r,
+                       size_t max, size_t found, size_t start, size_t end)
+{
+	size_t pc, n = 0, best_n = 0;
+	long sum = 0, part = 0, best = 0, best_sum = 0;
+
+	if (found >= max)
+		return 1;
+	r[found].start = start;
+	r[found].end = start;
+	for (pc = start; pc < end; pc += d->size[buf[pc]]) {
+		sum += weigh(d, buf, len, pc);
+		part = sum*16000 - bar*(long)++n;
+		if (part > best) {
+			best = part;
+			best_sum = sum;
+			best_n = n;
+			r[found].end = pc + d->size[buf[pc]];
+		}
+	}
+	r[found].score = per_mille(best_sum, best_n);
+	return best_n > 0;
+}
+
+struct slot {
+	size_t pc;
+	int s;
+};
+
+size_t dis8051_detect_regions(const struct dis8051_detect *d,
+                              const uint8_t *buf, size_t len, size_t window,
+                              int threshold, struct dis8051_region *r,
+                              size_t max)
+{
+	struct slot *ring;
+	size_t pc = 0, head = 0, tail = 0, n = 0, found = 0, start = 0;
+	size_t end = 0, f, i, k;
+	/* per_mille(sum, n) >= threshold without dividing */
+	long bar = (long)threshold*(SCORE_HI - SCORE_LO) + SCORE_LO*1000L;
+	long sum = 0, part, low;
+	int in = 0;
+
+	if (window == 0 || !(ring = malloc(window*sizeof(*ring))))
+		return 0;
+
+	while (pc < len && pc + d->size[buf[pc]] <= len) {
+		/* fill is no code, but it leaves the window */
+		if ((f = fill(buf, len, pc)))
+			pc += f;
+
+		/* the window ends with this instruction */
+		while (n > 0 && ring[head].pc + window <= pc) {
+			sum -= ring[head].s;
+			head = head + 1 == window ? 0 : head + 1;
+			n--;
+		}
+		if (f) {
+			if (in)
+				found += add_region(d, buf, len, bar, r, max,
+				                    found, start, end);
+			in = 0;
+			continue;
+		}
+		ring[tail].pc = pc;
+		sum += ring[tail].s = weigh(d, buf, len, pc);
+		tail = tail + 1 == window ? 0 : tail + 1;
+		n++;
+
+		/* a few instructions are no evidence */
+		if (n < window/8 || sum*16000 < bar*(long)n) {
+			if (in)
+				found += add_region(d, buf, len, bar, r, max,
+				                    found, start, end);
+			in = 0;
+		} else if (!in) {
+			/* it starts where the window is furthest above
+			 * the bar from there on, and not before the
+			 * previous region */
+			start = ring[head].pc;
+			for (i = head, k = 0, part = low = 0; k < n; k++) {
+				part += ring[i].s*16000L - bar;
+				i = i + 1 == window ? 0 : i + 1;
+				if (part < low && k + 1 < n) {
+					low = part;
+					start = ring[i].pc;
+				}
+			}
+			start = start > end ? start : end;
+			in = 1;
+		}
+		if (in)
+			end = pc + d->size[buf[pc]];
+		pc += d->size[buf[pc]];
+	}
+	if (in)
+		found += add_region(d, buf, len, bar, r, max, found, start,
+		                    end);
+	free(ring);
+	return found;
+}
@@ -0,0 +1,51 @@
+/* likelihood that a blob is 8051 code, and where the code is */
+
+#ifndef DIS8051_DETECT_H
+#define DIS8051_DETECT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* code address operands, see 'jump' */
+#define DIS8051_DETECT_ADDR16 1  /* ljmp / lcall, target within the blob */
+#define DIS8051_DETECT_ADDR11 2  /* ajmp / acall, target within the blob */
+
+/* tables built once from the decode table and the SFR names of the
+ * derivatives, read only afterwards */
+struct dis8051_detect {
+	int8_t weight[256];      /* of each opcode, higher is more typical */
+	uint8_t size[256];
+	uint8_t direct[256][2];  /* offsets of direct address operands, or 0 */
+	uint8_t jump[256];       /* DIS8051_DETECT_ADDR*, or 0 */
+	int8_t sfr[256];         /* added per direct address operand, below 0
+	                          * for SFRs few parts have */
+};
+
+/* one region of code */
+struct dis8051_region {
+	size_t start, end;       /* [start, end) */
+	int score;               /* per mille */
+};
+
+void dis8051_detect_init(struct dis8051_detect *d);
+
+/* likelihood per mille that 'len' bytes at 'buf', loaded at 0, are 8051
+ * code, from a linear sweep: opcode weights, operand checks and the
+ * reset and interrupt vectors count, erased or zeroed runs don't */
+int dis8051_detect_score(const struct dis8051_detect *d, const uint8_t *buf,
+                         size_t len);
+
+/* interrupt vectors at 0x0000, 0x0003 ... 0x0023 that look like it:
+ * jumps, reti or erased, 0 -- 6 */
+int dis8051_detect_vectors(const uint8_t *buf, size_t len);
+
+/* regions of code in 'buf': a window of 'window' bytes slides over the
+ * linear sweep, and where it scores at least 'threshold' per mille its
+ * instructions are code; stores up to 'max' regions in 'r', returns
+ * how many there are */
+size_t dis8051_detect_regions(const struct dis8051_detect *d,
+                              const uint8_t *buf, size_t len, size_t window,
+                              int threshold, struct dis8051_region *r,
+                              size_t max);
+
+#endif
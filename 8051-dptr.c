@@ -0,0 +1,501 @@
+/* 8051/8052 DPTR constant propagation,
+ * resolves the targets of movx @dptr and movc @a+dptr */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-xref.h"
+#include "8051-render.h"
+#include "8051-dptr.h"
+
+void dis8051_dptr_reset(struct dis8051_dptr_state *s)
+{
+	s->dptr = 0;
+	s->alt = 0;
+	s->a = 0;
+	s->dps = 0;
+	s->known = 0;
+	s->dps_known = 0;
+}
+
+/* DPTR as seen by SFR accesses */
+#define SEL 0   /* the selected one */
+#define ALT 1   /* the other one */
+#define ANY -1  /* either, it isn't known which is selected */
+
+/* selected DPTR, 0 or 1, -1 if unknown */
+static int selected(const struct dis8051_derivative *d,
+                    const struct dis8051_dptr_state *s)
+{
+	if (!d || !d->dps)
+		return 0;
+	if (!(s->dps_known & d->dps_sel))
+		return -1;
+	return (s->dps & d->dps_sel) != 0;
+}
+
+/* byte 'hi' of DPTR 'which' */
+static void set_byte(struct dis8051_dptr_state *s, int which, int hi,
+                     uint8_t v, int known)
+{
+	uint16_t *p = which == ALT ? &s->alt : &s->dptr;
+	uint8_t k = which == ALT ?
+	            (hi ? DIS8051_KNOWN_ALT_DPH : DIS8051_KNOWN_ALT_DPL) :
+	            (hi ? DIS8051_KNOWN_DPH : DIS8051_KNOWN_DPL);
+
+	if (which == ANY) {
+		set_byte(s, SEL, hi, 0, 0);
+		set_byte(s, ALT, hi, 0, 0);
+		return;
+	}
+	*p = hi ? (*p & 0x00ff) | v<<8 : (*p & 0xff00) | v;
+	s->known = known ? s->known | k : s->known & ~k;
+}
+
+static void set_dptr(struct dis8051_dptr_state *s, uint16_t v, int known)
+{
+	set_byte(s, SEL, 0, v & 0xff, known);
+	set_byte(s, SEL, 1, v >> 8, known);
+}
+
+static void swap(struct dis8051_dptr_state *s)
+{
+	uint16_t t = s->dptr;
+	uint8_t k = s->known & ~(DIS8051_KNOWN_DPTR | DIS8051_KNOWN_ALT);
+
+	s->dptr = s->alt;
+	s->alt = t;
+	if (s->known & DIS8051_KNOWN_DPL)     k |= DIS8051_KNOWN_ALT_DPL;
+	if (s->known & DIS8051_KNOWN_DPH)     k |= DIS8051_KNOWN_ALT_DPH;
+	if (s->known & DIS8051_KNOWN_ALT_DPL) k |= DIS8051_KNOWN_DPL;
+	if (s->known & DIS8051_KNOWN_ALT_DPH) k |= DIS8051_KNOWN_DPH;
+	s->known = k;
+}
+
+/* DPTR and byte SFR 'addr' is, returns 0 if it is neither; DPL and
+ * DPH are DPTR0 on parts with DPL1, DPH1, the selected one otherwise */
+static int dptr_sfr(const struct dis8051_derivative *d,
+                    const struct dis8051_dptr_state *s, uint8_t addr,
+                    int *which, int *hi)
+{
+	int n, sel = selected(d, s);
+
+	if (d && d->dptr1 && (addr == d->dptr1 || addr == d->dptr1 + 1)) {
+		n = 1;
+		*hi = addr != d->dptr1;
+	} else if (addr == DIS8051_SFR_DPL || addr == DIS8051_SFR_DPH) {
+		n = 0;
+		*hi = addr == DIS8051_SFR_DPH;
+		if (!d || !d->dptr1) {
+			*which = SEL;
+			return 1;
+		}
+	} else {
+		return 0;
+	}
+	*which = sel < 0 ? ANY : sel == n ? SEL : ALT;
+	return 1;
+}
+
+/* write a byte, known or not, to a tracked SFR */
+static void set_sfr(const struct dis8051_derivative *d,
+                    struct dis8051_dptr_state *s, uint8_t addr, uint8_t v,
+                    int known)
+{
+	int which, hi;
+
+	if (dptr_sfr(d, s, addr, &which, &hi)) {
+		set_byte(s, which, hi, v, known);
+	} else if (addr == DIS8051_SFR_ACC) {
+		s->a = v;
+		s->known = known ? s->known | DIS8051_KNOWN_A :
+		           s->known & ~DIS8051_KNOWN_A;
+	} else if (d && d->dps && addr == d->dps) {
+		s->dps = v;
+		s->dps_known = known ? 0xff : 0;
+	}
+}
+
+/* read a tracked SFR, returns 0 if it is not known */
+static int get_sfr(const struct dis8051_derivative *d,
+                   const struct dis8051_dptr_state *s, uint8_t addr,
+                   uint8_t *v)
+{
+	int which, hi;
+	uint8_t k;
+
+	if (dptr_sfr(d, s, addr, &which, &hi)) {
+		if (which == ANY)
+			return 0;
+		*v = (which == ALT ? s->alt : s->dptr) >> (hi ? 8 : 0);
+		k = which == ALT ?
+		    (hi ? DIS8051_KNOWN_ALT_DPH : DIS8051_KNOWN_ALT_DPL) :
+		    (hi ? DIS8051_KNOWN_DPH : DIS8051_KNOWN_DPL);
+		return (s->known & k) != 0;
+	}
+	if (addr == DIS8051_SFR_ACC) {
+		*v = s->a;
+		return (s->known & DIS8051_KNOWN_A) != 0;
+	}
+	return 0;
+}
+
+/* whether operand 'i' of 'in' is the DPS of 'd' or one of its bits */
+static int is_dps(const struct dis8051_derivative *d,
+                  const struct dis8051_insn *in, int i)
+{
+	if (!d || !d->dps)
+		return 0;
+	return (in->opnd[i] == DIS8051_OPND_DIRECT && in->val[i] == d->dps) ||
+	       (in->opnd[i] == DIS8051_OPND_BIT &&
+	        (in->val[i] & 0xf8) == d->dps);
+}
+
+/* forget everything an operand written by 'in' may have changed */
+static void clobber(const struct dis8051_derivative *d,
+                    struct dis8051_dptr_state *s,
+                    const struct dis8051_insn *in, int i)
+{
+	switch (in->opnd[i]) {
+	case DIS8051_OPND_A:
+	case DIS8051_OPND_AB:
+		s->known &= ~DIS8051_KNOWN_A;
+		break;
+
+	case DIS8051_OPND_DPTR:
+		set_dptr(s, 0, 0);
+		break;
+
+	case DIS8051_OPND_DIRECT:
+		set_sfr(d, s, in->val[i], 0, 0);
+		break;
+
+	/* bits of ACC or DPS */
+	case DIS8051_OPND_BIT:
+		if ((in->val[i] & 0xf8) == DIS8051_SFR_ACC)
+			s->known &= ~DIS8051_KNOWN_A;
+		else if (is_dps(d, in, i))
+			s->dps_known &= ~(1 << (in->val[i] & 0x7));
+		break;
+	}
+}
+
+/* orl / anl / xrl / inc of DPS, the usual ways to flip its select bit */
+static void dps_logic(struct dis8051_dptr_state *s,
+                      const struct dis8051_dptr_state *old, int opcode,
+                      uint8_t v)
+{
+	s->dps_known = old->dps_known;
+	switch (opcode) {
+	case 0x43: /* orl */
+		s->dps = old->dps | v;
+		s->dps_known |= v;
+		break;
+	case 0x53: /* anl */
+		s->dps = old->dps & v;
+		s->dps_known |= (uint8_t)~v;
+		break;
+	case 0x63: /* xrl */
+		s->dps = old->dps ^ v;
+		break;
+	case 0x05: /* inc, a carry out of a known bit 0 clears the rest */
+		s->dps = old->dps + 1;
+		if (old->dps_known != 0xff)
+			s->dps_known = !(old->dps_known & 0x1) ? 0 :
+			               old->dps & 0x1 ? 0x1 : old->dps_known;
+		break;
+	}
+}
+
+/* whether a DPS write by 'in' toggled the select bit, -1 if unknown */
+static int dps_flip(const struct dis8051_derivative *d,
+                    const struct dis8051_dptr_state *old,
+                    const struct dis8051_dptr_state *s,
+                    const struct dis8051_insn *in)
+{
+	uint8_t sel = d->dps_sel;
+
+	switch (in->opcode) {
+	case 0x63: /* xrl */
+		return (in->val[1] & sel) != 0;
+	case 0x05: /* inc */
+		if (sel == 0x1)
+			return 1;
+		break;
+	case 0x43: /* orl */
+		if (!(in->val[1] & sel))
+			return 0;
+		break;
+	case 0x53: /* anl */
+		if ((in->val[1] & sel) == sel)
+			return 0;
+		break;
+	}
+	if ((old->dps_known & sel) && (s->dps_known & sel))
+		return ((old->dps ^ s->dps) & sel) != 0;
+	return -1;
+}
+
+/* movx @dptr stepping the selected DPTR */
+static void dps_step(const struct dis8051_derivative *d,
+                     struct dis8051_dptr_state *s,
+                     const struct dis8051_dptr_state *old)
+{
+	uint8_t dec = 0;
+	int n;
+
+	if (!d || !d->dps || !d->dps_inc)
+		return;
+	if ((old->dps_known & d->dps_inc) && !(old->dps & d->dps_inc))
+		return;
+
+	/* the step down bits are per DPTR */
+	if (d->dps_dec[0] | d->dps_dec[1]) {
+		if ((n = selected(d, old)) < 0) {
+			set_dptr(s, 0, 0);
+			return;
+		}
+		dec = d->dps_dec[n];
+	}
+
+	if (!(old->dps_known & d->dps_inc) ||
+	    (dec && !(old->dps_known & dec)) ||
+	    (old->known & DIS8051_KNOWN_DPTR) != DIS8051_KNOWN_DPTR)
+		set_dptr(s, 0, 0);
+	else
+		set_dptr(s, old->dptr + (old->dps & dec ? -1 : 1), 1);
+}
+
+void dis8051_dptr_step(const struct dis8051_derivative *d,
+                       struct dis8051_dptr_state *s,
+                       const struct dis8051_insn *in)
+{
+	struct dis8051_dptr_state old = *s;
+	uint8_t v;
+	int i, dps = 0;
+
+	for (i = 0; i < 3 && in->opnd[i] != DIS8051_OPND_NONE; i++) {
+		if (!(dis8051_access(in, i) & DIS8051_WRITE))
+			continue;
+		clobber(d, s, in, i);
+		dps |= is_dps(d, in, i);
+	}
+
+	switch (in->opcode) {
+	/* mov dptr, #imm16 */
+	case 0x90:
+		set_dptr(s, in->val[1], 1);
+		break;
+
+	/* inc dptr */
+	case 0xa3:
+		if ((old.known & DIS8051_KNOWN_DPTR) == DIS8051_KNOWN_DPTR)
+			set_dptr(s, old.dptr + 1, 1);
+		break;
+
+	/* movx a, @dptr / movx @dptr, a */
+	case 0xe0:
+	case 0xf0:
+		dps_step(d, s, &old);
+		break;
+
+	/* mov a, #imm */
+	case 0x74:
+		s->a = in->val[1];
+		s->known |= DIS8051_KNOWN_A;
+		break;
+
+	/* clr a */
+	case 0xe4:
+		s->a = 0;
+		s->known |= DIS8051_KNOWN_A;
+		break;
+
+	/* inc a, dec a */
+	case 0x04:
+	case 0x14:
+		if (old.known & DIS8051_KNOWN_A) {
+			s->a = old.a + (in->opcode == 0x04 ? 1 : -1);
+			s->known |= DIS8051_KNOWN_A;
+		}
+		break;
+
+	/* mov data addr., #imm */
+	case 0x75:
+		set_sfr(d, s, in->val[0], in->val[1], 1);
+		break;
+
+	/* mov data addr., a */
+	case 0xf5:
+		if (old.known & DIS8051_KNOWN_A)
+			set_sfr(d, s, in->val[0], old.a, 1);
+		break;
+
+	/* mov a, data addr. */
+	case 0xe5:
+		if (get_sfr(d, &old, in->val[1], &v))
+			set_sfr(d, s, DIS8051_SFR_ACC, v, 1);
+		break;
+
+	/* orl / anl / xrl data addr., #imm, inc data addr. */
+	case 0x43:
+	case 0x53:
+	case 0x63:
+	case 0x05:
+		if (dps)
+			dps_logic(s, &old, in->opcode, in->val[1]);
+		break;
+	}
+
+	/* a new DPS swaps the two DPTRs, or mixes them up */
+	if (dps) {
+		switch (dps_flip(d, &old, s, in)) {
+		case 1:
+			swap(s);
+			break;
+		case -1:
+			s->known &= ~(DIS8051_KNOWN_DPTR | DIS8051_KNOWN_ALT);
+			break;
+		}
+	}
+}
+
+/* basic block leaders inside the swept range, one bit per address */
+static uint8_t *leaders(const struct dis8051_xrefs *x)
+{
+	uint8_t *map;
+	size_t i;
+
+	if (!(map = calloc(0x10000/8, 1)))
+		return NULL;
+
+	/* code references sort first in 'by_to' */
+	for (i = 0; i < x->count &&
+	            x->by_to[i].space == DIS8051_SPACE_CODE; i++)
+		map[x->by_to[i].to >> 3] |= 1 << (x->by_to[i].to & 7);
+
+	return map;
+}
+
+/* whether any instruction may write the DPS of 'd' */
+static int writes_dps(const struct dis8051_derivative *d, uint16_t base,
+                      const uint8_t *buf, int len)
+{
+	struct dis8051_insn in;
+	int off, size, i;
+
+	if (!d || !d->dps)
+		return 0;
+	for (off = 0; off < len; off += size) {
+		if (!(size = dis8051_decode_deriv(d, base + off, buf + off,
+		                                  len - off, &in)))
+			break;
+		for (i = 0; i < 3 && in.opnd[i] != DIS8051_OPND_NONE; i++)
+			if ((dis8051_access(&in, i) & DIS8051_WRITE) &&
+			    is_dps(d, &in, i))
+				return 1;
+	}
+	return 0;
+}
+
+/* state at a block leader, DPS stays 0 if code never writes it */
+static void block_reset(struct dis8051_dptr_state *s, int dps)
+{
+	dis8051_dptr_reset(s);
+	if (!dps)
+		s->dps_known = 0xff;
+}
+
+int dis8051_dptr_resolve(const struct dis8051_derivative *d,
+                         struct dis8051_xrefs *x, uint16_t base,
+                         const uint8_t *buf, int len)
+{
+	struct dis8051_dptr_state s;
+	struct dis8051_insn in;
+	uint8_t *map;
+	uint16_t pc;
+	int off, size, found = 0, ret = 0, dps;
+
+	if (!(map = leaders(x)))
+		return -1;
+
+	dps = writes_dps(d, base, buf, len);
+	block_reset(&s, dps);
+
+	for (off = 0; off < len; off += size) {
+		pc = base + off;
+		if (!(size = dis8051_decode_deriv(d, pc, buf + off, len - off,
+		                                  &in)))
+			break;
+
+		if (map[pc >> 3] & (1 << (pc & 7)))
+			block_reset(&s, dps);
+
+		if ((s.known & DIS8051_KNOWN_DPTR) == DIS8051_KNOWN_DPTR) {
+			switch (in.opcode) {
+			/* movx a, @dptr */
+			case 0xe0:
+				ret = dis8051_xrefs_add(x, pc, s.dptr,
+				      DIS8051_SPACE_XDATA,
+				      DIS8051_READ | DIS8051_XREF_DPTR);
+				found++;
+				break;
+
+			/* movx @dptr, a */
+			case 0xf0:
+				ret = dis8051_xrefs_add(x, pc, s.dptr,
+				      DIS8051_SPACE_XDATA,
+				      DIS8051_WRITE | DIS8051_XREF_DPTR);
+				found++;
+				break;
+
+			/* movc a, @a+dptr, exact if a is known,
+			 * else the table base */
+			case 0x93:
+				ret = dis8051_xrefs_add(x, pc,
+				      s.known & DIS8051_KNOWN_A ?
+				      s.dptr + s.a : s.dptr,
+				      DIS8051_SPACE_CODE,
+				      DIS8051_READ | DIS8051_XREF_DPTR);
+				found++;
+				break;
+			}
+			if (ret)
+				break;
+		}
+
+		dis8051_dptr_step(d, &s, &in);
+
+		/* end of block, callees may change DPTR and a */
+		if (in.flow != DIS8051_FLOW_NONE &&
+		    in.flow != DIS8051_FLOW_CJMP)
+			block_reset(&s, dps);
+	}
+
+	free(map);
+	if (ret)
+		return -1;
+
+	dis8051_xrefs_sort(x);
+	return found;
+}
+
+int dis8051_dptr_comment(const struct dis8051_xrefs *x, uint16_t pc,
+                         char *s, int n)
+{
+	const struct dis8051_xref *r;
+	size_t i, count;
+
+	count = dis8051_xrefs_from(x, pc, &r);
+	for (i = 0; i < count; i++) {
+		if (!(r[i].kind & DIS8051_XREF_DPTR))
+			continue;
+		snprintf(s, n, "%s 0x%x", r[i].space == DIS8051_SPACE_CODE ?
+		         "code" : "xdata", r[i].to);
+		return 1;
+	}
+
+	return 0;
+}
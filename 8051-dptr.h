@@ -0,0 +1,60 @@
+/* 8051/8052 DPTR constant propagation,
+ * resolves the targets of movx @dptr and movc @a+dptr */
+
+#ifndef DIS8051_DPTR_H
+#define DIS8051_DPTR_H
+
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-xref.h"
+#include "8051-render.h"
+
+/* known parts of the tracked state */
+#define DIS8051_KNOWN_DPL 0x1
+#define DIS8051_KNOWN_DPH 0x2
+#define DIS8051_KNOWN_A   0x4
+#define DIS8051_KNOWN_ALT_DPL 0x8
+#define DIS8051_KNOWN_ALT_DPH 0x10
+#define DIS8051_KNOWN_DPTR (DIS8051_KNOWN_DPL | DIS8051_KNOWN_DPH)
+#define DIS8051_KNOWN_ALT (DIS8051_KNOWN_ALT_DPL | DIS8051_KNOWN_ALT_DPH)
+
+/* reference resolved through DPTR, used together with
+ * DIS8051_READ / DIS8051_WRITE in 'struct dis8051_xref' */
+#define DIS8051_XREF_DPTR 0x20
+
+/* dual DPTR parts keep the one not selected in 'alt', toggling the
+ * select bit swaps them even while it is not known which is DPTR0 */
+struct dis8051_dptr_state {
+	uint16_t dptr;       /* the selected DPTR */
+	uint16_t alt;        /* the other one */
+	uint8_t a;
+	uint8_t dps;         /* the DPTR select SFR of the derivative */
+	uint8_t known;
+	uint8_t dps_known;   /* known bits of 'dps' */
+};
+
+/* nothing known, DPS neither */
+void dis8051_dptr_reset(struct dis8051_dptr_state *s);
+
+/* update 's' with the effects of 'in' on derivative 'd', NULL for a
+ * single DPTR: DPS writes, movx @dptr stepping the selected DPTR */
+void dis8051_dptr_step(const struct dis8051_derivative *d,
+                       struct dis8051_dptr_state *s,
+                       const struct dis8051_insn *in);
+
+/* propagate DPTR within the basic blocks of 'len' bytes of code at
+ * 'base' of derivative 'd' (NULL for the default) and add the resolved
+ * movx/movc targets to 'x', which must have been built over the same
+ * code, block leaders are taken from its code references; DPTR0 is
+ * taken as selected where code never writes DPS,
+ * returns the number of resolved accesses or -1 if out of memory */
+int dis8051_dptr_resolve(const struct dis8051_derivative *d,
+                         struct dis8051_xrefs *x, uint16_t base,
+                         const uint8_t *buf, int len);
+
+/* comment for the resolved access at 'pc', e.g. "xdata 0x8000",
+ * returns 0 if there is none */
+int dis8051_dptr_comment(const struct dis8051_xrefs *x, uint16_t pc,
+                         char *s, int n);
+
+#endif
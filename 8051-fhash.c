@@ -0,0 +1,509 @@
+/* position independent function fingerprints, and matching the
+ * functions of two images through locality sensitive hashing */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-flow.h"
+#include "8051-fhash.h"
+
+#define BANDS (DIS8051_FHASH_K / DIS8051_FHASH_ROWS)
+
+/* functions in one bucket compared at most, a bound for the many
+ * identical stubs */
+#define BUCKET_MAX 256
+
+/* block shapes are hashed apart from instruction 3-grams */
+#define SHAPE_SALT 0x5ba9e000u
+
+/* work of one function walk */
+struct fpass {
+	const struct dis8051_flow *f;
+	uint32_t *owner;      /* stamp of the function that walked a byte */
+	uint32_t *leader;     /* stamp of the function it starts a block of */
+	uint16_t *pcs;        /* instructions walked, then sorted */
+	size_t npcs, apcs;
+	uint16_t *work;
+	size_t nwork, awork;
+	uint32_t *elems;      /* set the minhash values are taken over */
+	size_t nelems, aelems;
+};
+
+/* bucket entry of the diff */
+struct band {
+	uint32_t key;
+	uint32_t func;
+};
+
+/* candidate of the diff, by function index */
+struct pair {
+	uint32_t a, b;
+	int score;
+	int dist;             /* between the addresses */
+};
+
+static uint32_t mix(uint32_t x)
+{
+	x ^= x >> 16;
+	x *= 0x85ebca6bu;
+	x ^= x >> 13;
+	x *= 0xc2b2ae35u;
+	x ^= x >> 16;
+	return x;
+}
+
+static int in_range(const struct dis8051_flow *f, uint16_t addr)
+{
+	return addr >= f->base && addr - f->base < f->len;
+}
+
+static int grow(void **v, size_t *a, size_t n, size_t size)
+{
+	void *p;
+	size_t m;
+
+	if (n < *a)
+		return 0;
+	m = *a ? *a*2 : 64;
+	if (!(p = realloc(*v, m*size)))
+		return -1;
+	*v = p;
+	*a = m;
+	return 0;
+}
+
+static int push_work(struct fpass *p, uint16_t pc)
+{
+	if (grow((void **)&p->work, &p->awork, p->nwork, sizeof(*p->work)))
+		return -1;
+	p->work[p->nwork++] = pc;
+	return 0;
+}
+
+static int push_elem(struct fpass *p, uint32_t e)
+{
+	if (grow((void **)&p->elems, &p->aelems, p->nelems,
+	         sizeof(*p->elems)))
+		return -1;
+	p->elems[p->nelems++] = e;
+	return 0;
+}
+
+/* a branch within the function starts a block there */
+static int edge(struct fpass *p, struct dis8051_fhash *h, uint32_t stamp,
+                uint16_t to)
+{
+	if (!in_range(p->f, to))
+		return 0;
+	p->leader[to - p->f->base] = stamp;
+	h->edges++;
+	return push_work(p, to);
+}
+
+/* jumps into other functions are tail calls */
+static int tail_call(const struct dis8051_flow *f,
+                     const struct dis8051_fhash *h, uint16_t to)
+{
+	return in_range(f, to) && to != h->addr &&
+	       (f->map[to - f->base] & DIS8051_MAP_FUNC);
+}
+
+/* collect the instructions of the function at h->addr */
+static int walk(struct fpass *p, struct dis8051_fhash *h, uint32_t stamp)
+{
+	const struct dis8051_flow *f = p->f;
+	const struct dis8051_jtab *j;
+	struct dis8051_insn in;
+	uint16_t pc;
+	int off, i;
+
+	p->npcs = p->nwork = 0;
+	if (in_range(f, h->addr))
+		p->leader[h->addr - f->base] = stamp;
+	if (push_work(p, h->addr))
+		return -1;
+
+	while (p->nwork > 0) {
+		pc = p->work[--p->nwork];
+		for (;;) {
+			if (!in_range(f, pc))
+				break;
+			off = pc - f->base;
+			if (!(f->map[off] & DIS8051_MAP_CODE) ||
+			    p->owner[off] == stamp)
+				break;
+			p->owner[off] = stamp;
+			if (!dis8051_decode(pc, f->buf + off, f->len - off, &in))
+				break;
+			if (grow((void **)&p->pcs, &p->apcs, p->npcs,
+			         sizeof(*p->pcs)))
+				return -1;
+			p->pcs[p->npcs++] = pc;
+
+			switch (in.flow) {
+			case DIS8051_FLOW_CALL:
+				h->calls++;
+				pc += in.size;
+				continue;
+
+			case DIS8051_FLOW_JMP:
+			case DIS8051_FLOW_CJMP:
+				if (!tail_call(f, h, in.target) &&
+				    edge(p, h, stamp, in.target))
+					return -1;
+				if (in.flow == DIS8051_FLOW_JMP)
+					break;
+				if (edge(p, h, stamp, pc + in.size))
+					return -1;
+				break;
+
+			case DIS8051_FLOW_IJMP:
+			case DIS8051_FLOW_RET:
+				if (!(j = dis8051_flow_jtab(f, pc)))
+					break;
+				for (i = 0; i < j->entries; i++)
+					if (edge(p, h, stamp,
+					         dis8051_jtab_target(f, j, i)))
+						return -1;
+				break;
+
+			case DIS8051_FLOW_RETI:
+			case DIS8051_FLOW_ILL:
+				break;
+
+			default:
+				pc += in.size;
+				continue;
+			}
+			break;
+		}
+	}
+	return 0;
+}
+
+static int cmp_pc(const void *a, const void *b)
+{
+	return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+}
+
+/* operands that move between builds are masked: code addresses,
+ * immediates and IRAM; SFRs and their bits stay */
+static uint32_t token(const struct dis8051_insn *in)
+{
+	uint32_t t = in->opcode;
+	int i;
+
+	if ((t & 0x1f) == 0x01 || t == 0x80)  /* ajmp, sjmp */
+		t = 0x02;
+	else if ((t & 0x1f) == 0x11)          /* acall */
+		t = 0x12;
+	for (i = 0; i < 3 && in->opnd[i]; i++)
+		if ((in->opnd[i] == DIS8051_OPND_DIRECT ||
+		     in->opnd[i] == DIS8051_OPND_BIT ||
+		     in->opnd[i] == DIS8051_OPND_NBIT) && in->val[i] >= 0x80)
+			t = t << 8 ^ in->val[i];
+	return mix(t);
+}
+
+/* shape of the block ending with 'in' */
+static uint32_t shape(const struct dis8051_insn *in, unsigned insns,
+                      unsigned out)
+{
+	return mix(SHAPE_SALT | (insns < 255 ? insns : 255) << 4 |
+	           (out < 15 ? out : 15) | (uint32_t)in->flow << 12);
+}
+
+/* instruction 3-grams and block shapes of the walked instructions */
+static int features(struct fpass *p, struct dis8051_fhash *h,
+                    uint32_t stamp)
+{
+	const struct dis8051_flow *f = p->f;
+	struct dis8051_insn in;
+	uint32_t t[3] = {0, 0, 0};
+	unsigned insns = 0;
+	size_t i;
+	int off, last, out;
+
+	if (p->npcs)
+		qsort(p->pcs, p->npcs, sizeof(*p->pcs), cmp_pc);
+	p->nelems = 0;
+	h->exact = 0;
+	h->insns = p->npcs < 0xffff ? p->npcs : 0xffff;
+
+	for (i = 0; i < p->npcs; i++) {
+		off = p->pcs[i] - f->base;
+		dis8051_decode(p->pcs[i], f->buf + off, f->len - off, &in);
+		t[0] = t[1];
+		t[1] = t[2];
+		t[2] = token(&in);
+		h->exact = mix(h->exact ^ t[2]) + 0x9e3779b9u;
+		if (i >= 2 && push_elem(p, mix(t[0] ^ (t[1] << 11 | t[1] >> 21) ^
+		                               (t[2] << 22 | t[2] >> 10))))
+			return -1;
+
+		if (p->leader[off] == stamp)
+			h->blocks++;
+		insns++;
+
+		/* the block ends before the next leader or gap */
+		last = i + 1 == p->npcs ||
+		       p->pcs[i+1] != p->pcs[i] + in.size ||
+		       p->leader[p->pcs[i+1] - f->base] == stamp;
+		if (!last)
+			continue;
+		switch (in.flow) {
+		case DIS8051_FLOW_NONE:
+		case DIS8051_FLOW_CALL:
+			out = i + 1 < p->npcs &&
+			      p->pcs[i+1] == p->pcs[i] + in.size;
+			h->edges += out;
+			break;
+		case DIS8051_FLOW_CJMP:
+			out = 2;
+			break;
+		case DIS8051_FLOW_JMP:
+			out = 1;
+			break;
+		default:
+			out = 0;
+			break;
+		}
+		if (push_elem(p, shape(&in, insns, out)))
+			return -1;
+		insns = 0;
+	}
+
+	/* too short for 3-grams */
+	if (p->npcs < 3 && push_elem(p, h->exact))
+		return -1;
+	return 0;
+}
+
+static void minhash(const struct fpass *p, struct dis8051_fhash *h)
+{
+	uint32_t v;
+	size_t i;
+	int k;
+
+	for (k = 0; k < DIS8051_FHASH_K; k++)
+		h->minhash[k] = 0xffffffffu;
+	for (i = 0; i < p->nelems; i++)
+		for (k = 0; k < DIS8051_FHASH_K; k++) {
+			v = mix(p->elems[i] ^ (0x9e3779b9u * (k + 1)));
+			if (v < h->minhash[k])
+				h->minhash[k] = v;
+		}
+}
+
+int dis8051_fhash_run(const struct dis8051_flow *f, struct dis8051_fhashes *h)
+{
+	struct fpass p;
+	size_t n = 0, i;
+	int off, ret = 0;
+
+	memset(h, 0, sizeof(*h));
+	memset(&p, 0, sizeof(p));
+	p.f = f;
+
+	for (off = 0; off < f->len; off++)
+		if (f->map[off] & DIS8051_MAP_FUNC)
+			n++;
+	h->funcs = calloc(n ? n : 1, sizeof(*h->funcs));
+	p.owner = calloc(f->len ? f->len : 1, sizeof(*p.owner));
+	p.leader = calloc(f->len ? f->len : 1, sizeof(*p.leader));
+	if (!h->funcs || !p.owner || !p.leader) {
+		ret = -1;
+		goto out;
+	}
+
+	for (off = 0; off < f->len; off++)
+		if (f->map[off] & DIS8051_MAP_FUNC)
+			h->funcs[h->nfuncs++].addr = f->base + off;
+	for (i = 0; i < h->nfuncs && !ret; i++) {
+		if (!(ret = walk(&p, &h->funcs[i], i + 1)))
+			ret = features(&p, &h->funcs[i], i + 1);
+		minhash(&p, &h->funcs[i]);
+	}
+
+out:
+	free(p.owner);
+	free(p.leader);
+	free(p.pcs);
+	free(p.work);
+	free(p.elems);
+	if (ret)
+		dis8051_fhash_free(h);
+	return ret;
+}
+
+void dis8051_fhash_free(struct dis8051_fhashes *h)
+{
+	free(h->funcs);
+	memset(h, 0, sizeof(*h));
+}
+
+static int ratio(unsigned a, unsigned b)
+{
+	if (a == b)
+		return 1000;
+	return a < b ? a*1000/b : b*1000/a;
+}
+
+int dis8051_fhash_similarity(const struct dis8051_fhash *a,
+                             const struct dis8051_fhash *b)
+{
+	int k, same = 0, s;
+
+	if (a->exact == b->exact && a->insns == b->insns)
+		return 1000;
+	for (k = 0; k < DIS8051_FHASH_K; k++)
+		same += a->minhash[k] == b->minhash[k];
+
+	/* three parts content, one part shape */
+	s = 3*same*1000/DIS8051_FHASH_K +
+	    (ratio(a->insns, b->insns) + ratio(a->blocks, b->blocks) +
+	     ratio(a->edges, b->edges) + ratio(a->calls, b->calls))/4;
+	s /= 4;
+	return s < 1000 ? s : 999;
+}
+
+static uint32_t band_key(const struct dis8051_fhash *h, int band)
+{
+	uint32_t key = band;
+	int k;
+
+	for (k = 0; k < DIS8051_FHASH_ROWS; k++)
+		key = mix(key ^ h->minhash[band*DIS8051_FHASH_ROWS + k]);
+	return key;
+}
+
+static int cmp_band(const void *a, const void *b)
+{
+	const struct band *x = a, *y = b;
+
+	if (x->key != y->key)
+		return x->key < y->key ? -1 : 1;
+	return x->func < y->func ? -1 : x->func > y->func;
+}
+
+/* best score first, then the pair closest in address */
+static int cmp_pair(const void *a, const void *b)
+{
+	const struct pair *x = a, *y = b;
+
+	if (x->score != y->score)
+		return x->score > y->score ? -1 : 1;
+	if (x->dist != y->dist)
+		return x->dist < y->dist ? -1 : 1;
+	if (x->a != y->a)
+		return x->a < y->a ? -1 : 1;
+	return x->b < y->b ? -1 : x->b > y->b;
+}
+
+static int cmp_match(const void *a, const void *b)
+{
+	const struct dis8051_fmatch *x = a, *y = b;
+
+	return (int)x->a - (int)y->a;
+}
+
+/* first entry of 'key' in the sorted 'v' */
+static size_t lower(const struct band *v, size_t n, uint32_t key)
+{
+	size_t lo = 0, hi = n, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo)/2;
+		if (v[mid].key < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+int dis8051_fhash_diff(const struct dis8051_fhashes *a,
+                       const struct dis8051_fhashes *b, int threshold,
+                       struct dis8051_fdiff *d)
+{
+	struct band *bands;
+	struct pair *pairs = NULL;
+	size_t nbands = 0, npairs = 0, apairs = 0, i, k, e, n;
+	uint32_t *seen, key;
+	uint8_t *used_a, *used_b;
+	int s, band, ret = -1;
+
+	memset(d, 0, sizeof(*d));
+	bands = malloc((b->nfuncs ? b->nfuncs : 1)*BANDS*sizeof(*bands));
+	seen = calloc(b->nfuncs ? b->nfuncs : 1, sizeof(*seen));
+	used_a = calloc(a->nfuncs ? a->nfuncs : 1, 1);
+	used_b = calloc(b->nfuncs ? b->nfuncs : 1, 1);
+	if (!bands || !seen || !used_a || !used_b)
+		goto out;
+
+	/* functions not reached have no instructions to compare */
+	for (i = 0; i < b->nfuncs; i++)
+		for (band = 0; band < BANDS && b->funcs[i].insns; band++) {
+			bands[nbands].key = band_key(&b->funcs[i], band);
+			bands[nbands++].func = i;
+		}
+	qsort(bands, nbands, sizeof(*bands), cmp_band);
+
+	/* candidates share a band */
+	for (i = 0; i < a->nfuncs; i++) {
+		for (band = 0; band < BANDS && a->funcs[i].insns; band++) {
+			key = band_key(&a->funcs[i], band);
+			e = lower(bands, nbands, key);
+			for (n = 0; e < nbands && bands[e].key == key &&
+			     n < BUCKET_MAX; e++, n++) {
+				k = bands[e].func;
+				if (seen[k] == i + 1)
+					continue;
+				seen[k] = i + 1;
+				s = dis8051_fhash_similarity(&a->funcs[i],
+				                             &b->funcs[k]);
+				if (s < threshold)
+					continue;
+				if (grow((void **)&pairs, &apairs, npairs,
+				         sizeof(*pairs)))
+					goto out;
+				pairs[npairs].a = i;
+				pairs[npairs].b = k;
+				pairs[npairs].score = s;
+				pairs[npairs++].dist = abs(a->funcs[i].addr -
+				                           b->funcs[k].addr);
+			}
+		}
+	}
+
+	/* each function once, best pairs first */
+	if (npairs)
+		qsort(pairs, npairs, sizeof(*pairs), cmp_pair);
+	if (!(d->matches = malloc((npairs ? npairs : 1)*sizeof(*d->matches))))
+		goto out;
+	for (i = 0; i < npairs; i++) {
+		if (used_a[pairs[i].a] || used_b[pairs[i].b])
+			continue;
+		used_a[pairs[i].a] = used_b[pairs[i].b] = 1;
+		d->matches[d->nmatches].a = a->funcs[pairs[i].a].addr;
+		d->matches[d->nmatches].b = b->funcs[pairs[i].b].addr;
+		d->matches[d->nmatches++].score = pairs[i].score;
+	}
+	qsort(d->matches, d->nmatches, sizeof(*d->matches), cmp_match);
+	ret = 0;
+
+out:
+	free(bands);
+	free(seen);
+	free(used_a);
+	free(used_b);
+	free(pairs);
+	return ret;
+}
+
+void dis8051_fdiff_free(struct dis8051_fdiff *d)
+{
+	free(d->matches);
+	memset(d, 0, sizeof(*d));
+}
@@ -0,0 +1,63 @@
+/* position independent function fingerprints, and matching the
+ * functions of two images through locality sensitive hashing */
+
+#ifndef DIS8051_FHASH_H
+#define DIS8051_FHASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-flow.h"
+
+/* minhash values per function, in bands of DIS8051_FHASH_ROWS */
+#define DIS8051_FHASH_K    32
+#define DIS8051_FHASH_ROWS 2
+
+struct dis8051_fhash {
+	uint16_t addr;
+	uint16_t insns;
+	uint16_t blocks;
+	uint16_t edges;
+	uint16_t calls;
+	uint32_t exact;    /* of all instructions, operands masked */
+	uint32_t minhash[DIS8051_FHASH_K];  /* of the instruction 3-grams
+	                                     * and basic block shapes */
+};
+
+struct dis8051_fhashes {
+	struct dis8051_fhash *funcs;  /* sorted by address */
+	size_t nfuncs;
+};
+
+/* a function of image a and the one of image b it became */
+struct dis8051_fmatch {
+	uint16_t a, b;
+	uint16_t score;    /* per mille, 1000 if unchanged */
+};
+
+struct dis8051_fdiff {
+	struct dis8051_fmatch *matches;  /* sorted by a */
+	size_t nmatches;
+};
+
+/* fingerprint the functions found by 'f': instructions reached from
+ * each entry without following calls or jumps into other functions,
+ * with code addresses, immediates and IRAM addresses masked and
+ * ajmp / sjmp / ljmp, acall / lcall taken as one; returns 0 on
+ * success, -1 if out of memory */
+int dis8051_fhash_run(const struct dis8051_flow *f, struct dis8051_fhashes *h);
+void dis8051_fhash_free(struct dis8051_fhashes *h);
+
+/* per mille, from the shared minhash values and the CFG shape */
+int dis8051_fhash_similarity(const struct dis8051_fhash *a,
+                             const struct dis8051_fhash *b);
+
+/* match the functions of 'a' to those of 'b', each at most once, best
+ * first; only pairs sharing a band of minhash values are compared, and
+ * matched if they score at least 'threshold' per mille; returns 0 on
+ * success, -1 if out of memory */
+int dis8051_fhash_diff(const struct dis8051_fhashes *a,
+                       const struct dis8051_fhashes *b, int threshold,
+                       struct dis8051_fdiff *d);
+void dis8051_fdiff_free(struct dis8051_fdiff *d);
+
+#endif
@@ -0,0 +1,540 @@
+/* 8051/8052 recursive traversal with jump table recovery */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-xref.h"
+#include "8051-dptr.h"
+#include "8051-flow.h"
+
+#define FLOW_INITIAL 64
+
+/* slot of a in 'bound', r0 -- r7 use 0 -- 7 */
+#define LOC_A 8
+
+/* pending compare, carry set afterwards if ... */
+#define CMP_NONE 0
+#define CMP_LT   1  /* ... loc < n (cjne, subb) */
+#define CMP_GE   2  /* ... loc >= n (add a, #256-n) */
+
+/* dataflow state along one path */
+struct track {
+	struct dis8051_dptr_state d;
+	uint16_t bound[9];    /* exclusive upper bound, 0 if unknown */
+	int8_t a_src;         /* a is a (scaled) copy of this rN, or -1 */
+
+	/* a was loaded by movc a, @a+dptr */
+	uint8_t a_table;
+	uint16_t a_tbase, a_tbound;
+
+	int8_t cmp_loc;
+	uint8_t cmp_mode;
+	uint16_t cmp_n;
+
+	/* tables pushed by push acc, -1 after any other push */
+	int npushed;
+	uint16_t pushed[2], pushed_bound[2];
+};
+
+static void track_reset(struct track *t)
+{
+	memset(t, 0, sizeof(*t));
+	dis8051_dptr_reset(&t->d);
+	t->a_src = -1;
+	t->cmp_loc = -1;
+}
+
+static int in_range(const struct dis8051_flow *f, uint16_t addr)
+{
+	return addr >= f->base && addr - f->base < f->len;
+}
+
+static int push_work(struct dis8051_flow *f, uint16_t addr)
+{
+	uint16_t *w;
+
+	if (!in_range(f, addr))
+		return 0;
+
+	if (f->nwork == f->awork) {
+		size_t n = f->awork ? f->awork*2 : FLOW_INITIAL;
+
+		if (!(w = realloc(f->work, n*sizeof(*w))))
+			return -1;
+		f->work = w;
+		f->awork = n;
+	}
+	f->work[f->nwork++] = addr;
+	return 0;
+}
+
+/* queue a branch target */
+static int branch(struct dis8051_flow *f, uint16_t addr, uint8_t flag)
+{
+	if (in_range(f, addr))
+		f->map[addr - f->base] |= flag;
+	return push_work(f, addr);
+}
+
+int dis8051_flow_init(struct dis8051_flow *f, uint16_t base,
+                      const uint8_t *buf, int len, struct dis8051_xrefs *x)
+{
+	memset(f, 0, sizeof(*f));
+
+	if (len < 0 || base + len > 0x10000)
+		return -1;
+	if (!(f->map = calloc(len ? len : 1, 1)))
+		return -1;
+
+	f->base = base;
+	f->len = len;
+	f->buf = buf;
+	f->xrefs = x;
+	return 0;
+}
+
+void dis8051_flow_free(struct dis8051_flow *f)
+{
+	free(f->map);
+	free(f->work);
+	free(f->jtabs);
+	memset(f, 0, sizeof(*f));
+}
+
+int dis8051_flow_add_entry(struct dis8051_flow *f, uint16_t addr)
+{
+	return branch(f, addr, DIS8051_MAP_FUNC);
+}
+
+int dis8051_flow_add_vectors(struct dis8051_flow *f)
+{
+	struct dis8051_insn in;
+	uint16_t v;
+
+	if (dis8051_flow_add_entry(f, 0x0000))
+		return -1;
+
+	/* interrupt vectors, 8 bytes apart,
+	 * only taken if they start with a jump or reti */
+	for (v = 0x0003; v <= 0x002b; v += 8) {
+		if (!in_range(f, v) ||
+		    !dis8051_decode(v, f->buf + v - f->base,
+		                    f->len - (v - f->base), &in))
+			continue;
+		if (in.flow == DIS8051_FLOW_JMP || in.flow == DIS8051_FLOW_RETI)
+			if (dis8051_flow_add_entry(f, v))
+				return -1;
+	}
+
+	return 0;
+}
+
+static int add_jtab(struct dis8051_flow *f, const struct dis8051_jtab *j)
+{
+	struct dis8051_jtab *p;
+
+	if (f->njtabs == f->ajtabs) {
+		size_t n = f->ajtabs ? f->ajtabs*2 : 8;
+
+		if (!(p = realloc(f->jtabs, n*sizeof(*p))))
+			return -1;
+		f->jtabs = p;
+		f->ajtabs = n;
+	}
+	f->jtabs[f->njtabs++] = *j;
+	return 0;
+}
+
+/* byte of the image, or -1 outside of it */
+static int byte_at(const struct dis8051_flow *f, uint16_t addr)
+{
+	return in_range(f, addr) ? f->buf[addr - f->base] : -1;
+}
+
+static void mark_data(struct dis8051_flow *f, uint16_t addr, int n)
+{
+	for (; n > 0; n--, addr++)
+		if (in_range(f, addr))
+			f->map[addr - f->base] |= DIS8051_MAP_DATA;
+}
+
+/* queue one table target and record it as a jump reference */
+static int jtab_target(struct dis8051_flow *f, uint16_t pc, uint16_t addr)
+{
+	if (branch(f, addr, DIS8051_MAP_BLOCK))
+		return -1;
+	if (f->xrefs && dis8051_xrefs_add(f->xrefs, pc, addr,
+	                                  DIS8051_SPACE_CODE,
+	                                  DIS8051_XREF_JUMP))
+		return -1;
+	return 0;
+}
+
+/* size of a jump table entry, 0 if the opcode can't be one */
+static int entry_size(int opcode)
+{
+	if (opcode < 0)
+		return 0;
+	if ((opcode & 0x1f) == 0x01 || opcode == 0x80)  /* ajmp, sjmp */
+		return 2;
+	if (opcode == 0x02)                             /* ljmp */
+		return 3;
+	return 0;
+}
+
+/* jmp @a+dptr into a table of ajmp/sjmp/ljmp entries, bounded by
+ * 'count' if known, else by the first entry that doesn't fit */
+static int jtab_jumps(struct dis8051_flow *f, uint16_t pc, uint16_t table,
+                      int count)
+{
+	struct dis8051_jtab j = {pc, table, 0, 0, 0, DIS8051_JTAB_JUMPS};
+	struct dis8051_insn in;
+	uint8_t e[3];
+	uint16_t addr;
+	int i, k, size;
+
+	if (!(size = entry_size(byte_at(f, table))))
+		return 0;
+	if (!count || count > 256/size)
+		count = 256/size;
+
+	for (i = 0; i < count; i++) {
+		addr = table + i*size;
+		if (entry_size(byte_at(f, addr)) != size ||
+		    (f->map[addr - f->base] & (DIS8051_MAP_CODE |
+		                               DIS8051_MAP_BLOCK)) ||
+		    !in_range(f, addr + size - 1))
+			break;
+		for (k = 0; k < size; k++)
+			e[k] = byte_at(f, addr + k);
+		dis8051_decode(addr, e, size, &in);
+
+		/* entries pointing back into the table end it */
+		if (in.target >= table && in.target < addr + size)
+			break;
+
+		mark_data(f, addr, size);
+		if (jtab_target(f, pc, in.target))
+			return -1;
+	}
+
+	j.entries = i;
+	j.entry_size = size;
+	return i ? add_jtab(f, &j) : 0;
+}
+
+/* movc a, @a+dptr; jmp @a+dptr, entries are offsets from the table */
+static int jtab_offsets(struct dis8051_flow *f, uint16_t pc, uint16_t table,
+                        int count)
+{
+	struct dis8051_jtab j = {pc, table, 0, 0, 1, DIS8051_JTAB_OFFSETS};
+	int i, b;
+
+	for (i = 0; i < count; i++) {
+		if ((b = byte_at(f, table + i)) < 0)
+			break;
+		mark_data(f, table + i, 1);
+		if (jtab_target(f, pc, table + b))
+			return -1;
+	}
+
+	j.entries = i;
+	return i ? add_jtab(f, &j) : 0;
+}
+
+/* push acc of two movc results followed by ret,
+ * the last push is the high byte */
+static int jtab_bytes(struct dis8051_flow *f, uint16_t pc,
+                      const struct track *t)
+{
+	struct dis8051_jtab j = {pc, t->pushed[0], t->pushed[1], 0, 1,
+	                         DIS8051_JTAB_BYTES};
+	int i, count, lo, hi;
+
+	count = t->pushed_bound[0] ? t->pushed_bound[0] : t->pushed_bound[1];
+
+	/* unbounded: low and high tables back to back */
+	if (!count && j.table_hi > j.table && j.table_hi - j.table <= 256)
+		count = j.table_hi - j.table;
+
+	for (i = 0; i < count; i++) {
+		if ((lo = byte_at(f, j.table + i)) < 0 ||
+		    (hi = byte_at(f, j.table_hi + i)) < 0)
+			break;
+		mark_data(f, j.table + i, 1);
+		mark_data(f, j.table_hi + i, 1);
+		if (jtab_target(f, pc, hi<<8 | lo))
+			return -1;
+	}
+
+	j.entries = i;
+	return i ? add_jtab(f, &j) : 0;
+}
+
+static int jmp_a_dptr(struct dis8051_flow *f, uint16_t pc,
+                      const struct track *t)
+{
+	/* dataflow: table address known */
+	if ((t->d.known & DIS8051_KNOWN_DPTR) == DIS8051_KNOWN_DPTR) {
+		if (t->a_table && t->a_tbase == t->d.dptr)
+			return t->a_tbound ?
+			       jtab_offsets(f, pc, t->d.dptr, t->a_tbound) : 0;
+		return jtab_jumps(f, pc, t->d.dptr, t->bound[LOC_A]);
+	}
+
+	/* pattern: table right after the jump */
+	return jtab_jumps(f, pc, pc + 1, 0);
+}
+
+/* clear the bounds an operand written by 'in' may have changed */
+static void clobber(struct track *t, const struct dis8051_insn *in, int i)
+{
+	switch (in->opnd[i]) {
+	case DIS8051_OPND_RN:
+		t->bound[in->val[i]] = 0;
+		break;
+
+	case DIS8051_OPND_DIRECT:
+		/* r0 -- r7 of bank 0 */
+		if (in->val[i] < 8)
+			t->bound[in->val[i]] = 0;
+		if (in->val[i] != DIS8051_SFR_ACC)
+			break;
+		/* fall through */
+	case DIS8051_OPND_A:
+	case DIS8051_OPND_AB:
+		t->bound[LOC_A] = 0;
+		t->a_src = -1;
+		t->a_table = 0;
+		break;
+	}
+}
+
+/* apply a pending compare to the fall-through of jc/jnc */
+static void take_bound(struct track *t, uint8_t mode)
+{
+	uint16_t *b;
+
+	if (t->cmp_mode != mode || t->cmp_loc < 0)
+		return;
+
+	b = &t->bound[t->cmp_loc];
+	if (!*b || t->cmp_n < *b)
+		*b = t->cmp_n;
+
+	/* a and the register it was copied from */
+	if (t->cmp_loc == LOC_A && t->a_src >= 0)
+		t->bound[t->a_src] = *b;
+	else if (t->cmp_loc == t->a_src)
+		t->bound[LOC_A] = *b;
+}
+
+static void track_step(struct track *t, const struct dis8051_insn *in)
+{
+	struct track old = *t;
+	int i;
+
+	dis8051_dptr_step(NULL, &t->d, in);
+
+	for (i = 0; i < 3 && in->opnd[i] != DIS8051_OPND_NONE; i++)
+		if (dis8051_access(in, i) & DIS8051_WRITE)
+			clobber(t, in, i);
+
+	t->cmp_mode = CMP_NONE;
+	t->cmp_loc = -1;
+
+	switch (in->opcode) {
+	/* mov a, rN */
+	case 0xe8: case 0xe9: case 0xea: case 0xeb:
+	case 0xec: case 0xed: case 0xee: case 0xef:
+		t->bound[LOC_A] = old.bound[in->val[1]];
+		t->a_src = in->val[1];
+		break;
+
+	/* mov rN, a */
+	case 0xf8: case 0xf9: case 0xfa: case 0xfb:
+	case 0xfc: case 0xfd: case 0xfe: case 0xff:
+		t->bound[in->val[0]] = old.bound[LOC_A];
+		break;
+
+	/* rl a, add a, acc: index scaled by 2 */
+	case 0x23:
+	case 0x25:
+		if (in->opcode == 0x25 && in->val[1] != DIS8051_SFR_ACC)
+			break;
+		t->bound[LOC_A] = old.bound[LOC_A];
+		t->a_src = old.a_src;
+		break;
+
+	/* add a, rN: index scaled by one more if a is a copy of rN */
+	case 0x28: case 0x29: case 0x2a: case 0x2b:
+	case 0x2c: case 0x2d: case 0x2e: case 0x2f:
+		if (old.a_src == in->val[1]) {
+			t->bound[LOC_A] = old.bound[LOC_A];
+			t->a_src = old.a_src;
+		}
+		break;
+
+	/* cjne a, #imm, cjne rN, #imm */
+	case 0xb4:
+	case 0xb8: case 0xb9: case 0xba: case 0xbb:
+	case 0xbc: case 0xbd: case 0xbe: case 0xbf:
+		t->cmp_loc = in->opcode == 0xb4 ? LOC_A : in->val[0];
+		t->cmp_n = in->val[1];
+		t->cmp_mode = CMP_LT;
+		break;
+
+	/* subb a, #imm / add a, #imm: the bound holds for the
+	 * register a was copied from */
+	case 0x94:
+	case 0x24:
+		if (old.a_src < 0)
+			break;
+		t->cmp_loc = old.a_src;
+		t->cmp_n = in->opcode == 0x94 ? in->val[1] :
+		           0x100 - in->val[1];
+		t->cmp_mode = in->opcode == 0x94 ? CMP_LT : CMP_GE;
+		break;
+
+	/* movc a, @a+dptr */
+	case 0x93:
+		if ((old.d.known & DIS8051_KNOWN_DPTR) == DIS8051_KNOWN_DPTR) {
+			t->a_table = 1;
+			t->a_tbase = old.d.dptr;
+			t->a_tbound = old.bound[LOC_A];
+		}
+		break;
+
+	/* push data addr. */
+	case 0xc0:
+		if (in->val[0] == DIS8051_SFR_ACC && old.a_table &&
+		    t->npushed >= 0 && t->npushed < 2) {
+			t->pushed[t->npushed] = old.a_tbase;
+			t->pushed_bound[t->npushed++] = old.a_tbound;
+		} else {
+			t->npushed = -1;
+		}
+		break;
+
+	/* pop data addr. */
+	case 0xd0:
+		t->npushed = -1;
+		break;
+	}
+}
+
+/* follow one path until it leaves the known code */
+static int walk(struct dis8051_flow *f, uint16_t pc)
+{
+	struct dis8051_insn in;
+	struct track t;
+	int off, i;
+
+	track_reset(&t);
+
+	while (in_range(f, pc)) {
+		off = pc - f->base;
+		if (f->map[off] & (DIS8051_MAP_CODE | DIS8051_MAP_BODY |
+		                   DIS8051_MAP_DATA))
+			return 0;
+		if (!dis8051_decode(pc, f->buf + off, f->len - off, &in))
+			return 0;
+
+		f->map[off] |= DIS8051_MAP_CODE;
+		for (i = 1; i < in.size; i++)
+			f->map[off + i] |= DIS8051_MAP_BODY;
+
+		switch (in.flow) {
+		case DIS8051_FLOW_JMP:
+			return branch(f, in.target, DIS8051_MAP_BLOCK);
+
+		case DIS8051_FLOW_CJMP:
+			if (branch(f, in.target, DIS8051_MAP_BLOCK))
+				return -1;
+			/* fall-through of jnc: carry was set,
+			 * of jc: carry was clear */
+			if (in.opcode == 0x50 || in.opcode == 0x40) {
+				take_bound(&t, in.opcode == 0x50 ?
+				           CMP_LT : CMP_GE);
+				t.cmp_mode = CMP_NONE;
+			} else {
+				track_step(&t, &in);
+			}
+			pc += in.size;
+			continue;
+
+		case DIS8051_FLOW_CALL:
+			if (branch(f, in.target, DIS8051_MAP_FUNC))
+				return -1;
+			/* the callee may change everything */
+			track_reset(&t);
+			pc += in.size;
+			continue;
+
+		case DIS8051_FLOW_RET:
+			if (t.npushed == 2)
+				return jtab_bytes(f, pc, &t);
+			return 0;
+
+		case DIS8051_FLOW_IJMP:
+			return jmp_a_dptr(f, pc, &t);
+
+		case DIS8051_FLOW_RETI:
+		case DIS8051_FLOW_ILL:
+			return 0;
+		}
+
+		track_step(&t, &in);
+		pc += in.size;
+	}
+
+	return 0;
+}
+
+int dis8051_flow_run(struct dis8051_flow *f)
+{
+	size_t nrefs = f->xrefs ? f->xrefs->count : 0;
+
+	while (f->nwork > 0)
+		if (walk(f, f->work[--f->nwork]))
+			return -1;
+
+	if (f->xrefs && f->xrefs->count != nrefs)
+		dis8051_xrefs_sort(f->xrefs);
+	return 0;
+}
+
+const struct dis8051_jtab *dis8051_flow_jtab(const struct dis8051_flow *f,
+                                             uint16_t pc)
+{
+	size_t i;
+
+	for (i = 0; i < f->njtabs; i++)
+		if (f->jtabs[i].pc == pc)
+			return &f->jtabs[i];
+	return NULL;
+}
+
+uint16_t dis8051_jtab_target(const struct dis8051_flow *f,
+                             const struct dis8051_jtab *j, int i)
+{
+	struct dis8051_insn in;
+	uint8_t e[3];
+	uint16_t addr;
+	int k;
+
+	switch (j->kind) {
+	case DIS8051_JTAB_OFFSETS:
+		return j->table + byte_at(f, j->table + i);
+
+	case DIS8051_JTAB_BYTES:
+		return byte_at(f, j->table_hi + i)<<8 | byte_at(f, j->table + i);
+	}
+
+	addr = j->table + i*j->entry_size;
+	for (k = 0; k < j->entry_size; k++)
+		e[k] = byte_at(f, addr + k);
+	dis8051_decode(addr, e, j->entry_size, &in);
+	return in.target;
+}
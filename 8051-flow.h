@@ -0,0 +1,67 @@
+/* 8051/8052 recursive traversal with jump table recovery */
+
+#ifndef DIS8051_FLOW_H
+#define DIS8051_FLOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-xref.h"
+
+/* per byte flags of the code map */
+#define DIS8051_MAP_CODE  0x01  /* first byte of an instruction */
+#define DIS8051_MAP_BODY  0x02  /* operand byte of an instruction */
+#define DIS8051_MAP_DATA  0x04  /* jump table */
+#define DIS8051_MAP_FUNC  0x08  /* entry point or call target */
+#define DIS8051_MAP_BLOCK 0x10  /* branch target */
+
+/* jump table kinds */
+enum dis8051_jtab_kind {
+	DIS8051_JTAB_JUMPS,    /* jmp @a+dptr into ajmp/sjmp/ljmp entries */
+	DIS8051_JTAB_OFFSETS,  /* movc a, @a+dptr; jmp @a+dptr */
+	DIS8051_JTAB_BYTES     /* low/high address bytes, push acc; ret */
+};
+
+struct dis8051_jtab {
+	uint16_t pc;       /* dispatching instruction */
+	uint16_t table;    /* first entry, low bytes for DIS8051_JTAB_BYTES */
+	uint16_t table_hi; /* high bytes for DIS8051_JTAB_BYTES */
+	uint16_t entries;
+	uint8_t entry_size;
+	uint8_t kind;
+};
+
+struct dis8051_flow {
+	uint16_t base;
+	int len;
+	const uint8_t *buf;
+	uint8_t *map;                /* DIS8051_MAP_* for each byte */
+	uint16_t *work;              /* worklist of code addresses */
+	size_t nwork, awork;
+	struct dis8051_jtab *jtabs;
+	size_t njtabs, ajtabs;
+	struct dis8051_xrefs *xrefs; /* optional, gets jump table refs */
+};
+
+/* 'len' bytes of code at 'base', 'x' may be NULL,
+ * return 0 on success, -1 if out of memory */
+int dis8051_flow_init(struct dis8051_flow *f, uint16_t base,
+                      const uint8_t *buf, int len, struct dis8051_xrefs *x);
+void dis8051_flow_free(struct dis8051_flow *f);
+
+/* queue an entry point / the reset and interrupt vectors */
+int dis8051_flow_add_entry(struct dis8051_flow *f, uint16_t addr);
+int dis8051_flow_add_vectors(struct dis8051_flow *f);
+
+/* follow all queued entry points,
+ * returns 0 on success, -1 if out of memory */
+int dis8051_flow_run(struct dis8051_flow *f);
+
+/* jump table dispatched at 'pc', or NULL */
+const struct dis8051_jtab *dis8051_flow_jtab(const struct dis8051_flow *f,
+                                             uint16_t pc);
+
+/* target of entry 'i' of 'j' */
+uint16_t dis8051_jtab_target(const struct dis8051_flow *f,
+                             const struct dis8051_jtab *j, int i);
+
+#endif
@@ -0,0 +1,200 @@
+/* streaming Intel HEX loader */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-ihex.h"
+
+enum { DATA, END, SEGMENT, START_SEGMENT, LINEAR, START_LINEAR };
+
+/* digit values with 0x10 set, 0 for anything else */
+static const uint8_t hex[256] = {
+	['0'] = 0x10, ['1'] = 0x11, ['2'] = 0x12, ['3'] = 0x13,
+	['4'] = 0x14, ['5'] = 0x15, ['6'] = 0x16, ['7'] = 0x17,
+	['8'] = 0x18, ['9'] = 0x19,
+	['a'] = 0x1a, ['b'] = 0x1b, ['c'] = 0x1c,
+	['d'] = 0x1d, ['e'] = 0x1e, ['f'] = 0x1f,
+	['A'] = 0x1a, ['B'] = 0x1b, ['C'] = 0x1c,
+	['D'] = 0x1d, ['E'] = 0x1e, ['F'] = 0x1f,
+};
+
+void dis8051_ihex_init(struct dis8051_ihex *p, struct dis8051_image *img)
+{
+	memset(p, 0, sizeof(*p));
+	p->img = img;
+}
+
+static int fail(struct dis8051_ihex *p, int error)
+{
+	p->error = error;
+	return -1;
+}
+
+/* one line without its newline */
+static int record(struct dis8051_ihex *p, const char *s, size_t n)
+{
+	uint8_t rec[255 + 5], sum = 0, hi, lo;
+	uint16_t off;
+	size_t i, k;
+
+	p->line++;
+	while (n > 0 && (s[n-1] == '\r' || s[n-1] == ' ' || s[n-1] == '\t'))
+		n--;
+	if (n == 0 || p->eof)
+		return 0;
+
+	if (s[0] != ':' || n < 11 || n % 2 == 0 || n > DIS8051_IHEX_LINE)
+		return fail(p, DIS8051_IHEX_ESYNTAX);
+	for (i = 0; i < n/2; i++) {
+		hi = hex[(uint8_t)s[1 + 2*i]];
+		lo = hex[(uint8_t)s[2 + 2*i]];
+		if (!(hi & lo & 0x10))
+			return fail(p, DIS8051_IHEX_ESYNTAX);
+		rec[i] = hi << 4 | (lo & 0x0f);
+		sum += rec[i];
+	}
+	if (n/2 != rec[0] + 5u)
+		return fail(p, DIS8051_IHEX_ESYNTAX);
+	if (sum != 0)
+		return fail(p, DIS8051_IHEX_ECHECKSUM);
+
+	off = rec[1] << 8 | rec[2];
+	switch (rec[3]) {
+	case DATA:
+		/* the offset wraps within a 64 KiB segment, a linear
+		 * address goes on */
+		k = rec[0];
+		if (p->segment && (size_t)(0x10000 - off) < k)
+			k = 0x10000 - off;
+		if (dis8051_image_write(p->img, p->base + off, rec + 4, k) < 0 ||
+		    dis8051_image_write(p->img, p->base, rec + 4 + k,
+		                        rec[0] - k) < 0)
+			return fail(p, DIS8051_IHEX_ENOMEM);
+		return 0;
+	case END:
+		p->eof = 1;
+		return 0;
+	case SEGMENT:
+	case LINEAR:
+		if (rec[0] != 2)
+			break;
+		p->base = (uint32_t)(rec[4] << 8 | rec[5]) <<
+		          (rec[3] == LINEAR ? 16 : 4);
+		p->segment = rec[3] == SEGMENT;
+		return 0;
+	case START_SEGMENT:
+	case START_LINEAR:
+		if (rec[0] != 4)
+			break;
+		if (rec[3] == START_LINEAR)
+			p->img->entry = (uint32_t)rec[4] << 24 | rec[5] << 16 |
+			                rec[6] << 8 | rec[7];
+		else
+			p->img->entry = (uint32_t)(rec[4] << 8 | rec[5]) * 16 +
+			                (rec[6] << 8 | rec[7]);
+		p->img->has_entry = 1;
+		return 0;
+	}
+	return fail(p, DIS8051_IHEX_ETYPE);
+}
+
+int dis8051_ihex_feed(struct dis8051_ihex *p, const char *s, size_t n)
+{
+	const char *nl;
+	size_t k;
+
+	if (p->error)
+		return -1;
+
+	/* finish the record the last chunk ended in */
+	if (p->len > 0) {
+		nl = memchr(s, '\n', n);
+		k = nl ? (size_t)(nl - s) : n;
+		if (p->len + k > sizeof(p->buf)) {
+			p->line++;
+			return fail(p, DIS8051_IHEX_ESYNTAX);
+		}
+		memcpy(p->buf + p->len, s, k);
+		p->len += k;
+		if (!nl)
+			return 0;
+		k++;
+		s += k;
+		n -= k;
+		if (record(p, p->buf, p->len) < 0)
+			return -1;
+		p->len = 0;
+	}
+
+	while ((nl = memchr(s, '\n', n))) {
+		k = nl - s;
+		if (record(p, s, k) < 0)
+			return -1;
+		s += k + 1;
+		n -= k + 1;
+	}
+
+	if (n > sizeof(p->buf)) {
+		p->line++;
+		return fail(p, DIS8051_IHEX_ESYNTAX);
+	}
+	memcpy(p->buf, s, n);
+	p->len = n;
+	return 0;
+}
+
+int dis8051_ihex_finish(struct dis8051_ihex *p)
+{
+	if (p->error)
+		return -1;
+	if (p->len > 0 && record(p, p->buf, p->len) < 0)
+		return -1;
+	p->len = 0;
+	if (!p->eof)
+		return fail(p, DIS8051_IHEX_ENOEOF);
+	return 0;
+}
+
+int dis8051_ihex_load(struct dis8051_image *img, const char *path,
+                      unsigned *line)
+{
+	struct dis8051_ihex p;
+	char buf[65536];
+	size_t n;
+	FILE *f;
+
+	dis8051_ihex_init(&p, img);
+	if (!(f = fopen(path, "rb"))) {
+		p.error = DIS8051_IHEX_EIO;
+		goto out;
+	}
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		if (dis8051_ihex_feed(&p, buf, n) < 0)
+			break;
+	if (!p.error && ferror(f))
+		p.error = DIS8051_IHEX_EIO;
+	if (!p.error)
+		dis8051_ihex_finish(&p);
+	fclose(f);
+out:
+	if (line)
+		*line = p.line;
+	return p.error;
+}
+
+const char *dis8051_ihex_strerror(int error)
+{
+	static const char *const msg[] = {
+		[DIS8051_IHEX_OK] = "no error",
+		[DIS8051_IHEX_ESYNTAX] = "not an Intel HEX record",
+		[DIS8051_IHEX_ECHECKSUM] = "checksum mismatch",
+		[DIS8051_IHEX_ETYPE] = "bad record type",
+		[DIS8051_IHEX_ENOEOF] = "no end of file record",
+		[DIS8051_IHEX_ENOMEM] = "out of memory",
+		[DIS8051_IHEX_EIO] = "read error",
+	};
+
+	if (error < 0 || error > DIS8051_IHEX_EIO)
+		return "unknown error";
+	return msg[error];
+}
@@ -0,0 +1,56 @@
+/* streaming Intel HEX loader */
+
+#ifndef DIS8051_IHEX_H
+#define DIS8051_IHEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-image.h"
+
+/* ':', 255 data bytes and the 5 byte header in hex */
+#define DIS8051_IHEX_LINE (1 + 2*(255 + 5))
+
+enum {
+	DIS8051_IHEX_OK,
+	DIS8051_IHEX_ESYNTAX,     /* not a record */
+	DIS8051_IHEX_ECHECKSUM,
+	DIS8051_IHEX_ETYPE,       /* unknown or malformed record type */
+	DIS8051_IHEX_ENOEOF,      /* input ended without end of file record */
+	DIS8051_IHEX_ENOMEM,
+	DIS8051_IHEX_EIO
+};
+
+struct dis8051_ihex {
+	struct dis8051_image *img;
+	uint32_t base;                  /* extended address records */
+	int segment;                    /* 'base' is a segment, offsets
+	                                 * wrap within its 64 KiB */
+	unsigned line;                  /* line of the last record */
+	int eof;                        /* end of file record seen */
+	int error;                      /* DIS8051_IHEX_E*, sticky */
+	size_t len;                     /* record split between two feeds */
+	char buf[DIS8051_IHEX_LINE + 1];
+};
+
+/* records are loaded into 'img': extended linear address records give
+ * bank:address (8051-codebank.h), data running past the end of a bank
+ * going on into the next one; extended segment ones give segment*16,
+ * and data wraps around within the segment */
+void dis8051_ihex_init(struct dis8051_ihex *p, struct dis8051_image *img);
+
+/* input in chunks of any size, returns 0 or -1 with p->error and
+ * p->line set; records are parsed where they are, only one split
+ * between two chunks is copied */
+int dis8051_ihex_feed(struct dis8051_ihex *p, const char *s, size_t n);
+
+/* end of input, -1 if the last record was cut off or missing */
+int dis8051_ihex_finish(struct dis8051_ihex *p);
+
+/* a whole file, returns DIS8051_IHEX_OK or an error, 'line' (may be
+ * NULL) gets the line it was found on */
+int dis8051_ihex_load(struct dis8051_image *img, const char *path,
+                      unsigned *line);
+
+const char *dis8051_ihex_strerror(int error);
+
+#endif
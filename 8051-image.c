@@ -0,0 +1,174 @@
+/* sparse paged code image, filled by the loaders */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-image.h"
+
+#define PAGE_MASK ((uint32_t)DIS8051_IMAGE_PAGE - 1)
+
+void dis8051_image_init(struct dis8051_image *img)
+{
+	memset(img, 0, sizeof(*img));
+}
+
+void dis8051_image_free(struct dis8051_image *img)
+{
+	size_t i;
+
+	for (i = 0; i < img->npages; i++)
+		free(img->pages[i]);
+	free(img->pages);
+	memset(img, 0, sizeof(*img));
+}
+
+/* index of the page at or after 'addr' */
+static size_t find(const struct dis8051_image *img, uint32_t addr)
+{
+	size_t lo = 0, hi = img->npages, mid;
+
+	addr &= ~PAGE_MASK;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (img->pages[mid]->addr < addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/* page holding 'addr', created if needed */
+static struct dis8051_image_page *page(struct dis8051_image *img,
+                                       uint32_t addr)
+{
+	struct dis8051_image_page *p, **pp;
+	size_t i;
+
+	addr &= ~PAGE_MASK;
+
+	/* loaders write in order, mostly into the same page */
+	if (img->last < img->npages && img->pages[img->last]->addr == addr)
+		return img->pages[img->last];
+
+	i = find(img, addr);
+	if (i < img->npages && img->pages[i]->addr == addr) {
+		img->last = i;
+		return img->pages[i];
+	}
+
+	if (img->npages == img->apages) {
+		size_t n = img->apages ? img->apages*2 : 16;
+
+		if (!(pp = realloc(img->pages, n*sizeof(*pp))))
+			return NULL;
+		img->pages = pp;
+		img->apages = n;
+	}
+	if (!(p = malloc(sizeof(*p))))
+		return NULL;
+	p->addr = addr;
+	memset(p->valid, 0, sizeof(p->valid));
+
+	memmove(img->pages + i + 1, img->pages + i,
+	        (img->npages++ - i)*sizeof(*img->pages));
+	img->pages[i] = p;
+	img->last = i;
+	return p;
+}
+
+int dis8051_image_write(struct dis8051_image *img, uint32_t addr,
+                        const uint8_t *buf, size_t n)
+{
+	struct dis8051_image_page *p;
+	uint32_t off;
+	size_t k, i;
+
+	while (n > 0) {
+		if (!(p = page(img, addr)))
+			return -1;
+		off = addr & PAGE_MASK;
+		k = DIS8051_IMAGE_PAGE - off < n ? DIS8051_IMAGE_PAGE - off : n;
+		memcpy(p->data + off, buf, k);
+		for (i = off; i < off + k; i++)
+			p->valid[i/8] |= 1 << (i%8);
+
+		/* the last page of the 32 bit space */
+		if (addr + k < addr)
+			return 0;
+		addr += k;
+		buf += k;
+		n -= k;
+	}
+	return 0;
+}
+
+static int loaded(const struct dis8051_image_page *p, uint32_t off)
+{
+	return p->valid[off/8] & (1 << (off%8));
+}
+
+const uint8_t *dis8051_image_map(const struct dis8051_image *img,
+                                 uint32_t addr, size_t *n)
+{
+	const struct dis8051_image_page *p;
+	uint32_t off = addr & PAGE_MASK, end;
+	size_t i = find(img, addr);
+
+	if (i == img->npages || img->pages[i]->addr != (addr & ~PAGE_MASK))
+		return NULL;
+	p = img->pages[i];
+	if (!loaded(p, off))
+		return NULL;
+
+	for (end = off + 1; end < DIS8051_IMAGE_PAGE && loaded(p, end); end++)
+		;
+	*n = end - off;
+	return p->data + off;
+}
+
+size_t dis8051_image_read(const struct dis8051_image *img, uint32_t addr,
+                          uint8_t *buf, size_t n, uint8_t fill)
+{
+	const struct dis8051_image_page *p;
+	uint64_t end = (uint64_t)addr + n, lo, hi, a;
+	size_t i, got = 0;
+
+	memset(buf, fill, n);
+	for (i = find(img, addr); i < img->npages; i++) {
+		p = img->pages[i];
+		if (p->addr >= end)
+			break;
+		lo = p->addr > addr ? p->addr : addr;
+		hi = (uint64_t)p->addr + DIS8051_IMAGE_PAGE;
+		if (hi > end)
+			hi = end;
+		for (a = lo; a < hi; a++)
+			if (loaded(p, a - p->addr)) {
+				buf[a - addr] = p->data[a - p->addr];
+				got++;
+			}
+	}
+	return got;
+}
+
+int dis8051_image_range(const struct dis8051_image *img, uint32_t *first,
+                        uint32_t *last)
+{
+	const struct dis8051_image_page *p;
+	int off;
+
+	if (img->npages == 0)
+		return 0;
+
+	p = img->pages[0];
+	for (off = 0; !loaded(p, off); off++)
+		;
+	*first = p->addr + off;
+
+	p = img->pages[img->npages - 1];
+	for (off = DIS8051_IMAGE_PAGE - 1; !loaded(p, off); off--)
+		;
+	*last = p->addr + off;
+	return 1;
+}
@@ -0,0 +1,48 @@
+/* sparse paged code image, filled by the loaders */
+
+#ifndef DIS8051_IMAGE_H
+#define DIS8051_IMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DIS8051_IMAGE_PAGE 4096
+
+struct dis8051_image_page {
+	uint32_t addr;                                /* page aligned */
+	uint8_t data[DIS8051_IMAGE_PAGE];
+	uint8_t valid[DIS8051_IMAGE_PAGE/8];          /* bytes loaded */
+};
+
+/* only pages something was loaded into exist; addresses above 64 KiB
+ * are bank:address for banked images, see 8051-codebank.h */
+struct dis8051_image {
+	struct dis8051_image_page **pages;  /* sorted by address */
+	size_t npages, apages;
+	size_t last;                        /* page written last */
+	uint32_t entry;                     /* start address, if has_entry */
+	int has_entry;
+};
+
+void dis8051_image_init(struct dis8051_image *img);
+void dis8051_image_free(struct dis8051_image *img);
+
+/* load 'n' bytes at 'addr', returns 0 on success, -1 if out of memory */
+int dis8051_image_write(struct dis8051_image *img, uint32_t addr,
+                        const uint8_t *buf, size_t n);
+
+/* loaded bytes at 'addr' without copying, '*n' gets how many follow
+ * in the same page, returns NULL if 'addr' was not loaded */
+const uint8_t *dis8051_image_map(const struct dis8051_image *img,
+                                 uint32_t addr, size_t *n);
+
+/* copy 'n' bytes at 'addr' into 'buf', 'fill' where nothing was
+ * loaded, returns the number of loaded bytes */
+size_t dis8051_image_read(const struct dis8051_image *img, uint32_t addr,
+                          uint8_t *buf, size_t n, uint8_t fill);
+
+/* first and last loaded address, returns 0 if the image is empty */
+int dis8051_image_range(const struct dis8051_image *img, uint32_t *first,
+                        uint32_t *last);
+
+#endif
@@ -0,0 +1,128 @@
+/* 8051/8052 structured instruction decoder,
+ * independent of radare2 */
+
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-render.h"
+
+static int decode(const struct dis8051_opcode *o, const char *esil,
+                  uint16_t pc, const uint8_t *buf, int len,
+                  struct dis8051_insn *insn)
+{
+	uint16_t next;
+	int i, p;
+
+	if (len < o->size)
+		return 0;
+
+	next = pc + o->size;
+	insn->pc = pc;
+	insn->target = 0;
+	insn->opcode = *buf;
+	insn->mnem = o->mnem;
+	insn->flow = o->flow;
+	insn->size = o->size;
+	insn->esil = esil;
+
+	/* operand bytes follow the opcode in operand order,
+	 * except for mov data addr., data addr. (src first) */
+	for (i = 0, p = 1; i < 3; i++) {
+		insn->opnd[i] = o->opnd[i];
+		insn->val[i] = 0;
+
+		switch (o->opnd[i]) {
+		case DIS8051_OPND_RN:
+			insn->val[i] = *buf & 0x7;
+			break;
+		case DIS8051_OPND_IRI:
+			insn->val[i] = *buf & 0x1;
+			break;
+		case DIS8051_OPND_DIRECT:
+		case DIS8051_OPND_BIT:
+		case DIS8051_OPND_NBIT:
+		case DIS8051_OPND_IMM8:
+			insn->val[i] = buf[p++];
+			break;
+		case DIS8051_OPND_IMM16:
+			insn->val[i] = buf[p]<<8 | buf[p+1];
+			p += 2;
+			break;
+		case DIS8051_OPND_REL:
+			insn->val[i] = next + (int8_t)buf[p++];
+			insn->target = insn->val[i];
+			break;
+		case DIS8051_OPND_ADDR11:
+			insn->val[i] = (next&0xf800) | (*buf&0xe0)<<3 | buf[p++];
+			insn->target = insn->val[i];
+			break;
+		case DIS8051_OPND_ADDR16:
+			insn->val[i] = buf[p]<<8 | buf[p+1];
+			insn->target = insn->val[i];
+			p += 2;
+			break;
+		}
+	}
+
+	if (*buf == 0x85) {
+		insn->val[0] = buf[2];
+		insn->val[1] = buf[1];
+	}
+
+	return o->size;
+}
+
+int dis8051_decode(uint16_t pc, const uint8_t *buf, int len,
+                   struct dis8051_insn *insn)
+{
+	if (len < 1)
+		return 0;
+	return decode(&dis8051_opcodes[*buf], dis8051_esil_templates[*buf],
+	              pc, buf, len, insn);
+}
+
+int dis8051_decode_deriv(const struct dis8051_derivative *d, uint16_t pc,
+                         const uint8_t *buf, int len,
+                         struct dis8051_insn *insn)
+{
+	int i;
+
+	if (len < 1)
+		return 0;
+	for (i = 0; d && i < d->next; i++)
+		if (d->ext[i].opcode == *buf)
+			return decode(&d->ext[i].op, d->ext[i].esil, pc, buf, len,
+			              insn);
+	return dis8051_decode(pc, buf, len, insn);
+}
+
+int dis8051_access(const struct dis8051_insn *insn, int n)
+{
+	if (n > 0) {
+		if (n == 1 && (insn->mnem == DIS8051_XCH ||
+		               insn->mnem == DIS8051_XCHD))
+			return DIS8051_READ | DIS8051_WRITE;
+		return DIS8051_READ;
+	}
+
+	switch (insn->mnem) {
+	/* destination only */
+	case DIS8051_MOV:
+	case DIS8051_MOVC:
+	case DIS8051_MOVX:
+	case DIS8051_POP:
+	case DIS8051_SETB:
+	case DIS8051_CLR:
+		return DIS8051_WRITE;
+
+	/* source only */
+	case DIS8051_PUSH:
+	case DIS8051_JB:
+	case DIS8051_JNB:
+	case DIS8051_CJNE:
+	case DIS8051_JMP:
+		return DIS8051_READ;
+	}
+
+	/* read-modify-write */
+	return DIS8051_READ | DIS8051_WRITE;
+}
@@ -0,0 +1,112 @@
+/* 8051/8052 structured instruction decoder,
+ * independent of radare2; decoding keeps no state and all tables are
+ * const, it is safe to call from any number of threads */
+
+#ifndef DIS8051_INSN_H
+#define DIS8051_INSN_H
+
+#include <stdint.h>
+#include "8051-isa.h"
+
+/* operand kinds */
+enum dis8051_opnd {
+	DIS8051_OPND_NONE,
+	DIS8051_OPND_A,       /* a */
+	DIS8051_OPND_AB,      /* ab */
+	DIS8051_OPND_C,       /* c */
+	DIS8051_OPND_DPTR,    /* dptr */
+	DIS8051_OPND_RN,      /* r0 -- r7 */
+	DIS8051_OPND_IRI,     /* @r0, @r1 */
+	DIS8051_OPND_IDPTR,   /* @dptr */
+	DIS8051_OPND_IADPTR,  /* @a+dptr */
+	DIS8051_OPND_IAPC,    /* @a+pc */
+	DIS8051_OPND_DIRECT,  /* data addr. */
+	DIS8051_OPND_BIT,     /* bit addr. */
+	DIS8051_OPND_NBIT,    /* /bit addr. */
+	DIS8051_OPND_IMM8,    /* #imm */
+	DIS8051_OPND_IMM16,   /* #imm16 */
+	DIS8051_OPND_REL,     /* code addr., relative */
+	DIS8051_OPND_ADDR11,  /* code addr., same 2 KiB page */
+	DIS8051_OPND_ADDR16   /* code addr., absolute */
+};
+
+/* control flow class */
+enum dis8051_flow_class {
+	DIS8051_FLOW_NONE,  /* falls through */
+	DIS8051_FLOW_JMP,   /* unconditional jump */
+	DIS8051_FLOW_CJMP,  /* conditional jump */
+	DIS8051_FLOW_CALL,
+	DIS8051_FLOW_RET,
+	DIS8051_FLOW_RETI,
+	DIS8051_FLOW_IJMP,  /* jmp @a+dptr */
+	DIS8051_FLOW_ILL    /* reserved opcode */
+};
+
+/* SFR addresses used by the analysis passes */
+#define DIS8051_SFR_SP   0x81
+#define DIS8051_SFR_DPL  0x82
+#define DIS8051_SFR_DPH  0x83
+#define DIS8051_SFR_PSW  0xd0
+#define DIS8051_SFR_ACC  0xe0
+#define DIS8051_SFR_B    0xf0
+
+/* operand access, see 'dis8051_access' */
+#define DIS8051_READ  0x1
+#define DIS8051_WRITE 0x2
+
+/* PSW flags written by an instruction */
+#define DIS8051_FLAG_C  0x1
+#define DIS8051_FLAG_AC 0x2
+#define DIS8051_FLAG_OV 0x4
+
+/* static description of an opcode, generated from 8051.isa */
+struct dis8051_opcode {
+	uint8_t mnem;
+	uint8_t flow;
+	uint8_t size;
+	uint8_t cycles;    /* machine cycles */
+	uint8_t flags;     /* DIS8051_FLAG_* */
+	uint8_t opnd[3];
+};
+
+/* opcode a derivative puts into a reserved slot */
+struct dis8051_ext {
+	uint8_t opcode;
+	struct dis8051_opcode op;
+	const char *esil;
+};
+
+struct dis8051_derivative;
+
+extern const struct dis8051_opcode dis8051_opcodes[256];
+extern const char *const dis8051_mnem_names[DIS8051_MNEM_COUNT];
+extern const char *const dis8051_esil_templates[256];
+
+/* decoded instruction */
+struct dis8051_insn {
+	uint16_t pc;
+	uint16_t target;   /* jump/call destination, if any */
+	uint8_t opcode;
+	uint8_t mnem;
+	uint8_t flow;
+	uint8_t size;
+	uint8_t opnd[3];   /* operand kinds */
+	uint16_t val[3];   /* register number, address, immediate or
+	                    * resolved code address of each operand */
+	const char *esil;  /* ESIL template, see 'dis8051_esil' */
+};
+
+/* decode one instruction at 'pc',
+ * returns its size or 0 if 'buf' is too short */
+int dis8051_decode(uint16_t pc, const uint8_t *buf, int len,
+                   struct dis8051_insn *insn);
+
+/* the same with the extra opcodes of derivative 'd', NULL for none */
+int dis8051_decode_deriv(const struct dis8051_derivative *d, uint16_t pc,
+                         const uint8_t *buf, int len,
+                         struct dis8051_insn *insn);
+
+/* DIS8051_READ / DIS8051_WRITE access of operand 'n' */
+int dis8051_access(const struct dis8051_insn *insn, int n);
+
+#endif
@@ -0,0 +1,143 @@
+/* 8051hex:// and 8051omf:// io plugin for radare2, Intel HEX and OMF-51
+ * images for the disassembler */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <r_io.h>
+#include <r_lib.h>
+#include <r_types.h>
+#include "dis8051.h"
+
+#define HEX "8051hex://"
+#define OMF "8051omf://"
+
+/* gaps read as erased flash */
+#define FILL 0xff
+
+struct image {
+	struct dis8051_image img;
+	ut64 off;
+	ut64 size;              /* last loaded address + 1 */
+};
+
+RIOPlugin r_io_plugin_8051;
+
+static bool io_check (RIO *io, const char *file, bool many) {
+	(void)io;
+	(void)many;
+	return !strncmp(file, HEX, strlen(HEX)) ||
+	       !strncmp(file, OMF, strlen(OMF));
+}
+
+/* returns 0 or prints why it did not load */
+static int load (struct dis8051_image *img, const char *file) {
+	struct dis8051_symtab syms;
+	struct dis8051_omf o;
+	unsigned line;
+	int e;
+
+	if (!strncmp(file, HEX, strlen(HEX))) {
+		file += strlen(HEX);
+		if (!(e = dis8051_ihex_load(img, file, &line)))
+			return 0;
+		eprintf("8051hex: %s:%u: %s\n", file, line,
+		        dis8051_ihex_strerror(e));
+		return -1;
+	}
+
+	/* the asm plugin takes the symbols from $DIS8051_SYMBOLS */
+	file += strlen(OMF);
+	dis8051_symtab_init(&syms);
+	dis8051_omf_init(&o, img, &syms);
+	e = dis8051_omf_load_file(&o, file);
+	if (e)
+		eprintf("8051omf: %s: record at 0x%zx: %s\n", file, o.offset,
+		        dis8051_omf_strerror(e));
+	dis8051_omf_free(&o);
+	dis8051_symtab_free(&syms);
+	/* an unsupported record leaves the rest of the image usable */
+	return e && e != DIS8051_OMF_EUNSUPPORTED ? -1 : 0;
+}
+
+static RIODesc *io_open (RIO *io, const char *file, int rw, int mode) {
+	struct image *im;
+	uint32_t first, last;
+
+	if (!io_check(io, file, false))
+		return NULL;
+	if (!(im = R_NEW0(struct image)))
+		return NULL;
+
+	dis8051_image_init(&im->img);
+	if (load(&im->img, file) < 0) {
+		dis8051_image_free(&im->img);
+		free(im);
+		return NULL;
+	}
+	if (dis8051_image_range(&im->img, &first, &last))
+		im->size = (ut64)last + 1;
+	return r_io_desc_new(io, &r_io_plugin_8051, file, rw, mode, im);
+}
+
+static int io_close (RIODesc *fd) {
+	struct image *im = fd->data;
+
+	dis8051_image_free(&im->img);
+	R_FREE(fd->data);
+	return 0;
+}
+
+static int io_read (RIO *io, RIODesc *fd, ut8 *buf, int count) {
+	struct image *im = fd->data;
+
+	(void)io;
+	if (count <= 0 || im->off > UINT32_MAX)
+		return -1;
+	if (im->off + count > (ut64)UINT32_MAX + 1)
+		count = (ut64)UINT32_MAX + 1 - im->off;
+	dis8051_image_read(&im->img, im->off, buf, count, FILL);
+	im->off += count;
+	return count;
+}
+
+static ut64 io_lseek (RIO *io, RIODesc *fd, ut64 offset, int whence) {
+	struct image *im = fd->data;
+
+	(void)io;
+	switch (whence) {
+	case SEEK_SET: im->off = offset; break;
+	case SEEK_CUR: im->off += offset; break;
+	case SEEK_END: im->off = im->size + offset; break;
+	}
+	return im->off;
+}
+
+/* the image is read only */
+static int io_write (RIO *io, RIODesc *fd, const ut8 *buf, int count) {
+	(void)io;
+	(void)fd;
+	(void)buf;
+	(void)count;
+	return -1;
+}
+
+RIOPlugin r_io_plugin_8051 = {
+	.name = "8051",
+	.desc = "8051 images (" HEX "file, " OMF "file), banks at bank:address",
+	.license = "MIT License",
+	.open = &io_open,
+	.close = &io_close,
+	.read = &io_read,
+	.lseek = &io_lseek,
+	.write = &io_write,
+	.check = &io_check
+};
+
+#ifndef CORELIB
+struct r_lib_struct_t radare_plugin = {
+	.type = R_LIB_TYPE_IO,
+	.data = &r_io_plugin_8051
+};
+#endif
@@ -0,0 +1,575 @@
+/* generated by tools/gen-isa.py from 8051.isa, do not edit */
+
+#include <stdint.h>
+#include "8051-insn.h"
+
+const char *const dis8051_mnem_names[DIS8051_MNEM_COUNT] = {
+	"acall", "add", "addc", "ajmp", "anl",
+	"cjne", "clr", "cpl", "da", "dec",
+	"div", "djnz", "inc", "jb", "jbc",
+	"jc", "jmp", "jnb", "jnc", "jnz",
+	"jz", "lcall", "ljmp", "mov", "movc",
+	"movx", "mul", "nop", "orl", "pop",
+	"push", "reserved", "ret", "reti", "rl",
+	"rlc", "rr", "rrc", "setb", "sjmp",
+	"subb", "swap", "trap", "xch", "xchd",
+	"xrl",
+};
+
+#define OP(m, f, s, c, fl, o1, o2, o3) \
+	{DIS8051_##m, DIS8051_FLOW_##f, s, c, fl, \
+	 {DIS8051_OPND_##o1, DIS8051_OPND_##o2, DIS8051_OPND_##o3}}
+
+/* opcode map: mnemonic, control flow, size, cycles, flags written, operands */
+const struct dis8051_opcode dis8051_opcodes[256] = {
+/* 0x00 -- 0x0f */
+	OP(NOP, NONE, 1, 1, 0, NONE, NONE, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(LJMP, JMP, 3, 2, 0, ADDR16, NONE, NONE),
+	OP(RR, NONE, 1, 1, 0, A, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, A, NONE, NONE),
+	OP(INC, NONE, 2, 1, 0, DIRECT, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, IRI, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, IRI, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(INC, NONE, 1, 1, 0, RN, NONE, NONE),
+/* 0x10 -- 0x1f */
+	OP(JBC, CJMP, 3, 2, 0, BIT, REL, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(LCALL, CALL, 3, 2, 0, ADDR16, NONE, NONE),
+	OP(RRC, NONE, 1, 1, DIS8051_FLAG_C, A, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, A, NONE, NONE),
+	OP(DEC, NONE, 2, 1, 0, DIRECT, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, IRI, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, IRI, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+	OP(DEC, NONE, 1, 1, 0, RN, NONE, NONE),
+/* 0x20 -- 0x2f */
+	OP(JB, CJMP, 3, 2, 0, BIT, REL, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(RET, RET, 1, 2, 0, NONE, NONE, NONE),
+	OP(RL, NONE, 1, 1, 0, A, NONE, NONE),
+	OP(ADD, NONE, 2, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IMM8, NONE),
+	OP(ADD, NONE, 2, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, DIRECT, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IRI, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IRI, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADD, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+/* 0x30 -- 0x3f */
+	OP(JNB, CJMP, 3, 2, 0, BIT, REL, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(RETI, RETI, 1, 2, 0, NONE, NONE, NONE),
+	OP(RLC, NONE, 1, 1, DIS8051_FLAG_C, A, NONE, NONE),
+	OP(ADDC, NONE, 2, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IMM8, NONE),
+	OP(ADDC, NONE, 2, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, DIRECT, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IRI, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IRI, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(ADDC, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+/* 0x40 -- 0x4f */
+	OP(JC, CJMP, 2, 2, 0, REL, NONE, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(ORL, NONE, 2, 1, 0, DIRECT, A, NONE),
+	OP(ORL, NONE, 3, 2, 0, DIRECT, IMM8, NONE),
+	OP(ORL, NONE, 2, 1, 0, A, IMM8, NONE),
+	OP(ORL, NONE, 2, 1, 0, A, DIRECT, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ORL, NONE, 1, 1, 0, A, RN, NONE),
+/* 0x50 -- 0x5f */
+	OP(JNC, CJMP, 2, 2, 0, REL, NONE, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(ANL, NONE, 2, 1, 0, DIRECT, A, NONE),
+	OP(ANL, NONE, 3, 2, 0, DIRECT, IMM8, NONE),
+	OP(ANL, NONE, 2, 1, 0, A, IMM8, NONE),
+	OP(ANL, NONE, 2, 1, 0, A, DIRECT, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(ANL, NONE, 1, 1, 0, A, RN, NONE),
+/* 0x60 -- 0x6f */
+	OP(JZ, CJMP, 2, 2, 0, REL, NONE, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(XRL, NONE, 2, 1, 0, DIRECT, A, NONE),
+	OP(XRL, NONE, 3, 2, 0, DIRECT, IMM8, NONE),
+	OP(XRL, NONE, 2, 1, 0, A, IMM8, NONE),
+	OP(XRL, NONE, 2, 1, 0, A, DIRECT, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XRL, NONE, 1, 1, 0, A, RN, NONE),
+/* 0x70 -- 0x7f */
+	OP(JNZ, CJMP, 2, 2, 0, REL, NONE, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(ORL, NONE, 2, 2, DIS8051_FLAG_C, C, BIT, NONE),
+	OP(JMP, IJMP, 1, 2, 0, IADPTR, NONE, NONE),
+	OP(MOV, NONE, 2, 1, 0, A, IMM8, NONE),
+	OP(MOV, NONE, 3, 2, 0, DIRECT, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, IRI, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, IRI, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+	OP(MOV, NONE, 2, 1, 0, RN, IMM8, NONE),
+/* 0x80 -- 0x8f */
+	OP(SJMP, JMP, 2, 2, 0, REL, NONE, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(ANL, NONE, 2, 2, DIS8051_FLAG_C, C, BIT, NONE),
+	OP(MOVC, NONE, 1, 2, 0, A, IAPC, NONE),
+	OP(DIV, NONE, 1, 4, DIS8051_FLAG_C|DIS8051_FLAG_OV, AB, NONE, NONE),
+	OP(MOV, NONE, 3, 2, 0, DIRECT, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, IRI, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, IRI, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+	OP(MOV, NONE, 2, 2, 0, DIRECT, RN, NONE),
+/* 0x90 -- 0x9f */
+	OP(MOV, NONE, 3, 2, 0, DPTR, IMM16, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(MOV, NONE, 2, 2, 0, BIT, C, NONE),
+	OP(MOVC, NONE, 1, 2, 0, A, IADPTR, NONE),
+	OP(SUBB, NONE, 2, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IMM8, NONE),
+	OP(SUBB, NONE, 2, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, DIRECT, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IRI, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, IRI, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+	OP(SUBB, NONE, 1, 1, DIS8051_FLAG_C|DIS8051_FLAG_AC|DIS8051_FLAG_OV, A, RN, NONE),
+/* 0xa0 -- 0xaf */
+	OP(ORL, NONE, 2, 2, DIS8051_FLAG_C, C, NBIT, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(MOV, NONE, 2, 1, DIS8051_FLAG_C, C, BIT, NONE),
+	OP(INC, NONE, 1, 2, 0, DPTR, NONE, NONE),
+	OP(MUL, NONE, 1, 4, DIS8051_FLAG_C|DIS8051_FLAG_OV, AB, NONE, NONE),
+	OP(RESERVED, ILL, 1, 1, 0, NONE, NONE, NONE),
+	OP(MOV, NONE, 2, 2, 0, IRI, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, IRI, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+	OP(MOV, NONE, 2, 2, 0, RN, DIRECT, NONE),
+/* 0xb0 -- 0xbf */
+	OP(ANL, NONE, 2, 2, DIS8051_FLAG_C, C, NBIT, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(CPL, NONE, 2, 1, 0, BIT, NONE, NONE),
+	OP(CPL, NONE, 1, 1, DIS8051_FLAG_C, C, NONE, NONE),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, A, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, A, DIRECT, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, IRI, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, IRI, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+	OP(CJNE, CJMP, 3, 2, DIS8051_FLAG_C, RN, IMM8, REL),
+/* 0xc0 -- 0xcf */
+	OP(PUSH, NONE, 2, 2, 0, DIRECT, NONE, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(CLR, NONE, 2, 1, 0, BIT, NONE, NONE),
+	OP(CLR, NONE, 1, 1, DIS8051_FLAG_C, C, NONE, NONE),
+	OP(SWAP, NONE, 1, 1, 0, A, NONE, NONE),
+	OP(XCH, NONE, 2, 1, 0, A, DIRECT, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+	OP(XCH, NONE, 1, 1, 0, A, RN, NONE),
+/* 0xd0 -- 0xdf */
+	OP(POP, NONE, 2, 2, 0, DIRECT, NONE, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(SETB, NONE, 2, 1, 0, BIT, NONE, NONE),
+	OP(SETB, NONE, 1, 1, DIS8051_FLAG_C, C, NONE, NONE),
+	OP(DA, NONE, 1, 1, DIS8051_FLAG_C, A, NONE, NONE),
+	OP(DJNZ, CJMP, 3, 2, 0, DIRECT, REL, NONE),
+	OP(XCHD, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(XCHD, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+	OP(DJNZ, CJMP, 2, 2, 0, RN, REL, NONE),
+/* 0xe0 -- 0xef */
+	OP(MOVX, NONE, 1, 2, 0, A, IDPTR, NONE),
+	OP(AJMP, JMP, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(MOVX, NONE, 1, 2, 0, A, IRI, NONE),
+	OP(MOVX, NONE, 1, 2, 0, A, IRI, NONE),
+	OP(CLR, NONE, 1, 1, 0, A, NONE, NONE),
+	OP(MOV, NONE, 2, 1, 0, A, DIRECT, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, IRI, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+	OP(MOV, NONE, 1, 1, 0, A, RN, NONE),
+/* 0xf0 -- 0xff */
+	OP(MOVX, NONE, 1, 2, 0, IDPTR, A, NONE),
+	OP(ACALL, CALL, 2, 2, 0, ADDR11, NONE, NONE),
+	OP(MOVX, NONE, 1, 2, 0, IRI, A, NONE),
+	OP(MOVX, NONE, 1, 2, 0, IRI, A, NONE),
+	OP(CPL, NONE, 1, 1, 0, A, NONE, NONE),
+	OP(MOV, NONE, 2, 1, 0, DIRECT, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, IRI, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, IRI, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+	OP(MOV, NONE, 1, 1, 0, RN, A, NONE),
+};
+
+#undef OP
+
+/* ESIL templates, see 'dis8051_esil' */
+const char *const dis8051_esil_templates[256] = {
+/* 0x00 -- 0x0f */
+	"",
+	"{0},pc,=",
+	"{0},pc,=",
+	"1,a,>>,7,a,<<,|,0xff,&,a,=",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+	"1,{0},+,0xff,&,{=0}",
+/* 0x10 -- 0x1f */
+	"{0},?{,0,{=0},{1},pc,=,}",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"1,a,&,1,a,>>,7,c,<<,|,a,=,c,=",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+	"1,{0},-,0xff,&,{=0}",
+/* 0x20 -- 0x2f */
+	"{0},?{,{1},pc,=,}",
+	"{0},pc,=",
+	"8,sp,_idata,+,[1],<<,1,sp,-=,sp,_idata,+,[1],|,1,sp,-=,pc,=",
+	"7,a,>>,1,a,<<,|,0xff,&,a,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+	"{1},a,+=,$c7,c,=",
+/* 0x30 -- 0x3f */
+	"{0},!,?{,{1},pc,=,}",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"8,sp,_idata,+,[1],<<,1,sp,-=,sp,_idata,+,[1],|,1,sp,-=,pc,=",
+	"7,a,>>,c,1,a,<<,|,0xff,&,a,=,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+	"c,{1},+,a,+=,$c7,c,=",
+/* 0x40 -- 0x4f */
+	"c,?{,{0},pc,=,}",
+	"{0},pc,=",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+	"{1},{0},|,{=0}",
+/* 0x50 -- 0x5f */
+	"c,!,?{,{0},pc,=,}",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+	"{1},{0},&,{=0}",
+/* 0x60 -- 0x6f */
+	"a,!,?{,{0},pc,=,}",
+	"{0},pc,=",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+	"{1},{0},^,{=0}",
+/* 0x70 -- 0x7f */
+	"a,?{,{0},pc,=,}",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"{1},c,|=",
+	"a,dptr,+,pc,=",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+/* 0x80 -- 0x8f */
+	"{0},pc,=",
+	"{0},pc,=",
+	"{1},c,&=",
+	"{1},a,=",
+	"b,a,/,b,a,%,b,=,a,=,0,c,=",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+/* 0x90 -- 0x9f */
+	"{1},{=0}",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"{1},{=0}",
+	"{1},a,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+	"c,{1},+,a,-=,$b8,c,=",
+/* 0xa0 -- 0xaf */
+	"{1},!,c,|=",
+	"{0},pc,=",
+	"{1},{=0}",
+	"1,dptr,+=",
+	"b,a,*,0xff,&,8,b,a,*,>>,b,=,a,=,0,c,=",
+	"",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+/* 0xb0 -- 0xbf */
+	"{1},!,c,&=",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"{0},!,{=0}",
+	"{0},!,{=0}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+	"{1},{0},<,c,=,{1},{0},-,?{,{2},pc,=,}",
+/* 0xc0 -- 0xcf */
+	"1,sp,+=,{0},sp,_idata,+,=[1]",
+	"{0},pc,=",
+	"0,{=0}",
+	"0,{=0}",
+	"4,a,>>,4,a,<<,|,0xff,&,a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+	"{1},a,{=1},a,=",
+/* 0xd0 -- 0xdf */
+	"sp,_idata,+,[1],{=0},1,sp,-=",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"1,{=0}",
+	"1,{=0}",
+	"9,a,0x0f,&,>,ac,|,?{,6,a,+=,},0x99,a,>,c,|,?{,0x60,a,+=,1,c,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"{1},0xf0,&,a,0x0f,&,|,{1},0x0f,&,a,0xf0,&,|,a,=,{=1}",
+	"{1},0xf0,&,a,0x0f,&,|,{1},0x0f,&,a,0xf0,&,|,a,=,{=1}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+	"1,{0},-,0xff,&,{=0},{0},?{,{1},pc,=,}",
+/* 0xe0 -- 0xef */
+	"{x1},[1],a,=",
+	"{0},pc,=",
+	"{x1},[1],a,=",
+	"{x1},[1],a,=",
+	"0,{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+/* 0xf0 -- 0xff */
+	"a,{x0},=[1]",
+	"1,sp,+=,pc,0xff,&,sp,_idata,+,=[1],1,sp,+=,8,pc,>>,sp,_idata,+,=[1],{0},pc,=",
+	"a,{x0},=[1]",
+	"a,{x0},=[1]",
+	"0xff,a,^=",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+	"{1},{=0}",
+};
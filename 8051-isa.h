@@ -0,0 +1,25 @@
+/* generated by tools/gen-isa.py from 8051.isa and 8051.sfr, do not edit */
+
+#ifndef DIS8051_ISA_H
+#define DIS8051_ISA_H
+
+/* mnemonics */
+enum dis8051_mnem {
+	DIS8051_ACALL, DIS8051_ADD, DIS8051_ADDC, DIS8051_AJMP, DIS8051_ANL,
+	DIS8051_CJNE, DIS8051_CLR, DIS8051_CPL, DIS8051_DA, DIS8051_DEC,
+	DIS8051_DIV, DIS8051_DJNZ, DIS8051_INC, DIS8051_JB, DIS8051_JBC,
+	DIS8051_JC, DIS8051_JMP, DIS8051_JNB, DIS8051_JNC, DIS8051_JNZ,
+	DIS8051_JZ, DIS8051_LCALL, DIS8051_LJMP, DIS8051_MOV, DIS8051_MOVC,
+	DIS8051_MOVX, DIS8051_MUL, DIS8051_NOP, DIS8051_ORL, DIS8051_POP,
+	DIS8051_PUSH, DIS8051_RESERVED, DIS8051_RET, DIS8051_RETI, DIS8051_RL,
+	DIS8051_RLC, DIS8051_RR, DIS8051_RRC, DIS8051_SETB, DIS8051_SJMP,
+	DIS8051_SUBB, DIS8051_SWAP, DIS8051_TRAP, DIS8051_XCH, DIS8051_XCHD,
+	DIS8051_XRL,
+	DIS8051_MNEM_COUNT
+};
+
+/* derivatives, see 'dis8051_derivative' */
+#define DIS8051_DERIVS 10
+#define DIS8051_DERIV_NAMES "8052,8051,at89s52,ds89c450,c8051f3xx,cc2530,nrf24le1,n76e003,stc15,c8051f12x"
+
+#endif
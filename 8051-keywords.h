@@ -0,0 +1,803 @@
+/* generated by tools/gen-isa.py from 8051.isa and 8051.sfr, do not edit */
+
+#ifndef DIS8051_KEYWORDS_H
+#define DIS8051_KEYWORDS_H
+
+#define KW_SLOTS 512
+#define KW_BUCKETS 128
+
+/* displacement of each bucket, see 'kw_lookup' */
+static const uint16_t kw_disp[KW_BUCKETS] = {
+	0, 1, 2, 2, 1, 1, 1, 1, 2, 1,
+	1, 1, 0, 1, 0, 2, 1, 0, 1, 1,
+	2, 0, 0, 2, 1, 1, 1, 1, 0, 2,
+	1, 2, 0, 0, 0, 1, 1, 1, 0, 0,
+	1, 2, 2, 1, 1, 2, 1, 0, 0, 1,
+	1, 1, 1, 1, 1, 1, 1, 0, 1, 1,
+	0, 2, 1, 1, 1, 1, 0, 0, 1, 0,
+	0, 3, 1, 1, 1, 1, 2, 5, 2, 1,
+	3, 1, 1, 1, 1, 1, 1, 2, 0, 2,
+	0, 0, 1, 2, 1, 1, 2, 1, 0, 1,
+	1, 1, 1, 1, 1, 3, 1, 0, 2, 0,
+	1, 2, 0, 1, 0, 1, 1, 1, 1, 1,
+	1, 1, 1, 1, 0, 3, 2, 0,
+};
+
+static const struct keyword kw_table[KW_SLOTS] = {
+	[0] = {"swap", 4, KW_MNEM, DIS8051_SWAP},
+	[2] = {"mul", 3, KW_MNEM, DIS8051_MUL},
+	[4] = {"p0", 2, KW_SFR, 0x80},
+	[5] = {"b.3", 3, KW_BIT, 0xf3},
+	[8] = {"th0", 3, KW_SFR, 0x8c},
+	[10] = {"p1.5", 4, KW_BIT, 0x95},
+	[13] = {"dptr", 4, KW_REG, DIS8051_OPND_DPTR},
+	[15] = {"orl", 3, KW_MNEM, DIS8051_ORL},
+	[16] = {"r2", 2, KW_REG, DIS8051_OPND_RN | 2<<8},
+	[18] = {"rclk", 4, KW_BIT, 0xcd},
+	[20] = {"tmod", 4, KW_SFR, 0x89},
+	[24] = {"scon", 4, KW_SFR, 0x98},
+	[26] = {"reserved", 8, KW_MNEM, DIS8051_RESERVED},
+	[29] = {"tl0", 3, KW_SFR, 0x8a},
+	[32] = {"ex1", 3, KW_BIT, 0xaa},
+	[34] = {"movx", 4, KW_MNEM, DIS8051_MOVX},
+	[37] = {"pop", 3, KW_MNEM, DIS8051_POP},
+	[38] = {"b.6", 3, KW_BIT, 0xf6},
+	[42] = {"@a+dptr", 7, KW_REG, DIS8051_OPND_IADPTR},
+	[43] = {"p1.2", 4, KW_BIT, 0x92},
+	[46] = {"r5", 2, KW_REG, DIS8051_OPND_RN | 5<<8},
+	[50] = {"exf2", 4, KW_BIT, 0xce},
+	[52] = {"p2.0", 4, KW_BIT, 0xa0},
+	[53] = {"reti", 4, KW_MNEM, DIS8051_RETI},
+	[54] = {"psw.1", 5, KW_BIT, 0xd1},
+	[57] = {"xchd", 4, KW_MNEM, DIS8051_XCHD},
+	[60] = {"acc.5", 5, KW_BIT, 0xe5},
+	[62] = {"inc", 3, KW_MNEM, DIS8051_INC},
+	[64] = {"tf0", 3, KW_BIT, 0x8d},
+	[65] = {"p3.2", 4, KW_BIT, 0xb2},
+	[66] = {"@dptr", 5, KW_REG, DIS8051_OPND_IDPTR},
+	[72] = {"acc.2", 5, KW_BIT, 0xe2},
+	[74] = {"cp/t2", 5, KW_BIT, 0xc9},
+	[76] = {"exen2", 5, KW_BIT, 0xcb},
+	[79] = {"acall", 5, KW_MNEM, DIS8051_ACALL},
+	[80] = {"trap", 4, KW_MNEM, DIS8051_TRAP},
+	[82] = {"b", 1, KW_SFR, 0xf0},
+	[84] = {"dpl", 3, KW_SFR, 0x82},
+	[86] = {"ea", 2, KW_BIT, 0xaf},
+	[89] = {"cpl", 3, KW_MNEM, DIS8051_CPL},
+	[92] = {"r6", 2, KW_REG, DIS8051_OPND_RN | 6<<8},
+	[96] = {"ajmp", 4, KW_MNEM, DIS8051_AJMP},
+	[101] = {"ip", 2, KW_SFR, 0xb8},
+	[106] = {"p0.0", 4, KW_BIT, 0x80},
+	[107] = {"pt1", 3, KW_BIT, 0xbb},
+	[111] = {"et0", 3, KW_BIT, 0xa9},
+	[114] = {"b.2", 3, KW_BIT, 0xf2},
+	[119] = {"p1.6", 4, KW_BIT, 0x96},
+	[125] = {"jnc", 3, KW_MNEM, DIS8051_JNC},
+	[134] = {"xch", 3, KW_MNEM, DIS8051_XCH},
+	[138] = {"tcon", 4, KW_SFR, 0x88},
+	[139] = {"p0.7", 4, KW_BIT, 0x87},
+	[141] = {"p3.6", 4, KW_BIT, 0xb6},
+	[147] = {"b.5", 3, KW_BIT, 0xf5},
+	[148] = {"cy", 2, KW_BIT, 0xd7},
+	[149] = {"acc", 3, KW_SFR, 0xe0},
+	[155] = {"sm1", 3, KW_BIT, 0x9e},
+	[156] = {"tr2", 3, KW_BIT, 0xca},
+	[161] = {"p2.7", 4, KW_BIT, 0xa7},
+	[169] = {"rs0", 3, KW_BIT, 0xd3},
+	[174] = {"p3.3", 4, KW_BIT, 0xb3},
+	[176] = {"jz", 2, KW_MNEM, DIS8051_JZ},
+	[177] = {"@r1", 3, KW_REG, DIS8051_OPND_IRI | 1<<8},
+	[180] = {"jb", 2, KW_MNEM, DIS8051_JB},
+	[186] = {"xrl", 3, KW_MNEM, DIS8051_XRL},
+	[189] = {"p3", 2, KW_SFR, 0xb0},
+	[191] = {"a", 1, KW_REG, DIS8051_OPND_A},
+	[201] = {"r1", 2, KW_REG, DIS8051_OPND_RN | 1<<8},
+	[204] = {"subb", 4, KW_MNEM, DIS8051_SUBB},
+	[208] = {"rr", 2, KW_MNEM, DIS8051_RR},
+	[215] = {"p0.3", 4, KW_BIT, 0x83},
+	[216] = {"pt0", 3, KW_BIT, 0xb9},
+	[220] = {"et1", 3, KW_BIT, 0xab},
+	[223] = {"tl1", 3, KW_SFR, 0x8b},
+	[228] = {"p1.7", 4, KW_BIT, 0x97},
+	[230] = {"th1", 3, KW_SFR, 0x8d},
+	[231] = {"div", 3, KW_MNEM, DIS8051_DIV},
+	[233] = {"nop", 3, KW_MNEM, DIS8051_NOP},
+	[234] = {"jnb", 3, KW_MNEM, DIS8051_JNB},
+	[236] = {"jnz", 3, KW_MNEM, DIS8051_JNZ},
+	[237] = {"ie.6", 4, KW_BIT, 0xae},
+	[238] = {"mov", 3, KW_MNEM, DIS8051_MOV},
+	[241] = {"ri", 2, KW_BIT, 0x98},
+	[245] = {"acc.6", 5, KW_BIT, 0xe6},
+	[247] = {"tl2", 3, KW_SFR, 0xcc},
+	[248] = {"it1", 3, KW_BIT, 0x8a},
+	[250] = {"p3.7", 4, KW_BIT, 0xb7},
+	[256] = {"b.4", 3, KW_BIT, 0xf4},
+	[257] = {"acc.1", 5, KW_BIT, 0xe1},
+	[258] = {"f0", 2, KW_BIT, 0xd5},
+	[259] = {"ret", 3, KW_MNEM, DIS8051_RET},
+	[260] = {"cjne", 4, KW_MNEM, DIS8051_CJNE},
+	[264] = {"sm0", 3, KW_BIT, 0x9f},
+	[269] = {"djnz", 4, KW_MNEM, DIS8051_DJNZ},
+	[270] = {"p2.6", 4, KW_BIT, 0xa6},
+	[275] = {"da", 2, KW_MNEM, DIS8051_DA},
+	[277] = {"p", 1, KW_BIT, 0xd0},
+	[278] = {"rs1", 3, KW_BIT, 0xd4},
+	[283] = {"p3.0", 4, KW_BIT, 0xb0},
+	[286] = {"@r0", 3, KW_REG, DIS8051_OPND_IRI | 0<<8},
+	[291] = {"ac", 2, KW_BIT, 0xd6},
+	[298] = {"p2", 2, KW_SFR, 0xa0},
+	[302] = {"th2", 3, KW_SFR, 0xcd},
+	[310] = {"r0", 2, KW_REG, DIS8051_OPND_RN | 0<<8},
+	[318] = {"it0", 3, KW_BIT, 0x88},
+	[323] = {"ljmp", 4, KW_MNEM, DIS8051_LJMP},
+	[324] = {"p0.2", 4, KW_BIT, 0x82},
+	[330] = {"setb", 4, KW_MNEM, DIS8051_SETB},
+	[332] = {"b.0", 3, KW_BIT, 0xf0},
+	[337] = {"p1.0", 4, KW_BIT, 0x90},
+	[338] = {"px1", 3, KW_BIT, 0xba},
+	[340] = {"addc", 4, KW_MNEM, DIS8051_ADDC},
+	[341] = {"tr1", 3, KW_BIT, 0x8e},
+	[344] = {"lcall", 5, KW_MNEM, DIS8051_LCALL},
+	[346] = {"p2.2", 4, KW_BIT, 0xa2},
+	[349] = {"tf2", 3, KW_BIT, 0xcf},
+	[350] = {"es", 2, KW_BIT, 0xac},
+	[351] = {"p3.1", 4, KW_BIT, 0xb1},
+	[354] = {"acc.7", 5, KW_BIT, 0xe7},
+	[356] = {"rcap2l", 6, KW_SFR, 0xca},
+	[357] = {"ip.6", 4, KW_BIT, 0xbe},
+	[363] = {"rlc", 3, KW_MNEM, DIS8051_RLC},
+	[370] = {"sbuf", 4, KW_SFR, 0x99},
+	[372] = {"dec", 3, KW_MNEM, DIS8051_DEC},
+	[374] = {"b.1", 3, KW_BIT, 0xf1},
+	[379] = {"p2.5", 4, KW_BIT, 0xa5},
+	[383] = {"psw", 3, KW_SFR, 0xd0},
+	[384] = {"p3.4", 4, KW_BIT, 0xb4},
+	[386] = {"r4", 2, KW_REG, DIS8051_OPND_RN | 4<<8},
+	[387] = {"acc.0", 5, KW_BIT, 0xe0},
+	[389] = {"ie1", 3, KW_BIT, 0x8b},
+	[390] = {"p2.3", 4, KW_BIT, 0xa3},
+	[393] = {"tf1", 3, KW_BIT, 0x8f},
+	[399] = {"p1.3", 4, KW_BIT, 0x93},
+	[401] = {"ren", 3, KW_BIT, 0x9c},
+	[402] = {"ps", 2, KW_BIT, 0xbc},
+	[404] = {"px0", 3, KW_BIT, 0xb8},
+	[405] = {"et2", 3, KW_BIT, 0xad},
+	[407] = {"p1", 2, KW_SFR, 0x90},
+	[409] = {"dph", 3, KW_SFR, 0x83},
+	[411] = {"clr", 3, KW_MNEM, DIS8051_CLR},
+	[413] = {"p1.4", 4, KW_BIT, 0x94},
+	[417] = {"jbc", 3, KW_MNEM, DIS8051_JBC},
+	[419] = {"r3", 2, KW_REG, DIS8051_OPND_RN | 3<<8},
+	[426] = {"rl", 2, KW_MNEM, DIS8051_RL},
+	[427] = {"jc", 2, KW_MNEM, DIS8051_JC},
+	[431] = {"jmp", 3, KW_MNEM, DIS8051_JMP},
+	[433] = {"p0.5", 4, KW_BIT, 0x85},
+	[435] = {"ex0", 3, KW_BIT, 0xa8},
+	[436] = {"cp/rl2", 6, KW_BIT, 0xc8},
+	[438] = {"ie", 2, KW_SFR, 0xa8},
+	[439] = {"sjmp", 4, KW_MNEM, DIS8051_SJMP},
+	[441] = {"b.7", 3, KW_BIT, 0xf7},
+	[442] = {"tlck", 4, KW_BIT, 0xcc},
+	[443] = {"pcon", 4, KW_SFR, 0x87},
+	[445] = {"anl", 3, KW_MNEM, DIS8051_ANL},
+	[446] = {"p1.1", 4, KW_BIT, 0x91},
+	[447] = {"add", 3, KW_MNEM, DIS8051_ADD},
+	[450] = {"tr0", 3, KW_BIT, 0x8c},
+	[451] = {"sm2", 3, KW_BIT, 0x9d},
+	[453] = {"ov", 2, KW_BIT, 0xd2},
+	[454] = {"rcap2h", 6, KW_SFR, 0xcb},
+	[455] = {"p2.1", 4, KW_BIT, 0xa1},
+	[457] = {"rrc", 3, KW_MNEM, DIS8051_RRC},
+	[458] = {"tb8", 3, KW_BIT, 0x9b},
+	[463] = {"acc.4", 5, KW_BIT, 0xe4},
+	[466] = {"ip.7", 4, KW_BIT, 0xbf},
+	[467] = {"push", 4, KW_MNEM, DIS8051_PUSH},
+	[468] = {"p3.5", 4, KW_BIT, 0xb5},
+	[469] = {"p0.4", 4, KW_BIT, 0x84},
+	[471] = {"call", 4, KW_MNEM, KW_CALL},
+	[474] = {"p0.6", 4, KW_BIT, 0x86},
+	[475] = {"acc.3", 5, KW_BIT, 0xe3},
+	[477] = {"rb8", 3, KW_BIT, 0x9a},
+	[480] = {"ti", 2, KW_BIT, 0x99},
+	[484] = {"@a+pc", 5, KW_REG, DIS8051_OPND_IAPC},
+	[485] = {"c", 1, KW_REG, DIS8051_OPND_C},
+	[487] = {"ab", 2, KW_REG, DIS8051_OPND_AB},
+	[488] = {"p2.4", 4, KW_BIT, 0xa4},
+	[495] = {"r7", 2, KW_REG, DIS8051_OPND_RN | 7<<8},
+	[498] = {"ie0", 3, KW_BIT, 0x89},
+	[503] = {"movc", 4, KW_MNEM, DIS8051_MOVC},
+	[506] = {"t2con", 5, KW_SFR, 0xc8},
+	[509] = {"p0.1", 4, KW_BIT, 0x81},
+	[510] = {"pt2", 3, KW_BIT, 0xbd},
+	[511] = {"sp", 2, KW_SFR, 0x81},
+};
+
+/* SFR and bit names of each derivative, then of each of its SFR pages,
+ * see 'names_lookup' */
+static const uint16_t names_disp[731] = {
+	15, 10, 2, 3, 5, 2, 6, 6, 3, 8,
+	26, 1, 17, 1, 10, 7, 9, 1, 7, 2,
+	3, 1, 4, 2, 4, 66, 0, 1, 29, 41,
+	1, 11, 8, 0, 1, 28, 17, 2, 8, 1,
+	6, 0, 5, 2, 3, 2, 6, 7, 7, 3,
+	10, 1, 15, 1, 20, 6, 16, 10, 5, 0,
+	39, 1, 2, 3, 2, 3, 8, 1, 1, 20,
+	1, 3, 3, 9, 13, 3, 5, 1, 3, 2,
+	1, 5, 6, 1, 20, 6, 1, 33, 7, 28,
+	7, 5, 2, 10, 1, 2, 12, 2, 9, 29,
+	1, 5, 10, 2, 16, 14, 10, 1, 1, 1,
+	1, 28, 3, 3, 47, 1, 3, 12, 5, 24,
+	10, 4, 5, 2, 20, 9, 21, 89, 3, 12,
+	2, 4, 6, 11, 1, 1, 17, 8, 12, 2,
+	1, 6, 5, 2, 3, 1, 23, 4, 4, 1,
+	16, 3, 8, 13, 0, 1, 9, 2, 12, 1,
+	1, 14, 9, 6, 10, 1, 1, 16, 6, 5,
+	13, 2, 15, 10, 3, 1, 1, 4, 13, 1,
+	5, 0, 34, 2, 2, 2, 2, 16, 2, 14,
+	1, 2, 1, 1, 1, 42, 4, 11, 16, 15,
+	1, 15, 6, 5, 2, 21, 1, 1, 6, 2,
+	13, 1, 12, 2, 9, 5, 1, 1, 2, 9,
+	13, 2, 4, 9, 1, 18, 2, 15, 11, 4,
+	3, 4, 6, 6, 13, 2, 9, 31, 11, 9,
+	3, 16, 1, 1, 3, 7, 6, 13, 3, 11,
+	3, 6, 1, 5, 11, 4, 5, 1, 3, 7,
+	9, 1, 8, 6, 9, 5, 5, 5, 5, 5,
+	3, 11, 2, 2, 3, 1, 8, 5, 1, 1,
+	3, 1, 1, 4, 29, 6, 8, 14, 1, 2,
+	1, 1, 1, 1, 9, 37, 4, 7, 2, 15,
+	5, 9, 1, 13, 2, 2, 1, 18, 12, 1,
+	1, 5, 3, 1, 2, 19, 13, 22, 6, 9,
+	5, 1, 7, 26, 1, 7, 15, 11, 4, 1,
+	1, 2, 6, 1, 1, 3, 4, 9, 1, 4,
+	11, 4, 4, 7, 1, 8, 45, 17, 2, 5,
+	2, 6, 10, 1, 1, 2, 1, 1, 1, 25,
+	5, 5, 6, 1, 2, 2, 2, 3, 37, 9,
+	3, 1, 12, 1, 1, 2, 6, 8, 34, 1,
+	3, 5, 3, 6, 3, 1, 4, 1, 57, 2,
+	40, 1, 21, 15, 18, 1, 27, 1, 11, 1,
+	17, 13, 35, 1, 1, 1, 12, 14, 1, 1,
+	5, 4, 6, 18, 12, 10, 2, 3, 1, 7,
+	1, 10, 7, 5, 23, 15, 0, 3, 8, 53,
+	2, 6, 5, 2, 5, 16, 2, 6, 1, 5,
+	13, 2, 3, 9, 4, 1, 1, 3, 2, 1,
+	9, 2, 6, 25, 9, 1, 5, 4, 1, 3,
+	3, 5, 13, 5, 2, 3, 16, 4, 18, 3,
+	2, 10, 6, 10, 4, 8, 1, 7, 3, 4,
+	1, 9, 2, 10, 5, 1, 1, 5, 4, 2,
+	9, 4, 2, 5, 5, 10, 1, 4, 14, 4,
+	1, 22, 11, 1, 6, 3, 14, 7, 14, 1,
+	1, 4, 15, 9, 7, 12, 4, 3, 2, 18,
+	16, 3, 3, 1, 2, 2, 0, 13, 27, 14,
+	5, 1, 1, 3, 4, 5, 1, 3, 5, 1,
+	2, 5, 5, 5, 16, 5, 20, 3, 4, 2,
+	3, 1, 9, 1, 7, 18, 16, 12, 21, 27,
+	9, 2, 17, 1, 4, 11, 1, 3, 1, 4,
+	3, 2, 7, 17, 1, 2, 80, 0, 4, 29,
+	7, 4, 2, 16, 2, 6, 6, 1, 6, 1,
+	14, 3, 8, 4, 1, 8, 13, 5, 1, 1,
+	5, 4, 3, 10, 22, 10, 3, 4, 1, 14,
+	9, 1, 8, 1, 7, 20, 13, 19, 13, 3,
+	22, 27, 13, 6, 2, 3, 20, 9, 0, 5,
+	1, 1, 24, 7, 5, 1, 2, 8, 26, 7,
+	1, 4, 1, 2, 32, 2, 6, 2, 2, 1,
+	5, 5, 1, 12, 1, 18, 2, 4, 1, 1,
+	2, 3, 14, 1, 2, 35, 4, 1, 15, 4,
+	18, 3, 1, 8, 28, 4, 13, 9, 1, 2,
+	5, 2, 3, 4, 3, 8, 34, 1, 2, 1,
+	1, 2, 7, 15, 1, 8, 5, 18, 13, 2,
+	5, 29, 2, 2, 14, 10, 4, 5, 1, 27,
+	17, 7, 23, 4, 6, 11, 0, 4, 20, 18,
+	12, 7, 10, 21, 0, 24, 1, 5, 0, 2,
+	44,
+};
+
+/* 0, or 1 + bit<<7 + address - 0x80 */
+static const uint16_t names_slots[4436] = {
+	155, 0, 175, 0, 152, 0, 0, 76, 0, 153,
+	0, 8, 206, 205, 188, 210, 2, 159, 0, 243,
+	0, 164, 213, 77, 139, 204, 171, 242, 185, 151,
+	134, 73, 146, 0, 189, 113, 211, 246, 228, 232,
+	140, 150, 0, 17, 203, 191, 201, 173, 12, 0,
+	241, 0, 182, 154, 13, 131, 0, 157, 3, 174,
+	0, 57, 0, 0, 0, 145, 0, 144, 163, 248,
+	158, 136, 160, 168, 0, 10, 0, 227, 167, 0,
+	178, 132, 0, 0, 177, 170, 49, 0, 162, 0,
+	25, 75, 11, 181, 176, 0, 180, 143, 0, 78,
+	97, 165, 0, 0, 244, 179, 135, 0, 0, 4,
+	0, 138, 0, 0, 187, 149, 9, 133, 1, 0,
+	192, 0, 214, 142, 212, 0, 0, 14, 226, 0,
+	0, 0, 166, 172, 0, 137, 148, 184, 0, 183,
+	147, 33, 0, 208, 0, 207, 202, 129, 231, 0,
+	230, 190, 0, 225, 0, 229, 161, 209, 130, 81,
+	0, 0, 0, 169, 0, 26, 0, 0, 245, 0,
+	156, 215, 216, 41, 247, 0, 0, 0, 141, 186,
+	0, 0, 0, 0, 136, 2, 231, 0, 11, 185,
+	81, 0, 113, 0, 212, 0, 154, 166, 0, 0,
+	0, 12, 0, 213, 230, 151, 214, 162, 0, 0,
+	174, 0, 148, 0, 158, 228, 170, 172, 178, 25,
+	0, 215, 129, 0, 0, 167, 0, 0, 1, 0,
+	132, 144, 41, 0, 180, 14, 4, 163, 211, 0,
+	0, 146, 0, 142, 165, 225, 189, 209, 171, 187,
+	9, 157, 184, 152, 0, 181, 0, 0, 216, 159,
+	138, 169, 0, 0, 248, 153, 0, 131, 0, 97,
+	183, 10, 3, 8, 156, 135, 186, 168, 247, 0,
+	161, 177, 191, 210, 0, 143, 0, 0, 227, 0,
+	0, 190, 0, 140, 182, 0, 241, 57, 0, 226,
+	0, 0, 244, 188, 0, 33, 173, 147, 0, 0,
+	164, 0, 246, 0, 145, 0, 13, 0, 0, 133,
+	0, 242, 160, 0, 0, 175, 192, 243, 149, 0,
+	130, 134, 26, 49, 137, 155, 139, 17, 179, 232,
+	176, 0, 229, 0, 0, 150, 141, 245, 0, 5,
+	172, 174, 0, 0, 0, 0, 201, 184, 130, 158,
+	81, 0, 0, 0, 136, 0, 0, 0, 4, 0,
+	140, 2, 189, 175, 162, 141, 145, 150, 8, 0,
+	210, 0, 0, 182, 155, 216, 0, 228, 180, 0,
+	157, 186, 139, 14, 204, 15, 247, 0, 187, 190,
+	0, 0, 6, 143, 73, 248, 132, 0, 77, 0,
+	33, 0, 25, 177, 188, 78, 75, 0, 0, 113,
+	0, 0, 0, 159, 26, 192, 0, 0, 135, 134,
+	129, 152, 13, 205, 241, 0, 0, 229, 215, 212,
+	146, 97, 0, 0, 0, 0, 208, 144, 214, 243,
+	0, 225, 230, 0, 185, 0, 232, 17, 0, 0,
+	151, 3, 0, 74, 203, 171, 166, 231, 183, 0,
+	154, 138, 12, 156, 169, 0, 131, 178, 179, 170,
+	0, 161, 0, 148, 0, 76, 0, 160, 0, 209,
+	242, 57, 0, 133, 137, 0, 0, 213, 206, 0,
+	202, 191, 164, 176, 147, 245, 211, 9, 39, 35,
+	0, 142, 0, 0, 246, 226, 227, 173, 0, 0,
+	41, 1, 49, 0, 0, 207, 153, 0, 167, 0,
+	165, 168, 0, 181, 10, 244, 11, 163, 0, 149,
+	0, 219, 140, 43, 6, 251, 11, 187, 0, 213,
+	0, 0, 246, 152, 78, 0, 170, 154, 0, 198,
+	242, 137, 30, 0, 196, 252, 0, 145, 0, 160,
+	0, 151, 0, 0, 253, 0, 172, 0, 74, 236,
+	0, 249, 81, 0, 0, 0, 178, 244, 157, 163,
+	203, 155, 70, 211, 234, 0, 0, 0, 193, 13,
+	135, 41, 218, 248, 7, 0, 113, 212, 132, 256,
+	0, 139, 174, 164, 182, 73, 192, 166, 159, 0,
+	138, 240, 14, 69, 162, 222, 26, 97, 215, 87,
+	149, 0, 185, 205, 0, 59, 0, 0, 0, 158,
+	148, 206, 201, 4, 0, 0, 143, 224, 0, 175,
+	232, 239, 129, 156, 235, 0, 10, 0, 0, 169,
+	161, 217, 0, 0, 0, 50, 0, 223, 189, 0,
+	15, 220, 245, 0, 190, 177, 89, 227, 202, 173,
+	184, 0, 176, 183, 134, 130, 194, 231, 228, 136,
+	86, 0, 0, 0, 67, 75, 3, 0, 0, 209,
+	72, 0, 9, 181, 179, 105, 255, 0, 0, 237,
+	197, 142, 0, 230, 76, 58, 0, 207, 0, 0,
+	0, 199, 0, 0, 77, 42, 66, 0, 0, 2,
+	0, 0, 0, 167, 25, 0, 188, 33, 8, 131,
+	238, 121, 0, 216, 0, 0, 5, 141, 254, 133,
+	250, 221, 0, 0, 153, 0, 0, 191, 0, 114,
+	0, 204, 0, 247, 0, 186, 0, 229, 0, 0,
+	225, 18, 200, 0, 49, 233, 150, 65, 241, 226,
+	23, 243, 0, 208, 214, 57, 1, 0, 0, 0,
+	0, 0, 0, 180, 210, 171, 147, 165, 0, 0,
+	0, 0, 17, 168, 0, 0, 146, 144, 195, 12,
+	68, 174, 248, 130, 211, 190, 215, 101, 0, 25,
+	212, 195, 108, 189, 205, 145, 0, 0, 191, 0,
+	0, 106, 208, 0, 0, 0, 24, 0, 136, 75,
+	160, 219, 146, 63, 0, 0, 175, 33, 13, 0,
+	207, 85, 90, 77, 186, 250, 159, 244, 0, 194,
+	185, 0, 132, 76, 0, 0, 164, 0, 9, 232,
+	41, 140, 228, 255, 42, 0, 0, 0, 236, 144,
+	0, 166, 231, 229, 134, 157, 243, 99, 133, 169,
+	0, 0, 65, 0, 209, 170, 0, 0, 141, 119,
+	32, 239, 23, 0, 70, 142, 0, 0, 69, 0,
+	0, 240, 15, 73, 43, 0, 0, 17, 113, 0,
+	0, 11, 103, 66, 89, 122, 1, 0, 105, 107,
+	123, 92, 217, 0, 82, 30, 0, 78, 0, 256,
+	0, 50, 112, 115, 51, 0, 86, 14, 93, 202,
+	225, 0, 198, 216, 109, 235, 16, 0, 226, 131,
+	173, 0, 252, 188, 0, 125, 139, 0, 67, 187,
+	0, 220, 0, 124, 0, 227, 152, 200, 0, 0,
+	165, 114, 138, 0, 224, 162, 21, 0, 0, 10,
+	0, 97, 129, 214, 19, 0, 213, 237, 0, 0,
+	81, 176, 0, 223, 0, 0, 204, 143, 0, 148,
+	0, 0, 12, 39, 197, 37, 155, 245, 0, 150,
+	38, 0, 249, 147, 0, 238, 192, 0, 135, 218,
+	196, 246, 57, 0, 98, 52, 0, 121, 0, 0,
+	199, 153, 62, 156, 222, 0, 61, 0, 28, 56,
+	0, 206, 193, 4, 8, 59, 201, 0, 0, 0,
+	26, 0, 0, 0, 234, 60, 0, 254, 0, 0,
+	247, 251, 0, 0, 128, 137, 241, 149, 0, 0,
+	0, 0, 167, 0, 230, 0, 0, 0, 71, 0,
+	171, 0, 221, 55, 91, 210, 172, 2, 242, 161,
+	203, 151, 168, 20, 0, 253, 3, 0, 233, 0,
+	0, 18, 22, 0, 154, 0, 163, 0, 0, 158,
+	188, 132, 70, 0, 118, 81, 100, 187, 143, 163,
+	131, 0, 160, 106, 174, 0, 0, 134, 0, 152,
+	0, 155, 237, 18, 62, 23, 109, 22, 0, 90,
+	55, 126, 69, 240, 191, 32, 197, 28, 0, 232,
+	0, 150, 173, 4, 0, 59, 144, 0, 226, 60,
+	230, 0, 0, 172, 242, 9, 0, 0, 221, 0,
+	83, 189, 0, 0, 0, 76, 145, 0, 199, 0,
+	7, 157, 0, 58, 120, 119, 198, 0, 38, 247,
+	51, 74, 244, 5, 94, 0, 75, 53, 146, 0,
+	1, 0, 246, 105, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 241, 0, 154, 186, 93, 228,
+	88, 135, 0, 77, 149, 0, 114, 89, 8, 63,
+	79, 249, 36, 166, 111, 65, 0, 78, 169, 34,
+	50, 220, 190, 0, 124, 85, 103, 234, 0, 0,
+	0, 256, 141, 107, 170, 0, 29, 0, 231, 0,
+	0, 95, 6, 61, 0, 82, 0, 194, 255, 0,
+	0, 104, 0, 140, 159, 167, 0, 67, 39, 115,
+	33, 0, 0, 47, 0, 148, 251, 16, 127, 252,
+	30, 212, 125, 0, 110, 19, 161, 17, 0, 158,
+	121, 45, 250, 0, 253, 176, 245, 0, 2, 227,
+	0, 27, 0, 40, 216, 123, 0, 68, 248, 222,
+	0, 64, 0, 209, 0, 122, 0, 214, 0, 0,
+	117, 46, 10, 238, 162, 133, 0, 139, 175, 42,
+	0, 31, 165, 137, 0, 136, 99, 97, 0, 0,
+	0, 72, 0, 218, 0, 21, 71, 196, 0, 0,
+	195, 224, 0, 12, 0, 0, 192, 0, 0, 96,
+	0, 235, 102, 0, 233, 48, 0, 0, 108, 0,
+	200, 52, 217, 54, 168, 138, 116, 0, 57, 84,
+	66, 0, 229, 236, 147, 130, 0, 215, 0, 171,
+	92, 225, 193, 211, 0, 128, 20, 0, 164, 0,
+	91, 185, 0, 0, 156, 14, 113, 0, 0, 25,
+	210, 11, 0, 35, 243, 98, 44, 0, 0, 112,
+	0, 41, 129, 0, 239, 0, 219, 0, 0, 101,
+	142, 13, 151, 0, 0, 0, 0, 86, 3, 24,
+	223, 0, 213, 0, 0, 0, 37, 80, 87, 153,
+	254, 0, 0, 89, 13, 0, 230, 110, 232, 164,
+	85, 9, 0, 75, 199, 240, 205, 82, 180, 0,
+	214, 97, 142, 0, 81, 125, 0, 78, 131, 74,
+	148, 219, 11, 167, 0, 0, 222, 187, 65, 184,
+	0, 0, 207, 111, 0, 231, 0, 194, 0, 144,
+	94, 185, 0, 48, 177, 0, 238, 212, 196, 172,
+	153, 69, 233, 0, 76, 0, 41, 220, 47, 0,
+	166, 123, 255, 188, 173, 44, 53, 0, 228, 216,
+	0, 0, 0, 77, 36, 0, 197, 186, 0, 208,
+	139, 0, 165, 31, 0, 169, 154, 195, 0, 0,
+	133, 0, 108, 215, 0, 0, 146, 157, 135, 0,
+	211, 106, 54, 40, 223, 4, 0, 61, 80, 200,
+	0, 0, 0, 163, 151, 0, 43, 225, 168, 0,
+	35, 0, 32, 247, 33, 0, 0, 71, 249, 88,
+	19, 235, 91, 38, 217, 179, 0, 0, 0, 55,
+	226, 248, 26, 204, 159, 0, 190, 68, 103, 0,
+	0, 45, 0, 0, 0, 0, 252, 0, 70, 0,
+	0, 254, 0, 96, 250, 130, 0, 67, 51, 90,
+	218, 0, 37, 245, 0, 104, 0, 0, 0, 149,
+	160, 198, 132, 162, 0, 161, 193, 0, 239, 52,
+	150, 0, 253, 256, 0, 182, 92, 224, 109, 24,
+	102, 241, 0, 0, 147, 0, 134, 192, 64, 0,
+	14, 86, 0, 246, 0, 0, 0, 0, 23, 72,
+	0, 229, 0, 0, 0, 49, 0, 0, 0, 244,
+	121, 22, 210, 79, 12, 0, 39, 50, 0, 0,
+	171, 0, 242, 178, 129, 243, 175, 251, 126, 87,
+	20, 1, 0, 0, 234, 143, 0, 152, 57, 101,
+	0, 237, 236, 174, 21, 105, 98, 181, 221, 73,
+	107, 201, 0, 112, 0, 158, 0, 99, 93, 2,
+	136, 0, 0, 25, 59, 209, 3, 83, 155, 140,
+	8, 5, 0, 145, 127, 0, 95, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 213, 202, 34, 0,
+	0, 46, 0, 0, 0, 0, 17, 128, 0, 189,
+	122, 0, 0, 176, 156, 138, 113, 58, 0, 0,
+	141, 0, 170, 10, 0, 0, 66, 203, 63, 227,
+	191, 137, 206, 0, 84, 42, 183, 10, 256, 107,
+	195, 27, 78, 226, 65, 155, 0, 202, 0, 0,
+	0, 2, 0, 232, 26, 165, 0, 98, 147, 0,
+	0, 0, 140, 77, 200, 125, 122, 56, 174, 37,
+	245, 0, 135, 86, 47, 0, 133, 9, 146, 0,
+	0, 12, 159, 128, 100, 247, 224, 0, 120, 0,
+	0, 0, 0, 36, 67, 0, 0, 16, 84, 82,
+	75, 19, 116, 205, 79, 132, 223, 88, 0, 0,
+	129, 192, 234, 243, 242, 141, 250, 69, 220, 0,
+	103, 227, 0, 180, 0, 0, 0, 7, 0, 196,
+	96, 0, 0, 0, 0, 0, 127, 0, 215, 18,
+	70, 0, 13, 189, 17, 230, 4, 253, 0, 0,
+	172, 175, 0, 255, 0, 0, 208, 0, 0, 217,
+	123, 199, 201, 249, 74, 124, 0, 136, 0, 173,
+	0, 0, 53, 0, 231, 0, 0, 33, 137, 240,
+	118, 0, 238, 0, 90, 25, 109, 0, 14, 0,
+	0, 95, 213, 105, 0, 60, 72, 0, 167, 163,
+	20, 46, 198, 209, 0, 54, 5, 0, 28, 169,
+	0, 0, 0, 0, 42, 66, 188, 168, 99, 0,
+	0, 0, 0, 150, 51, 161, 244, 162, 241, 0,
+	92, 183, 0, 80, 52, 15, 178, 207, 164, 156,
+	233, 251, 76, 106, 21, 0, 50, 0, 130, 0,
+	87, 0, 0, 203, 8, 0, 29, 0, 49, 171,
+	91, 218, 97, 193, 110, 0, 24, 0, 112, 0,
+	0, 0, 181, 38, 142, 0, 121, 58, 22, 101,
+	117, 154, 43, 44, 179, 212, 0, 246, 59, 145,
+	187, 236, 108, 39, 0, 0, 237, 225, 115, 41,
+	0, 0, 57, 204, 114, 0, 158, 0, 206, 0,
+	191, 48, 0, 89, 0, 0, 71, 113, 0, 0,
+	6, 0, 0, 214, 83, 182, 0, 0, 219, 0,
+	186, 23, 197, 134, 131, 0, 0, 81, 45, 252,
+	221, 35, 248, 119, 0, 184, 0, 190, 0, 0,
+	0, 0, 0, 149, 0, 11, 111, 0, 144, 151,
+	166, 194, 94, 0, 177, 254, 0, 160, 0, 0,
+	104, 0, 222, 228, 0, 40, 138, 85, 157, 0,
+	216, 211, 239, 0, 176, 210, 0, 0, 148, 0,
+	235, 32, 1, 0, 68, 73, 102, 153, 152, 139,
+	143, 170, 229, 93, 185, 0, 3, 0, 10, 91,
+	76, 72, 0, 0, 56, 0, 129, 0, 0, 0,
+	12, 0, 2, 104, 144, 0, 165, 0, 127, 147,
+	180, 106, 3, 28, 234, 200, 60, 122, 46, 130,
+	0, 245, 0, 0, 0, 47, 0, 0, 70, 203,
+	0, 0, 167, 159, 128, 168, 166, 0, 19, 181,
+	199, 79, 255, 221, 0, 67, 69, 5, 0, 80,
+	82, 75, 109, 116, 0, 123, 0, 131, 88, 0,
+	0, 9, 192, 251, 163, 242, 74, 0, 202, 212,
+	45, 118, 227, 223, 0, 17, 0, 160, 7, 174,
+	0, 0, 0, 125, 35, 0, 0, 0, 0, 215,
+	18, 0, 0, 0, 189, 0, 230, 0, 0, 36,
+	44, 172, 204, 0, 0, 0, 0, 65, 225, 224,
+	217, 0, 0, 201, 90, 93, 0, 6, 136, 120,
+	195, 0, 146, 71, 177, 231, 0, 138, 0, 103,
+	0, 0, 0, 238, 32, 0, 0, 86, 107, 14,
+	0, 0, 25, 0, 0, 145, 175, 52, 0, 214,
+	246, 213, 41, 0, 78, 0, 54, 0, 40, 57,
+	0, 102, 0, 254, 0, 0, 66, 188, 0, 99,
+	0, 0, 0, 256, 150, 152, 37, 233, 162, 241,
+	0, 226, 0, 135, 137, 209, 15, 0, 0, 183,
+	156, 124, 153, 0, 101, 249, 29, 50, 0, 157,
+	0, 87, 0, 84, 77, 142, 0, 0, 244, 49,
+	171, 11, 186, 97, 193, 110, 210, 24, 0, 112,
+	0, 133, 0, 95, 220, 0, 0, 121, 58, 22,
+	8, 117, 0, 0, 219, 179, 222, 149, 0, 232,
+	0, 187, 236, 108, 0, 0, 100, 237, 0, 115,
+	139, 43, 148, 140, 0, 176, 0, 240, 0, 0,
+	81, 191, 48, 205, 89, 0, 0, 243, 0, 0,
+	53, 198, 196, 173, 105, 83, 182, 253, 0, 20,
+	208, 250, 23, 161, 134, 0, 16, 169, 92, 0,
+	252, 0, 0, 248, 119, 111, 184, 113, 190, 21,
+	4, 0, 178, 0, 0, 218, 0, 38, 0, 155,
+	151, 51, 0, 94, 206, 143, 98, 197, 27, 114,
+	85, 164, 96, 0, 228, 207, 0, 13, 194, 39,
+	0, 216, 33, 239, 0, 132, 59, 211, 0, 247,
+	0, 235, 42, 26, 0, 68, 73, 141, 154, 0,
+	0, 158, 170, 229, 0, 185, 1, 0, 0, 0,
+	0, 248, 0, 240, 197, 93, 0, 174, 0, 211,
+	18, 0, 2, 255, 0, 239, 131, 105, 34, 0,
+	0, 0, 201, 250, 0, 121, 0, 0, 236, 10,
+	62, 158, 155, 0, 59, 199, 233, 41, 136, 125,
+	3, 43, 0, 229, 20, 0, 214, 0, 27, 0,
+	231, 51, 0, 0, 188, 186, 254, 212, 221, 0,
+	184, 46, 220, 178, 14, 245, 0, 151, 85, 79,
+	154, 12, 81, 70, 223, 123, 166, 0, 0, 0,
+	0, 206, 52, 113, 65, 26, 170, 0, 106, 138,
+	0, 0, 9, 0, 149, 69, 0, 0, 140, 0,
+	234, 181, 0, 24, 227, 251, 164, 222, 0, 0,
+	134, 148, 99, 256, 0, 180, 238, 242, 0, 224,
+	195, 235, 115, 0, 0, 13, 194, 0, 116, 0,
+	0, 139, 0, 203, 68, 161, 0, 83, 109, 67,
+	132, 0, 218, 25, 165, 244, 88, 0, 193, 205,
+	0, 0, 75, 249, 84, 22, 0, 0, 150, 246,
+	44, 48, 0, 107, 175, 0, 89, 0, 133, 92,
+	0, 0, 157, 0, 0, 142, 0, 45, 0, 1,
+	153, 182, 0, 0, 50, 145, 49, 76, 0, 74,
+	77, 191, 0, 4, 189, 144, 0, 0, 152, 135,
+	90, 0, 11, 159, 241, 0, 215, 243, 204, 0,
+	210, 156, 252, 162, 0, 0, 28, 0, 247, 0,
+	108, 216, 0, 17, 177, 57, 0, 0, 0, 207,
+	168, 208, 192, 226, 58, 171, 0, 217, 0, 169,
+	0, 0, 33, 0, 225, 0, 54, 23, 42, 35,
+	71, 0, 213, 0, 0, 78, 72, 0, 66, 190,
+	237, 122, 137, 15, 187, 16, 163, 91, 0, 167,
+	97, 219, 200, 86, 0, 253, 176, 0, 0, 172,
+	0, 0, 19, 80, 0, 0, 0, 173, 98, 232,
+	8, 61, 0, 160, 179, 0, 124, 0, 230, 146,
+	30, 117, 0, 202, 0, 0, 209, 228, 0, 21,
+	0, 185, 183, 0, 0, 129, 198, 0, 147, 87,
+	141, 0, 82, 196, 0, 53, 0, 73, 130, 143,
+	0, 0, 63, 0, 189, 0, 196, 163, 77, 0,
+	139, 197, 246, 188, 59, 11, 74, 15, 0, 172,
+	0, 36, 153, 0, 0, 142, 0, 185, 0, 0,
+	171, 8, 250, 0, 0, 49, 222, 211, 67, 135,
+	134, 0, 0, 132, 168, 81, 85, 194, 0, 70,
+	0, 1, 0, 187, 192, 238, 0, 71, 0, 107,
+	0, 63, 7, 214, 0, 90, 152, 104, 0, 193,
+	0, 207, 30, 0, 68, 165, 178, 225, 0, 28,
+	167, 169, 166, 103, 0, 254, 136, 177, 213, 0,
+	35, 245, 0, 26, 14, 208, 149, 57, 159, 244,
+	94, 256, 0, 3, 236, 0, 206, 190, 0, 66,
+	0, 41, 73, 5, 42, 0, 27, 0, 0, 0,
+	227, 158, 10, 218, 0, 241, 0, 0, 0, 0,
+	0, 0, 174, 95, 0, 175, 83, 137, 0, 0,
+	248, 173, 0, 0, 143, 0, 0, 210, 255, 183,
+	0, 0, 249, 224, 0, 0, 179, 150, 201, 13,
+	200, 0, 0, 78, 0, 93, 0, 251, 128, 141,
+	205, 184, 239, 0, 0, 219, 161, 0, 2, 0,
+	34, 170, 253, 75, 0, 228, 237, 199, 147, 202,
+	0, 162, 64, 176, 230, 56, 0, 0, 195, 0,
+	130, 231, 0, 0, 155, 69, 146, 247, 144, 0,
+	234, 16, 119, 17, 0, 217, 65, 133, 0, 180,
+	82, 113, 0, 252, 160, 0, 151, 18, 0, 0,
+	92, 0, 0, 0, 84, 209, 0, 0, 0, 9,
+	0, 0, 138, 0, 89, 0, 235, 148, 0, 0,
+	120, 0, 80, 156, 76, 243, 154, 60, 0, 106,
+	203, 191, 121, 0, 0, 129, 25, 221, 0, 233,
+	0, 232, 240, 0, 58, 182, 33, 242, 186, 0,
+	131, 6, 215, 216, 181, 229, 97, 0, 96, 0,
+	0, 145, 204, 0, 157, 61, 226, 0, 4, 12,
+	223, 220, 105, 212, 91, 0, 198, 0, 164, 72,
+	140, 93, 94, 199, 196, 154, 84, 63, 69, 197,
+	105, 188, 59, 0, 171, 15, 0, 172, 0, 36,
+	0, 0, 0, 170, 181, 185, 26, 0, 208, 8,
+	179, 92, 0, 202, 0, 152, 67, 135, 134, 0,
+	142, 0, 144, 95, 80, 0, 145, 0, 0, 1,
+	0, 0, 0, 4, 0, 71, 162, 107, 242, 41,
+	128, 0, 0, 158, 0, 104, 226, 213, 0, 34,
+	2, 0, 0, 251, 178, 25, 210, 28, 167, 169,
+	166, 103, 0, 0, 11, 131, 0, 0, 240, 85,
+	0, 0, 14, 168, 149, 216, 0, 82, 156, 0,
+	0, 3, 236, 0, 68, 141, 73, 0, 0, 129,
+	74, 5, 65, 0, 241, 0, 0, 0, 227, 76,
+	132, 0, 182, 0, 90, 0, 143, 159, 27, 0,
+	249, 16, 223, 0, 0, 106, 180, 0, 0, 207,
+	0, 139, 234, 0, 0, 165, 255, 146, 0, 0,
+	0, 212, 0, 0, 0, 13, 56, 256, 200, 0,
+	177, 10, 247, 66, 201, 0, 193, 75, 231, 140,
+	58, 0, 174, 96, 161, 214, 0, 0, 237, 61,
+	253, 183, 78, 219, 91, 220, 155, 0, 72, 243,
+	64, 83, 57, 157, 192, 0, 195, 0, 130, 190,
+	239, 211, 248, 244, 147, 0, 238, 35, 189, 175,
+	119, 206, 0, 217, 0, 133, 33, 224, 230, 113,
+	0, 252, 0, 0, 151, 0, 235, 0, 18, 0,
+	0, 232, 245, 209, 164, 0, 6, 0, 222, 9,
+	0, 0, 89, 194, 204, 42, 0, 153, 221, 184,
+	0, 148, 150, 0, 186, 60, 205, 0, 77, 191,
+	121, 0, 0, 0, 233, 218, 250, 0, 246, 30,
+	137, 0, 0, 138, 160, 254, 203, 0, 225, 187,
+	215, 228, 97, 229, 0, 173, 0, 0, 163, 0,
+	70, 120, 17, 0, 0, 136, 81, 12, 0, 0,
+	49, 176, 0, 0, 198, 0, 7, 0, 0, 198,
+	175, 224, 11, 0, 0, 204, 245, 36, 246, 208,
+	70, 0, 0, 197, 0, 188, 0, 149, 132, 0,
+	41, 0, 0, 169, 0, 135, 139, 0, 211, 73,
+	193, 49, 156, 42, 71, 240, 209, 143, 0, 178,
+	170, 25, 130, 153, 182, 185, 0, 0, 0, 18,
+	0, 167, 0, 0, 222, 0, 236, 241, 60, 96,
+	234, 90, 56, 0, 0, 0, 0, 69, 30, 0,
+	68, 217, 0, 85, 0, 0, 183, 157, 166, 103,
+	231, 254, 235, 212, 213, 26, 35, 0, 14, 91,
+	12, 0, 159, 57, 250, 0, 0, 0, 0, 94,
+	247, 0, 0, 0, 0, 172, 0, 147, 65, 146,
+	0, 0, 0, 3, 5, 177, 220, 203, 0, 82,
+	72, 0, 77, 1, 0, 74, 145, 0, 174, 95,
+	92, 0, 221, 67, 0, 0, 248, 173, 140, 0,
+	0, 0, 131, 210, 255, 207, 218, 0, 249, 226,
+	0, 190, 179, 160, 199, 13, 0, 134, 142, 0,
+	0, 93, 0, 0, 196, 150, 136, 229, 0, 215,
+	0, 191, 0, 0, 2, 237, 34, 200, 137, 7,
+	0, 228, 8, 0, 0, 152, 0, 0, 106, 158,
+	121, 161, 104, 0, 0, 194, 0, 9, 0, 0,
+	133, 0, 180, 0, 165, 189, 28, 16, 81, 17,
+	0, 162, 75, 63, 227, 144, 176, 113, 0, 0,
+	214, 238, 0, 0, 0, 33, 0, 61, 251, 0,
+	84, 83, 0, 105, 201, 171, 4, 0, 216, 0,
+	138, 155, 148, 27, 66, 0, 120, 0, 244, 0,
+	202, 0, 119, 192, 6, 0, 0, 195, 0, 0,
+	76, 129, 141, 10, 184, 64, 0, 168, 128, 0,
+	58, 0, 219, 242, 239, 230, 151, 0, 243, 186,
+	181, 206, 97, 253, 0, 256, 0, 154, 187, 205,
+	15, 80, 0, 252, 225, 78, 223, 89, 0, 232,
+	59, 0, 163, 107, 164, 233, 0, 154, 0, 250,
+	0, 0, 0, 227, 70, 0, 0, 0, 207, 0,
+	205, 0, 0, 153, 209, 255, 49, 8, 0, 0,
+	30, 169, 175, 0, 242, 177, 193, 133, 81, 91,
+	176, 189, 0, 152, 0, 256, 215, 0, 166, 18,
+	92, 103, 0, 0, 82, 170, 232, 245, 0, 226,
+	76, 187, 0, 0, 0, 97, 158, 0, 238, 0,
+	60, 0, 185, 0, 135, 139, 0, 244, 156, 26,
+	157, 75, 0, 0, 164, 0, 0, 148, 236, 0,
+	0, 1, 121, 141, 0, 0, 253, 174, 0, 0,
+	0, 0, 168, 0, 202, 84, 4, 240, 0, 206,
+	147, 14, 3, 0, 172, 0, 229, 105, 234, 180,
+	0, 197, 107, 119, 0, 67, 0, 0, 0, 5,
+	203, 0, 161, 162, 0, 0, 71, 0, 0, 7,
+	0, 195, 35, 0, 137, 16, 9, 246, 34, 0,
+	181, 183, 2, 12, 0, 235, 178, 0, 77, 155,
+	254, 61, 0, 65, 0, 144, 96, 196, 134, 0,
+	198, 146, 241, 0, 149, 210, 17, 15, 0, 249,
+	27, 151, 104, 213, 83, 231, 142, 78, 0, 140,
+	0, 11, 10, 237, 214, 188, 0, 128, 87, 66,
+	0, 150, 216, 167, 194, 59, 0, 28, 6, 173,
+	94, 0, 25, 56, 136, 163, 0, 192, 212, 0,
+	88, 190, 248, 120, 143, 90, 204, 0, 0, 0,
+	0, 0, 252, 138, 0, 0, 0, 129, 72, 186,
+	85, 200, 0, 132, 0, 243, 57, 68, 145, 247,
+	179, 0, 0, 0, 0, 0, 74, 233, 0, 208,
+	0, 225, 73, 69, 251, 79, 113, 106, 171, 130,
+	182, 33, 0, 0, 211, 80, 0, 0, 201, 160,
+	0, 0, 184, 13, 159, 199, 0, 41, 228, 191,
+	64, 93, 239, 36, 0, 230, 42, 95, 63, 131,
+	0, 0, 165, 0, 58, 0, 129, 214, 26, 161,
+	5, 0, 0, 252, 0, 226, 0, 63, 182, 240,
+	95, 191, 0, 216, 11, 0, 0, 40, 15, 242,
+	6, 0, 0, 85, 0, 0, 241, 156, 0, 0,
+	0, 179, 80, 167, 61, 84, 0, 0, 187, 36,
+	0, 0, 0, 244, 81, 0, 0, 0, 14, 0,
+	253, 0, 0, 149, 152, 16, 0, 0, 177, 160,
+	247, 73, 75, 93, 145, 0, 24, 166, 219, 229,
+	7, 77, 0, 99, 0, 169, 0, 39, 233, 92,
+	8, 0, 0, 0, 168, 218, 0, 230, 0, 128,
+	0, 132, 23, 0, 72, 250, 0, 150, 0, 248,
+	121, 239, 221, 0, 113, 183, 46, 220, 103, 56,
+	0, 89, 0, 17, 157, 0, 231, 211, 0, 18,
+	246, 12, 180, 78, 228, 0, 243, 25, 107, 64,
+	98, 76, 0, 94, 200, 119, 245, 164, 199, 49,
+	222, 217, 184, 189, 181, 0, 208, 0, 0, 188,
+	159, 33, 28, 0, 0, 0, 58, 0, 194, 0,
+	170, 0, 136, 0, 60, 135, 0, 178, 0, 174,
+	41, 68, 120, 146, 38, 0, 104, 0, 0, 0,
+	202, 0, 100, 0, 210, 235, 204, 198, 34, 190,
+	82, 0, 97, 106, 67, 192, 238, 0, 0, 0,
+	162, 195, 0, 42, 251, 0, 0, 0, 175, 105,
+	0, 232, 0, 153, 35, 203, 212, 0, 27, 57,
+	71, 206, 0, 3, 0, 0, 163, 83, 0, 155,
+	223, 13, 234, 0, 158, 0, 0, 69, 196, 0,
+	37, 147, 134, 225, 59, 0, 0, 0, 0, 207,
+	1, 70, 227, 205, 130, 0, 0, 172, 0, 148,
+	0, 224, 30, 0, 0, 0, 0, 256, 254, 2,
+	65, 0, 249, 213, 193, 176, 10, 186, 154, 197,
+	91, 0, 151, 0, 66, 255, 0, 171, 236, 173,
+	74, 90, 131, 215, 0, 0, 201, 0, 209, 0,
+	4, 96, 237, 185, 133, 165,
+};
+
+static const struct names_set names_sets[15] = {
+	{0, 30, 0, 184},
+	{30, 27, 184, 164},
+	{57, 32, 348, 193},
+	{89, 44, 541, 269},
+	{133, 51, 810, 310},
+	{184, 58, 1120, 352},
+	{242, 59, 1472, 355},
+	{301, 61, 1827, 371},
+	{362, 61, 2198, 371},
+	{423, 55, 2569, 334},
+	{478, 51, 2903, 308},
+	{529, 51, 3211, 308},
+	{580, 51, 3519, 308},
+	{631, 49, 3827, 299},
+	{680, 51, 4126, 310},
+};
+
+/* the first of each derivative */
+static const uint8_t names_first[DIS8051_DERIVS] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 9, 10,
+};
+
+/* opcodes of each mnemonic */
+static const uint8_t mnem_opcodes[256] = {
+	0x11, 0x31, 0x51, 0x71, 0x91, 0xb1, 0xd1, 0xf1, 0x24, 0x25,
+	0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d,
+	0x3e, 0x3f, 0x01, 0x21, 0x41, 0x61, 0x81, 0xa1, 0xc1, 0xe1,
+	0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b,
+	0x5c, 0x5d, 0x5e, 0x5f, 0x82, 0xb0, 0xb4, 0xb5, 0xb6, 0xb7,
+	0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf, 0xc2, 0xc3,
+	0xe4, 0xb2, 0xb3, 0xf4, 0xd4, 0x14, 0x15, 0x16, 0x17, 0x18,
+	0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x84, 0xd5, 0xd8,
+	0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf, 0x04, 0x05, 0x06,
+	0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xa3,
+	0x20, 0x10, 0x40, 0x73, 0x30, 0x50, 0x70, 0x60, 0x12, 0x02,
+	0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d,
+	0x7e, 0x7f, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c,
+	0x8d, 0x8e, 0x8f, 0x90, 0x92, 0xa2, 0xa6, 0xa7, 0xa8, 0xa9,
+	0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf, 0xe5, 0xe6, 0xe7, 0xe8,
+	0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef, 0xf5, 0xf6, 0xf7,
+	0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff, 0x83, 0x93,
+	0xe0, 0xe2, 0xe3, 0xf0, 0xf2, 0xf3, 0xa4, 0x00, 0x42, 0x43,
+	0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d,
+	0x4e, 0x4f, 0x72, 0xa0, 0xd0, 0xc0, 0xa5, 0x22, 0x32, 0x23,
+	0x33, 0x03, 0x13, 0xd2, 0xd3, 0x80, 0x94, 0x95, 0x96, 0x97,
+	0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f, 0xc4, 0xc5,
+	0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+	0xd6, 0xd7, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+	0x6a, 0x6b, 0x6c, 0x6d, 0x6e, 0x6f,
+};
+
+static const uint16_t mnem_first[DIS8051_MNEM_COUNT + 1] = {
+	0, 8, 20, 32, 40, 56, 68, 71, 74, 75,
+	87, 88, 97, 110, 111, 112, 113, 114, 115, 116,
+	117, 118, 119, 120, 178, 180, 186, 187, 188, 204,
+	205, 206, 207, 208, 209, 210, 211, 212, 213, 215,
+	216, 228, 229, 229, 240, 242, 256,
+};
+
+#endif
@@ -0,0 +1,357 @@
+/* OMF-51 absolute object loader (Intel, Keil AOMF) */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-omf.h"
+#include "8051-xref.h"
+
+/* record types */
+#define MODULE_HEADER 0x02
+#define MODULE_END    0x04
+#define CONTENT       0x06
+#define SEGMENT_DEFS  0x0e
+#define SCOPE_DEF     0x10
+#define DEBUG_ITEMS   0x12
+#define PUBLIC_DEFS   0x16
+
+/* debug item kinds */
+#define DEBUG_LINES   3
+
+#define BEGIN_MODULE  0
+
+/* a record's contents being read */
+struct rec {
+	const uint8_t *p, *end;
+};
+
+void dis8051_omf_init(struct dis8051_omf *o, struct dis8051_image *img,
+                      struct dis8051_symtab *syms)
+{
+	memset(o, 0, sizeof(*o));
+	o->img = img;
+	o->syms = syms;
+}
+
+void dis8051_omf_free(struct dis8051_omf *o)
+{
+	size_t i;
+
+	for (i = 0; i < o->nsegs; i++)
+		free(o->segs[i].name);
+	for (i = 0; i < o->nmodules; i++)
+		free(o->modules[i]);
+	free(o->segs);
+	free(o->lines);
+	free(o->modules);
+	o->segs = NULL;
+	o->lines = NULL;
+	o->modules = NULL;
+	o->nsegs = o->nlines = o->alines = o->nmodules = 0;
+}
+
+static int byte(struct rec *r, uint8_t *v)
+{
+	if (r->p >= r->end)
+		return -1;
+	*v = *r->p++;
+	return 0;
+}
+
+/* little endian */
+static int word(struct rec *r, uint16_t *v)
+{
+	if (r->end - r->p < 2)
+		return -1;
+	*v = r->p[0] | r->p[1] << 8;
+	r->p += 2;
+	return 0;
+}
+
+/* length byte and characters */
+static int name(struct rec *r, const char **s, size_t *n)
+{
+	uint8_t k;
+
+	if (byte(r, &k) < 0 || r->end - r->p < k)
+		return -1;
+	*s = (const char *)r->p;
+	*n = k;
+	r->p += k;
+	return 0;
+}
+
+static char *copy(const char *s, size_t n)
+{
+	char *d = malloc(n + 1);
+
+	if (d) {
+		memcpy(d, s, n);
+		d[n] = '\0';
+	}
+	return d;
+}
+
+static const struct dis8051_omf_seg *seg(const struct dis8051_omf *o,
+                                         uint8_t id)
+{
+	size_t i;
+
+	for (i = 0; i < o->nsegs; i++)
+		if (o->segs[i].id == id)
+			return &o->segs[i];
+	return NULL;
+}
+
+/* absolute address of 'off' in segment 'id', 0 is absolute itself */
+static uint32_t addr(const struct dis8051_omf *o, uint8_t id, uint16_t off)
+{
+	const struct dis8051_omf_seg *s = id ? seg(o, id) : NULL;
+
+	return (s ? s->base : 0) + off;
+}
+
+static int segments(struct dis8051_omf *o, struct rec *r)
+{
+	struct dis8051_omf_seg *s;
+	uint8_t id, info, rel, res;
+	uint16_t base, size;
+	const char *n;
+	size_t k;
+
+	while (r->p < r->end) {
+		if (byte(r, &id) < 0 || byte(r, &info) < 0 ||
+		    byte(r, &rel) < 0 || byte(r, &res) < 0 ||
+		    word(r, &base) < 0 || word(r, &size) < 0 ||
+		    name(r, &n, &k) < 0)
+			return DIS8051_OMF_EFORMAT;
+		if (!(s = realloc(o->segs, (o->nsegs + 1)*sizeof(*s))))
+			return DIS8051_OMF_ENOMEM;
+		o->segs = s;
+		s += o->nsegs;
+		s->id = id;
+		s->type = info & 0x7;
+		s->base = base;
+		/* empty bit clear and size 0: all of 64 KiB */
+		s->size = (size || (info & 0x20)) ? size : 0x10000;
+		if (!(s->name = copy(n, k)))
+			return DIS8051_OMF_ENOMEM;
+		o->nsegs++;
+	}
+	return DIS8051_OMF_OK;
+}
+
+static int symbol(struct dis8051_omf *o, int type, uint32_t a,
+                  const char *n, size_t k)
+{
+	int space;
+
+	switch (type) {
+	case DIS8051_OMF_CODE:  space = DIS8051_SPACE_CODE; break;
+	case DIS8051_OMF_XDATA: space = DIS8051_SPACE_XDATA; break;
+	case DIS8051_OMF_BIT:   space = DIS8051_SPACE_BIT; break;
+	case DIS8051_OMF_DATA:
+		space = a < 0x80 ? DIS8051_SPACE_IRAM : DIS8051_SPACE_SFR;
+		break;
+	case DIS8051_OMF_IDATA:
+		/* above 0x7f only reachable indirectly */
+		if (a >= 0x80)
+			return DIS8051_OMF_OK;
+		space = DIS8051_SPACE_IRAM;
+		break;
+	default:
+		/* numbers are not addresses */
+		return DIS8051_OMF_OK;
+	}
+	if (dis8051_symtab_add(o->syms, space, a, n, k) < 0)
+		return DIS8051_OMF_ENOMEM;
+	return DIS8051_OMF_OK;
+}
+
+/* public definitions and the symbols of debug items */
+static int symbols(struct dis8051_omf *o, struct rec *r)
+{
+	uint8_t id, info, res;
+	uint16_t off;
+	const char *n;
+	size_t k;
+	int e;
+
+	while (r->p < r->end) {
+		if (byte(r, &id) < 0 || byte(r, &info) < 0 ||
+		    word(r, &off) < 0 || byte(r, &res) < 0 ||
+		    name(r, &n, &k) < 0)
+			return DIS8051_OMF_EFORMAT;
+		if ((e = symbol(o, info & 0x7, addr(o, id, off), n, k)))
+			return e;
+	}
+	return DIS8051_OMF_OK;
+}
+
+static int lines(struct dis8051_omf *o, struct rec *r)
+{
+	struct dis8051_omf_line *l;
+	uint16_t off, line;
+	uint8_t id;
+	size_t n;
+
+	while (r->p < r->end) {
+		if (byte(r, &id) < 0 || word(r, &off) < 0 ||
+		    word(r, &line) < 0)
+			return DIS8051_OMF_EFORMAT;
+		if (o->nlines == o->alines) {
+			n = o->alines ? o->alines*2 : 256;
+			if (!(l = realloc(o->lines, n*sizeof(*l))))
+				return DIS8051_OMF_ENOMEM;
+			o->lines = l;
+			o->alines = n;
+		}
+		l = &o->lines[o->nlines++];
+		l->addr = addr(o, id, off);
+		l->line = line;
+		l->module = o->nmodules ? o->nmodules - 1 : 0xffff;
+	}
+	return DIS8051_OMF_OK;
+}
+
+static int scope(struct dis8051_omf *o, struct rec *r)
+{
+	const char *n;
+	uint8_t type;
+	char **m;
+	size_t k;
+
+	if (byte(r, &type) < 0 || name(r, &n, &k) < 0)
+		return DIS8051_OMF_EFORMAT;
+	if (type != BEGIN_MODULE)
+		return DIS8051_OMF_OK;
+	if (!(m = realloc(o->modules, (o->nmodules + 1)*sizeof(*m))))
+		return DIS8051_OMF_ENOMEM;
+	o->modules = m;
+	if (!(m[o->nmodules] = copy(n, k)))
+		return DIS8051_OMF_ENOMEM;
+	o->nmodules++;
+	return DIS8051_OMF_OK;
+}
+
+static int content(struct dis8051_omf *o, struct rec *r)
+{
+	const struct dis8051_omf_seg *s;
+	uint16_t off;
+	uint8_t id;
+
+	if (byte(r, &id) < 0 || word(r, &off) < 0)
+		return DIS8051_OMF_EFORMAT;
+	/* only code is of interest, absolute content is code */
+	if (id && (s = seg(o, id)) && s->type != DIS8051_OMF_CODE)
+		return DIS8051_OMF_OK;
+	if (dis8051_image_write(o->img, addr(o, id, off), r->p,
+	                        r->end - r->p) < 0)
+		return DIS8051_OMF_ENOMEM;
+	return DIS8051_OMF_OK;
+}
+
+int dis8051_omf_load(struct dis8051_omf *o, const uint8_t *buf, size_t len)
+{
+	size_t n, i, skipped = 0;
+	struct rec r;
+	uint8_t sum, type;
+	int e, unsupported = 0;
+
+	if (len == 0)
+		return DIS8051_OMF_EFORMAT;
+	for (o->offset = 0; o->offset < len; o->offset += 3 + n) {
+		/* type, length of the rest, contents, checksum */
+		if (len - o->offset < 3)
+			return DIS8051_OMF_EFORMAT;
+		type = buf[o->offset];
+		n = buf[o->offset+1] | buf[o->offset+2] << 8;
+		if (n < 1 || len - o->offset - 3 < n)
+			return DIS8051_OMF_EFORMAT;
+		if (o->offset == 0 && type != MODULE_HEADER)
+			return DIS8051_OMF_EFORMAT;
+		for (sum = 0, i = 0; i < 3 + n; i++)
+			sum += buf[o->offset + i];
+		if (sum != 0)
+			return DIS8051_OMF_ECHECKSUM;
+
+		r.p = buf + o->offset + 3;
+		r.end = r.p + n - 1;
+		e = DIS8051_OMF_OK;
+		switch (type) {
+		case MODULE_HEADER: break;
+		case CONTENT:      e = content(o, &r); break;
+		case SEGMENT_DEFS: e = segments(o, &r); break;
+		case SCOPE_DEF:    e = scope(o, &r); break;
+		case PUBLIC_DEFS:  e = symbols(o, &r); break;
+		case DEBUG_ITEMS:
+			if (byte(&r, &type) < 0)
+				e = DIS8051_OMF_EFORMAT;
+			else if (type == DEBUG_LINES)
+				e = lines(o, &r);
+			else
+				e = symbols(o, &r);
+			break;
+		case MODULE_END:
+			goto end;
+		default:
+			/* e.g. Keil's extended debug items and publics */
+			if (!unsupported++)
+				skipped = o->offset;
+			break;
+		}
+		if (e)
+			return e;
+	}
+end:
+	if (!unsupported)
+		return DIS8051_OMF_OK;
+	o->offset = skipped;
+	return DIS8051_OMF_EUNSUPPORTED;
+}
+
+int dis8051_omf_load_file(struct dis8051_omf *o, const char *path)
+{
+	uint8_t *buf = NULL;
+	size_t n = 0, a = 0, k;
+	FILE *f;
+	int e;
+
+	if (!(f = fopen(path, "rb")))
+		return DIS8051_OMF_EIO;
+	do {
+		if (n == a) {
+			uint8_t *b;
+
+			a = a ? a*2 : 65536;
+			if (!(b = realloc(buf, a))) {
+				free(buf);
+				fclose(f);
+				return DIS8051_OMF_ENOMEM;
+			}
+			buf = b;
+		}
+		n += k = fread(buf + n, 1, a - n, f);
+	} while (k > 0);
+	e = ferror(f) ? DIS8051_OMF_EIO : dis8051_omf_load(o, buf, n);
+	fclose(f);
+	free(buf);
+	return e;
+}
+
+const char *dis8051_omf_strerror(int error)
+{
+	static const char *const msg[] = {
+		[DIS8051_OMF_OK] = "no error",
+		[DIS8051_OMF_EFORMAT] = "not an OMF-51 object",
+		[DIS8051_OMF_ECHECKSUM] = "checksum mismatch",
+		[DIS8051_OMF_ENOMEM] = "out of memory",
+		[DIS8051_OMF_EIO] = "read error",
+		[DIS8051_OMF_EUNSUPPORTED] = "record type not supported",
+	};
+
+	if (error < 0 || error > DIS8051_OMF_EUNSUPPORTED)
+		return "unknown error";
+	return msg[error];
+}
@@ -0,0 +1,73 @@
+/* OMF-51 absolute object loader (Intel, Keil AOMF) */
+
+#ifndef DIS8051_OMF_H
+#define DIS8051_OMF_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-image.h"
+#include "8051-symtab.h"
+
+enum {
+	DIS8051_OMF_OK,
+	DIS8051_OMF_EFORMAT,    /* not OMF-51, or a record is cut off */
+	DIS8051_OMF_ECHECKSUM,
+	DIS8051_OMF_ENOMEM,
+	DIS8051_OMF_EIO,
+	DIS8051_OMF_EUNSUPPORTED /* a record type not read, e.g. Keil's
+	                            extended ones; the others are loaded */
+};
+
+/* segment types of segment and symbol records */
+enum dis8051_omf_type {
+	DIS8051_OMF_CODE,
+	DIS8051_OMF_XDATA,
+	DIS8051_OMF_DATA,
+	DIS8051_OMF_IDATA,
+	DIS8051_OMF_BIT,
+	DIS8051_OMF_NUMBER
+};
+
+struct dis8051_omf_seg {
+	uint8_t id;
+	uint8_t type;      /* DIS8051_OMF_* */
+	uint16_t base;
+	uint32_t size;     /* 0x10000 for an empty 64 KiB one */
+	char *name;
+};
+
+struct dis8051_omf_line {
+	uint16_t addr;
+	uint16_t line;
+	uint16_t module;   /* index into 'modules' */
+};
+
+struct dis8051_omf {
+	struct dis8051_image *img;    /* code */
+	struct dis8051_symtab *syms;  /* local, public and segment symbols */
+	struct dis8051_omf_seg *segs;
+	size_t nsegs;
+	struct dis8051_omf_line *lines;
+	size_t nlines, alines;
+	char **modules;               /* names of the scopes lines are in */
+	size_t nmodules;
+	size_t offset;                /* of the record an error is in */
+};
+
+/* code goes into 'img', symbols into 'syms'; direct data symbols
+ * above 0x7f are SFRs */
+void dis8051_omf_init(struct dis8051_omf *o, struct dis8051_image *img,
+                      struct dis8051_symtab *syms);
+
+/* segments, lines and module names, not 'img' and 'syms' */
+void dis8051_omf_free(struct dis8051_omf *o);
+
+/* parse a whole file in one pass, returns DIS8051_OMF_OK or an error
+ * in the record at o->offset; DIS8051_OMF_EUNSUPPORTED is only returned
+ * at the end, for the first record skipped */
+int dis8051_omf_load(struct dis8051_omf *o, const uint8_t *buf, size_t len);
+int dis8051_omf_load_file(struct dis8051_omf *o, const char *path);
+
+const char *dis8051_omf_strerror(int error);
+
+#endif
@@ -0,0 +1,643 @@
+/* instruction pattern index over many images: the instruction stream
+ * of each is indexed by opcode 3-grams, built once and searched
+ * through a read only mapping of the file
+ *
+ * file, little endian:
+ *   "D8PIDX1\n", u32 images, u32 keys, u32 postings, u32 name bytes,
+ *   u32 code bytes, then
+ *   images:   u32 name offset, u32 code offset, u32 length
+ *   keys:     u32 key, u32 first posting, ascending
+ *   postings: u32 image, u16 address, by key, image and address
+ *   names, NUL terminated, and the code of the images */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "8051-insn.h"
+#include "8051-flow.h"
+#include "8051-asm.h"
+#include "8051-pindex.h"
+
+#define MAGIC "D8PIDX1\n"
+#define HEADER 28
+#define IMAGE_SIZE 12
+#define KEY_SIZE 8
+#define POSTING_SIZE 6
+
+/* in place of the opcodes past the end of an image */
+#define PAD 0xa5
+
+/* shortest run of 0x00 or 0xff that is fill rather than code */
+#define FILL 4
+
+/* key ranges looked up for one run of opcodes, as in "r*" */
+#define RANGES_MAX 256
+
+/* --- patterns --- */
+
+static const char *skip_space(const char *s, const char *e)
+{
+	while (s < e && isspace((unsigned char)*s))
+		s++;
+	return s;
+}
+
+static const char *trim_end(const char *s, const char *e)
+{
+	while (e > s && isspace((unsigned char)e[-1]))
+		e--;
+	return e;
+}
+
+/* bytes of an operand kind after the opcode */
+static int width(int kind)
+{
+	switch (kind) {
+	case DIS8051_OPND_IMM16:
+	case DIS8051_OPND_ADDR16:
+		return 2;
+	case DIS8051_OPND_DIRECT:
+	case DIS8051_OPND_BIT:
+	case DIS8051_OPND_NBIT:
+	case DIS8051_OPND_IMM8:
+	case DIS8051_OPND_REL:
+	case DIS8051_OPND_ADDR11:
+		return 1;
+	}
+	return 0;
+}
+
+/* mask the operands in 'wild' of the instruction in 'v' */
+static void mask_operands(const uint8_t *v, uint8_t *m, unsigned wild)
+{
+	const struct dis8051_opcode *op = &dis8051_opcodes[v[0]];
+	int k, off[3], w[3], p = 1, i;
+
+	for (k = 0; k < 3; k++) {
+		off[k] = p;
+		w[k] = op->opnd[k] ? width(op->opnd[k]) : 0;
+		p += w[k];
+	}
+	/* mov data addr., data addr.: source byte first */
+	if (v[0] == 0x85) {
+		off[0] = 2;
+		off[1] = 1;
+	}
+	for (k = 0; k < 3; k++) {
+		if (!(wild & 1 << k))
+			continue;
+		for (i = 0; i < w[k]; i++)
+			m[off[k] + i] = 0;
+		if (op->opnd[k] == DIS8051_OPND_ADDR11)
+			m[0] &= 0x1f;
+	}
+}
+
+/* one statement, registers "r*" and "@r*" become r0 and @r0 with the
+ * register bits of the opcode masked, other '*' become 0 */
+static int parse_insn(struct dis8051_pattern *p, const char *s,
+                      const char *e)
+{
+	char text[128];
+	uint8_t *v = p->sig.value + p->sig.len, *m = p->sig.mask + p->sig.len;
+	const char *o, *c;
+	unsigned wild = 0;
+	size_t n = 0;
+	int k, size, opmask = 0xff;
+
+	for (o = s; o < e && !isspace((unsigned char)*o); o++)
+		;
+	if ((size_t)(o - s) >= sizeof(text))
+		return -1;
+	memcpy(text, s, o - s);
+	n = o - s;
+
+	for (k = 0; (o = skip_space(o, e)) < e; k++, o = c + 1) {
+		for (c = o; c < e && *c != ','; c++)
+			;
+		if (k == 3 || n + (c - o) + 2 >= sizeof(text))
+			return -1;
+		text[n++] = k ? ',' : ' ';
+		if (trim_end(o, c) - o == 2 && !memcmp(o, "r*", 2)) {
+			memcpy(text + n, "r0", 2);
+			n += 2;
+			opmask = 0xf8;
+		} else if (trim_end(o, c) - o == 3 && !memcmp(o, "@r*", 3)) {
+			memcpy(text + n, "@r0", 3);
+			n += 3;
+			opmask = 0xfe;
+		} else {
+			for (; o < c; o++) {
+				if (*o == '*')
+					wild |= 1 << k;
+				text[n++] = *o == '*' ? '0' : *o;
+			}
+		}
+		if (c == e)
+			break;
+	}
+	text[n] = '\0';
+
+	if (p->n == DIS8051_PAT_MAX ||
+	    !(size = dis8051_assemble(NULL, 0, text, v)) ||
+	    p->sig.len + size > DIS8051_SIG_MAX)
+		return -1;
+	memset(m, 0xff, size);
+	m[0] = opmask;
+	mask_operands(v, m, wild);
+	for (k = 0; k < size; k++)
+		v[k] &= m[k];
+	p->size[p->n++] = size;
+	p->sig.len += size;
+	return 0;
+}
+
+int dis8051_pattern_parse(struct dis8051_pattern *p, const char *s,
+                          int *bad)
+{
+	const char *e;
+	int stmt = 0;
+
+	memset(p, 0, sizeof(*p));
+	p->sig.next = -1;
+	for (; *s; s = *e ? e + 1 : e) {
+		for (e = s; *e && *e != ';' && *e != '\n'; e++)
+			;
+		s = skip_space(s, e);
+		if (s == e)
+			continue;
+		stmt++;
+		if (parse_insn(p, s, trim_end(s, e)) < 0) {
+			*bad = stmt;
+			return -1;
+		}
+	}
+	if (p->n == 0) {
+		*bad = 1;
+		return -1;
+	}
+	return 0;
+}
+
+/* --- building --- */
+
+void dis8051_pindex_builder_init(struct dis8051_pindex_builder *b)
+{
+	memset(b, 0, sizeof(*b));
+}
+
+void dis8051_pindex_builder_free(struct dis8051_pindex_builder *b)
+{
+	free(b->images);
+	free(b->names);
+	free(b->code);
+	free(b->v);
+	memset(b, 0, sizeof(*b));
+}
+
+static int grow(void **v, size_t *a, size_t n, size_t more, size_t size)
+{
+	void *p;
+	size_t m = *a ? *a : 64;
+
+	if (n + more <= *a)
+		return 0;
+	while (m < n + more)
+		m *= 2;
+	if (!(p = realloc(*v, m*size)))
+		return -1;
+	*v = p;
+	*a = m;
+	return 0;
+}
+
+/* length of the run of fill at 'pc', 0 if there is none */
+static size_t fill(const uint8_t *code, size_t len, size_t pc)
+{
+	size_t n;
+
+	if (code[pc] != 0x00 && code[pc] != 0xff)
+		return 0;
+	for (n = 1; pc + n < len && code[pc + n] == code[pc]; n++)
+		;
+	return n >= FILL ? n : 0;
+}
+
+/* the opcode at 'pc' and those of the two instructions following */
+static uint32_t key_at(const uint8_t *code, size_t len, size_t pc)
+{
+	uint32_t key = 0;
+	int k;
+
+	for (k = 0; k < 3; k++) {
+		key = key << 8 | (pc < len ? code[pc] : PAD);
+		if (pc < len)
+			pc += dis8051_opcodes[code[pc]].size;
+	}
+	return key;
+}
+
+int dis8051_pindex_add(struct dis8051_pindex_builder *b, const char *name,
+                       const uint8_t *code, size_t len, const uint8_t *map)
+{
+	struct dis8051_posting *p;
+	size_t n = strlen(name) + 1, pc, f;
+
+	if (len > 0x10000)
+		len = 0x10000;
+	if (grow((void **)&b->images, &b->aimages, b->nimages, 1,
+	         sizeof(*b->images)) ||
+	    grow((void **)&b->names, &b->anames, b->nnames, n, 1) ||
+	    grow((void **)&b->code, &b->acode, b->ncode, len, 1))
+		return -1;
+
+	for (pc = 0; pc < len; ) {
+		/* operands and tables the traversal found are no stream */
+		if (map && !(map[pc] & DIS8051_MAP_CODE) &&
+		    (map[pc] & (DIS8051_MAP_BODY | DIS8051_MAP_DATA))) {
+			pc++;
+			continue;
+		}
+		if ((!map || !(map[pc] & DIS8051_MAP_CODE)) &&
+		    (f = fill(code, len, pc))) {
+			pc += f;
+			continue;
+		}
+		if (pc + dis8051_opcodes[code[pc]].size > len)
+			break;
+		if (grow((void **)&b->v, &b->alloc, b->count, 1, sizeof(*b->v)))
+			return -1;
+		p = &b->v[b->count++];
+		p->key = key_at(code, len, pc);
+		p->image = b->nimages;
+		p->addr = pc;
+		pc += dis8051_opcodes[code[pc]].size;
+	}
+
+	b->images[b->nimages].name = b->nnames;
+	b->images[b->nimages].code = b->ncode;
+	b->images[b->nimages++].len = len;
+	memcpy(b->names + b->nnames, name, n);
+	b->nnames += n;
+	memcpy(b->code + b->ncode, code, len);
+	b->ncode += len;
+	return 0;
+}
+
+struct named {
+	const char *name;
+	uint32_t image;
+};
+
+static int by_name(const void *a, const void *b)
+{
+	return strcmp(((const struct named *)a)->name,
+	              ((const struct named *)b)->name);
+}
+
+static int by_key(const void *a, const void *b)
+{
+	const struct dis8051_posting *x = a, *y = b;
+
+	if (x->key != y->key)
+		return x->key < y->key ? -1 : 1;
+	if (x->image != y->image)
+		return x->image < y->image ? -1 : 1;
+	return (int)x->addr - (int)y->addr;
+}
+
+static void put32(FILE *f, uint32_t v)
+{
+	uint8_t b[4] = {v, v >> 8, v >> 16, v >> 24};
+
+	fwrite(b, 1, 4, f);
+}
+
+static void put16(FILE *f, uint16_t v)
+{
+	uint8_t b[2] = {v, v >> 8};
+
+	fwrite(b, 1, 2, f);
+}
+
+int dis8051_pindex_write(struct dis8051_pindex_builder *b, const char *path)
+{
+	const struct dis8051_pindex_image *im;
+	struct named *order;
+	uint32_t *rank, nkeys = 0, name = 0, code = 0;
+	size_t i;
+	FILE *f;
+	int err;
+
+	order = malloc((b->nimages ? b->nimages : 1)*sizeof(*order));
+	rank = malloc((b->nimages ? b->nimages : 1)*sizeof(*rank));
+	if (!order || !rank) {
+		free(order);
+		free(rank);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	/* the same images give the same file, in whatever order they
+	 * were added */
+	for (i = 0; i < b->nimages; i++) {
+		order[i].name = b->names + b->images[i].name;
+		order[i].image = i;
+	}
+	qsort(order, b->nimages, sizeof(*order), by_name);
+	for (i = 0; i < b->nimages; i++)
+		rank[order[i].image] = i;
+	for (i = 0; i < b->count; i++)
+		b->v[i].image = rank[b->v[i].image];
+	qsort(b->v, b->count, sizeof(*b->v), by_key);
+	for (i = 0; i < b->count; i++)
+		nkeys += i == 0 || b->v[i].key != b->v[i-1].key;
+
+	if (!(f = fopen(path, "wb"))) {
+		err = errno;
+		free(order);
+		free(rank);
+		errno = err;
+		return -1;
+	}
+	fwrite(MAGIC, 1, 8, f);
+	put32(f, b->nimages);
+	put32(f, nkeys);
+	put32(f, b->count);
+	put32(f, b->nnames);
+	put32(f, b->ncode);
+	for (i = 0; i < b->nimages; i++) {
+		im = &b->images[order[i].image];
+		put32(f, name);
+		put32(f, code);
+		put32(f, im->len);
+		name += strlen(order[i].name) + 1;
+		code += im->len;
+	}
+	for (i = 0; i < b->count; i++)
+		if (i == 0 || b->v[i].key != b->v[i-1].key) {
+			put32(f, b->v[i].key);
+			put32(f, i);
+		}
+	for (i = 0; i < b->count; i++) {
+		put32(f, b->v[i].image);
+		put16(f, b->v[i].addr);
+	}
+	for (i = 0; i < b->nimages; i++)
+		fwrite(order[i].name, 1, strlen(order[i].name) + 1, f);
+	for (i = 0; i < b->nimages; i++) {
+		im = &b->images[order[i].image];
+		fwrite(b->code + im->code, 1, im->len, f);
+	}
+
+	/* added later, they are numbered in the order they came */
+	for (i = 0; i < b->count; i++)
+		b->v[i].image = order[b->v[i].image].image;
+
+	free(order);
+	free(rank);
+	if (ferror(f)) {
+		fclose(f);
+		errno = EIO;
+		return -1;
+	}
+	return fclose(f) ? -1 : 0;
+}
+
+/* --- searching --- */
+
+static uint32_t get32(const uint8_t *p)
+{
+	return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+	return p[0] | p[1] << 8;
+}
+
+int dis8051_pindex_open(struct dis8051_pindex *ix, const char *path)
+{
+	const uint8_t *p, *q;
+	struct stat st;
+	uint64_t need;
+	uint32_t names, code, i;
+	int fd, err;
+
+	memset(ix, 0, sizeof(*ix));
+	if ((fd = open(path, O_RDONLY)) < 0)
+		return -1;
+	if (fstat(fd, &st) < 0) {
+		err = errno;
+		close(fd);
+		errno = err;
+		return -1;
+	}
+	if (st.st_size < HEADER) {
+		close(fd);
+		errno = EINVAL;
+		return -1;
+	}
+	ix->size = st.st_size;
+	ix->map = mmap(NULL, ix->size, PROT_READ, MAP_SHARED, fd, 0);
+	err = errno;
+	close(fd);
+	if (ix->map == MAP_FAILED) {
+		ix->map = NULL;
+		errno = err;
+		return -1;
+	}
+
+	p = ix->map;
+	ix->nimages = get32(p + 8);
+	ix->nkeys = get32(p + 12);
+	ix->npostings = get32(p + 16);
+	names = get32(p + 20);
+	code = get32(p + 24);
+	need = HEADER + (uint64_t)ix->nimages*IMAGE_SIZE +
+	       (uint64_t)ix->nkeys*KEY_SIZE +
+	       (uint64_t)ix->npostings*POSTING_SIZE + names + code;
+	if (memcmp(p, MAGIC, 8) || need != ix->size ||
+	    (names && p[need - code - 1] != '\0'))
+		goto bad;
+	ix->images = p + HEADER;
+	ix->keys = ix->images + (size_t)ix->nimages*IMAGE_SIZE;
+	ix->postings = ix->keys + (size_t)ix->nkeys*KEY_SIZE;
+	ix->names = (const char *)ix->postings +
+	            (size_t)ix->npostings*POSTING_SIZE;
+	ix->code = (const uint8_t *)ix->names + names;
+
+	/* the rest is checked as the search gets to it, without touching
+	 * all of the postings */
+	for (i = 0; i < ix->nimages; i++) {
+		q = ix->images + (size_t)i*IMAGE_SIZE;
+		if (get32(q) >= names || get32(q + 4) > code ||
+		    get32(q + 8) > code - get32(q + 4))
+			goto bad;
+	}
+	return 0;
+
+bad:
+	dis8051_pindex_close(ix);
+	errno = EINVAL;
+	return -1;
+}
+
+void dis8051_pindex_close(struct dis8051_pindex *ix)
+{
+	if (ix->map)
+		munmap(ix->map, ix->size);
+	memset(ix, 0, sizeof(*ix));
+}
+
+/* first posting of a key at least 'key' */
+static uint32_t first(const struct dis8051_pindex *ix, uint64_t key)
+{
+	uint32_t lo = 0, hi = ix->nkeys, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo)/2;
+		if (get32(ix->keys + (size_t)mid*KEY_SIZE) < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == ix->nkeys)
+		return ix->npostings;
+	lo = get32(ix->keys + (size_t)lo*KEY_SIZE + 4);
+	return lo < ix->npostings ? lo : ix->npostings;
+}
+
+/* key ranges [lo, hi) of the opcodes of instructions i, i+1 ... that
+ * fit the pattern, at most three and RANGES_MAX ranges */
+struct ranges {
+	uint32_t lo[RANGES_MAX];
+	int n, shift;
+};
+
+static void ranges(const struct dis8051_pattern *p, int i, int off,
+                   struct ranges *r)
+{
+	uint32_t next[RANGES_MAX];
+	int level, k, v, n;
+
+	r->n = 1;
+	r->lo[0] = 0;
+	for (level = 0; level < 3 && i + level < p->n; level++) {
+		for (k = 0, n = 0; k < r->n; k++)
+			for (v = 0; v < 256; v++) {
+				if ((v & p->sig.mask[off]) != p->sig.value[off])
+					continue;
+				if (n == RANGES_MAX)
+					goto full;
+				next[n++] = r->lo[k] << 8 | v;
+			}
+		memcpy(r->lo, next, n*sizeof(*next));
+		r->n = n;
+		off += p->size[i + level];
+	}
+full:
+	r->shift = 8*(3 - level);
+	for (k = 0; k < r->n; k++)
+		r->lo[k] <<= r->shift;
+}
+
+static uint32_t postings(const struct dis8051_pindex *ix,
+                         const struct ranges *r)
+{
+	uint32_t n = 0;
+	int k;
+
+	for (k = 0; k < r->n; k++)
+		n += first(ix, (uint64_t)r->lo[k] + (1u << r->shift)) -
+		     first(ix, r->lo[k]);
+	return n;
+}
+
+struct hit {
+	uint32_t image;
+	uint16_t addr;
+};
+
+static int by_image(const void *a, const void *b)
+{
+	const struct hit *x = a, *y = b;
+
+	if (x->image != y->image)
+		return x->image < y->image ? -1 : 1;
+	return (int)x->addr - (int)y->addr;
+}
+
+static int matches(const struct dis8051_pindex *ix,
+                   const struct dis8051_pattern *p, uint32_t image,
+                   uint32_t addr)
+{
+	const uint8_t *im = ix->images + (size_t)image*IMAGE_SIZE, *c;
+	int k;
+
+	if (addr + p->sig.len > get32(im + 8))
+		return 0;
+	c = ix->code + get32(im + 4) + addr;
+	for (k = 0; k < p->sig.len; k++)
+		if ((c[k] & p->sig.mask[k]) != p->sig.value[k])
+			return 0;
+	return 1;
+}
+
+long dis8051_pindex_find(const struct dis8051_pindex *ix,
+                         const struct dis8051_pattern *p,
+                         dis8051_pindex_fn fn, void *user)
+{
+	struct ranges r, best;
+	struct hit *hits = NULL, *h;
+	size_t nhits = 0, ahits = 0, i;
+	uint32_t n, least = UINT32_MAX, e, image, addr;
+	int k, off, best_off = 0;
+	const uint8_t *q;
+
+	/* the instruction the fewest postings start a run at */
+	best.n = best.shift = 0;
+	for (k = 0, off = 0; k < p->n; off += p->size[k++]) {
+		ranges(p, k, off, &r);
+		if ((n = postings(ix, &r)) < least) {
+			least = n;
+			best = r;
+			best_off = off;
+		}
+	}
+
+	for (k = 0; least && k < best.n; k++) {
+		e = first(ix, (uint64_t)best.lo[k] + (1u << best.shift));
+		for (i = first(ix, best.lo[k]); i < e; i++) {
+			q = ix->postings + i*POSTING_SIZE;
+			image = get32(q);
+			addr = get16(q + 4);
+			if (image >= ix->nimages ||
+			    addr < (uint32_t)best_off ||
+			    !matches(ix, p, image, addr - best_off))
+				continue;
+			if (grow((void **)&hits, &ahits, nhits, 1,
+			         sizeof(*hits))) {
+				free(hits);
+				return -1;
+			}
+			hits[nhits].image = image;
+			hits[nhits++].addr = addr - best_off;
+		}
+	}
+
+	if (nhits)
+		qsort(hits, nhits, sizeof(*hits), by_image);
+	for (h = hits; h < hits + nhits; h++)
+		fn(user, ix->names +
+		   get32(ix->images + (size_t)h->image*IMAGE_SIZE), h->addr);
+	free(hits);
+	return nhits;
+}
@@ -0,0 +1,92 @@
+/* instruction pattern index over many images: the instruction stream
+ * of each is indexed by opcode 3-grams, built once and searched
+ * through a read only mapping of the file */
+
+#ifndef DIS8051_PINDEX_H
+#define DIS8051_PINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-sig.h"
+
+#define DIS8051_PAT_MAX 16   /* instructions of a pattern */
+
+/* instructions in a row, as one byte pattern */
+struct dis8051_pattern {
+	struct dis8051_sig sig;
+	uint8_t size[DIS8051_PAT_MAX];   /* of each instruction */
+	int n;
+};
+
+/* statements as for dis8051_assemble_block() without labels, where '*'
+ * is any value of an operand, "r*" and "@r*" any register, e.g.
+ * "mov dptr,#*; movx a,@dptr; cjne a,#*,*"; returns 0, or -1 with
+ * '*bad' set to the statement in error, counting from 1 */
+int dis8051_pattern_parse(struct dis8051_pattern *p, const char *s,
+                          int *bad);
+
+/* an instruction of the stream of an image, see 'key' */
+struct dis8051_posting {
+	uint32_t key;        /* its opcode and those of the next two */
+	uint32_t image;
+	uint16_t addr;
+};
+
+struct dis8051_pindex_image {
+	uint32_t name;       /* offsets into 'names' and 'code' */
+	uint32_t code;
+	uint32_t len;
+};
+
+struct dis8051_pindex_builder {
+	struct dis8051_pindex_image *images;
+	size_t nimages, aimages;
+	char *names;
+	size_t nnames, anames;
+	uint8_t *code;
+	size_t ncode, acode;
+	struct dis8051_posting *v;
+	size_t count, alloc;
+};
+
+void dis8051_pindex_builder_init(struct dis8051_pindex_builder *b);
+void dis8051_pindex_builder_free(struct dis8051_pindex_builder *b);
+
+/* add 'len' bytes of code at 0 as 'name': the instructions found by
+ * the traversal whose map is 'map', a linear sweep where it found
+ * nothing and everywhere if 'map' is NULL; runs of fill are skipped;
+ * returns 0 on success, -1 if out of memory */
+int dis8051_pindex_add(struct dis8051_pindex_builder *b, const char *name,
+                       const uint8_t *code, size_t len, const uint8_t *map);
+
+/* write the index, images in the order of their names; returns 0 on
+ * success, -1 with errno set */
+int dis8051_pindex_write(struct dis8051_pindex_builder *b,
+                         const char *path);
+
+/* an index file mapped for searching */
+struct dis8051_pindex {
+	void *map;
+	size_t size;
+	uint32_t nimages, nkeys, npostings;
+	const uint8_t *images, *keys, *postings;
+	const char *names;
+	const uint8_t *code;
+};
+
+/* returns 0 on success, -1 with errno set, EINVAL if it is no index */
+int dis8051_pindex_open(struct dis8051_pindex *ix, const char *path);
+void dis8051_pindex_close(struct dis8051_pindex *ix);
+
+typedef void (*dis8051_pindex_fn)(void *user, const char *image,
+                                  uint16_t addr);
+
+/* call 'fn' for each match of 'p' in the index, by image and address;
+ * the postings of the rarest run of up to three opcodes in 'p' are
+ * checked against the code; returns the number of matches, or -1 if
+ * out of memory */
+long dis8051_pindex_find(const struct dis8051_pindex *ix,
+                         const struct dis8051_pattern *p,
+                         dis8051_pindex_fn fn, void *user);
+
+#endif
@@ -1,894 +1,356 @@
-/* 8051/8052 disassembler plugin for radare2 */
+/* 8051/8052 disassembler plugin for radare2, an adapter for libdis8051 */
 /* All 8051/8052 mnemonics (c) Intel Corporation,
  * http://datasheets.chipdb.org/Intel/MCS51/MANUALS/27238302.PDF */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
 #include <r_asm.h>
 #include <r_lib.h>
 #include <r_types.h>
+#include "dis8051.h"
+
+/* symbols of the files in $DIS8051_SYMBOLS, separated by ':', OMF-51
+ * absolute files or SDCC .cdb, .map and .rst; loaded once by whichever
+ * thread gets there first.  The SDCC ones are read again when they
+ * change by a thread of their own, into the copy no one is reading,
+ * which then replaces the other under the write lock; disassembly holds
+ * the read lock for the whole call, and only when there is such a
+ * thread, otherwise nothing changes after loading */
+static pthread_once_t syms_once = PTHREAD_ONCE_INIT;
+static pthread_rwlock_t syms_lock = PTHREAD_RWLOCK_INITIALIZER;
+static struct {
+	struct dis8051_symtab omf;
+	struct dis8051_sdcc sdcc[2];
+	struct dis8051_sdcc *cur;       /* one of 'sdcc', under syms_lock */
+	int *reported;                  /* last error logged, by file */
+	pthread_mutex_t lock;           /* of 'stop' */
+	pthread_cond_t wake;
+	int stop, watching;
+	int locking;                    /* 'watching' but kept after fini() */
+	pthread_t watcher;
+} syms = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.wake = PTHREAD_COND_INITIALIZER
+};
 
-#define STR_BUFFER 20
-
-/* addressing modes,
- * used for mov part 1, 2, 3, cjne, djnz */
-static const char *regs[] = {"@r0", "@r1", "r0", "r1", "r2",
-	"r3", "r4", "r5", "r6", "r7"};
-
-/* SFR map for 8052, used in 'decode_sfr' */
-static const char *sfr_map[] = {
-/* 0x80 -- 0x87 */
-	"P0", "SP", "DPL", "DPH", "", "", "", "PCON",
-/* 0x88 -- 0x8f */
-	"TCON", "TMOD", "TL0", "TL1", "TH0", "TH1", "", "",
-/* 0x90 -- 0x97 */
-	"P1", "", "", "", "", "", "", "",
-/* 0x98 -- 0x9f */
-	"SCON", "SBUF", "", "", "", "", "", "",
-/* 0xa0 -- 0xa7 */
-	"P2", "", "", "", "", "", "", "",
-/* 0xa8 -- 0xaf */
-	"IE", "", "", "", "", "", "", "",
-/* 0xb0 -- 0xb7 */
-	"P3", "", "", "", "", "", "", "",
-/* 0xb8 -- 0xbf */
-	"IP", "", "", "", "", "", "", "",
-/* 0xc0 -- 0xc7 */
-	"", "", "", "", "", "", "", "",
-/* 0xc8 -- 0xcf */
-	"T2CON", "", "RCAP2L", "RCAP2H", "TL2", "TH2", "", "",
-/* 0xd0 -- 0xd7 */
-	"PSW", "", "", "", "", "", "", "",
-/* 0xd8 -- 0xdf */
-	"", "", "", "", "", "", "", "",
-/* 0xe0 -- 0xe7 */
-	"ACC", "", "", "", "", "", "", "",
-/* 0xe8 -- 0xef */
-	"", "", "", "", "", "", "", "",
-/* 0xf0 -- 0xf7 */
-	"B", "", "", "", "", "", "", "",
-/* 0xf8 -- 0xff */
-	"", "", "", "", "", "", "", ""};
-
-/* map of bit addressable SFRs, used in 'decode_bit' */
-static const char *sfr_bit_map[] = {
-/* P0   : 0x80 -- 0x87 */
-	"P0.0", "P0.1", "P0.2", "P0.3", "P0.4", "P0.5", "P0.6", "P0.7",
-/* TCON : 0x88 -- 0x8f */
-	"IT0", "IE0", "IT1", "IE1", "TR0", "TF0", "TR1", "TF1",
-/* P1   : 0x90 -- 0x97 */
-	"P1.0", "P1.1", "P1.2", "P1.3", "P1.4", "P1.5", "P1.6", "P1.7",
-/* SCON : 0x98 -- 0x9f */
-	"RI", "TI", "RB8", "TB8", "REN", "SM2", "SM1", "SM0",
-/* P2   : 0xa0 -- 0xa7 */
-	"P2.0", "P2.1", "P2.2", "P2.3", "P2.4", "P2.5", "P2.6", "P2.7",
-/* IE   : 0xa8 -- 0xaf */
-	"EX0", "ET0", "EX1", "ET1", "ES", "ET2", "IE.6", "EA",
-/* P3   : 0xb0 -- 0xb7 */
-	"P3.0", "P3.1", "P3.2", "P3.3", "P3.4", "P3.5", "P3.6", "P3.7",
-/* IP   : 0xb8 -- 0xbf */
-	"PX0", "PT0", "PX1", "PT1", "PS", "PT2", "IP.6", "IP.7",
-/* --   : 0xc0 -- 0xc7 */
-	"", "", "", "", "", "", "", "",
-/* T2CON: 0xc8 -- 0xcf */
-	"CP/RL2", "CP/T2", "TR2", "EXEN2", "TLCK", "RCLK", "EXF2", "TF2",
-/* PSW  : 0xd0 -- 0xd7 */
-	"P", "PSW.1", "OV", "RS0", "RS1", "F0", "AC", "CY",
-/* --   : 0xd8 -- 0xdf */
-	"", "", "", "", "", "", "", "",
-/* ACC  : 0xe0 -- 0xe7 */
-	"ACC.0", "ACC.1", "ACC.2", "ACC.3", "ACC.4", "ACC.5", "ACC.6", "ACC.7",
-/* --   : 0xe8 -- 0xef */
-	"", "", "", "", "", "", "", "",
-/* B    : 0xf0 -- 0xf7 */
-	"B.0", "B.1", "B.2", "B.3", "B.4", "B.5", "B.6", "B.7",
-/* --   : 0xf8 -- 0xff */
-	"", "", "", "", "", "", "", ""};
-
-/* decode special function registers */
-static void decode_sfr(uint8_t address, char *s)
-{
-	/* SFR: 0x80 - 0xff */
-	if (address >= 0x80) {
-		if (strlen(sfr_map[address-0x80]) > 0) {
-			strncpy(s, sfr_map[address-0x80], STR_BUFFER);
-			return;
-		}
-	}
+static int is_sdcc(const char *path, size_t n) {
+	static const char *const ext[] = {".cdb", ".map", ".rst"};
+	int i;
 
-	snprintf(s, STR_BUFFER, "0x%x", address);
+	for (i = 0; i < 3; i++)
+		if (n > 4 && !strncasecmp(path + n - 4, ext[i], 4))
+			return 1;
+	return 0;
 }
 
-/* decode bit addresses */
-static void decode_bit(uint8_t address, char *s)
-{
-	/* 0x80 -- 0xff: bit addressable SFRs */
-	if (address >= 0x80) {
-		if (strlen(sfr_bit_map[address-0x80]) > 0) {
-			strncpy(s, sfr_bit_map[address-0x80], STR_BUFFER);
-		} else {
-			snprintf(s, STR_BUFFER, "0x%x", address);
-		}
-	/* 0x00 -- 0x7f: bit addressable RAM (0x20 -- 0x2f) */
-	} else {
-		snprintf(s, STR_BUFFER, "0x%x.%i", address/8+0x20, address%8);
-	}
+static void load_omf(const char *path) {
+	struct dis8051_image img;
+	struct dis8051_omf o;
+	int e;
+
+	dis8051_image_init(&img);
+	dis8051_omf_init(&o, &img, &syms.omf);
+	if ((e = dis8051_omf_load_file(&o, path)))
+		eprintf("8051: %s: %s\n", path, dis8051_omf_strerror(e));
+	dis8051_omf_free(&o);
+	dis8051_image_free(&img);
 }
 
-/* decode addressing mode of an instruction,
- * used for inc, dec, add, addc, orl, anl, xrl, subb, xch, mov part 4, 5 */
-static int decode_a_mode(uint8_t low_nibble, uint8_t *buf, char *s)
-{
-	switch (low_nibble) {
-	/* immediate */
-	case 0x4:
-		snprintf(s, STR_BUFFER, "#0x%x", buf[1]);
-		return 2;
-
-	/* memory direct */
-	case 0x5:
-		decode_sfr(buf[1], s);
-		return 2;
-
-	/* register indirect: @r0, @r1 */
-	case 0x6:
-		snprintf(s, STR_BUFFER, "@r0");
-		return 1;
-	case 0x7:
-		snprintf(s, STR_BUFFER, "@r1");
-		return 1;
-
-	/* register direct: r0-r7 */
-	case 0x8:
-	case 0x9:
-	case 0xa:
-	case 0xb:
-	case 0xc:
-	case 0xd:
-	case 0xe:
-	case 0xf:
-		snprintf(s, STR_BUFFER, "r%i", low_nibble-0x8);
-		return 1;
+/* logs the files that could not be read, each error only once */
+static void report(const struct dis8051_sdcc *s) {
+	size_t i;
+
+	for (i = 0; i < s->nfiles; i++) {
+		if (s->files[i].error == syms.reported[i])
+			continue;
+		if (s->files[i].error)
+			eprintf("8051: %s: %s\n", s->files[i].path,
+			        strerror(s->files[i].error));
+		syms.reported[i] = s->files[i].error;
 	}
-
-	return 0;
 }
 
-static int disassemble (RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
-	uint8_t h, l;
-	uint16_t pc, dest;
-	char a_mode[STR_BUFFER], bit_addr[STR_BUFFER], sfr[STR_BUFFER],
-	     sfr2[STR_BUFFER];
-	int size;
-
-	/* get current program counter */
-	pc = a->pc & 0xffff;
-
-	/* high nibble of the opcode specifies the instruction,
-	 * low nibble the addressing mode or an irregular instruction,
-	 * ajmp and acall are exceptions  */
-	h = *buf & 0xf0;
-	l = *buf & 0x0f;
-
-	/* ajmp */
-	if ((*buf & 0x1f) == 0x1) {
-		pc += 2;
-		dest = (pc&0xf800) | (*buf&0xe0)<<3 | buf[1];
-		snprintf(op->buf_asm, R_ASM_BUFSIZE, "ajmp 0x%x", dest);
-		op->size = 2;
-		return 2;
+/* checks the SDCC files once a second until told to stop */
+static void *watch(void *arg) {
+	struct dis8051_sdcc *next;
+	struct timespec t;
+	int n;
+
+	(void)arg;
+	pthread_mutex_lock(&syms.lock);
+	while (!syms.stop) {
+		clock_gettime(CLOCK_REALTIME, &t);
+		t.tv_sec++;
+		pthread_cond_timedwait(&syms.wake, &syms.lock, &t);
+		if (syms.stop)
+			break;
+		pthread_mutex_unlock(&syms.lock);
+
+		/* only this thread ever changes syms.cur */
+		next = syms.cur == &syms.sdcc[0] ? &syms.sdcc[1] : &syms.sdcc[0];
+		if ((n = dis8051_sdcc_reload(next, NULL)) < 0)
+			eprintf("8051: reading symbols: %s\n", strerror(errno));
+		report(next);
+		if (n > 0) {
+			pthread_rwlock_wrlock(&syms_lock);
+			syms.cur = next;
+			pthread_rwlock_unlock(&syms_lock);
+		}
+		pthread_mutex_lock(&syms.lock);
 	}
+	pthread_mutex_unlock(&syms.lock);
+	return NULL;
+}
 
-	/* acall */
-	if ((*buf & 0x1f) == 0x11) {
-		pc += 2;
-		dest = (pc&0xf800) | (*buf&0xe0)<<3 | buf[1];
-		snprintf(op->buf_asm, R_ASM_BUFSIZE, "acall 0x%x", dest);
-		op->size = 2;
-		return 2;
+static void load_symbols(void) {
+	const char *list = getenv("DIS8051_SYMBOLS"), *p;
+	char path[4096];
+	size_t n;
+
+	dis8051_symtab_init(&syms.omf);
+	dis8051_sdcc_init(&syms.sdcc[0]);
+	dis8051_sdcc_init(&syms.sdcc[1]);
+	syms.cur = &syms.sdcc[0];
+	for (; list && *list; list = *p ? p + 1 : p) {
+		p = strchr(list, ':');
+		p = p ? p : list + strlen(list);
+		if ((n = p - list) == 0 || n >= sizeof(path))
+			continue;
+		memcpy(path, list, n);
+		path[n] = '\0';
+		if (!is_sdcc(path, n))
+			load_omf(path);
+		else if (dis8051_sdcc_add(&syms.sdcc[0], path) < 0 ||
+		         dis8051_sdcc_add(&syms.sdcc[1], path) < 0)
+			eprintf("8051: out of memory\n");
 	}
+	if (!syms.cur->nfiles)
+		return;
+	if (!(syms.reported = calloc(syms.cur->nfiles, sizeof(int)))) {
+		eprintf("8051: out of memory\n");
+		return;
+	}
+	if (dis8051_sdcc_reload(syms.cur, NULL) < 0)
+		eprintf("8051: reading symbols: %s\n", strerror(errno));
+	report(syms.cur);
+	if (pthread_create(&syms.watcher, NULL, watch, NULL) == 0)
+		syms.watching = syms.locking = 1;
+	else
+		eprintf("8051: symbols will not be reloaded\n");
+}
 
-	switch (h) {
-	/* inc */
-	case 0x00:
-		/* nop */
-		if (l == 0x0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "nop");
-			op->size = 1;
-			return 1;
-		}
-
-		/* ljmp code16 */
-		if (l == 0x2) {
-			dest = buf[1]<<8 | buf[2];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "ljmp 0x%x", dest);
-			op->size = 3;
-			return 3;
-		}
-
-		/* rr a */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "rr a");
-			op->size = 1;
-			return 1;
-		}
-
-		/* inc a */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "inc a");
-			op->size = 1;
-			return 1;
-		}
-
-		/* inc xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "inc %s", a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* dec */
-	case 0x10:
-		/* jbc bit addr., code addr.*/
-		if (l == 0x0) {
-			pc += 3;
-			decode_bit(buf[1], bit_addr);
-			dest = pc + (int8_t)buf[2];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jbc %s, 0x%x",
-			         bit_addr, dest);
-			op->size = 3;
-			return 3;
-		}
-
-		/* lcall code16 */
-		if (l == 0x2) {
-			dest = buf[1]<<8 | buf[2];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "lcall 0x%x",
-			         dest);
-			op->size = 3;
-			return 3;
-		}
-
-		/* rrc a */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "rrc a");
-			op->size = 1;
-			return 1;
-		}
-
-		/* dec a */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "dec a");
-			op->size = 1;
-			return 1;
-		}
-
-		/* dec xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "dec %s", a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* add */
-	case 0x20:
-		/* jb bit addr., code addr.*/
-		if (l == 0x0) {
-			pc += 3;
-			decode_bit(buf[1], bit_addr);
-			dest = pc + (int8_t)buf[2];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jb %s, 0x%x",
-			         bit_addr, dest);
-			op->size = 3;
-			return 3;
-		}
-
-		/* ret */
-		if (l == 0x2) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "ret");
-			op->size = 1;
-			return 1;
-		}
-
-		/* rl a */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "rl a");
-			op->size = 1;
-			return 1;
-		}
-
-		/* add a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "add a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* addc */
-	case 0x30:
-		/* jnb bit addr., code addr.*/
-		if (l == 0x0) {
-			pc += 3;
-			decode_bit(buf[1], bit_addr);
-			dest = pc + (int8_t)buf[2];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jnb %s, 0x%x",
-			         bit_addr, dest);
-			op->size = 3;
-			return 3;
-		}
-
-		/* reti */
-		if (l == 0x2) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "reti");
-			op->size = 1;
-			return 1;
-		}
-
-		/* rlc a */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "rlc a");
-			op->size = 1;
-			return 1;
-		}
-
-		/* addc a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "addc a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* orl */
-	case 0x40:
-		/* jc code addr.*/
-		if (l == 0x0) {
-			pc += 2;
-			dest = pc + (int8_t)buf[1];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jc 0x%x", dest);
-			op->size = 2;
-			return 2;
-		}
-
-		/* orl data addr., a */
-		if (l == 0x2) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "orl %s, a", sfr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* orl data addr., #imm */
-		if (l == 0x3) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "orl %s, #0x%x",
-			         sfr, buf[2]);
-			op->size = 3;
-			return 3;
-		}
-
-		/* orl a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "orl a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* anl */
-	case 0x50:
-		/* jnc code addr. */
-		if (l == 0x0) {
-			pc += 2;
-			dest = pc + (int8_t)buf[1];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jnc 0x%x", dest);
-			op->size = 2;
-			return 2;
-		}
-
-		/* anl data addr., a */
-		if (l == 0x2) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "anl %s, a", sfr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* anl data addr., #imm */
-		if (l == 0x3) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "anl %s, #0x%x",
-			         sfr, buf[2]);
-			op->size = 3;
-			return 3;
-		}
-
-		/* anl a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "anl a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* xrl */
-	case 0x60:
-		/* jz code addr. */
-		if (l == 0x0) {
-			pc += 2;
-			dest = pc + (int8_t)buf[1];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jz 0x%x", dest);
-			op->size = 2;
-			return 2;
-		}
-
-		/* xrl data addr., a */
-		if (l == 0x2) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "xrl %s, a", sfr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* xrl data addr., #imm */
-		if (l == 0x3) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "xrl %s, #0x%x",
-			         sfr, buf[2]);
-			op->size = 3;
-			return 3;
-		}
-
-		/* xrl a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "xrl a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* mov part 1 */
-	case 0x70:
-		/* jnz code addr. */
-		if (l == 0x0) {
-			pc += 2;
-			dest = pc + (int8_t)buf[1];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jnz 0x%x", dest);
-			op->size = 2;
-			return 2;
-		}
-
-		/* orl c, bit addr. */
-		if (l == 0x2) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "orl c, %s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* jmp @a+dptr */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "jmp @a+dptr");
-			op->size = 1;
-			return 1;
-		}
-
-		/* mov a, #imm */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov a, #0x%x",
-			         buf[1]);
-			op->size = 2;
-			return 2;
-		}
-
-		/* mov data addr., #imm */
-		if (l == 0x5) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov %s, #0x%x",
-			         sfr, buf[2]);
-			op->size = 3;
-			return 3;
-		}
-
-		/* mov xxx, #imm */
-		snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov %s, #0x%x",
-		         regs[l-0x6], buf[1]);
-		op->size = 2;
-		return 2;
-
-	/* mov part 2 */
-	case 0x80:
-		/* sjmp code addr. */
-		if (l == 0x0) {
-			pc += 2;
-			dest = pc + (int8_t)buf[1];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "sjmp 0x%x",
-			         dest);
-			op->size = 2;
-			return 2;
-		}
-
-		/* anl c, bit addr. */
-		if (l == 0x2) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "anl c, %s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* movc a, @a+pc */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movc a, @a+pc");
-			op->size = 1;
-			return 1;
-		}
-
-		/* div */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "div ab");
-			op->size = 1;
-			return 1;
-		}
-
-		/* mov data addr., data addr. */
-		if (l == 0x5) {
-			decode_sfr(buf[1], sfr); /* src */
-			decode_sfr(buf[2], sfr2); /* dest */
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov %s, %s",
-			         sfr2, sfr);
-			op->size = 3;
-			return 3;
-		}
-
-		/* mov data addr., xxx */
-		decode_sfr(buf[1], sfr);
-		snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov %s, %s",
-		         sfr, regs[l-0x6]);
-		op->size = 2;
-		return 2;
-
-	/* subb */
-	case 0x90:
-		/* mov dptr, #imm */
-		if (l == 0x0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov dptr, #0x%x",
-			         ((buf[1]<<8) | buf[2]) & 0xffff);
-			op->size = 3;
-			return 3;
-		}
-
-		/* mov bit addr., c */
-		if (l == 0x2) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov %s, c",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* movc a, @a+dptr */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movc a, @a+dptr");
-			op->size = 1;
-			return 1;
-		}
-
-		/* subb a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "subb a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* mov part 3 */
-	case 0xa0:
-		/* orl c, /bit addr. */
-		if (l == 0x0) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "orl c, /%s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* mov c, bit addr. */
-		if (l == 0x2) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov c, %s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* inc dptr */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "inc dptr");
-			op->size = 1;
-			return 1;
-		}
-
-		/* mul ab */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mul ab");
-			op->size = 1;
-			return 1;
-		}
-
-		/* reserved */
-		if (l == 0x5) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "reserved");
-			/* size is actually not defined */
-			op->size = 1;
-			return 1;
-		}
-
-		/* mov xxx, data addr. */
-		decode_sfr(buf[1], sfr);
-		snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov %s, %s",
-		         regs[l-0x6], sfr);
-		op->size = 2;
-		return 2;
-
-	/* cjne */
-	case 0xb0:
-		/* anl c, /bit addr. */
-		if (l == 0x0) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "anl c, /%s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* cpl bit addr. */
-		if (l == 0x2) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "cpl %s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* cpl c */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "cpl c");
-			op->size = 1;
-			return 1;
-		}
-
-		/* cjne a, #imm, code addr. */
-		if (l == 0x4) {
-			pc += 3;
-			dest = pc + (int8_t)buf[2];
-			snprintf(op->buf_asm, R_ASM_BUFSIZE,
-			         "cjne a, #0x%x, 0x%x", buf[1], dest);
-			op->size = 3;
-			return 3;
-		}
-
-		/* cjne a, data addr., code addr. */
-		if (l == 0x5) {
-			pc += 3;
-			dest = pc + (int8_t)buf[2];
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE,
-			         "cjne a, %s, 0x%x", sfr, dest);
-			op->size = 3;
-			return 3;
-		}
-
-		/* cjne xxx, #imm, code addr. */
-		pc += 3;
-		dest = pc + (int8_t)buf[2];
-		snprintf(op->buf_asm, R_ASM_BUFSIZE,
-		         "cjne %s, #0x%x, 0x%x",
-		         regs[l-0x6], buf[1], dest);
-		op->size = 3;
-		return 3;
-
-	/* xch */
-	case 0xc0:
-		/* push data addr. */
-		if (l == 0x0) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "push %s", sfr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* clr bit addr. */
-		if (l == 0x2) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "clr %s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* clr c */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "clr c");
-			op->size = 1;
-			return 1;
-		}
-
-		/* swap a */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "swap a");
-			op->size = 1;
-			return 1;
-		}
-
-		/* xch a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "xch a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
-
-	/* djnz */
-	case 0xd0:
-		/* pop data addr. */
-		if (l == 0x0) {
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "pop %s", sfr);
-			op->size = 2;
-			return 2;
-		}
-
-		/* setb bit addr. */
-		if (l == 0x2) {
-			decode_bit(buf[1], bit_addr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "setb %s",
-			         bit_addr);
-			op->size = 2;
-			return 2;
-		}
+/* the code of $DIS8051_IMAGE, bank 0, traversed once by whichever
+ * thread gets there first, with the SFR page at each instruction for
+ * each part that has pages; only read after that */
+static pthread_once_t image_once = PTHREAD_ONCE_INIT;
+static struct {
+	uint8_t *code;
+	struct dis8051_flow flow;
+	uint16_t *page[DIS8051_DERIVS];
+} image;
+
+static int read_image(struct dis8051_image *img, const char *path) {
+	struct dis8051_symtab syms;
+	struct dis8051_omf o;
+	const char *ext = strrchr(path, '.');
+	uint8_t buf[4096];
+	uint32_t addr = 0;
+	size_t n;
+	FILE *f;
+	int e;
+
+	ext = ext && !strchr(ext, '/') ? ext : "";
+	if (!strcasecmp(ext, ".hex") || !strcasecmp(ext, ".ihx")) {
+		if (!(e = dis8051_ihex_load(img, path, NULL)))
+			return 0;
+		eprintf("8051: %s: %s\n", path, dis8051_ihex_strerror(e));
+		return -1;
+	}
+	if (!strcasecmp(ext, ".abs") || !strcasecmp(ext, ".omf")) {
+		dis8051_symtab_init(&syms);
+		dis8051_omf_init(&o, img, &syms);
+		e = dis8051_omf_load_file(&o, path);
+		dis8051_omf_free(&o);
+		dis8051_symtab_free(&syms);
+		if (!e || e == DIS8051_OMF_EUNSUPPORTED)
+			return 0;
+		eprintf("8051: %s: %s\n", path, dis8051_omf_strerror(e));
+		return -1;
+	}
+	/* anything else is a raw image at 0 */
+	if (!(f = fopen(path, "rb"))) {
+		eprintf("8051: %s: %s\n", path, strerror(errno));
+		return -1;
+	}
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0 &&
+	       dis8051_image_write(img, addr, buf, n) == 0)
+		addr += n;
+	e = ferror(f) || n > 0;
+	fclose(f);
+	if (e)
+		eprintf("8051: %s: read error\n", path);
+	return e ? -1 : 0;
+}
 
-		/* setb c */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "setb c");
-			op->size = 1;
-			return 1;
-		}
+static void load_image(void) {
+	const char *path = getenv("DIS8051_IMAGE");
+	const struct dis8051_derivative *d;
+	struct dis8051_image img;
+	uint32_t first, last, len;
+	int i;
+
+	if (!path || !*path)
+		return;
+	dis8051_image_init(&img);
+	if (read_image(&img, path) < 0 ||
+	    !dis8051_image_range(&img, &first, &last)) {
+		dis8051_image_free(&img);
+		return;
+	}
+	len = last < 0x10000 ? last + 1 : 0x10000;
+	if ((image.code = malloc(len)))
+		dis8051_image_read(&img, 0, image.code, len, 0xff);
+	dis8051_image_free(&img);
+	if (!image.code ||
+	    dis8051_flow_init(&image.flow, 0, image.code, len, NULL) < 0 ||
+	    dis8051_flow_add_vectors(&image.flow) < 0 ||
+	    dis8051_flow_run(&image.flow) < 0)
+		goto fail;
+	for (i = 0; i < DIS8051_DERIVS; i++) {
+		d = &dis8051_derivatives[i];
+		if (!d->sfrpage)
+			continue;
+		if (!(image.page[i] = malloc(len*sizeof(*image.page[i]))) ||
+		    dis8051_sfrpage_run(&image.flow, d, image.page[i]) < 0)
+			goto fail;
+	}
+	return;
 
-		/* da a */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "da a");
-			op->size = 1;
-			return 1;
-		}
+fail:
+	eprintf("8051: %s: out of memory\n", path);
+	for (i = 0; i < DIS8051_DERIVS; i++) {
+		free(image.page[i]);
+		image.page[i] = NULL;
+	}
+	dis8051_flow_free(&image.flow);
+	free(image.code);
+	image.code = NULL;
+}
 
-		/* djnz data addr., code addr. */
-		if (l == 0x5) {
-			pc += 3;
-			dest = pc + (int8_t)buf[2];
-			decode_sfr(buf[1], sfr);
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "djnz %s, 0x%x",
-			         sfr, dest);
-			op->size = 3;
-			return 3;
-		}
+/* the SFR page at 'pc' of $DIS8051_IMAGE, if r2 shows that code */
+static void set_page(struct dis8051_ctx *ctx, ut64 pc, const ut8 *buf,
+                     int len) {
+	const uint16_t *page;
+	int n;
+
+	pthread_once(&image_once, load_image);
+	if (!(page = image.page[ctx->deriv - dis8051_derivatives]) ||
+	    pc >= (ut64)image.flow.len)
+		return;
+	n = image.flow.len - pc;
+	n = n < len ? n : len;
+	n = n < DIS8051_MAX_INSN ? n : DIS8051_MAX_INSN;
+	if (!memcmp(image.code + pc, buf, n))
+		dis8051_sfrpage_ctx(&image.flow, page, pc, ctx);
+}
 
-		/* xchd a, @r0 */
-		if (l == 0x6) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "xchd a, @r0");
-			op->size = 1;
-			return 1;
-		}
+static const char *symbol(void *user, int space, uint16_t addr) {
+	const struct dis8051_sym *s = dis8051_symtab_find(&syms.omf, space, addr);
 
-		/* xchd a, @r1 */
-		if (l == 0x7) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "xchd a, @r1");
-			op->size = 1;
-			return 1;
-		}
+	return s ? s->name : dis8051_sdcc_name(user, space, addr);
+}
 
-		/* djnz rx, code addr. */
-		pc += 2;
-		dest = pc + (int8_t)buf[1];
-		snprintf(op->buf_asm, R_ASM_BUFSIZE, "djnz %s, 0x%x",
-		         regs[l-0x6], dest);
-		op->size = 2;
-		return 2;
-
-	/* mov part 4 */
-	case 0xe0:
-		/* movx a, @dptr */
-		if (l == 0x0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movx a, @dptr");
-			op->size = 1;
-			return 1;
-		}
+/* takes the read lock if the symbols can change, which put_symbols()
+ * gives back */
+static void get_symbols(struct dis8051_ctx *ctx) {
+	pthread_once(&syms_once, load_symbols);
+	if (syms.locking)
+		pthread_rwlock_rdlock(&syms_lock);
+	if (syms.omf.count || syms.cur->nfiles) {
+		ctx->symbol = symbol;
+		ctx->user = syms.cur;
+	}
+}
 
-		/* movx a, @r0 */
-		if (l == 0x2) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movx a, @r0");
-			op->size = 1;
-			return 1;
-		}
+static void put_symbols(void) {
+	if (syms.locking)
+		pthread_rwlock_unlock(&syms_lock);
+}
 
-		/* movx a, @r1 */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movx a, @r1");
-			op->size = 1;
-			return 1;
-		}
+static int fini(void *user) {
+	(void)user;
+	if (!syms.watching)
+		return 0;
+	pthread_mutex_lock(&syms.lock);
+	syms.stop = 1;
+	pthread_cond_signal(&syms.wake);
+	pthread_mutex_unlock(&syms.lock);
+	pthread_join(syms.watcher, NULL);
+	syms.watching = 0;
+	return 0;
+}
 
-		/* clr a */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "clr a");
-			op->size = 1;
-			return 1;
-		}
+/* asm.cpu selects the derivative; put_symbols() when done */
+static void init_ctx(RAsm *a, struct dis8051_ctx *ctx) {
+	const struct dis8051_derivative *d;
 
-		/* mov a, xxx */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov a, %s",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
+	dis8051_ctx_init(ctx);
+	if ((d = dis8051_derivative(a->cpu)))
+		ctx->deriv = d;
+	get_symbols(ctx);
+}
 
-	/* mov part 5 */
-	case 0xf0:
-		/* movx @dptr, a */
-		if (l == 0x0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movx @dptr, a");
-			op->size = 1;
-			return 1;
-		}
 
-		/* movx @r0, a */
-		if (l == 0x2) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movx @r0, a");
-			op->size = 1;
-			return 1;
-		}
+static int disassemble (RAsm *a, RAsmOp *op, const ut8 *buf, int len) {
+	struct dis8051_insn insn;
+	struct dis8051_ctx ctx;
 
-		/* movx @r1, a */
-		if (l == 0x3) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "movx @r1, a");
-			op->size = 1;
-			return 1;
-		}
+	if (len < 1)
+		return 0;
 
-		/* cpl a */
-		if (l == 0x4) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "cpl a");
-			op->size = 1;
-			return 1;
-		}
+	/* per call, only the symbol tables and the image are shared */
+	init_ctx(a, &ctx);
+	set_page(&ctx, a->pc, buf, len);
 
-		/* mov xxx, a */
-		if ((size = decode_a_mode(l, (uint8_t *)buf, a_mode)) > 0) {
-			snprintf(op->buf_asm, R_ASM_BUFSIZE, "mov %s, a",
-			         a_mode);
-			op->size = size;
-			return size;
-		}
+	/* banked images are mapped bank:address (8051-codebank.h),
+	 * the CPU only sees the address within the bank window */
+	if (!dis8051_decode_deriv(ctx.deriv, a->pc & 0xffff, buf, len, &insn)) {
+		put_symbols();
+		return 0;
 	}
+	dis8051_render(&ctx, &insn, op->buf_asm, R_ASM_BUFSIZE);
+	put_symbols();
+	op->size = insn.size;
+	return insn.size;
+}
 
-	return 0;
+static int assemble (RAsm *a, RAsmOp *op, const char *buf) {
+	struct dis8051_ctx ctx;
+
+	init_ctx(a, &ctx);
+	op->size = dis8051_assemble(&ctx, a->pc & 0xffff, buf, op->buf);
+	put_symbols();
+	return op->size;
 }
 
 RAsmPlugin r_asm_plugin_mycpu = {
         .name = "8051-plugin",
         .arch = "8051",
+        .cpus = DIS8051_DERIV_NAMES,
         .license = "MIT License",
         .bits = 8,
         .desc = "8051/8052 plugin",
         .disassemble = &disassemble,
 	.init = NULL,
-	.fini = NULL,
+	.fini = &fini,
 	.modify = NULL,
-	.assemble = NULL
+	.assemble = &assemble
 };
 
 #ifndef CORELIB
@@ -0,0 +1,320 @@
+/* 8051/8052 instruction rendering: disassembler syntax and ESIL */
+/* All 8051/8052 mnemonics (c) Intel Corporation,
+ * http://datasheets.chipdb.org/Intel/MCS51/MANUALS/27238302.PDF */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <strings.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-render.h"
+
+/* output buffer, 'len' counts what did not fit as well */
+struct out {
+	char *s;
+	size_t n;
+	size_t len;
+};
+
+static void put(struct out *o, const char *fmt, ...)
+{
+	va_list ap;
+	int r;
+
+	va_start(ap, fmt);
+	r = vsnprintf(o->len < o->n ? o->s + o->len : NULL,
+	              o->len < o->n ? o->n - o->len : 0, fmt, ap);
+	va_end(ap);
+	if (r > 0)
+		o->len += r;
+}
+
+static int done(struct out *o)
+{
+	return o->len < o->n ? (int)o->len : -1;
+}
+
+const struct dis8051_derivative *dis8051_derivative(const char *name)
+{
+	int i;
+
+	for (i = 0; name && i < DIS8051_DERIVS; i++)
+		if (!strcasecmp(dis8051_derivatives[i].name, name))
+			return &dis8051_derivatives[i];
+	return NULL;
+}
+
+void dis8051_ctx_init(struct dis8051_ctx *ctx)
+{
+	ctx->deriv = &dis8051_derivatives[0];
+	ctx->syntax = DIS8051_SYNTAX_DEFAULT;
+	ctx->symbol = NULL;
+	ctx->user = NULL;
+	ctx->page = 0;
+}
+
+static const struct dis8051_derivative *deriv(const struct dis8051_ctx *ctx)
+{
+	return ctx && ctx->deriv ? ctx->deriv : &dis8051_derivatives[0];
+}
+
+/* names of the SFR page of 'ctx', page 0 is the derivative itself */
+static const struct dis8051_sfr_page *page(const struct dis8051_ctx *ctx,
+                                          const struct dis8051_derivative *d)
+{
+	int i;
+
+	for (i = 0; ctx && ctx->page > 0 && i < d->npages; i++)
+		if (d->pages[i].page == ctx->page)
+			return &d->pages[i];
+	return NULL;
+}
+
+const char *dis8051_sfr_name(const struct dis8051_ctx *ctx, uint8_t addr)
+{
+	const struct dis8051_derivative *d = deriv(ctx);
+	const struct dis8051_sfr_page *p = page(ctx, d);
+	const char *const *sfr = p ? p->sfr : d->sfr;
+
+	/* SFR: 0x80 - 0xff */
+	if (addr >= 0x80 && *sfr[addr-0x80])
+		return sfr[addr-0x80];
+	return NULL;
+}
+
+const char *dis8051_bit_name(const struct dis8051_ctx *ctx, uint8_t addr)
+{
+	const struct dis8051_derivative *d = deriv(ctx);
+	const struct dis8051_sfr_page *p = page(ctx, d);
+	const char *const *bit = p ? p->bit : d->bit;
+
+	/* 0x80 -- 0xff: bit addressable SFRs */
+	if (addr >= 0x80 && *bit[addr-0x80])
+		return bit[addr-0x80];
+	return NULL;
+}
+
+static const char *symbol(const struct dis8051_ctx *ctx, int space,
+                          uint16_t addr)
+{
+	return ctx && ctx->symbol ? ctx->symbol(ctx->user, space, addr) : NULL;
+}
+
+/* 0x1f, or 1fh with a leading 0 before a-f */
+static void put_num(struct out *o, const struct dis8051_ctx *ctx,
+                    unsigned v)
+{
+	if (ctx && ctx->syntax == DIS8051_SYNTAX_A51) {
+		char t[8];
+
+		snprintf(t, sizeof(t), "%x", v);
+		put(o, "%s%sh", *t > '9' ? "0" : "", t);
+	} else {
+		put(o, "0x%x", v);
+	}
+}
+
+static void put_sfr(struct out *o, const struct dis8051_ctx *ctx,
+                    uint8_t addr)
+{
+	const char *name = symbol(ctx, addr < 0x80 ? DIS8051_SPACE_IRAM :
+	                          DIS8051_SPACE_SFR, addr);
+
+	if (name || (name = dis8051_sfr_name(ctx, addr)))
+		put(o, "%s", name);
+	else
+		put_num(o, ctx, addr);
+}
+
+static void put_bit(struct out *o, const struct dis8051_ctx *ctx,
+                    uint8_t addr)
+{
+	const char *name = symbol(ctx, DIS8051_SPACE_BIT, addr);
+
+	if (name || (name = dis8051_bit_name(ctx, addr))) {
+		put(o, "%s", name);
+	/* 0x00 -- 0x7f: bit addressable RAM (0x20 -- 0x2f) */
+	} else if (addr < 0x80) {
+		put_num(o, ctx, addr/8+0x20);
+		put(o, ".%i", addr%8);
+	} else {
+		put_num(o, ctx, addr);
+	}
+}
+
+static void put_code(struct out *o, const struct dis8051_ctx *ctx,
+                     uint16_t addr)
+{
+	const char *name = symbol(ctx, DIS8051_SPACE_CODE, addr);
+
+	if (name)
+		put(o, "%s", name);
+	else
+		put_num(o, ctx, addr);
+}
+
+static void put_opnd(struct out *o, const struct dis8051_ctx *ctx,
+                     const struct dis8051_insn *in, int n)
+{
+	switch (in->opnd[n]) {
+	case DIS8051_OPND_A:      put(o, "a"); break;
+	case DIS8051_OPND_AB:     put(o, "ab"); break;
+	case DIS8051_OPND_C:      put(o, "c"); break;
+	case DIS8051_OPND_DPTR:   put(o, "dptr"); break;
+	case DIS8051_OPND_RN:     put(o, "r%i", in->val[n]); break;
+	case DIS8051_OPND_IRI:    put(o, "@r%i", in->val[n]); break;
+	case DIS8051_OPND_IDPTR:  put(o, "@dptr"); break;
+	case DIS8051_OPND_IADPTR: put(o, "@a+dptr"); break;
+	case DIS8051_OPND_IAPC:   put(o, "@a+pc"); break;
+	case DIS8051_OPND_DIRECT: put_sfr(o, ctx, in->val[n]); break;
+	case DIS8051_OPND_BIT:    put_bit(o, ctx, in->val[n]); break;
+	case DIS8051_OPND_NBIT:   put(o, "/"); put_bit(o, ctx, in->val[n]); break;
+	case DIS8051_OPND_IMM8:
+	case DIS8051_OPND_IMM16:  put(o, "#"); put_num(o, ctx, in->val[n]); break;
+	default:                  put_code(o, ctx, in->val[n]); break;
+	}
+}
+
+int dis8051_render(const struct dis8051_ctx *ctx,
+                   const struct dis8051_insn *insn, char *s, size_t n)
+{
+	struct out o = {s, n, 0};
+	int i;
+
+	put(&o, "%s", dis8051_mnem_names[insn->mnem]);
+	for (i = 0; i < 3 && insn->opnd[i]; i++) {
+		put(&o, i ? ", " : " ");
+		put_opnd(&o, ctx, insn, i);
+	}
+	return done(&o);
+}
+
+/* register name of a direct operand, a, b and sp are ESIL registers */
+static const char *esil_reg(uint8_t addr)
+{
+	switch (addr) {
+	case DIS8051_SFR_ACC: return "a";
+	case DIS8051_SFR_B:   return "b";
+	case DIS8051_SFR_SP:  return "sp";
+	}
+	return NULL;
+}
+
+static void esil_addr(struct out *o, uint8_t addr)
+{
+	put(o, addr < 0x80 ? "0x%x,_idata,+" : "0x%x,_sfr,+", addr);
+}
+
+/* address of the byte holding bit 'addr' */
+static void esil_bit_addr(struct out *o, uint8_t addr)
+{
+	esil_addr(o, addr < 0x80 ? 0x20 + addr/8 : addr & 0xf8);
+}
+
+static void esil_read(struct out *o, const struct dis8051_insn *in, int n)
+{
+	const char *reg;
+
+	switch (in->opnd[n]) {
+	case DIS8051_OPND_A:      put(o, "a"); break;
+	case DIS8051_OPND_AB:     put(o, "ab"); break;
+	case DIS8051_OPND_C:      put(o, "c"); break;
+	case DIS8051_OPND_DPTR:   put(o, "dptr"); break;
+	case DIS8051_OPND_RN:     put(o, "r%i", in->val[n]); break;
+	case DIS8051_OPND_IRI:    put(o, "r%i,_idata,+,[1]", in->val[n]); break;
+	case DIS8051_OPND_IDPTR:  put(o, "dptr,_xdata,+,[1]"); break;
+	case DIS8051_OPND_IADPTR: put(o, "a,dptr,+,[1]"); break;
+	case DIS8051_OPND_IAPC:   put(o, "a,pc,+,[1]"); break;
+	case DIS8051_OPND_DIRECT:
+		if ((reg = esil_reg(in->val[n]))) {
+			put(o, "%s", reg);
+		} else {
+			esil_addr(o, in->val[n]);
+			put(o, ",[1]");
+		}
+		break;
+	case DIS8051_OPND_BIT:
+	case DIS8051_OPND_NBIT:
+		put(o, "%i,", in->val[n] & 0x7);
+		esil_bit_addr(o, in->val[n]);
+		put(o, ",[1],>>,1,&");
+		break;
+	default:
+		put(o, "0x%x", in->val[n]);
+		break;
+	}
+}
+
+/* store the value on top of the stack */
+static void esil_write(struct out *o, const struct dis8051_insn *in, int n)
+{
+	const char *reg;
+	uint8_t mask;
+
+	switch (in->opnd[n]) {
+	case DIS8051_OPND_IRI:
+		put(o, "r%i,_idata,+,=[1]", in->val[n]);
+		break;
+	case DIS8051_OPND_DIRECT:
+		if ((reg = esil_reg(in->val[n]))) {
+			put(o, "%s,=", reg);
+		} else {
+			esil_addr(o, in->val[n]);
+			put(o, ",=[1]");
+		}
+		break;
+	case DIS8051_OPND_BIT:
+		mask = 1 << (in->val[n] & 0x7);
+		put(o, "?{,0x%x,", mask);
+		esil_bit_addr(o, in->val[n]);
+		put(o, ",[1],|,");
+		esil_bit_addr(o, in->val[n]);
+		put(o, ",=[1],}{,0x%x,", (uint8_t)~mask);
+		esil_bit_addr(o, in->val[n]);
+		put(o, ",[1],&,");
+		esil_bit_addr(o, in->val[n]);
+		put(o, ",=[1],}");
+		break;
+	default:
+		esil_read(o, in, n);
+		put(o, ",=");
+		break;
+	}
+}
+
+/* xdata address of a movx pointer, P2 is ignored for @r0, @r1 */
+static void esil_xdata(struct out *o, const struct dis8051_insn *in, int n)
+{
+	if (in->opnd[n] == DIS8051_OPND_IRI)
+		put(o, "r%i,_xdata,+", in->val[n]);
+	else
+		put(o, "dptr,_xdata,+");
+}
+
+int dis8051_esil(const struct dis8051_insn *insn, char *s, size_t n)
+{
+	const char *t = insn->esil;
+	struct out o = {s, n, 0};
+	int k;
+
+	if (n > 0)
+		*s = '\0';
+	for (; *t; t++) {
+		/* {n}, {=n}, {xn}, anything else is copied */
+		if (t[0] == '{' && t[1] >= '0' && t[1] <= '2' && t[2] == '}') {
+			esil_read(&o, insn, t[1] - '0');
+			t += 2;
+		} else if (t[0] == '{' && (t[1] == '=' || t[1] == 'x') &&
+		           t[2] >= '0' && t[2] <= '2' && t[3] == '}') {
+			k = t[2] - '0';
+			if (t[1] == '=')
+				esil_write(&o, insn, k);
+			else
+				esil_xdata(&o, insn, k);
+			t += 3;
+		} else {
+			put(&o, "%c", *t);
+		}
+	}
+	return done(&o);
+}
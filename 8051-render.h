@@ -0,0 +1,82 @@
+/* 8051/8052 instruction rendering: disassembler syntax and ESIL */
+
+#ifndef DIS8051_RENDER_H
+#define DIS8051_RENDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-xref.h"
+
+/* names of an SFR page other than 0 */
+struct dis8051_sfr_page {
+	uint8_t page;
+	const char *const *sfr;
+	const char *const *bit;
+};
+
+/* SFR and bit names of a part, generated from 8051.sfr */
+struct dis8051_derivative {
+	const char *name;
+	const char *const *sfr;   /* 0x80 -- 0xff, "" if unnamed */
+	const char *const *bit;   /* 0x80 -- 0xff, "" if unnamed */
+	uint8_t sfrpage;          /* SFR selecting the page, 0 if none */
+	uint8_t page_mask;        /* its bits that do */
+	uint8_t npages;
+	const struct dis8051_sfr_page *pages;
+	uint8_t dps;              /* SFR selecting DPTR1, 0 if none */
+	uint8_t dps_sel;          /* its bit that does */
+	uint8_t dps_inc;          /* bit making movx @dptr step, or 0 */
+	uint8_t dps_dec[2];       /* bits making DPTR0 / 1 step down, or 0 */
+	uint8_t dptr1;            /* DPL1, DPH1 follows; 0 if DPL and DPH
+	                           * are the selected DPTR */
+	uint8_t next;
+	const struct dis8051_ext *ext;  /* opcodes in reserved slots */
+};
+
+/* the first one, the 8052, is the default */
+extern const struct dis8051_derivative dis8051_derivatives[DIS8051_DERIVS];
+
+/* derivative called 'name' (DIS8051_DERIV_NAMES), NULL if unknown */
+const struct dis8051_derivative *dis8051_derivative(const char *name);
+
+/* number syntax */
+#define DIS8051_SYNTAX_DEFAULT 0  /* 0x1f */
+#define DIS8051_SYNTAX_A51     1  /* 1fh, 0ffh as ASM51 / A51 */
+
+/* name of 'addr' in 'space' (enum dis8051_space), NULL if none */
+typedef const char *(*dis8051_symbol_fn)(void *user, int space,
+                                         uint16_t addr);
+
+/* rendering options of a session; rendering only reads it and all
+ * tables are const, so one context can serve any number of threads
+ * as long as 'symbol' is thread-safe as well */
+struct dis8051_ctx {
+	const struct dis8051_derivative *deriv;
+	int syntax;                /* DIS8051_SYNTAX_* */
+	dis8051_symbol_fn symbol;  /* user symbols, before SFR names */
+	void *user;                /* passed to 'symbol' */
+	int page;                  /* SFR page, see 8051-sfrpage.h */
+};
+
+/* default derivative and syntax, no symbols, SFR page 0; selecting
+ * another derivative only sets 'deriv' */
+void dis8051_ctx_init(struct dis8051_ctx *ctx);
+
+/* name of SFR / SFR bit 'addr' in the derivative and SFR page of 'ctx',
+ * page 0 for pages it has no names of, NULL if it has none;
+ * 'ctx' may be NULL for the defaults */
+const char *dis8051_sfr_name(const struct dis8051_ctx *ctx, uint8_t addr);
+const char *dis8051_bit_name(const struct dis8051_ctx *ctx, uint8_t addr);
+
+/* render 'insn' into 's' as the disassembler prints it, 'ctx' may be
+ * NULL for the defaults,
+ * returns the length or -1 if it does not fit into 'n' bytes */
+int dis8051_render(const struct dis8051_ctx *ctx,
+                   const struct dis8051_insn *insn, char *s, size_t n);
+
+/* render the ESIL of 'insn' from its template in 8051.isa,
+ * returns the length or -1 if it does not fit into 'n' bytes */
+int dis8051_esil(const struct dis8051_insn *insn, char *s, size_t n);
+
+#endif
@@ -0,0 +1,590 @@
+/* SDCC debug information: .cdb, linker .map and .rst listings,
+ * reloaded file by file as they change */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "8051-sdcc.h"
+#include "8051-xref.h"
+
+/* a symbol record of a .cdb, the key is scope$name$level$block */
+struct decl {
+	const char *key;
+	size_t len;
+	int space;          /* enum dis8051_space, -1 for none */
+	uint32_t size;
+	int func;
+	int has_addr, has_end;
+	uint32_t addr, end;
+};
+
+/* a whole file being read */
+struct text {
+	const char *p, *end;
+};
+
+void dis8051_sdcc_init(struct dis8051_sdcc *s)
+{
+	memset(s, 0, sizeof(*s));
+}
+
+static void file_free(struct dis8051_sdcc_file *f)
+{
+	dis8051_symtab_free(&f->syms);
+	free(f->spans);
+	f->spans = NULL;
+	f->nspans = f->aspans = 0;
+}
+
+void dis8051_sdcc_free(struct dis8051_sdcc *s)
+{
+	size_t i;
+
+	for (i = 0; i < s->nfiles; i++) {
+		file_free(&s->files[i]);
+		free(s->files[i].path);
+	}
+	free(s->files);
+	dis8051_spans_free(&s->index);
+	memset(s, 0, sizeof(*s));
+}
+
+int dis8051_sdcc_add(struct dis8051_sdcc *s, const char *path)
+{
+	struct dis8051_sdcc_file *f;
+	size_t n = strlen(path);
+
+	if (!(f = realloc(s->files, (s->nfiles + 1)*sizeof(*f))))
+		return -1;
+	s->files = f;
+	f += s->nfiles;
+	memset(f, 0, sizeof(*f));
+	if (!(f->path = malloc(n + 1)))
+		return -1;
+	memcpy(f->path, path, n + 1);
+	f->mtime = f->size = -1;
+	dis8051_symtab_init(&f->syms);
+	s->nfiles++;
+	return 0;
+}
+
+static int push(struct dis8051_sdcc_file *f, int space, int kind,
+                uint32_t start, uint32_t end, const char *name,
+                uint32_t line)
+{
+	struct dis8051_span *v;
+	size_t n;
+
+	if (f->nspans == f->aspans) {
+		n = f->aspans ? f->aspans*2 : 256;
+		if (!(v = realloc(f->spans, n*sizeof(*v))))
+			return -1;
+		f->spans = v;
+		f->aspans = n;
+	}
+	v = &f->spans[f->nspans++];
+	v->start = start;
+	v->end = end;
+	v->space = space;
+	v->kind = kind;
+	v->line = line;
+	v->name = name;
+	return 0;
+}
+
+/* next line without its newline, 0 at the end */
+static int next_line(struct text *t, const char **s, size_t *n)
+{
+	const char *nl;
+
+	if (t->p >= t->end)
+		return 0;
+	nl = memchr(t->p, '\n', t->end - t->p);
+	*s = t->p;
+	*n = (nl ? nl : t->end) - t->p;
+	t->p = nl ? nl + 1 : t->end;
+	if (*n > 0 && (*s)[*n-1] == '\r')
+		(*n)--;
+	return 1;
+}
+
+static int hex_digit(char c)
+{
+	return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+	       (c >= 'A' && c <= 'F');
+}
+
+/* hex number of at least 'min' digits at 'p', returns the digits */
+static size_t hex(const char *p, const char *end, size_t min, uint32_t *v)
+{
+	size_t n;
+
+	for (n = 0; p + n < end && hex_digit(p[n]); n++)
+		;
+	if (n < min || n > 8)
+		return 0;
+	*v = strtoul(p, NULL, 16);
+	return n;
+}
+
+/* 'word' somewhere in the 'n' bytes at 's' */
+static int contains(const char *s, size_t n, const char *word)
+{
+	size_t k = strlen(word);
+
+	for (; n >= k; s++, n--)
+		if (!memcmp(s, word, k))
+			return 1;
+	return 0;
+}
+
+/* copy of the source file name of a line record, the same one as the
+ * last record's if they are equal */
+static const char *source(struct dis8051_sdcc_file *f, const char **last,
+                          const char *name, size_t n)
+{
+	if (*last && strlen(*last) == n && !memcmp(*last, name, n))
+		return *last;
+	return *last = dis8051_symtab_intern(&f->syms, name, n);
+}
+
+/* --- .cdb --- */
+
+static int cdb_space(char c)
+{
+	switch (c) {
+	case 'C': case 'D': return DIS8051_SPACE_CODE;
+	case 'E': case 'G': return DIS8051_SPACE_IRAM;
+	case 'F': case 'P': return DIS8051_SPACE_XDATA;
+	case 'H': case 'J': return DIS8051_SPACE_BIT;
+	case 'I':           return DIS8051_SPACE_SFR;
+	}
+	/* stacks, registers, none */
+	return -1;
+}
+
+static int decl_cmp(const void *a, const void *b)
+{
+	const struct decl *x = a, *y = b;
+	int r = memcmp(x->key, y->key, x->len < y->len ? x->len : y->len);
+
+	return r ? r : (x->len > y->len) - (x->len < y->len);
+}
+
+static struct decl *decl_find(struct decl *d, size_t n, const char *key,
+                              size_t len)
+{
+	struct decl k = {key, len, 0, 0, 0, 0, 0, 0, 0};
+
+	return bsearch(&k, d, n, sizeof(*d), decl_cmp);
+}
+
+/* S:key({size}type),space,... and F: the same for functions */
+static int cdb_decl(const char *s, size_t n, struct decl *d)
+{
+	const char *end = s + n, *p;
+
+	d->key = s + 2;
+	if (!(p = memchr(d->key, '(', end - d->key)))
+		return -1;
+	d->len = p - d->key;
+	d->size = p[1] == '{' ? strtoul(p + 2, NULL, 10) : 1;
+	if (!(p = memchr(p, ')', end - p)) || end - p < 3 || p[1] != ',')
+		return -1;
+	d->space = cdb_space(p[2]);
+	d->func = s[0] == 'F';
+	d->has_addr = d->has_end = 0;
+	return 0;
+}
+
+/* C$file$line$level$block or A$file$line */
+static int cdb_line(struct dis8051_sdcc_file *f, const char **last,
+                    struct dis8051_span *l, const char *key, size_t len,
+                    uint32_t addr)
+{
+	const char *end = key + len, *file = key + 2, *p;
+
+	if (!(p = memchr(file, '$', end - file)))
+		return 0;
+	l->start = addr;
+	l->end = addr + 1;
+	l->space = DIS8051_SPACE_CODE;
+	l->kind = DIS8051_SPAN_LINE;
+	l->line = strtoul(p + 1, NULL, 10);
+	if (!(l->name = source(f, last, file, p - file)))
+		return -1;
+	return 1;
+}
+
+static int line_cmp(const void *a, const void *b)
+{
+	const struct dis8051_span *x = a, *y = b;
+
+	return (x->start > y->start) - (x->start < y->start);
+}
+
+/* lines run up to the next one at a higher address */
+static void line_ends(struct dis8051_span *l, size_t n)
+{
+	uint32_t next = 0;
+	int have = 0;
+	size_t i;
+
+	qsort(l, n, sizeof(*l), line_cmp);
+	for (i = n; i-- > 0; ) {
+		if (have && next > l[i].start)
+			l[i].end = next;
+		if (i == 0 || l[i-1].start != l[i].start) {
+			next = l[i].start;
+			have = 1;
+		}
+	}
+}
+
+/* name in scope$name$level$block */
+static void decl_name(const struct decl *d, const char **s, size_t *n)
+{
+	const char *end = d->key + d->len, *p, *q;
+
+	p = memchr(d->key, '$', d->len);
+	p = p ? p + 1 : d->key;
+	q = memchr(p, '$', end - p);
+	*s = p;
+	*n = (q ? q : end) - p;
+}
+
+static int cdb(struct dis8051_sdcc_file *f, struct text t)
+{
+	struct dis8051_span *lines = NULL, *l;
+	struct decl *d = NULL, *e, *x;
+	size_t nd = 0, ad = 0, nl = 0, al = 0, n, len, k;
+	const char *s, *key, *name, *last = NULL;
+	struct text t2 = t;
+	uint32_t addr;
+	int r = -1;
+
+	/* declarations first, the addresses may come before them */
+	while (next_line(&t, &s, &n)) {
+		if (n < 3 || (s[0] != 'S' && s[0] != 'F') || s[1] != ':')
+			continue;
+		if (nd == ad) {
+			ad = ad ? ad*2 : 256;
+			if (!(e = realloc(d, ad*sizeof(*e))))
+				goto out;
+			d = e;
+		}
+		if (cdb_decl(s, n, &d[nd]) == 0)
+			nd++;
+	}
+	qsort(d, nd, sizeof(*d), decl_cmp);
+
+	/* L:key:addr */
+	while (next_line(&t2, &s, &n)) {
+		if (n < 3 || s[0] != 'L' || s[1] != ':')
+			continue;
+		key = s + 2;
+		for (len = n - 2; len > 0 && key[len-1] != ':'; len--)
+			;
+		if (len < 2 || !hex(key + len, s + n, 1, &addr))
+			continue;
+		len--;
+
+		if (len > 2 && (key[0] == 'C' || key[0] == 'A') &&
+		    key[1] == '$') {
+			if (nl == al) {
+				al = al ? al*2 : 1024;
+				if (!(l = realloc(lines, al*sizeof(*l))))
+					goto out;
+				lines = l;
+			}
+			switch (cdb_line(f, &last, &lines[nl], key, len, addr)) {
+			case -1: goto out;
+			case 1:  nl++;
+			}
+		} else if (key[0] == 'X') {
+			if ((x = decl_find(d, nd, key + 1, len - 1))) {
+				x->end = addr;
+				x->has_end = 1;
+			}
+		} else if ((x = decl_find(d, nd, key, len))) {
+			x->addr = addr;
+			x->has_addr = 1;
+		}
+	}
+
+	for (e = d; e < d + nd; e++) {
+		if (!e->has_addr || e->space < 0)
+			continue;
+		decl_name(e, &name, &k);
+		if (dis8051_symtab_add(&f->syms, e->space, e->addr, name, k) < 0)
+			goto out;
+		/* the name just added is the last one */
+		name = f->syms.syms[f->syms.count - 1].name;
+		if (e->func ?
+		    push(f, e->space, DIS8051_SPAN_FUNC, e->addr,
+		         e->has_end && e->end >= e->addr ? e->end + 1 :
+		         e->addr + 1, name, 0) :
+		    push(f, e->space, DIS8051_SPAN_VAR, e->addr,
+		         e->addr + (e->size ? e->size : 1), name, 0))
+			goto out;
+	}
+
+	line_ends(lines, nl);
+	for (k = 0; k < nl; k++)
+		if (push(f, lines[k].space, lines[k].kind, lines[k].start,
+		         lines[k].end, lines[k].name, lines[k].line) < 0)
+			goto out;
+	r = 0;
+out:
+	free(d);
+	free(lines);
+	return r;
+}
+
+/* --- .map --- */
+
+static int map_space(const char *attr, size_t n)
+{
+	/* (REL,CON,XDATA) */
+	const char *p = memchr(attr, '(', n);
+	size_t k;
+
+	if (!p)
+		return -1;
+	k = attr + n - p;
+	if (contains(p, k, "XDATA"))
+		return DIS8051_SPACE_XDATA;
+	if (contains(p, k, "CODE"))
+		return DIS8051_SPACE_CODE;
+	if (contains(p, k, "BIT"))
+		return DIS8051_SPACE_BIT;
+	if (contains(p, k, "DATA"))
+		return DIS8051_SPACE_IRAM;
+	return -1;
+}
+
+static int map(struct dis8051_sdcc_file *f, struct text t)
+{
+	const char *s, *end, *name;
+	int area = -1, space;
+	uint32_t addr;
+	size_t n, k;
+
+	while (next_line(&t, &s, &n)) {
+		end = s + n;
+		/* area headers: NAME addr size = n. bytes (attributes) */
+		if (contains(s, n, "bytes (")) {
+			area = map_space(s, n);
+			continue;
+		}
+
+		/* globals: [C:] addr name module */
+		while (s < end && (*s == ' ' || *s == '\t'))
+			s++;
+		space = area;
+		if (end - s > 2 && s[1] == ':') {
+			switch (s[0]) {
+			case 'C': space = DIS8051_SPACE_CODE; break;
+			case 'X': space = DIS8051_SPACE_XDATA; break;
+			case 'D':
+			case 'I': space = DIS8051_SPACE_IRAM; break;
+			case 'B': space = DIS8051_SPACE_BIT; break;
+			default:  continue;
+			}
+			s += 2;
+			while (s < end && *s == ' ')
+				s++;
+		}
+		if (!(k = hex(s, end, 4, &addr)) || s + k == end ||
+		    (s[k] != ' ' && s[k] != '\t'))
+			continue;
+		for (s += k; s < end && (*s == ' ' || *s == '\t'); s++)
+			;
+		for (name = s; s < end && *s != ' ' && *s != '\t'; s++)
+			;
+		if (s == name || space < 0)
+			continue;
+		if (space == DIS8051_SPACE_IRAM && addr >= 0x80)
+			space = DIS8051_SPACE_SFR;
+
+		if (dis8051_symtab_add(&f->syms, space, addr, name,
+		                       s - name) < 0 ||
+		    push(f, space, DIS8051_SPAN_VAR, addr, addr + 1,
+		         f->syms.syms[f->syms.count - 1].name, 0) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/* --- .rst --- */
+
+static int rst(struct dis8051_sdcc_file *f, struct text t)
+{
+	const char *s, *end, *name;
+	uint32_t addr, line = 0, size;
+	size_t n, k;
+
+	if (!(name = dis8051_symtab_intern(&f->syms, f->path,
+	                                   strlen(f->path))))
+		return -1;
+
+	/* address, then bytes one space apart */
+	while (next_line(&t, &s, &n)) {
+		line++;
+		end = s + n;
+		while (s < end && (*s == ' ' || *s == '\t'))
+			s++;
+		if (!(k = hex(s, end, 4, &addr)))
+			continue;
+		for (s += k, size = 0; end - s >= 3 && s[0] == ' ' &&
+		     hex_digit(s[1]) && hex_digit(s[2]) &&
+		     (end - s == 3 || s[3] == ' ' || s[3] == '\t'); s += 3)
+			size++;
+		if (size && push(f, DIS8051_SPACE_CODE, DIS8051_SPAN_LINE, addr,
+		                 addr + size, name, line) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/* --- reloading --- */
+
+static int slurp(const char *path, char **buf, size_t *n)
+{
+	size_t a = 0, k;
+	char *b;
+	FILE *fp;
+
+	*buf = NULL;
+	*n = 0;
+	if (!(fp = fopen(path, "rb")))
+		return -1;
+	do {
+		if (*n == a) {
+			a = a ? a*2 : 65536;
+			if (!(b = realloc(*buf, a))) {
+				fclose(fp);
+				free(*buf);
+				return -1;
+			}
+			*buf = b;
+		}
+		*n += k = fread(*buf + *n, 1, a - *n, fp);
+	} while (k > 0);
+	k = ferror(fp);
+	fclose(fp);
+	if (k) {
+		free(*buf);
+		errno = EIO;
+		return -1;
+	}
+	return 0;
+}
+
+static const char *ext(const char *path)
+{
+	const char *p = strrchr(path, '.');
+
+	return p ? p : "";
+}
+
+static int load(struct dis8051_sdcc_file *f)
+{
+	struct dis8051_sdcc_file tmp;
+	struct text t;
+	char *buf;
+	size_t n;
+	int r;
+
+	if (slurp(f->path, &buf, &n) < 0)
+		return -1;
+	memset(&tmp, 0, sizeof(tmp));
+	tmp.path = f->path;
+	dis8051_symtab_init(&tmp.syms);
+	t.p = buf;
+	t.end = buf + n;
+
+	if (!strcasecmp(ext(f->path), ".map"))
+		r = map(&tmp, t);
+	else if (!strcasecmp(ext(f->path), ".rst"))
+		r = rst(&tmp, t);
+	else
+		r = cdb(&tmp, t);
+	free(buf);
+
+	if (r < 0) {
+		file_free(&tmp);
+		errno = ENOMEM;
+		return -1;
+	}
+	file_free(f);
+	f->syms = tmp.syms;
+	f->spans = tmp.spans;
+	f->nspans = tmp.nspans;
+	f->aspans = tmp.aspans;
+	return 0;
+}
+
+int dis8051_sdcc_reload(struct dis8051_sdcc *s, int *failed)
+{
+	struct dis8051_sdcc_file *f;
+	int changed = 0, bad = 0;
+	struct stat st;
+	size_t i;
+
+	for (i = 0; i < s->nfiles; i++) {
+		f = &s->files[i];
+		if (stat(f->path, &st) < 0) {
+			f->error = errno;
+			bad++;
+			continue;
+		}
+		if (st.st_mtime == f->mtime && st.st_size == f->size) {
+			f->error = 0;
+			continue;
+		}
+		if (load(f) < 0) {
+			f->error = errno;
+			bad++;
+			continue;
+		}
+		f->error = 0;
+		f->mtime = st.st_mtime;
+		f->size = st.st_size;
+		changed++;
+	}
+	if (failed)
+		*failed = bad;
+	if (!changed)
+		return 0;
+
+	dis8051_spans_free(&s->index);
+	for (i = 0; i < s->nfiles; i++)
+		if (dis8051_spans_add(&s->index, s->files[i].spans,
+		                      s->files[i].nspans) < 0)
+			break;
+	if (i < s->nfiles || dis8051_spans_sort(&s->index) < 0) {
+		/* all of them again next time */
+		for (i = 0; i < s->nfiles; i++)
+			s->files[i].mtime = s->files[i].size = -1;
+		errno = ENOMEM;
+		return -1;
+	}
+	return changed;
+}
+
+const char *dis8051_sdcc_name(void *user, int space, uint16_t addr)
+{
+	const struct dis8051_sdcc *s = user;
+	const struct dis8051_sym *sym;
+	size_t i;
+
+	for (i = 0; i < s->nfiles; i++)
+		if ((sym = dis8051_symtab_find(&s->files[i].syms, space, addr)))
+			return sym->name;
+	return NULL;
+}
@@ -0,0 +1,46 @@
+/* SDCC debug information: .cdb, linker .map and .rst listings,
+ * reloaded file by file as they change */
+
+#ifndef DIS8051_SDCC_H
+#define DIS8051_SDCC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-symtab.h"
+#include "8051-span.h"
+
+struct dis8051_sdcc_file {
+	char *path;
+	int64_t mtime, size;            /* when it was read, -1 before */
+	int error;                      /* errno of the last failed read */
+	struct dis8051_symtab syms;     /* by address, and the names */
+	struct dis8051_span *spans;
+	size_t nspans, aspans;
+};
+
+/* .cdb: functions, globals, statics and locals with their extent, C
+ * and asm lines; .map: globals, each one byte; .rst: the listing line
+ * of each instruction; .mem only sums up memory use and is not read */
+struct dis8051_sdcc {
+	struct dis8051_sdcc_file *files;
+	size_t nfiles;
+	struct dis8051_spans index;     /* the spans of all files */
+};
+
+void dis8051_sdcc_init(struct dis8051_sdcc *s);
+void dis8051_sdcc_free(struct dis8051_sdcc *s);
+
+/* add a file, the type goes by its extension; it is read by the next
+ * dis8051_sdcc_reload(), returns 0 on success, -1 if out of memory */
+int dis8051_sdcc_add(struct dis8051_sdcc *s, const char *path);
+
+/* read the files that changed size or time since the last call again,
+ * returns how many, or -1 if out of memory; a file that could not be
+ * read keeps what it had and its 'error', and '*failed' unless NULL is
+ * the number of those, the others are reloaded all the same */
+int dis8051_sdcc_reload(struct dis8051_sdcc *s, int *failed);
+
+/* dis8051_symbol_fn (8051-render.h) for a dis8051_sdcc as 'user' */
+const char *dis8051_sdcc_name(void *user, int space, uint16_t addr);
+
+#endif
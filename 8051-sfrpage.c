@@ -0,0 +1,387 @@
+/* 8051 SFR page tracking for derivatives with an SFR page register */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-render.h"
+#include "8051-flow.h"
+#include "8051-sfrpage.h"
+
+#define PAGE_ENTRY     0x101   /* as on entry, in function summaries */
+#define PAGE_UNVISITED 0xffff
+
+/* function summaries */
+#define FUNC_NEW  0
+#define FUNC_BUSY 1
+#define FUNC_DONE 2
+
+/* depth of saved pages followed along a path */
+#define PAGE_STACK 8
+
+struct pstate {
+	uint16_t page;
+	uint8_t depth;
+	uint16_t stack[PAGE_STACK];
+};
+
+struct pwork {
+	uint16_t pc;
+	struct pstate s;
+};
+
+struct worklist {
+	struct pwork *work;
+	size_t nwork, awork;
+};
+
+struct ppass {
+	const struct dis8051_flow *f;
+	uint8_t reg, mask;
+	uint16_t *page;     /* result */
+	uint16_t *seen;     /* page in the summary walk of owner[] */
+	int *owner;         /* function walked last, -1 if none */
+	uint16_t *summary;  /* page after a call, at function entries */
+	uint8_t *fstate;    /* FUNC_* at function entries */
+	struct worklist w;
+};
+
+static int queue(struct ppass *p, struct worklist *w, uint16_t pc,
+                 const struct pstate *s)
+{
+	struct pwork *n;
+
+	if (pc < p->f->base || pc - p->f->base >= p->f->len)
+		return 0;
+
+	if (w->nwork == w->awork) {
+		size_t a = w->awork ? w->awork*2 : 64;
+
+		if (!(n = realloc(w->work, a*sizeof(*n))))
+			return -1;
+		w->work = n;
+		w->awork = a;
+	}
+	w->work[w->nwork].pc = pc;
+	w->work[w->nwork++].s = *s;
+	return 0;
+}
+
+static uint16_t merge(uint16_t a, uint16_t b)
+{
+	if (a == PAGE_UNVISITED || a == b)
+		return b;
+	return DIS8051_PAGE_UNKNOWN;
+}
+
+/* effect of 'in' on the page */
+static void step(const struct ppass *p, struct pstate *s,
+                 const struct dis8051_insn *in)
+{
+	uint8_t v;
+	int i;
+
+	switch (in->opcode) {
+	/* mov / orl / anl SFRPAGE, #imm */
+	case 0x75:
+	case 0x43:
+	case 0x53:
+		if (in->val[0] != p->reg)
+			return;
+		v = in->val[1] & p->mask;
+		if (in->opcode == 0x75)
+			s->page = v;
+		else if (s->page < DIS8051_PAGE_UNKNOWN)
+			s->page = in->opcode == 0x43 ? s->page | v :
+			          s->page & v;
+		else
+			s->page = DIS8051_PAGE_UNKNOWN;
+		return;
+
+	/* push SFRPAGE */
+	case 0xc0:
+		if (in->val[0] == p->reg && s->depth < PAGE_STACK)
+			s->stack[s->depth++] = s->page;
+		return;
+
+	/* pop SFRPAGE */
+	case 0xd0:
+		if (in->val[0] == p->reg)
+			s->page = s->depth > 0 ? s->stack[--s->depth] :
+			          DIS8051_PAGE_UNKNOWN;
+		return;
+	}
+
+	/* any other write to SFRPAGE */
+	for (i = 0; i < 3 && in->opnd[i] != DIS8051_OPND_NONE; i++) {
+		if (!(dis8051_access(in, i) & DIS8051_WRITE))
+			continue;
+		if ((in->opnd[i] == DIS8051_OPND_DIRECT &&
+		     in->val[i] == p->reg) ||
+		    (in->opnd[i] == DIS8051_OPND_BIT &&
+		     (in->val[i] & 0xf8) == p->reg))
+			s->page = DIS8051_PAGE_UNKNOWN;
+	}
+}
+
+static int summarize(struct ppass *p, int entry);
+
+/* page after calling 'target' on 'page' */
+static int call(struct ppass *p, uint16_t target, uint16_t *page)
+{
+	int off = target - p->f->base;
+	uint16_t r;
+
+	if (target < p->f->base || off >= p->f->len ||
+	    !(p->f->map[off] & DIS8051_MAP_FUNC))
+		return 0;
+
+	if (p->fstate[off] == FUNC_NEW && summarize(p, off))
+		return -1;
+	/* recursion */
+	r = p->fstate[off] == FUNC_DONE ? p->summary[off] :
+	    DIS8051_PAGE_UNKNOWN;
+	if (r != PAGE_ENTRY)
+		*page = r;
+	return 0;
+}
+
+/* jump from 'pc' to another function */
+static int tail_call(const struct ppass *p, int entry, uint16_t target)
+{
+	int off = target - p->f->base;
+
+	return target >= p->f->base && off < p->f->len && off != entry &&
+	       (p->f->map[off] & DIS8051_MAP_FUNC);
+}
+
+/* page the function at 'entry' returns with, relative to PAGE_ENTRY */
+static int summarize(struct ppass *p, int entry)
+{
+	const struct dis8051_flow *f = p->f;
+	const struct dis8051_jtab *j;
+	struct dis8051_insn in;
+	struct worklist w = {NULL, 0, 0};
+	struct pwork cur;
+	uint16_t ret = PAGE_UNVISITED, pc, *seen;
+	int off, i, err = 0;
+
+	p->fstate[entry] = FUNC_BUSY;
+	memset(&cur.s, 0, sizeof(cur.s));
+	cur.s.page = PAGE_ENTRY;
+	err = queue(p, &w, f->base + entry, &cur.s);
+
+	while (!err && w.nwork > 0) {
+		cur = w.work[--w.nwork];
+		for (pc = cur.pc;; pc += in.size) {
+			if (pc < f->base || pc - f->base >= f->len)
+				break;
+			off = pc - f->base;
+			if (!(f->map[off] & DIS8051_MAP_CODE))
+				break;
+
+			/* merge: stop once nothing changes */
+			seen = &p->seen[off];
+			if (p->owner[off] != entry) {
+				p->owner[off] = entry;
+				*seen = cur.s.page;
+			} else if (*seen == cur.s.page ||
+			           *seen == DIS8051_PAGE_UNKNOWN) {
+				break;
+			} else {
+				*seen = DIS8051_PAGE_UNKNOWN;
+			}
+			cur.s.page = *seen;
+
+			if (!dis8051_decode(pc, f->buf + off, f->len - off, &in))
+				break;
+			step(p, &cur.s, &in);
+
+			if (in.flow == DIS8051_FLOW_CALL) {
+				if ((err = call(p, in.target, &cur.s.page)))
+					break;
+				continue;
+			}
+			if (in.flow == DIS8051_FLOW_JMP &&
+			    tail_call(p, entry, in.target)) {
+				if ((err = call(p, in.target, &cur.s.page)))
+					break;
+				ret = merge(ret, cur.s.page);
+				break;
+			}
+			if (in.flow == DIS8051_FLOW_JMP ||
+			    in.flow == DIS8051_FLOW_CJMP)
+				if ((err = queue(p, &w, in.target, &cur.s)) ||
+				    in.flow == DIS8051_FLOW_JMP)
+					break;
+
+			if (in.flow == DIS8051_FLOW_RET ||
+			    in.flow == DIS8051_FLOW_IJMP) {
+				if ((j = dis8051_flow_jtab(f, pc))) {
+					for (i = 0; i < j->entries && !err; i++)
+						err = queue(p, &w,
+						            dis8051_jtab_target(f, j, i),
+						            &cur.s);
+				} else if (in.flow == DIS8051_FLOW_RET) {
+					ret = merge(ret, cur.s.page);
+				}
+				break;
+			}
+			if (in.flow == DIS8051_FLOW_RETI ||
+			    in.flow == DIS8051_FLOW_ILL)
+				break;
+		}
+	}
+
+	free(w.work);
+	/* never returns: the page after it does not matter */
+	p->summary[entry] = ret == PAGE_UNVISITED ? PAGE_ENTRY : ret;
+	p->fstate[entry] = FUNC_DONE;
+	return err;
+}
+
+/* follow one path while it changes the recorded pages */
+static int walk(struct ppass *p, uint16_t pc, struct pstate s)
+{
+	const struct dis8051_flow *f = p->f;
+	const struct dis8051_jtab *j;
+	struct dis8051_insn in;
+	uint16_t *pg;
+	int off, i;
+
+	for (;;) {
+		if (pc < f->base || pc - f->base >= f->len)
+			return 0;
+		off = pc - f->base;
+		if (!(f->map[off] & DIS8051_MAP_CODE))
+			return 0;
+
+		/* merge: stop once nothing changes */
+		pg = &p->page[off];
+		if (*pg == PAGE_UNVISITED)
+			*pg = s.page;
+		else if (*pg == s.page || *pg == DIS8051_PAGE_UNKNOWN)
+			return 0;
+		else
+			*pg = DIS8051_PAGE_UNKNOWN;
+		s.page = *pg;
+
+		if (!dis8051_decode(pc, f->buf + off, f->len - off, &in))
+			return 0;
+		step(p, &s, &in);
+
+		switch (in.flow) {
+		case DIS8051_FLOW_JMP:
+			return queue(p, &p->w, in.target, &s);
+
+		case DIS8051_FLOW_CJMP:
+			if (queue(p, &p->w, in.target, &s))
+				return -1;
+			break;
+
+		case DIS8051_FLOW_CALL:
+			/* callees start on the caller's page */
+			if (queue(p, &p->w, in.target, &s) ||
+			    call(p, in.target, &s.page))
+				return -1;
+			break;
+
+		case DIS8051_FLOW_IJMP:
+		case DIS8051_FLOW_RET:
+			if ((j = dis8051_flow_jtab(f, pc)))
+				for (i = 0; i < j->entries; i++)
+					if (queue(p, &p->w,
+					          dis8051_jtab_target(f, j, i), &s))
+						return -1;
+			return 0;
+
+		case DIS8051_FLOW_RETI:
+		case DIS8051_FLOW_ILL:
+			return 0;
+		}
+
+		pc += in.size;
+	}
+}
+
+static int drain(struct ppass *p)
+{
+	struct pwork w;
+
+	while (p->w.nwork > 0) {
+		w = p->w.work[--p->w.nwork];
+		if (walk(p, w.pc, w.s))
+			return -1;
+	}
+	return 0;
+}
+
+int dis8051_sfrpage_run(const struct dis8051_flow *f,
+                        const struct dis8051_derivative *d, uint16_t *page)
+{
+	struct ppass p;
+	struct pstate s;
+	int off, ret = 0;
+
+	if (!d || !d->sfrpage || f->len == 0) {
+		memset(page, 0, f->len*sizeof(*page));
+		return 0;
+	}
+
+	memset(&p, 0, sizeof(p));
+	p.f = f;
+	p.reg = d->sfrpage;
+	p.mask = d->page_mask;
+	p.page = page;
+	p.seen = malloc(f->len*sizeof(*p.seen));
+	p.owner = malloc(f->len*sizeof(*p.owner));
+	p.summary = malloc(f->len*sizeof(*p.summary));
+	p.fstate = calloc(f->len, 1);
+	if (!p.seen || !p.owner || !p.summary || !p.fstate)
+		ret = -1;
+
+	for (off = 0; off < f->len; off++) {
+		page[off] = PAGE_UNVISITED;
+		if (p.owner)
+			p.owner[off] = -1;
+	}
+	memset(&s, 0, sizeof(s));
+
+	/* SFRPAGE is 0 after reset */
+	if (!ret && (ret = queue(&p, &p.w, 0x0000, &s)) == 0)
+		ret = drain(&p);
+
+	/* interrupt handlers and entries nobody calls */
+	s.page = DIS8051_PAGE_UNKNOWN;
+	for (off = 0; off < f->len && !ret; off++) {
+		if ((f->map[off] & DIS8051_MAP_FUNC) &&
+		    page[off] == PAGE_UNVISITED) {
+			if ((ret = queue(&p, &p.w, f->base + off, &s)) == 0)
+				ret = drain(&p);
+		}
+	}
+
+	free(p.w.work);
+	free(p.seen);
+	free(p.owner);
+	free(p.summary);
+	free(p.fstate);
+
+	/* code only reachable through unresolved jumps */
+	for (off = 0; off < f->len; off++)
+		if (page[off] == PAGE_UNVISITED)
+			page[off] = DIS8051_PAGE_UNKNOWN;
+
+	return ret;
+}
+
+void dis8051_sfrpage_ctx(const struct dis8051_flow *f, const uint16_t *page,
+                         uint16_t pc, struct dis8051_ctx *ctx)
+{
+	int off = pc - f->base;
+
+	ctx->page = 0;
+	if (pc >= f->base && off < f->len &&
+	    page[off] < DIS8051_PAGE_UNKNOWN)
+		ctx->page = page[off];
+}
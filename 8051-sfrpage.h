@@ -0,0 +1,28 @@
+/* 8051 SFR page tracking for derivatives with an SFR page register */
+
+#ifndef DIS8051_SFRPAGE_H
+#define DIS8051_SFRPAGE_H
+
+#include <stdint.h>
+#include "8051-render.h"
+#include "8051-flow.h"
+
+/* pages 0x00 -- 0xff, or ... */
+#define DIS8051_PAGE_UNKNOWN 0x100
+
+/* SFR page at each instruction found by 'f' on derivative 'd', 'page'
+ * holds f->len entries and is only meaningful where f->map has
+ * DIS8051_MAP_CODE; follows immediate writes to the page register and
+ * push / pop of it, a call leaves the page its callee returns with,
+ * the reset entry starts on page 0, interrupt handlers and other
+ * entries that aren't called on an unknown page; all 0 for parts
+ * without pages,
+ * returns 0 on success, -1 if out of memory */
+int dis8051_sfrpage_run(const struct dis8051_flow *f,
+                        const struct dis8051_derivative *d, uint16_t *page);
+
+/* set the page of 'ctx' for the instruction at 'pc', page 0 if unknown */
+void dis8051_sfrpage_ctx(const struct dis8051_flow *f, const uint16_t *page,
+                         uint16_t pc, struct dis8051_ctx *ctx);
+
+#endif
@@ -0,0 +1,328 @@
+/* library function signatures: relocatable operands masked, matched
+ * through a prefix trie */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-sig.h"
+
+int dis8051_sig_make(struct dis8051_sig *s, uint16_t pc, const uint8_t *buf,
+                     size_t len)
+{
+	struct dis8051_insn in;
+	size_t pos = 0, reach = 0, i;
+	uint16_t off;
+	int n, k, absolute;
+
+	memset(s, 0, sizeof(*s));
+	s->next = -1;
+	while (pos < len) {
+		if (!(n = dis8051_decode(pc + pos, buf + pos, len - pos, &in)) ||
+		    in.flow == DIS8051_FLOW_ILL || pos + n > DIS8051_SIG_MAX)
+			break;
+		for (i = 0; i < (size_t)n; i++)
+			s->mask[pos+i] = 0xff;
+		for (k = 0, absolute = 0; k < 3; k++) {
+			switch (in.opnd[k]) {
+			case DIS8051_OPND_ADDR16:
+				absolute = 1;
+				/* fall through */
+			case DIS8051_OPND_IMM16:
+				s->mask[pos+1] = s->mask[pos+2] = 0;
+				break;
+			case DIS8051_OPND_ADDR11:
+				/* address bits 8 -- 10 are in the opcode */
+				s->mask[pos] = 0x1f;
+				s->mask[pos+1] = 0;
+				absolute = 1;
+				break;
+			case DIS8051_OPND_REL:
+				/* relative branches move with the code */
+				off = in.target - pc;
+				if (off < 0x8000 && off > reach)
+					reach = off;
+				break;
+			}
+		}
+		/* an ajmp or ljmp ahead into the buffer, e.g. over a table,
+		 * is masked but the code still goes on there */
+		off = in.target - pc;
+		if (absolute && in.flow == DIS8051_FLOW_JMP && off > pos &&
+		    off < len && off > reach)
+			reach = off;
+		for (i = 0; i < (size_t)n; i++)
+			s->value[pos+i] = buf[pos+i] & s->mask[pos+i];
+		pos += n;
+
+		/* the end, unless a branch skips over it */
+		if ((in.flow == DIS8051_FLOW_RET ||
+		     in.flow == DIS8051_FLOW_RETI ||
+		     in.flow == DIS8051_FLOW_JMP ||
+		     in.flow == DIS8051_FLOW_IJMP) && pos > reach)
+			break;
+	}
+	s->len = pos;
+	return pos;
+}
+
+void dis8051_sigs_init(struct dis8051_sigs *t)
+{
+	memset(t, 0, sizeof(*t));
+	dis8051_symtab_init(&t->names);
+}
+
+void dis8051_sigs_free(struct dis8051_sigs *t)
+{
+	size_t i;
+
+	for (i = 0; i < t->nnodes; i++)
+		free(t->nodes[i].e);
+	free(t->nodes);
+	free(t->v);
+	dis8051_symtab_free(&t->names);
+	memset(t, 0, sizeof(*t));
+}
+
+/* index of a new node, -1 if out of memory */
+static long node(struct dis8051_sigs *t)
+{
+	struct dis8051_sig_node *v;
+	size_t n;
+
+	if (t->nnodes == t->anodes) {
+		n = t->anodes ? t->anodes*2 : 256;
+		if (!(v = realloc(t->nodes, n*sizeof(*v))))
+			return -1;
+		t->nodes = v;
+		t->anodes = n;
+	}
+	v = &t->nodes[t->nnodes];
+	v->e = NULL;
+	v->n = 0;
+	v->sig = -1;
+	return t->nnodes++;
+}
+
+/* child of 'from' over (value, mask), created if needed */
+static long child(struct dis8051_sigs *t, uint32_t from, uint8_t value,
+                  uint8_t mask)
+{
+	struct dis8051_sig_edge *e;
+	uint32_t i;
+	long c;
+
+	for (i = 0; i < t->nodes[from].n; i++) {
+		e = &t->nodes[from].e[i];
+		if (e->value == value && e->mask == mask)
+			return e->node;
+	}
+	if ((c = node(t)) < 0)
+		return -1;
+	e = realloc(t->nodes[from].e, (t->nodes[from].n + 1)*sizeof(*e));
+	if (!e)
+		return -1;
+	t->nodes[from].e = e;
+	e += t->nodes[from].n++;
+	e->value = value;
+	e->mask = mask;
+	e->node = c;
+	return c;
+}
+
+int dis8051_sigs_add(struct dis8051_sigs *t, const struct dis8051_sig *s,
+                     const char *name)
+{
+	struct dis8051_sig *v;
+	long at = 0;
+	size_t n;
+	int i;
+
+	if (s->len == 0)
+		return 0;
+	if (t->nnodes == 0 && node(t) < 0)
+		return -1;
+	if (t->count == t->alloc) {
+		n = t->alloc ? t->alloc*2 : 64;
+		if (!(v = realloc(t->v, n*sizeof(*v))))
+			return -1;
+		t->v = v;
+		t->alloc = n;
+	}
+	for (i = 0; i < s->len; i++)
+		if ((at = child(t, at, s->value[i], s->mask[i])) < 0)
+			return -1;
+
+	v = &t->v[t->count];
+	*v = *s;
+	v->next = -1;
+	if (!(v->name = dis8051_symtab_intern(&t->names, name, strlen(name))))
+		return -1;
+
+	/* the same pattern again, after the others */
+	if ((i = t->nodes[at].sig) < 0) {
+		t->nodes[at].sig = t->count;
+	} else {
+		while (t->v[i].next >= 0)
+			i = t->v[i].next;
+		t->v[i].next = t->count;
+	}
+	t->count++;
+	return 0;
+}
+
+static int hex(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+/* 12, .. or 11/1f */
+static int byte(const char *p, size_t n, uint8_t *value, uint8_t *mask)
+{
+	if (n == 2 && p[0] == '.' && p[1] == '.') {
+		*value = *mask = 0;
+		return 0;
+	}
+	if ((n != 2 && n != 5) || hex(p[0]) < 0 || hex(p[1]) < 0)
+		return -1;
+	*value = hex(p[0]) << 4 | hex(p[1]);
+	*mask = 0xff;
+	if (n == 5) {
+		if (p[2] != '/' || hex(p[3]) < 0 || hex(p[4]) < 0)
+			return -1;
+		*mask = hex(p[3]) << 4 | hex(p[4]);
+	}
+	return *value & ~*mask ? -1 : 0;
+}
+
+static int space(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+int dis8051_sigs_parse(struct dis8051_sigs *t, const char *s, size_t n,
+                       unsigned *line)
+{
+	const char *end = s + n, *eol, *p, *q;
+	struct dis8051_sig sig;
+	char name[256];
+
+	for (*line = 1; s < end; s = eol + 1, ++*line) {
+		if (!(eol = memchr(s, '\n', end - s)))
+			eol = end;
+		if ((p = memchr(s, '#', eol - s)))
+			eol = p;
+
+		for (p = s; p < eol && space(*p); p++)
+			;
+		if (p == eol)
+			goto next;
+		for (q = p; q < eol && !space(*q); q++)
+			;
+		if ((size_t)(q - p) >= sizeof(name))
+			return -1;
+		memcpy(name, p, q - p);
+		name[q - p] = '\0';
+
+		memset(&sig, 0, sizeof(sig));
+		for (;;) {
+			for (p = q; p < eol && space(*p); p++)
+				;
+			if (p == eol)
+				break;
+			for (q = p; q < eol && !space(*q); q++)
+				;
+			if (sig.len == DIS8051_SIG_MAX ||
+			    byte(p, q - p, &sig.value[sig.len],
+			         &sig.mask[sig.len]) < 0)
+				return -1;
+			sig.len++;
+		}
+		if (sig.len == 0)
+			return -1;
+		if (dis8051_sigs_add(t, &sig, name) < 0) {
+			*line = 0;
+			return -1;
+		}
+next:
+		if (eol == end)
+			break;
+		/* past a comment */
+		if (*eol == '#' && !(eol = memchr(eol, '\n', end - eol)))
+			break;
+	}
+	return 0;
+}
+
+int dis8051_sig_format(const struct dis8051_sig *s, char *out, size_t n)
+{
+	size_t len = 0;
+	int i, r;
+
+	r = snprintf(out, n, "%s", s->name ? s->name : "?");
+	for (i = 0; r >= 0 && i < s->len; i++) {
+		len += r;
+		if (s->mask[i] == 0xff)
+			r = snprintf(len < n ? out + len : NULL,
+			             len < n ? n - len : 0, " %02x", s->value[i]);
+		else if (s->mask[i] == 0)
+			r = snprintf(len < n ? out + len : NULL,
+			             len < n ? n - len : 0, " ..");
+		else
+			r = snprintf(len < n ? out + len : NULL,
+			             len < n ? n - len : 0, " %02x/%02x",
+			             s->value[i], s->mask[i]);
+	}
+	len += r > 0 ? r : 0;
+	return len < n ? (int)len : -1;
+}
+
+/* longest signature below 'at', 'depth' bytes matched so far */
+static void walk(const struct dis8051_sigs *t, uint32_t at, const uint8_t *p,
+                 size_t n, size_t depth, int *best, size_t *blen)
+{
+	const struct dis8051_sig_node *x = &t->nodes[at];
+	uint32_t i;
+
+	if (x->sig >= 0 && depth > *blen) {
+		*best = x->sig;
+		*blen = depth;
+	}
+	if (depth == n)
+		return;
+	for (i = 0; i < x->n; i++)
+		if ((p[depth] & x->e[i].mask) == x->e[i].value)
+			walk(t, x->e[i].node, p, n, depth + 1, best, blen);
+}
+
+size_t dis8051_sigs_scan(const struct dis8051_sigs *t, const uint8_t *buf,
+                         size_t len, uint32_t base, dis8051_sig_fn fn,
+                         void *user)
+{
+	size_t i = 0, blen, found = 0;
+	int best;
+
+	if (t->nnodes == 0)
+		return 0;
+	while (i < len) {
+		best = -1;
+		blen = 0;
+		walk(t, 0, buf + i, len - i < DIS8051_SIG_MAX ?
+		     len - i : DIS8051_SIG_MAX, 0, &best, &blen);
+		if (best < 0) {
+			i++;
+			continue;
+		}
+		fn(user, &t->v[best], base + i);
+		found++;
+		i += blen;
+	}
+	return found;
+}
@@ -0,0 +1,76 @@
+/* library function signatures: relocatable operands masked, matched
+ * through a prefix trie */
+
+#ifndef DIS8051_SIG_H
+#define DIS8051_SIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-symtab.h"
+
+#define DIS8051_SIG_MAX 64
+
+/* byte i matches b if (b & mask[i]) == value[i] */
+struct dis8051_sig {
+	const char *name;
+	uint8_t len;
+	uint8_t value[DIS8051_SIG_MAX];
+	uint8_t mask[DIS8051_SIG_MAX];
+	int next;          /* index of another one of the same pattern, -1 */
+};
+
+struct dis8051_sig_edge {
+	uint8_t value, mask;
+	uint32_t node;
+};
+
+struct dis8051_sig_node {
+	struct dis8051_sig_edge *e;
+	uint32_t n;
+	int sig;           /* ending here, -1 if none */
+};
+
+struct dis8051_sigs {
+	struct dis8051_sig *v;
+	size_t count, alloc;
+	struct dis8051_sig_node *nodes;  /* nodes[0] is the root */
+	size_t nnodes, anodes;
+	struct dis8051_symtab names;     /* pool of the names */
+};
+
+/* pattern of the function at 'pc' in 'len' bytes of 'buf': whole
+ * instructions up to DIS8051_SIG_MAX bytes, ending at a ret or jump no
+ * branch before it jumps past; ljmp / lcall, ajmp / acall targets and
+ * mov dptr immediates are masked; returns its length */
+int dis8051_sig_make(struct dis8051_sig *s, uint16_t pc, const uint8_t *buf,
+                     size_t len);
+
+void dis8051_sigs_init(struct dis8051_sigs *t);
+void dis8051_sigs_free(struct dis8051_sigs *t);
+
+/* add 's' as 'name', returns 0 on success, -1 if out of memory */
+int dis8051_sigs_add(struct dis8051_sigs *t, const struct dis8051_sig *s,
+                     const char *name);
+
+/* signature file: "name byte..." a line, where a byte is 12, .. for
+ * any or 11/1f for value/mask, '#' starts a comment; returns 0, or -1
+ * with '*line' set to the line in error, 0 if out of memory */
+int dis8051_sigs_parse(struct dis8051_sigs *t, const char *s, size_t n,
+                       unsigned *line);
+
+/* 's' as a line of a signature file, without newline,
+ * returns the length or -1 if it does not fit into 'n' bytes */
+int dis8051_sig_format(const struct dis8051_sig *s, char *out, size_t n);
+
+/* called for each match, 'addr' is where it starts */
+typedef void (*dis8051_sig_fn)(void *user, const struct dis8051_sig *s,
+                               uint32_t addr);
+
+/* one pass over 'len' bytes of code loaded at 'base': at each offset
+ * the trie is walked for the longest signature matching there, which
+ * is reported and skipped; returns the number of matches */
+size_t dis8051_sigs_scan(const struct dis8051_sigs *t, const uint8_t *buf,
+                         size_t len, uint32_t base, dis8051_sig_fn fn,
+                         void *user);
+
+#endif
@@ -0,0 +1,98 @@
+/* interval index of functions, variables and source lines */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-span.h"
+
+void dis8051_spans_init(struct dis8051_spans *x)
+{
+	memset(x, 0, sizeof(*x));
+}
+
+void dis8051_spans_free(struct dis8051_spans *x)
+{
+	free(x->v);
+	free(x->max_end);
+	memset(x, 0, sizeof(*x));
+}
+
+int dis8051_spans_add(struct dis8051_spans *x, const struct dis8051_span *s,
+                      size_t n)
+{
+	struct dis8051_span *v;
+	size_t a = x->alloc ? x->alloc : 64;
+
+	if (n == 0)
+		return 0;
+	while (a < x->count + n)
+		a *= 2;
+	if (a != x->alloc) {
+		if (!(v = realloc(x->v, a*sizeof(*v))))
+			return -1;
+		x->v = v;
+		x->alloc = a;
+	}
+	memcpy(x->v + x->count, s, n*sizeof(*s));
+	x->count += n;
+	return 0;
+}
+
+static int cmp(const void *a, const void *b)
+{
+	const struct dis8051_span *x = a, *y = b;
+
+	if (x->space != y->space)
+		return x->space - y->space;
+	if (x->start != y->start)
+		return x->start < y->start ? -1 : 1;
+	/* outer before inner */
+	if (x->end != y->end)
+		return x->end > y->end ? -1 : 1;
+	return x->kind - y->kind;
+}
+
+int dis8051_spans_sort(struct dis8051_spans *x)
+{
+	uint32_t *m;
+	size_t i;
+
+	free(x->max_end);
+	x->max_end = NULL;
+	if (x->count == 0)
+		return 0;
+	if (!(m = malloc(x->count*sizeof(*m))))
+		return -1;
+	qsort(x->v, x->count, sizeof(*x->v), cmp);
+	for (i = 0; i < x->count; i++)
+		m[i] = i && x->v[i-1].space == x->v[i].space &&
+		       m[i-1] > x->v[i].end ? m[i-1] : x->v[i].end;
+	x->max_end = m;
+	return 0;
+}
+
+const struct dis8051_span *dis8051_spans_find(const struct dis8051_spans *x,
+                                              int space, int kind,
+                                              uint32_t addr)
+{
+	const struct dis8051_span *s;
+	size_t lo = 0, hi = x->count, mid;
+
+	/* past the last span of 'space' starting at or before 'addr' */
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		s = &x->v[mid];
+		if (s->space < space || (s->space == space && s->start <= addr))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	/* back while anything before can still reach 'addr' */
+	while (lo-- > 0 && x->v[lo].space == space && x->max_end[lo] > addr) {
+		s = &x->v[lo];
+		if (s->kind == kind && s->end > addr)
+			return s;
+	}
+	return NULL;
+}
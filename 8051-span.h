@@ -0,0 +1,45 @@
+/* interval index of functions, variables and source lines */
+
+#ifndef DIS8051_SPAN_H
+#define DIS8051_SPAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum dis8051_span_kind {
+	DIS8051_SPAN_FUNC,
+	DIS8051_SPAN_VAR,
+	DIS8051_SPAN_LINE
+};
+
+struct dis8051_span {
+	uint32_t start, end;  /* [start, end) */
+	uint8_t space;        /* enum dis8051_space */
+	uint8_t kind;         /* DIS8051_SPAN_* */
+	uint32_t line;        /* of DIS8051_SPAN_LINE */
+	const char *name;     /* symbol, or source file of a line */
+};
+
+struct dis8051_spans {
+	struct dis8051_span *v;  /* by (space, start) once sorted */
+	uint32_t *max_end;       /* largest end in v[0..i] of v[i]'s space */
+	size_t count, alloc;
+};
+
+void dis8051_spans_init(struct dis8051_spans *x);
+void dis8051_spans_free(struct dis8051_spans *x);
+
+/* add 'n' spans, the names are not copied; dis8051_spans_sort() before
+ * the next query; returns 0 on success, -1 if out of memory */
+int dis8051_spans_add(struct dis8051_spans *x, const struct dis8051_span *s,
+                      size_t n);
+
+/* returns 0 on success, -1 if out of memory */
+int dis8051_spans_sort(struct dis8051_spans *x);
+
+/* innermost span of 'kind' containing 'addr', NULL if there is none */
+const struct dis8051_span *dis8051_spans_find(const struct dis8051_spans *x,
+                                              int space, int kind,
+                                              uint32_t addr);
+
+#endif
@@ -0,0 +1,334 @@
+/* 8051/8052 static stack depth analysis */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-flow.h"
+#include "8051-stack.h"
+
+/* SP after reset */
+#define SP_RESET 0x07
+
+/* deeper than any 8051 stack */
+#define DEPTH_MAX 0x100
+
+#define SFR_IP 0xb8
+
+/* per function state while walking the call graph */
+#define FUNC_NEW   0
+#define FUNC_BUSY  1
+#define FUNC_DONE  2
+
+struct swork {
+	uint16_t pc;
+	uint16_t depth;
+};
+
+struct spass {
+	const struct dis8051_flow *f;
+	struct dis8051_stack *s;
+	uint8_t *state;     /* FUNC_* per function */
+	int16_t *seen;      /* deepest depth walked at each byte */
+	uint16_t *owner;    /* function that walked it */
+};
+
+static int in_range(const struct dis8051_flow *f, uint16_t addr)
+{
+	return addr >= f->base && addr - f->base < f->len;
+}
+
+static int func_index(const struct dis8051_stack *s, uint16_t addr)
+{
+	size_t lo = 0, hi = s->nfuncs, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo)/2;
+		if (s->funcs[mid].addr < addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo < s->nfuncs && s->funcs[lo].addr == addr ? (int)lo : -1;
+}
+
+static int func_depth(struct spass *p, int idx);
+
+/* depth and flags of a callee, relative to the call site */
+static int callee(struct spass *p, int caller, uint16_t addr,
+                  uint16_t *depth)
+{
+	int idx = func_index(p->s, addr);
+
+	*depth = 0;
+	if (idx < 0)
+		return 0;
+
+	switch (p->state[idx]) {
+	case FUNC_BUSY:
+		p->s->funcs[idx].flags |= DIS8051_STACK_RECURSIVE;
+		p->s->funcs[caller].flags |= DIS8051_STACK_RECURSIVE;
+		return 0;
+
+	case FUNC_NEW:
+		if (func_depth(p, idx))
+			return -1;
+		break;
+	}
+
+	*depth = p->s->funcs[idx].depth;
+	p->s->funcs[caller].flags |= p->s->funcs[idx].flags &
+	                             ~DIS8051_STACK_RECURSIVE;
+	return 0;
+}
+
+static int queue(struct swork **w, size_t *n, size_t *a, uint16_t pc,
+                 uint16_t depth)
+{
+	struct swork *p;
+
+	if (*n == *a) {
+		size_t m = *a ? *a*2 : 32;
+
+		if (!(p = realloc(*w, m*sizeof(*p))))
+			return -1;
+		*w = p;
+		*a = m;
+	}
+	(*w)[*n].pc = pc;
+	(*w)[(*n)++].depth = depth;
+	return 0;
+}
+
+/* walk the body of function 'idx', following calls */
+static int func_depth(struct spass *p, int idx)
+{
+	const struct dis8051_flow *f = p->f;
+	struct dis8051_stack_func *fn = &p->s->funcs[idx];
+	const struct dis8051_jtab *j;
+	struct dis8051_insn in;
+	struct swork *work = NULL, w;
+	size_t nwork = 0, awork = 0;
+	uint16_t d, sub, max = 0;
+	int off, i, ret = 0;
+
+	p->state[idx] = FUNC_BUSY;
+	if (queue(&work, &nwork, &awork, fn->addr, 0))
+		return -1;
+
+	while (nwork > 0 && !ret) {
+		w = work[--nwork];
+
+		for (;;) {
+			if (!in_range(f, w.pc))
+				break;
+			off = w.pc - f->base;
+			if (!(f->map[off] & DIS8051_MAP_CODE))
+				break;
+
+			/* walked before by this function, at least as deep */
+			if (p->owner[off] == idx && p->seen[off] >= w.depth)
+				break;
+			p->owner[off] = idx;
+			p->seen[off] = w.depth;
+
+			if (w.depth > DEPTH_MAX) {
+				fn->flags |= DIS8051_STACK_UNBOUNDED;
+				break;
+			}
+			if (w.depth > max)
+				max = w.depth;
+
+			if (!dis8051_decode(w.pc, f->buf + off, f->len - off,
+			                    &in))
+				break;
+
+			/* push / pop, SP writes */
+			d = w.depth;
+			if (in.opcode == 0xc0)
+				d++;
+			else if (in.opcode == 0xd0 && d > 0)
+				d--;
+			else if (in.opcode == 0x05 && in.val[0] == DIS8051_SFR_SP)
+				d++;
+			else if (in.opcode == 0x15 && in.val[0] == DIS8051_SFR_SP &&
+			         d > 0)
+				d--;
+			/* mov sp, #imm is the startup setup, see 'scan_sfrs' */
+			else if (in.opcode != 0x75)
+				for (i = 0; i < 3 && in.opnd[i]; i++)
+					if (in.opnd[i] == DIS8051_OPND_DIRECT &&
+					    in.val[i] == DIS8051_SFR_SP &&
+					    (dis8051_access(&in, i) &
+					     DIS8051_WRITE))
+						fn->flags |= DIS8051_STACK_SP_WRITE;
+
+			switch (in.flow) {
+			case DIS8051_FLOW_CALL:
+				/* return address plus the callee */
+				if ((ret = callee(p, idx, in.target, &sub)))
+					break;
+				if (d + 2 + sub > max)
+					max = d + 2 + sub;
+				w.depth = d;
+				w.pc += in.size;
+				continue;
+
+			case DIS8051_FLOW_JMP:
+			case DIS8051_FLOW_CJMP:
+				/* jumps to other functions are tail calls */
+				if (in_range(f, in.target) &&
+				    (f->map[in.target - f->base] &
+				     DIS8051_MAP_FUNC) && in.target != fn->addr) {
+					if ((ret = callee(p, idx, in.target, &sub)))
+						break;
+					if (d + sub > max)
+						max = d + sub;
+				} else if ((ret = queue(&work, &nwork, &awork,
+				                        in.target, d))) {
+					break;
+				}
+				if (in.flow == DIS8051_FLOW_JMP)
+					break;
+				w.depth = d;
+				w.pc += in.size;
+				continue;
+
+			/* jump tables stay within the function,
+			 * push acc; push acc; ret dispatch pops two */
+			case DIS8051_FLOW_IJMP:
+			case DIS8051_FLOW_RET:
+				if (!(j = dis8051_flow_jtab(f, w.pc)))
+					break;
+				if (j->kind == DIS8051_JTAB_BYTES)
+					d = d >= 2 ? d - 2 : 0;
+				for (i = 0; i < j->entries && !ret; i++)
+					ret = queue(&work, &nwork, &awork,
+					            dis8051_jtab_target(f, j, i), d);
+				break;
+
+			case DIS8051_FLOW_RETI:
+			case DIS8051_FLOW_ILL:
+				break;
+
+			default:
+				w.depth = d;
+				w.pc += in.size;
+				continue;
+			}
+			break;
+		}
+	}
+
+	free(work);
+	fn->depth = max;
+	p->state[idx] = FUNC_DONE;
+	return ret;
+}
+
+/* SP set up by the startup code and priority bits set anywhere */
+static void scan_sfrs(const struct dis8051_flow *f, struct dis8051_stack *s,
+                      int find_ip)
+{
+	struct dis8051_insn in;
+	int off, sp_found = 0;
+
+	s->sp_init = SP_RESET;
+	for (off = 0; off < f->len; off++) {
+		if (!(f->map[off] & DIS8051_MAP_CODE) ||
+		    !dis8051_decode(f->base + off, f->buf + off, f->len - off,
+		                    &in))
+			continue;
+
+		/* mov data addr., #imm */
+		if (in.opcode == 0x75) {
+			if (in.val[0] == DIS8051_SFR_SP && !sp_found) {
+				s->sp_init = in.val[1];
+				sp_found = 1;
+			} else if (in.val[0] == SFR_IP && find_ip) {
+				s->ip |= in.val[1];
+			}
+		/* setb / orl of priority bits */
+		} else if (find_ip && in.opcode == 0xd2 &&
+		           (in.val[0] & 0xf8) == SFR_IP) {
+			s->ip |= 1 << (in.val[0] & 0x7);
+		} else if (find_ip && in.opcode == 0x43 &&
+		           in.val[0] == SFR_IP) {
+			s->ip |= in.val[1];
+		}
+	}
+}
+
+int dis8051_stack_run(const struct dis8051_flow *f, int ip,
+                      uint8_t iram_top, struct dis8051_stack *s)
+{
+	struct spass p = {f, s, NULL, NULL, NULL};
+	uint16_t lo = 0, hi = 0, v;
+	size_t n = 0;
+	int off, idx, k, ret = 0;
+
+	memset(s, 0, sizeof(*s));
+
+	for (off = 0; off < f->len; off++)
+		if (f->map[off] & DIS8051_MAP_FUNC)
+			n++;
+
+	s->funcs = calloc(n ? n : 1, sizeof(*s->funcs));
+	p.state = calloc(n ? n : 1, 1);
+	p.seen = calloc(f->len ? f->len : 1, sizeof(*p.seen));
+	p.owner = malloc((f->len ? f->len : 1)*sizeof(*p.owner));
+	if (!s->funcs || !p.state || !p.seen || !p.owner) {
+		ret = -1;
+		goto out;
+	}
+	memset(p.owner, 0xff, f->len*sizeof(*p.owner));
+
+	for (off = 0; off < f->len; off++)
+		if (f->map[off] & DIS8051_MAP_FUNC)
+			s->funcs[s->nfuncs++].addr = f->base + off;
+
+	for (idx = 0; idx < (int)s->nfuncs && !ret; idx++)
+		if (p.state[idx] == FUNC_NEW)
+			ret = func_depth(&p, idx);
+	if (ret)
+		goto out;
+
+	s->ip = ip >= 0 ? ip : 0;
+	scan_sfrs(f, s, ip < 0);
+
+	if ((idx = func_index(s, 0x0000)) >= 0)
+		s->main_depth = s->funcs[idx].depth;
+
+	/* one handler per priority level can be active at a time */
+	for (k = 0; k < DIS8051_VECTORS; k++) {
+		v = 0x0003 + 8*k;
+		s->isr_depth[k] = -1;
+		if ((idx = func_index(s, v)) < 0)
+			continue;
+		s->isr_depth[k] = 2 + s->funcs[idx].depth;
+		if (s->ip & (1 << k))
+			hi = hi > s->isr_depth[k] ? hi : s->isr_depth[k];
+		else
+			lo = lo > s->isr_depth[k] ? lo : s->isr_depth[k];
+	}
+
+	for (idx = 0; idx < (int)s->nfuncs; idx++)
+		s->flags |= s->funcs[idx].flags;
+
+	s->total = s->main_depth + lo + hi;
+	s->headroom = (int)iram_top - s->sp_init - s->total;
+
+out:
+	free(p.state);
+	free(p.seen);
+	free(p.owner);
+	if (ret)
+		dis8051_stack_free(s);
+	return ret;
+}
+
+void dis8051_stack_free(struct dis8051_stack *s)
+{
+	free(s->funcs);
+	memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,47 @@
+/* 8051/8052 static stack depth analysis */
+
+#ifndef DIS8051_STACK_H
+#define DIS8051_STACK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "8051-flow.h"
+
+/* interrupt vectors of the 8052, 0x0003 + 8*n, IP bit n */
+#define DIS8051_VECTORS 6
+
+/* function / result flags */
+#define DIS8051_STACK_RECURSIVE 0x1  /* part of a call cycle */
+#define DIS8051_STACK_UNBOUNDED 0x2  /* pushes in a loop */
+#define DIS8051_STACK_SP_WRITE  0x4  /* writes SP other than inc/dec */
+
+struct dis8051_stack_func {
+	uint16_t addr;
+	uint16_t depth;   /* bytes above SP at entry, callees included */
+	uint8_t flags;
+};
+
+struct dis8051_stack {
+	struct dis8051_stack_func *funcs;  /* sorted by address */
+	size_t nfuncs;
+
+	uint16_t main_depth;               /* from the reset entry */
+	int16_t isr_depth[DIS8051_VECTORS];  /* incl. return address,
+	                                      * -1 if there is no handler */
+	uint8_t ip;         /* interrupt priorities assumed */
+	uint8_t sp_init;    /* SP after startup */
+	uint16_t total;     /* worst case, with nested interrupts */
+	int headroom;       /* bytes left up to the top of IRAM,
+	                     * negative on overflow */
+	uint8_t flags;      /* any function's flags */
+};
+
+/* analyse the functions found by 'f'; 'ip' is the IP register value,
+ * or -1 to take every priority bit set anywhere in the code, 'iram_top'
+ * is the last IRAM address usable by the stack (0x7f on the 8051,
+ * 0xff on the 8052), returns 0 on success, -1 if out of memory */
+int dis8051_stack_run(const struct dis8051_flow *f, int ip,
+                      uint8_t iram_top, struct dis8051_stack *s);
+void dis8051_stack_free(struct dis8051_stack *s);
+
+#endif
@@ -0,0 +1,181 @@
+/* superset disassembly of every byte offset */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-superset.h"
+
+static int in_range(const struct dis8051_superset *s, uint16_t addr)
+{
+	return addr >= s->base && addr - s->base < s->len;
+}
+
+static int falls_through(const struct dis8051_srec *r)
+{
+	switch (r->flags & DIS8051_SREC_FLOW) {
+	case DIS8051_FLOW_NONE:
+	case DIS8051_FLOW_CJMP:
+	case DIS8051_FLOW_CALL:
+		return 1;
+	}
+	return 0;
+}
+
+int dis8051_superset_init(struct dis8051_superset *s,
+                          const struct dis8051_derivative *d, uint16_t base,
+                          const uint8_t *buf, int len)
+{
+	struct dis8051_insn in;
+	struct dis8051_srec *r;
+	int off;
+
+	memset(s, 0, sizeof(*s));
+	if (len < 0 || base + len > 0x10000)
+		return -1;
+	if (!(s->rec = calloc(len ? len : 1, sizeof(*s->rec))))
+		return -1;
+	s->base = base;
+	s->len = len;
+
+	for (off = 0; off < len; off++) {
+		r = &s->rec[off];
+		if (!dis8051_decode_deriv(d, base + off, buf + off, len - off,
+		                          &in)) {
+			/* the opcode still tells what it would have been */
+			r->flags = dis8051_opcodes[buf[off]].flow;
+			continue;
+		}
+		r->size = in.size;
+		r->flags = in.flow;
+		r->target = in.target;
+		if (in.flow == DIS8051_FLOW_JMP ||
+		    in.flow == DIS8051_FLOW_CJMP ||
+		    in.flow == DIS8051_FLOW_CALL)
+			r->flags |= DIS8051_SREC_TARGET;
+	}
+	return 0;
+}
+
+void dis8051_superset_free(struct dis8051_superset *s)
+{
+	free(s->rec);
+	memset(s, 0, sizeof(*s));
+}
+
+const struct dis8051_srec *dis8051_superset_at(
+		const struct dis8051_superset *s, uint16_t addr)
+{
+	return in_range(s, addr) ? &s->rec[addr - s->base] : NULL;
+}
+
+int dis8051_superset_next(const struct dis8051_superset *s, uint16_t addr)
+{
+	const struct dis8051_srec *r = dis8051_superset_at(s, addr);
+	int next;
+
+	if (!r || !r->size || !falls_through(r))
+		return -1;
+	next = addr + r->size;
+	return next < s->base + s->len ? next : -1;
+}
+
+int dis8051_superset_prev(const struct dis8051_superset *s, uint16_t addr,
+                          uint16_t prev[3])
+{
+	const struct dis8051_srec *r;
+	int k, n = 0;
+
+	if (!in_range(s, addr))
+		return 0;
+	for (k = 1; k <= 3 && addr - k >= s->base; k++) {
+		r = &s->rec[addr - k - s->base];
+		if (r->size == k && falls_through(r))
+			prev[n++] = addr - k;
+	}
+	return n;
+}
+
+/* bad by itself, before looking at what follows */
+static int bad(const struct dis8051_superset *s, int off)
+{
+	const struct dis8051_srec *r = &s->rec[off];
+
+	if (!r->size || (r->flags & DIS8051_SREC_FLOW) == DIS8051_FLOW_ILL)
+		return 1;
+	if (falls_through(r) && off + r->size >= s->len)
+		return 1;
+	return (r->flags & DIS8051_SREC_TARGET) && !in_range(s, r->target);
+}
+
+int dis8051_superset_prune(struct dis8051_superset *s)
+{
+	struct dis8051_srec *r;
+	uint32_t *first, *from;
+	uint16_t *work, prev[3];
+	int off, t, n = 0, nwork = 0, i, k;
+
+	/* the jumps and calls into each offset, grouped by target */
+	first = calloc(s->len + 1, sizeof(*first));
+	from = malloc((s->len ? s->len : 1)*sizeof(*from));
+	work = malloc((s->len ? s->len : 1)*sizeof(*work));
+	if (!first || !from || !work) {
+		free(first);
+		free(from);
+		free(work);
+		return -1;
+	}
+	for (off = 0; off < s->len; off++) {
+		r = &s->rec[off];
+		if (r->size && (r->flags & DIS8051_SREC_TARGET) &&
+		    in_range(s, r->target))
+			first[r->target - s->base + 1]++;
+	}
+	for (off = 0; off < s->len; off++)
+		first[off + 1] += first[off];
+	for (off = 0; off < s->len; off++) {
+		r = &s->rec[off];
+		if (r->size && (r->flags & DIS8051_SREC_TARGET) &&
+		    in_range(s, r->target))
+			from[first[r->target - s->base]++] = off;
+	}
+	/* 'first' was moved on to the end of each group */
+	memmove(first + 1, first, s->len*sizeof(*first));
+	first[0] = 0;
+
+	for (off = 0; off < s->len; off++) {
+		s->rec[off].flags &= ~DIS8051_SREC_BAD;
+		if (bad(s, off)) {
+			s->rec[off].flags |= DIS8051_SREC_BAD;
+			work[nwork++] = off;
+		}
+	}
+
+	/* badness goes back to whatever reaches a bad instruction, each
+	 * offset is queued once */
+	while (nwork) {
+		off = work[--nwork];
+		n++;
+		k = dis8051_superset_prev(s, s->base + off, prev);
+		for (i = 0; i < k; i++) {
+			r = &s->rec[prev[i] - s->base];
+			if (!(r->flags & DIS8051_SREC_BAD)) {
+				r->flags |= DIS8051_SREC_BAD;
+				work[nwork++] = prev[i] - s->base;
+			}
+		}
+		for (i = first[off]; i < (int)first[off + 1]; i++) {
+			t = from[i];
+			r = &s->rec[t];
+			if (!(r->flags & DIS8051_SREC_BAD)) {
+				r->flags |= DIS8051_SREC_BAD;
+				work[nwork++] = t;
+			}
+		}
+	}
+
+	free(first);
+	free(from);
+	free(work);
+	return n;
+}
@@ -0,0 +1,57 @@
+/* superset disassembly: the instruction at every byte offset of an
+ * image, decoded once, for heuristics that pick the real instruction
+ * stream out of the overlapping ones without decoding again */
+
+#ifndef DIS8051_SUPERSET_H
+#define DIS8051_SUPERSET_H
+
+#include <stdint.h>
+#include "8051-insn.h"
+
+/* record flags */
+#define DIS8051_SREC_FLOW   0x07  /* DIS8051_FLOW_* */
+#define DIS8051_SREC_TARGET 0x08  /* 'target' is a jump or call target */
+#define DIS8051_SREC_BAD    0x10  /* see dis8051_superset_prune() */
+
+/* the instruction at one offset; the ones at the next size - 1 offsets
+ * overlap it */
+struct dis8051_srec {
+	uint16_t target;
+	uint8_t size;     /* 0 if it runs past the end of the image */
+	uint8_t flags;
+};
+
+struct dis8051_superset {
+	uint16_t base;
+	int len;
+	struct dis8051_srec *rec;   /* one per byte */
+};
+
+/* decode 'len' bytes of code at 'base' at every offset, with the extra
+ * opcodes of derivative 'd', NULL for none;
+ * returns 0 on success, -1 if out of memory */
+int dis8051_superset_init(struct dis8051_superset *s,
+                          const struct dis8051_derivative *d, uint16_t base,
+                          const uint8_t *buf, int len);
+void dis8051_superset_free(struct dis8051_superset *s);
+
+/* the record at 'addr', NULL outside of the image */
+const struct dis8051_srec *dis8051_superset_at(
+		const struct dis8051_superset *s, uint16_t addr);
+
+/* the instruction after the one at 'addr' on its fall-through chain,
+ * -1 if it does not fall through or the chain leaves the image */
+int dis8051_superset_next(const struct dis8051_superset *s, uint16_t addr);
+
+/* the up to three instructions that fall through into 'addr',
+ * returns their number */
+int dis8051_superset_prev(const struct dis8051_superset *s, uint16_t addr,
+                          uint16_t prev[3]);
+
+/* flag DIS8051_SREC_BAD on the instructions that cannot be code: those
+ * that are reserved or run past the end, and those with a successor,
+ * fall-through or target, that is bad or outside of the image;
+ * returns the number of bad ones, or -1 if out of memory */
+int dis8051_superset_prune(struct dis8051_superset *s);
+
+#endif
@@ -0,0 +1,184 @@
+/* symbol table filled by the loaders, hashed by address and by name */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-symtab.h"
+
+#define POOL_BLOCK 65536
+
+void dis8051_symtab_init(struct dis8051_symtab *t)
+{
+	memset(t, 0, sizeof(*t));
+}
+
+void dis8051_symtab_free(struct dis8051_symtab *t)
+{
+	size_t i;
+
+	for (i = 0; i < t->npool; i++)
+		free(t->pool[i]);
+	free(t->pool);
+	free(t->syms);
+	free(t->by_addr);
+	free(t->by_name);
+	memset(t, 0, sizeof(*t));
+}
+
+static size_t hash_addr(int space, uint32_t addr)
+{
+	return ((uint32_t)space << 28 ^ addr) * 0x9e3779b1u;
+}
+
+/* FNV-1a */
+static size_t hash_name(const char *s, size_t len)
+{
+	uint32_t h = 2166136261u;
+
+	while (len--)
+		h = (h ^ (uint8_t)*s++) * 16777619u;
+	return h;
+}
+
+static void insert_addr(struct dis8051_symtab *t, size_t i)
+{
+	const struct dis8051_sym *s = &t->syms[i], *o;
+	size_t m = t->buckets - 1, h = hash_addr(s->space, s->addr) & m;
+
+	for (; t->by_addr[h]; h = (h + 1) & m) {
+		o = &t->syms[t->by_addr[h] - 1];
+		if (o->space == s->space && o->addr == s->addr)
+			return;
+	}
+	t->by_addr[h] = i + 1;
+}
+
+static void insert_name(struct dis8051_symtab *t, size_t i)
+{
+	const char *name = t->syms[i].name;
+	size_t m = t->buckets - 1, h = hash_name(name, strlen(name)) & m;
+
+	for (; t->by_name[h]; h = (h + 1) & m)
+		if (!strcmp(t->syms[t->by_name[h] - 1].name, name))
+			return;
+	t->by_name[h] = i + 1;
+}
+
+/* keep the tables at most half full */
+static int grow(struct dis8051_symtab *t)
+{
+	size_t n = t->buckets ? t->buckets*2 : 256, i;
+	uint32_t *a, *b;
+
+	if (!(a = calloc(n, sizeof(*a))))
+		return -1;
+	if (!(b = calloc(n, sizeof(*b)))) {
+		free(a);
+		return -1;
+	}
+	free(t->by_addr);
+	free(t->by_name);
+	t->by_addr = a;
+	t->by_name = b;
+	t->buckets = n;
+	for (i = 0; i < t->count; i++) {
+		insert_addr(t, i);
+		insert_name(t, i);
+	}
+	return 0;
+}
+
+/* copy of 'len' bytes of 'name' in the pool */
+static char *intern(struct dis8051_symtab *t, const char *name, size_t len)
+{
+	size_t n = len + 1 > POOL_BLOCK ? len + 1 : POOL_BLOCK;
+	char **p, *s;
+
+	if (t->npool == 0 || t->pool_used + len + 1 > POOL_BLOCK) {
+		if (!(p = realloc(t->pool, (t->npool + 1)*sizeof(*p))))
+			return NULL;
+		t->pool = p;
+		if (!(p[t->npool] = malloc(n)))
+			return NULL;
+		t->npool++;
+		t->pool_used = 0;
+	}
+	s = t->pool[t->npool - 1] + t->pool_used;
+	memcpy(s, name, len);
+	s[len] = '\0';
+	t->pool_used += len + 1;
+	return s;
+}
+
+const char *dis8051_symtab_intern(struct dis8051_symtab *t, const char *name,
+                                  size_t len)
+{
+	return intern(t, name, len);
+}
+
+int dis8051_symtab_add(struct dis8051_symtab *t, int space, uint32_t addr,
+                       const char *name, size_t len)
+{
+	struct dis8051_sym *s;
+	size_t n;
+
+	if (t->count == t->alloc) {
+		n = t->alloc ? t->alloc*2 : 64;
+		if (!(s = realloc(t->syms, n*sizeof(*s))))
+			return -1;
+		t->syms = s;
+		t->alloc = n;
+	}
+	if (2*(t->count + 1) > t->buckets && grow(t) < 0)
+		return -1;
+
+	s = &t->syms[t->count];
+	if (!(s->name = intern(t, name, len)))
+		return -1;
+	s->addr = addr;
+	s->space = space;
+	insert_addr(t, t->count);
+	insert_name(t, t->count);
+	t->count++;
+	return 0;
+}
+
+const struct dis8051_sym *dis8051_symtab_find(const struct dis8051_symtab *t,
+                                              int space, uint32_t addr)
+{
+	const struct dis8051_sym *s;
+	size_t m = t->buckets - 1, h;
+
+	if (t->count == 0)
+		return NULL;
+	for (h = hash_addr(space, addr) & m; t->by_addr[h]; h = (h + 1) & m) {
+		s = &t->syms[t->by_addr[h] - 1];
+		if (s->space == space && s->addr == addr)
+			return s;
+	}
+	return NULL;
+}
+
+const struct dis8051_sym *dis8051_symtab_lookup(const struct dis8051_symtab *t,
+                                                const char *name)
+{
+	const struct dis8051_sym *s;
+	size_t m = t->buckets - 1, h;
+
+	if (t->count == 0)
+		return NULL;
+	for (h = hash_name(name, strlen(name)) & m; t->by_name[h];
+	     h = (h + 1) & m) {
+		s = &t->syms[t->by_name[h] - 1];
+		if (!strcmp(s->name, name))
+			return s;
+	}
+	return NULL;
+}
+
+const char *dis8051_symtab_name(void *user, int space, uint16_t addr)
+{
+	const struct dis8051_sym *s = dis8051_symtab_find(user, space, addr);
+
+	return s ? s->name : NULL;
+}
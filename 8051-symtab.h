@@ -0,0 +1,48 @@
+/* symbol table filled by the loaders, hashed by address and by name */
+
+#ifndef DIS8051_SYMTAB_H
+#define DIS8051_SYMTAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct dis8051_sym {
+	const char *name;
+	uint32_t addr;     /* bank:address for banked code */
+	uint8_t space;     /* enum dis8051_space */
+};
+
+struct dis8051_symtab {
+	struct dis8051_sym *syms;  /* in the order they were added */
+	size_t count, alloc;
+	uint32_t *by_addr;         /* index + 1 or 0, open addressing */
+	uint32_t *by_name;
+	size_t buckets;            /* power of 2, at least 2*count */
+	char **pool;               /* blocks the names are kept in */
+	size_t npool, pool_used;
+};
+
+void dis8051_symtab_init(struct dis8051_symtab *t);
+void dis8051_symtab_free(struct dis8051_symtab *t);
+
+/* add 'name' for 'addr' in 'space'; the first name of an address is
+ * the one it is shown as, the others can still be looked up by name;
+ * returns 0 on success, -1 if out of memory */
+int dis8051_symtab_add(struct dis8051_symtab *t, int space, uint32_t addr,
+                       const char *name, size_t len);
+
+/* copy of a name that is no symbol, such as a source file, kept as
+ * long as 't'; NULL if out of memory */
+const char *dis8051_symtab_intern(struct dis8051_symtab *t, const char *name,
+                                  size_t len);
+
+/* NULL if there is none */
+const struct dis8051_sym *dis8051_symtab_find(const struct dis8051_symtab *t,
+                                              int space, uint32_t addr);
+const struct dis8051_sym *dis8051_symtab_lookup(const struct dis8051_symtab *t,
+                                                const char *name);
+
+/* dis8051_symbol_fn (8051-render.h) for a symtab passed as 'user' */
+const char *dis8051_symtab_name(void *user, int space, uint16_t addr);
+
+#endif
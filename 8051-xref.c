@@ -0,0 +1,196 @@
+/* 8051/8052 cross-reference index,
+ * built in a single sweep over the decoder output */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "8051-insn.h"
+#include "8051-xref.h"
+
+#define XREF_INITIAL 256
+
+/* key for the 'by_to' order: space, to, from */
+static uint64_t to_key(const struct dis8051_xref *r)
+{
+	return (uint64_t)r->space<<32 | (uint32_t)r->to<<16 | r->from;
+}
+
+static int cmp_to(const void *a, const void *b)
+{
+	uint64_t ka = to_key(a), kb = to_key(b);
+
+	return (ka > kb) - (ka < kb);
+}
+
+static int cmp_from(const void *a, const void *b)
+{
+	const struct dis8051_xref *ra = a, *rb = b;
+
+	return (int)ra->from - (int)rb->from;
+}
+
+static int push(struct dis8051_xrefs *x, uint16_t from, uint16_t to,
+                uint8_t space, uint8_t kind)
+{
+	struct dis8051_xref *r;
+
+	if (x->count == x->alloc) {
+		size_t n = x->alloc ? x->alloc*2 : XREF_INITIAL;
+
+		if (!(r = realloc(x->by_from, n*sizeof(*r))))
+			return -1;
+		x->by_from = r;
+		x->alloc = n;
+	}
+
+	r = &x->by_from[x->count++];
+	r->from = from;
+	r->to = to;
+	r->space = space;
+	r->kind = kind;
+	return 0;
+}
+
+/* references made by the operands of one instruction */
+static int add_insn(struct dis8051_xrefs *x, const struct dis8051_insn *in)
+{
+	int i, kind;
+
+	for (i = 0; i < 3 && in->opnd[i] != DIS8051_OPND_NONE; i++) {
+		kind = dis8051_access(in, i);
+
+		switch (in->opnd[i]) {
+		case DIS8051_OPND_DIRECT:
+			if (push(x, in->pc, in->val[i], in->val[i] < 0x80 ?
+			         DIS8051_SPACE_IRAM : DIS8051_SPACE_SFR, kind))
+				return -1;
+			break;
+
+		case DIS8051_OPND_BIT:
+		case DIS8051_OPND_NBIT:
+			if (push(x, in->pc, in->val[i], DIS8051_SPACE_BIT,
+			         kind))
+				return -1;
+			break;
+
+		/* mov dptr, #imm16 */
+		case DIS8051_OPND_IMM16:
+			if (push(x, in->pc, in->val[i], DIS8051_SPACE_XDATA,
+			         DIS8051_XREF_PTR))
+				return -1;
+			break;
+
+		case DIS8051_OPND_REL:
+		case DIS8051_OPND_ADDR11:
+		case DIS8051_OPND_ADDR16:
+			if (push(x, in->pc, in->val[i], DIS8051_SPACE_CODE,
+			         in->flow == DIS8051_FLOW_CALL ?
+			         DIS8051_XREF_CALL : DIS8051_XREF_JUMP))
+				return -1;
+			break;
+		}
+	}
+
+	return 0;
+}
+
+void dis8051_xrefs_sort(struct dis8051_xrefs *x)
+{
+	qsort(x->by_from, x->count, sizeof(*x->by_from), cmp_from);
+	memcpy(x->by_to, x->by_from, x->count*sizeof(*x->by_to));
+	qsort(x->by_to, x->count, sizeof(*x->by_to), cmp_to);
+}
+
+int dis8051_xrefs_build(struct dis8051_xrefs *x, uint16_t base,
+                        const uint8_t *buf, int len)
+{
+	struct dis8051_insn in;
+	int off, size;
+
+	memset(x, 0, sizeof(*x));
+
+	/* linear sweep, emits in 'from' order */
+	for (off = 0; off < len; off += size) {
+		if (!(size = dis8051_decode(base + off, buf + off, len - off,
+		                            &in)))
+			break;
+		if (add_insn(x, &in))
+			goto fail;
+	}
+
+	if (!(x->by_to = malloc((x->alloc ? x->alloc : 1)*sizeof(*x->by_to))))
+		goto fail;
+	memcpy(x->by_to, x->by_from, x->count*sizeof(*x->by_to));
+	qsort(x->by_to, x->count, sizeof(*x->by_to), cmp_to);
+	return 0;
+
+fail:
+	dis8051_xrefs_free(x);
+	return -1;
+}
+
+int dis8051_xrefs_add(struct dis8051_xrefs *x, uint16_t from, uint16_t to,
+                      uint8_t space, uint8_t kind)
+{
+	size_t alloc = x->alloc;
+	struct dis8051_xref *r;
+
+	if (push(x, from, to, space, kind))
+		return -1;
+
+	/* keep 'by_to' as large as 'by_from' */
+	if (x->alloc != alloc || !x->by_to) {
+		if (!(r = realloc(x->by_to, x->alloc*sizeof(*r)))) {
+			x->count--;
+			return -1;
+		}
+		x->by_to = r;
+	}
+	return 0;
+}
+
+void dis8051_xrefs_free(struct dis8051_xrefs *x)
+{
+	free(x->by_from);
+	free(x->by_to);
+	memset(x, 0, sizeof(*x));
+}
+
+/* first entry with key >= 'key' */
+static size_t lower_bound(const struct dis8051_xref *r, size_t n,
+                          uint64_t key, int by_to)
+{
+	size_t lo = 0, hi = n, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo)/2;
+		if ((by_to ? to_key(&r[mid]) : r[mid].from) < key)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+size_t dis8051_xrefs_to(const struct dis8051_xrefs *x, uint8_t space,
+                        uint16_t to, const struct dis8051_xref **refs)
+{
+	uint64_t key = (uint64_t)space<<32 | (uint32_t)to<<16;
+	size_t lo, hi;
+
+	lo = lower_bound(x->by_to, x->count, key, 1);
+	hi = lower_bound(x->by_to, x->count, key + 0x10000, 1);
+	*refs = &x->by_to[lo];
+	return hi - lo;
+}
+
+size_t dis8051_xrefs_from(const struct dis8051_xrefs *x, uint16_t from,
+                          const struct dis8051_xref **refs)
+{
+	size_t lo, hi;
+
+	lo = lower_bound(x->by_from, x->count, from, 0);
+	hi = lower_bound(x->by_from, x->count, (uint64_t)from + 1, 0);
+	*refs = &x->by_from[lo];
+	return hi - lo;
+}
@@ -0,0 +1,58 @@
+/* 8051/8052 cross-reference index,
+ * built in a single sweep over the decoder output */
+
+#ifndef DIS8051_XREF_H
+#define DIS8051_XREF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* address spaces */
+enum dis8051_space {
+	DIS8051_SPACE_CODE,
+	DIS8051_SPACE_XDATA,
+	DIS8051_SPACE_IRAM,   /* direct addresses 0x00 -- 0x7f */
+	DIS8051_SPACE_SFR,    /* direct addresses 0x80 -- 0xff */
+	DIS8051_SPACE_BIT
+};
+
+/* kind of reference, DIS8051_READ / DIS8051_WRITE are used as is */
+#define DIS8051_XREF_JUMP 0x4
+#define DIS8051_XREF_CALL 0x8
+#define DIS8051_XREF_PTR  0x10  /* address loaded into a pointer */
+
+struct dis8051_xref {
+	uint16_t from;
+	uint16_t to;
+	uint8_t space;
+	uint8_t kind;
+};
+
+/* the same references, sorted two ways */
+struct dis8051_xrefs {
+	struct dis8051_xref *by_from;  /* by (from) */
+	struct dis8051_xref *by_to;    /* by (space, to, from) */
+	size_t count;
+	size_t alloc;
+};
+
+/* sweep 'len' bytes of code loaded at 'base',
+ * returns 0 on success, -1 if out of memory */
+int dis8051_xrefs_build(struct dis8051_xrefs *x, uint16_t base,
+                        const uint8_t *buf, int len);
+void dis8051_xrefs_free(struct dis8051_xrefs *x);
+
+/* add a single reference, e.g. from a later analysis pass,
+ * and restore the sort order, see 'dis8051_xrefs_sort' */
+int dis8051_xrefs_add(struct dis8051_xrefs *x, uint16_t from, uint16_t to,
+                      uint8_t space, uint8_t kind);
+void dis8051_xrefs_sort(struct dis8051_xrefs *x);
+
+/* references to 'to' in 'space' / from instruction at 'from',
+ * return the number of entries found and the first one in 'refs' */
+size_t dis8051_xrefs_to(const struct dis8051_xrefs *x, uint8_t space,
+                        uint16_t to, const struct dis8051_xref **refs);
+size_t dis8051_xrefs_from(const struct dis8051_xrefs *x, uint16_t from,
+                          const struct dis8051_xref **refs);
+
+#endif
@@ -0,0 +1,31 @@
+/* libdis8051: 8051/8052 decoder, renderer, assembler and analysis
+ * passes, plain C without dependencies; the radare2 plugin is a thin
+ * adapter over it */
+
+#ifndef DIS8051_H
+#define DIS8051_H
+
+#include "8051-insn.h"
+#include "8051-render.h"
+#include "8051-asm.h"
+#include "8051-xref.h"
+#include "8051-dptr.h"
+#include "8051-flow.h"
+#include "8051-bank.h"
+#include "8051-sfrpage.h"
+#include "8051-codebank.h"
+#include "8051-stack.h"
+#include "8051-image.h"
+#include "8051-ihex.h"
+#include "8051-symtab.h"
+#include "8051-omf.h"
+#include "8051-span.h"
+#include "8051-sdcc.h"
+#include "8051-sig.h"
+#include "8051-detect.h"
+#include "8051-fhash.h"
+#include "8051-pindex.h"
+#include "8051-superset.h"
+#include "8051-cache.h"
+
+#endif
@@ -0,0 +1,1098 @@
+/* analysis tests: small programs, assembled from source, are run through
+ * each analysis and what it finds is compared with what it must find
+ *
+ * usage: analysis */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include "../8051-insn.h"
+#include "../8051-asm.h"
+#include "../8051-render.h"
+#include "../8051-xref.h"
+#include "../8051-dptr.h"
+#include "../8051-flow.h"
+#include "../8051-stack.h"
+#include "../8051-bank.h"
+#include "../8051-sfrpage.h"
+#include "../8051-codebank.h"
+#include "../8051-sig.h"
+#include "../8051-detect.h"
+#include "../8051-fhash.h"
+#include "../8051-pindex.h"
+#include "../8051-superset.h"
+#include "../8051-cache.h"
+
+#define CODE_MAX 512
+
+static unsigned checks, bad;
+
+/* what an analysis gave, as text */
+static char got[1024];
+static size_t ngot;
+
+static void say(const char *fmt, ...)
+{
+	va_list ap;
+	int n;
+
+	va_start(ap, fmt);
+	n = vsnprintf(got + ngot, sizeof(got) - ngot, fmt, ap);
+	va_end(ap);
+	if (n > 0)
+		ngot = ngot + n < sizeof(got) ? ngot + n : sizeof(got) - 1;
+}
+
+static void expect(const char *what, const char *src, const char *want)
+{
+	checks++;
+	if (strcmp(got, want)) {
+		printf("%s of '%s'\n  is '%s'\n  not '%s'\n", what, src, got,
+		       want);
+		bad++;
+	}
+	ngot = 0;
+	*got = '\0';
+}
+
+static void check(const char *what, const char *src, int ok)
+{
+	checks++;
+	if (!ok) {
+		printf("%s of '%s' failed\n", what, src);
+		bad++;
+	}
+}
+
+/* 'src' at 'pc', or -1 after a message */
+static int assemble(uint16_t pc, const char *src, uint8_t *code)
+{
+	int len = dis8051_assemble_block(NULL, pc, src, code, CODE_MAX);
+
+	if (len < 0) {
+		printf("'%s' does not assemble\n", src);
+		bad++;
+	}
+	return len;
+}
+
+/* a new empty file for 'path', or -1 after a message */
+static int temp_path(char *path, size_t n)
+{
+	const char *dir = getenv("TMPDIR");
+	int fd;
+
+	snprintf(path, n, "%s/dis8051-XXXXXX", dir && *dir ? dir : "/tmp");
+	if ((fd = mkstemp(path)) < 0) {
+		perror(path);
+		bad++;
+		return -1;
+	}
+	close(fd);
+	return 0;
+}
+
+static const char *const spaces[] = {"code", "xdata", "iram", "sfr", "bit"};
+
+/* --- decoding --- */
+
+static void check_decode(void)
+{
+	struct dis8051_insn in;
+	uint8_t *end = calloc(1, 1);
+
+	/* nothing is read of an empty buffer */
+	if (!end)
+		return;
+	check("decoding", "no bytes", !dis8051_decode(0, end + 1, 0, &in) &&
+	      !dis8051_decode_deriv(dis8051_derivative("ds89c450"), 0,
+	                            end + 1, 0, &in));
+	free(end);
+}
+
+/* --- cross references --- */
+
+static const struct {
+	const char *src;
+	const char *xrefs;     /* "from space to kind" by from */
+} xref_tests[] = {
+	{"lcall 0x0010; mov 0x30,a; setb 0x90; mov dptr,#0x1234; "
+	 "sjmp 0x0000",
+	 "0000 code 0010 c; 0003 iram 0030 w; 0005 bit 0090 w; "
+	 "0007 xdata 1234 p; 000a code 0000 j; "},
+	{"mov a,0x81; jb 0xe0,0x0000; anl 0x20,#0x0f",
+	 "0000 sfr 0081 r; 0002 bit 00e0 r; 0002 code 0000 j; "
+	 "0005 iram 0020 rw; "},
+};
+
+static void kind(int k)
+{
+	say(" %s%s%s%s%s", k & DIS8051_READ ? "r" : "",
+	    k & DIS8051_WRITE ? "w" : "", k & DIS8051_XREF_JUMP ? "j" : "",
+	    k & DIS8051_XREF_CALL ? "c" : "", k & DIS8051_XREF_PTR ? "p" : "");
+}
+
+static void xref_summary(const struct dis8051_xrefs *x)
+{
+	const struct dis8051_xref *r;
+	size_t n;
+
+	for (n = 0; n < x->count; n++) {
+		r = &x->by_from[n];
+		say("%04x %s %04x", r->from, spaces[r->space], r->to);
+		kind(r->kind);
+		say("; ");
+	}
+}
+
+static void check_xrefs(void)
+{
+	const struct dis8051_xref *r;
+	struct dis8051_xrefs x;
+	uint8_t code[CODE_MAX];
+	size_t i, n;
+	int len;
+
+	for (i = 0; i < sizeof(xref_tests)/sizeof(xref_tests[0]); i++) {
+		if ((len = assemble(0, xref_tests[i].src, code)) < 0)
+			continue;
+		if (dis8051_xrefs_build(&x, 0, code, len) < 0) {
+			check("xrefs", xref_tests[i].src, 0);
+			continue;
+		}
+		xref_summary(&x);
+		expect("xrefs", xref_tests[i].src, xref_tests[i].xrefs);
+
+		/* the other order finds the same ones */
+		for (n = 0; n < x.count; n++) {
+			r = &x.by_from[n];
+			if (!dis8051_xrefs_to(&x, r->space, r->to, &r) ||
+			    r->to != x.by_from[n].to)
+				break;
+		}
+		check("xrefs by target", xref_tests[i].src, n == x.count);
+		dis8051_xrefs_free(&x);
+	}
+}
+
+/* --- DPTR propagation --- */
+
+static const struct {
+	const char *deriv;
+	const char *src;
+	const char *dptrs;     /* "from space to kind" of resolved ones */
+} dptr_tests[] = {
+	{"8052", "mov dptr,#0x1000; inc dptr; movx a,@dptr; inc dptr; "
+	         "movx @dptr,a",
+	 "0004 xdata 1001 r; 0006 xdata 1002 w; "},
+	/* DPL and DPH written directly, from an immediate and from a */
+	{"8052", "mov 0x82,#0x34; mov 0x83,#0x12; movx a,@dptr; "
+	         "mov a,#0x56; mov 0x83,a; movx a,@dptr",
+	 "0006 xdata 1234 r; 000b xdata 5634 r; "},
+	{"8052", "mov dptr,#0x0100; mov a,#2; movc a,@a+dptr",
+	 "0005 code 0102 r; "},
+	/* a jump ends the block, its target starts one */
+	{"8052", "mov dptr,#0x2000; movx a,@dptr; sjmp next; "
+	         "next: movx a,@dptr",
+	 "0003 xdata 2000 r; "},
+	{"8052", "mov dptr,#0x2000; loop: movx a,@dptr; sjmp loop",
+	 ""},
+	/* inc DPS toggles the select bit, back to DPTR0 */
+	{"ds89c450", "mov DPS,#0; mov dptr,#0x1000; inc DPS; "
+	             "mov dptr,#0x2000; movx a,@dptr; inc DPS; movx a,@dptr",
+	 "000b xdata 2000 r; 000e xdata 1000 r; "},
+	/* DPTR1 through DPL1 and DPH1 while DPTR0 is selected */
+	{"ds89c450", "mov DPS,#0; mov DPL1,#0x78; mov DPH1,#0x56; "
+	             "mov dptr,#0x1000; orl DPS,#1; movx a,@dptr",
+	 "000f xdata 5678 r; "},
+	/* movx steps the selected DPTR up, or down */
+	{"ds89c450", "mov DPS,#0x10; mov dptr,#0x3000; movx a,@dptr; "
+	             "movx a,@dptr",
+	 "0006 xdata 3000 r; 0007 xdata 3001 r; "},
+	{"ds89c450", "mov DPS,#0x50; mov dptr,#0x3000; movx a,@dptr; "
+	             "movx a,@dptr",
+	 "0006 xdata 3000 r; 0007 xdata 2fff r; "},
+	/* a DPS of unknown value leaves no DPTR known */
+	{"ds89c450", "mov dptr,#0x1000; mov DPS,a; movx a,@dptr",
+	 ""},
+};
+
+static void check_dptr(void)
+{
+	const struct dis8051_xref *r;
+	struct dis8051_xrefs x;
+	struct dis8051_ctx ctx;
+	uint8_t code[CODE_MAX];
+	size_t i, n;
+	int len;
+
+	for (i = 0; i < sizeof(dptr_tests)/sizeof(dptr_tests[0]); i++) {
+		dis8051_ctx_init(&ctx);
+		ctx.deriv = dis8051_derivative(dptr_tests[i].deriv);
+		if ((len = dis8051_assemble_block(&ctx, 0, dptr_tests[i].src,
+		                                  code, CODE_MAX)) < 0 ||
+		    dis8051_xrefs_build(&x, 0, code, len) < 0) {
+			check("assembly", dptr_tests[i].src, 0);
+			continue;
+		}
+		if (dis8051_dptr_resolve(ctx.deriv, &x, 0, code, len) < 0) {
+			check("dptr", dptr_tests[i].src, 0);
+			dis8051_xrefs_free(&x);
+			continue;
+		}
+		for (n = 0; n < x.count; n++) {
+			r = &x.by_from[n];
+			if (!(r->kind & DIS8051_XREF_DPTR))
+				continue;
+			say("%04x %s %04x", r->from, spaces[r->space], r->to);
+			kind(r->kind & ~DIS8051_XREF_DPTR);
+			say("; ");
+		}
+		expect("dptr", dptr_tests[i].src, dptr_tests[i].dptrs);
+		dis8051_xrefs_free(&x);
+	}
+}
+
+/* --- traversal --- */
+
+static const struct {
+	const char *src;
+	const char *flow;      /* functions, jump tables and data */
+} flow_tests[] = {
+	/* ajmp entries, bounded by the compare */
+	{"cjne a,#3,next; next: jnc out; rl a; mov dptr,#0x000a; "
+	 "jmp @a+dptr; ajmp f0; ajmp f1; ajmp f2; out: ret; "
+	 "f0: ret; f1: ret; f2: ret",
+	 "func 0000; jtab 0009 jumps 000a 3x2 -> 0011 0012 0013; "
+	 "data 000a-000f; "},
+	/* offsets loaded by movc, the table being "rr a; inc a" */
+	{"mov a,r7; cjne a,#2,next; next: jnc out; mov dptr,#0x000b; "
+	 "movc a,@a+dptr; jmp @a+dptr; rr a; inc a; out: ret; ret; ret",
+	 "func 0000; jtab 000a offsets 000b 2x1 -> 000e 000f; "
+	 "data 000b-000c; "},
+	/* a call target starts a function */
+	{"lcall f; sjmp 0x0003; f: ret",
+	 "func 0000 0005; "},
+};
+
+static void flow_summary(const struct dis8051_flow *f)
+{
+	const struct dis8051_jtab *j;
+	static const char *const kinds[] = {"jumps", "offsets", "bytes"};
+	int off, start, i;
+	size_t k;
+
+	say("func");
+	for (off = 0; off < f->len; off++)
+		if (f->map[off] & DIS8051_MAP_FUNC)
+			say(" %04x", f->base + off);
+	say("; ");
+	for (k = 0; k < f->njtabs; k++) {
+		j = &f->jtabs[k];
+		say("jtab %04x %s %04x %ux%u ->", j->pc, kinds[j->kind],
+		    j->table, j->entries, j->entry_size);
+		for (i = 0; i < j->entries; i++)
+			say(" %04x", dis8051_jtab_target(f, j, i));
+		say("; ");
+	}
+	for (off = 0; off < f->len; off++) {
+		if (!(f->map[off] & DIS8051_MAP_DATA))
+			continue;
+		for (start = off; off + 1 < f->len &&
+		     (f->map[off + 1] & DIS8051_MAP_DATA); off++)
+			;
+		say("data %04x-%04x; ", f->base + start, f->base + off);
+	}
+}
+
+static void check_flow(void)
+{
+	struct dis8051_flow f;
+	uint8_t code[CODE_MAX];
+	size_t i;
+	int len;
+
+	for (i = 0; i < sizeof(flow_tests)/sizeof(flow_tests[0]); i++) {
+		if ((len = assemble(0, flow_tests[i].src, code)) < 0)
+			continue;
+		if (dis8051_flow_init(&f, 0, code, len, NULL) < 0 ||
+		    dis8051_flow_add_entry(&f, 0) < 0 ||
+		    dis8051_flow_run(&f) < 0) {
+			check("flow", flow_tests[i].src, 0);
+			dis8051_flow_free(&f);
+			continue;
+		}
+		flow_summary(&f);
+		expect("flow", flow_tests[i].src, flow_tests[i].flow);
+		dis8051_flow_free(&f);
+	}
+}
+
+/* --- stack depth --- */
+
+static const struct {
+	const char *src;
+	const char *stack;     /* depths and flags */
+} stack_tests[] = {
+	/* timer 0 at high priority over main */
+	{"ljmp main; nop; nop; nop; nop; nop; nop; nop; nop; ljmp t0; "
+	 "main: mov 0x81,#0x50; setb 0xb9; lcall f; sjmp $; "
+	 "f: push 0xe0; push 0xf0; lcall g; pop 0xf0; pop 0xe0; ret; "
+	 "g: ret; "
+	 "t0: push 0xd0; lcall g; pop 0xd0; reti",
+	 "0000 6; 000b 3; 0018 4; 0024 0; isr -1 5 -1 -1 -1 -1; "
+	 "ip 02 sp 50 total 11 headroom 36"},
+	/* the nop keeps the sjmp off the first vector */
+	{"lcall r; nop; sjmp $; r: lcall r; ret",
+	 "0000 4; 0006 2 recursive; isr -1 -1 -1 -1 -1 -1; "
+	 "ip 00 sp 07 total 4 headroom 116"},
+	{"loop: push 0xe0; sjmp loop",
+	 "0000 256 unbounded; isr -1 -1 -1 -1 -1 -1; "
+	 "ip 00 sp 07 total 256 headroom -136"},
+};
+
+static void check_stack(void)
+{
+	struct dis8051_flow f;
+	struct dis8051_stack st;
+	uint8_t code[CODE_MAX];
+	size_t i, k;
+	int len;
+
+	for (i = 0; i < sizeof(stack_tests)/sizeof(stack_tests[0]); i++) {
+		if ((len = assemble(0, stack_tests[i].src, code)) < 0)
+			continue;
+		if (dis8051_flow_init(&f, 0, code, len, NULL) < 0 ||
+		    dis8051_flow_add_vectors(&f) < 0 ||
+		    dis8051_flow_run(&f) < 0 ||
+		    dis8051_stack_run(&f, -1, 0x7f, &st) < 0) {
+			check("stack", stack_tests[i].src, 0);
+			dis8051_flow_free(&f);
+			continue;
+		}
+		for (k = 0; k < st.nfuncs; k++)
+			say("%04x %u%s%s%s; ", st.funcs[k].addr,
+			    st.funcs[k].depth,
+			    st.funcs[k].flags & DIS8051_STACK_RECURSIVE ?
+			    " recursive" : "",
+			    st.funcs[k].flags & DIS8051_STACK_UNBOUNDED ?
+			    " unbounded" : "",
+			    st.funcs[k].flags & DIS8051_STACK_SP_WRITE ?
+			    " sp" : "");
+		say("isr");
+		for (k = 0; k < DIS8051_VECTORS; k++)
+			say(" %d", st.isr_depth[k]);
+		say("; ip %02x sp %02x total %u headroom %d", st.ip,
+		    st.sp_init, st.total, st.headroom);
+		expect("stack", stack_tests[i].src, stack_tests[i].stack);
+		dis8051_stack_free(&st);
+		dis8051_flow_free(&f);
+	}
+}
+
+/* --- register banks --- */
+
+static const struct {
+	const char *src;
+	const char *regs;      /* "from iram kind" of the registers */
+} bank_tests[] = {
+	{"mov r0,#1; setb rs0; mov r0,#2; mov r7,a; clr rs0; mov a,r7; "
+	 "sjmp $",
+	 "0000 00 w; 0004 08 w; 0006 0f w; 0009 07 r; "},
+	/* @r1 reads the pointer register only */
+	{"mov psw,#0x18; mov a,r2; mov @r1,a; anl psw,#0xef; mov r2,a; "
+	 "sjmp $",
+	 "0003 1a r; 0004 19 r; 0008 0a w; "},
+	/* a handler saves the bank it was called in and restores it */
+	{"ljmp main; nop; nop; nop; nop; nop; nop; nop; nop; ljmp t0; "
+	 "main: mov psw,#0x08; lcall f; mov r5,a; sjmp $; "
+	 "f: push psw; setb rs1; mov r5,a; pop psw; mov r6,a; ret; "
+	 "t0: push psw; mov psw,#0x10; mov r3,a; pop psw; mov r4,a; reti",
+	 "0014 0d w; 001b 1d w; 001e 0e w; 0025 13 w; "},
+};
+
+static void check_bank(void)
+{
+	const struct dis8051_xref *r;
+	struct dis8051_xrefs x;
+	struct dis8051_flow f;
+	uint8_t code[CODE_MAX], bank[CODE_MAX];
+	char s[64];
+	size_t i, n;
+	int len;
+
+	for (i = 0; i < sizeof(bank_tests)/sizeof(bank_tests[0]); i++) {
+		if ((len = assemble(0, bank_tests[i].src, code)) < 0)
+			continue;
+		memset(&x, 0, sizeof(x));
+		if (dis8051_flow_init(&f, 0, code, len, NULL) < 0 ||
+		    dis8051_flow_add_vectors(&f) < 0 ||
+		    dis8051_flow_run(&f) < 0 ||
+		    dis8051_bank_run(&f, bank) < 0 ||
+		    dis8051_bank_xrefs(&f, bank, &x) < 0) {
+			check("banks", bank_tests[i].src, 0);
+			dis8051_xrefs_free(&x);
+			dis8051_flow_free(&f);
+			continue;
+		}
+		for (n = 0; n < x.count; n++) {
+			r = &x.by_from[n];
+			say("%04x %02x", r->from, r->to);
+			kind(r->kind);
+			say("; ");
+		}
+		expect("registers", bank_tests[i].src, bank_tests[i].regs);
+		dis8051_xrefs_free(&x);
+		dis8051_flow_free(&f);
+	}
+
+	/* the IRAM address in the comment, none where the bank is unknown */
+	if ((len = assemble(0, bank_tests[2].src, code)) < 0)
+		return;
+	if (dis8051_flow_init(&f, 0, code, len, NULL) < 0 ||
+	    dis8051_flow_add_vectors(&f) < 0 || dis8051_flow_run(&f) < 0 ||
+	    dis8051_bank_run(&f, bank) < 0) {
+		check("banks", bank_tests[2].src, 0);
+	} else {
+		if (dis8051_bank_comment(&f, bank, 0x0025, s, sizeof(s)))
+			say("%s; ", s);
+		if (dis8051_bank_comment(&f, bank, 0x0028, s, sizeof(s)))
+			say("%s; ", s);
+		expect("comments", bank_tests[2].src, "r3=0x13; ");
+	}
+	dis8051_flow_free(&f);
+}
+
+/* --- SFR pages --- */
+
+/* C8051F12x: 0x99 is SBUF0 on page 0 and SBUF1 on page 1, 0xcc TMR2L
+ * and TMR4L on page 2, 0xc8 TMR2CN and P4 on page f; f returns on the
+ * page it pushed, the handler restores one that is not known */
+static const char sfrpage_src[] =
+	"ljmp main; nop; nop; nop; nop; nop; nop; nop; nop; ljmp t0; "
+	"main: mov 0x99,a; mov 0x84,#1; mov 0x99,a; lcall f; mov 0xcc,a; "
+	"sjmp $; "
+	"f: mov 0x84,#2; mov 0xcc,a; push 0x84; mov 0x84,#1; mov 0x99,a; "
+	"pop 0x84; ret; "
+	"t0: push 0x84; mov 0x84,#0x0f; mov 0xc8,a; pop 0x84; mov 0xc8,a; "
+	"reti";
+
+static void check_sfrpage(void)
+{
+	const struct dis8051_derivative *d = dis8051_derivative("c8051f12x");
+	struct dis8051_flow f;
+	struct dis8051_insn in;
+	struct dis8051_ctx ctx;
+	uint8_t code[CODE_MAX];
+	uint16_t page[CODE_MAX];
+	char s[64];
+	int len, off;
+
+	if ((len = assemble(0, sfrpage_src, code)) < 0)
+		return;
+	if (dis8051_flow_init(&f, 0, code, len, NULL) < 0 ||
+	    dis8051_flow_add_vectors(&f) < 0 || dis8051_flow_run(&f) < 0 ||
+	    dis8051_sfrpage_run(&f, d, page) < 0) {
+		check("pages", sfrpage_src, 0);
+		dis8051_flow_free(&f);
+		return;
+	}
+	/* the moves to SFRs other than SFRPAGE, as rendered on their page */
+	dis8051_ctx_init(&ctx);
+	ctx.deriv = d;
+	for (off = 0; off < len; off++) {
+		if (!(f.map[off] & DIS8051_MAP_CODE) || code[off] != 0xf5 ||
+		    !dis8051_decode(off, code + off, len - off, &in))
+			continue;
+		dis8051_sfrpage_ctx(&f, page, off, &ctx);
+		dis8051_render(&ctx, &in, s, sizeof(s));
+		say("%04x %s; ", off, s);
+	}
+	expect("pages", sfrpage_src,
+	       "000e mov SBUF0, a; 0013 mov SBUF1, a; 0018 mov TMR4L, a; "
+	       "001f mov TMR4L, a; 0026 mov SBUF1, a; 0030 mov P4, a; "
+	       "0034 mov TMR2CN, a; ");
+	dis8051_flow_free(&f);
+}
+
+/* --- code banks --- */
+
+/* Keil BL51 layout, 32 KiB banks 0 -- 2 behind 0x8000 selected by P1,
+ * each piece of code at its image offset */
+static const struct {
+	uint32_t off;
+	uint16_t pc;
+	const char *src;
+} codebank_image[] = {
+	{0x00000, 0x0000, "ljmp 0x0100"},
+	{0x00100, 0x0100, "lcall 0x0200; sjmp $"},
+	/* ?B_SWITCH style: DPTR, the select bits, then jmp @a+dptr */
+	{0x00200, 0x0200, "mov dptr,#0x8010; clr a; anl 0x90,#0xf0; "
+	                  "sjmp next; next: orl 0x90,#1; jmp @a+dptr"},
+	/* a pushed return address and P1 bits one by one */
+	{0x00300, 0x0300, "mov a,#0; push 0xe0; mov a,#0x90; push 0xe0; "
+	                  "clr 0x90; setb 0x91; clr 0x92; clr 0x93; ret"},
+	{0x00400, 0x0400, "ret"},
+	{0x18010, 0x8010, "lcall 0x0300; lcall 0x0400; ret"},
+	{0x29000, 0x9000, "mov a,#1; ret"},
+};
+
+#define CODEBANK_LEN 0x30000
+
+static void check_codebank(void)
+{
+	struct dis8051_codebank_layout l;
+	struct dis8051_codebank cb;
+	const struct dis8051_farcall *c;
+	uint8_t *img, code[CODE_MAX];
+	uint32_t target;
+	char s[64];
+	size_t i;
+	int len;
+
+	if (!(img = malloc(CODEBANK_LEN)))
+		return;
+	memset(img, 0xff, CODEBANK_LEN);
+	for (i = 0; i < sizeof(codebank_image)/sizeof(codebank_image[0]);
+	     i++) {
+		if ((len = assemble(codebank_image[i].pc,
+		                    codebank_image[i].src, code)) < 0)
+			continue;
+		memcpy(img + codebank_image[i].off, code, len);
+	}
+
+	dis8051_codebank_layout_init(&l);
+	if (dis8051_codebank_init(&cb, &l, img, CODEBANK_LEN) < 0 ||
+	    dis8051_codebank_run(&cb) < 0) {
+		check("banks", "banked image", 0);
+		dis8051_codebank_free(&cb);
+		free(img);
+		return;
+	}
+
+	/* calls through the trampolines, bank:address */
+	for (i = 0; i < cb.ncalls; i++) {
+		c = &cb.calls[i];
+		say("%05x via %04x -> %05x; ", c->site, c->via, c->target);
+	}
+	expect("far calls", "banked image",
+	       "00100 via 0200 -> 18010; 18010 via 0300 -> 29000; ");
+
+	check("banks", "banked image", cb.nbanks == 3);
+	check("far target", "banked image",
+	      (cb.views[2].flow.map[0x9000] & DIS8051_MAP_FUNC) &&
+	      (cb.views[2].flow.map[0x9002] & DIS8051_MAP_CODE) &&
+	      !(cb.views[0].flow.map[0x9000] & DIS8051_MAP_CODE));
+	check("common call", "lcall 0x0400",
+	      !dis8051_codebank_far(&cb, DIS8051_BADDR(1, 0x8013)) &&
+	      !dis8051_codebank_trampoline(&cb, cb.views[1].buf, 0x0400,
+	                                   &target));
+	check("addresses", "banked image",
+	      dis8051_codebank_addr(&cb, 2, 0x0100) == 0x00100 &&
+	      dis8051_codebank_addr(&cb, 2, 0x9000) == 0x29000 &&
+	      dis8051_codebank_offset(&cb, DIS8051_BADDR(2, 0x9000)) ==
+	      0x29000 &&
+	      dis8051_codebank_offset(&cb, DIS8051_BADDR(3, 0x8000)) == -1);
+	if (dis8051_codebank_comment(&cb, DIS8051_BADDR(1, 0x8010), s,
+	                             sizeof(s)))
+		say("%s", s);
+	expect("comment", "lcall 0x0300", "far 2:0x9000");
+
+	dis8051_codebank_free(&cb);
+	free(img);
+}
+
+/* --- signatures --- */
+
+static const struct {
+	const char *src;       /* at 0x1000 */
+	const char *sig;
+} sig_tests[] = {
+	{"lcall 0x2000; mov dptr,#0x1234; ret; nop",
+	 "? 12 .. .. 90 .. .. 22"},
+	/* a branch past the ret goes on */
+	{"jz skip; ret; skip: inc a; ret; nop",
+	 "? 60 01 22 04 22"},
+	/* and so does an absolute jump, over data */
+	{"ljmp 0x1006; nop; nop; nop; ret; nop",
+	 "? 02 .. .. 00 00 00 22"},
+	{"ajmp 0x1004; mov a,#1; clr a; ret; nop",
+	 "? 01/1f .. 74 01 e4 22"},
+	{"ljmp 0x0000; ret",
+	 "? 02 .. .."},
+};
+
+static const char sig_file[] =
+	"# name, then the bytes\n"
+	"call_ret 12 .. .. 22\n"
+	"\n"
+	"mov_a 74 ..   # any immediate\n";
+
+static void found(void *user, const struct dis8051_sig *s, uint32_t addr)
+{
+	(void)user;
+	say("%s %04x; ", s->name, addr);
+}
+
+static void check_sigs(void)
+{
+	static const uint8_t scan[] = {0xe4, 0x74, 0x05, 0x12, 0x00, 0x10,
+	                               0x22, 0x74};
+	struct dis8051_sigs t;
+	struct dis8051_sig s;
+	uint8_t code[CODE_MAX];
+	char out[256];
+	unsigned line;
+	size_t i;
+	int len;
+
+	for (i = 0; i < sizeof(sig_tests)/sizeof(sig_tests[0]); i++) {
+		if ((len = assemble(0x1000, sig_tests[i].src, code)) < 0)
+			continue;
+		dis8051_sig_make(&s, 0x1000, code, len);
+		if (dis8051_sig_format(&s, out, sizeof(out)) >= 0)
+			say("%s", out);
+		expect("signature", sig_tests[i].src, sig_tests[i].sig);
+	}
+
+	dis8051_sigs_init(&t);
+	check("parsing", "signature file",
+	      !dis8051_sigs_parse(&t, sig_file, strlen(sig_file), &line));
+	dis8051_sigs_scan(&t, scan, sizeof(scan), 0x100, found, NULL);
+	expect("matches", "e4 74 05 12 00 10 22 74",
+	       "mov_a 0101; call_ret 0103; ");
+	dis8051_sigs_free(&t);
+
+	dis8051_sigs_init(&t);
+	check("error line", "x 12 zz",
+	      dis8051_sigs_parse(&t, "ok 22\nx 12 zz\n", 14, &line) < 0 &&
+	      line == 2);
+	dis8051_sigs_free(&t);
+}
+
+/* --- code detection --- */
+
+/* a small firmware: a main loop, a serial routine and a timer 0
+ * handler, behind the vectors that program() puts in front */
+static const char program_body[] =
+	"sjmp main; "
+	"t0: push 0xd0; push 0xe0; mov 0x8c,#0xff; inc 0x30; lcall g; "
+	"pop 0xe0; pop 0xd0; reti; "
+	"main: mov 0x81,#0x50; mov 0x89,#0x01; setb 0xa9; setb 0xaf; "
+	"setb 0x8c; "
+	"loop: mov r7,#10; wait: mov a,0x30; jz wait; lcall f; "
+	"djnz r7,wait; mov dptr,#0x1000; movx a,@dptr; anl a,#0x0f; "
+	"mov 0x31,a; inc dptr; movx @dptr,a; cpl 0x90; sjmp loop; "
+	"f: push 0xe0; push 0xf0; mov a,0x31; add a,#0x30; mov 0x99,a; "
+	"jnb 0x99,$; clr 0x99; lcall g; pop 0xf0; pop 0xe0; ret; "
+	"g: mov r0,#0x40; mov a,@r0; inc r0; add a,@r0; mov 0x32,a; ret";
+
+#define BODY 0x30   /* the startup sjmp, t0 right after it */
+
+/* 'body' at BODY, behind reset and timer 0 vectors jumping to it and
+ * the others returning at once; returns its length or -1 */
+static int program(const char *body, uint8_t *code)
+{
+	static const uint8_t vectors[] = {
+		0x02, 0x00, BODY, 0x32, 0, 0, 0, 0, 0, 0, 0,
+		0x02, 0x00, BODY + 2, 0, 0, 0, 0, 0, 0x32, 0, 0, 0, 0, 0, 0, 0,
+		0x32, 0, 0, 0, 0, 0, 0, 0, 0x32, 0, 0, 0, 0, 0, 0, 0, 0x32
+	};
+	int len;
+
+	memset(code, 0, BODY);
+	memcpy(code, vectors, sizeof(vectors));
+	if ((len = dis8051_assemble_block(NULL, BODY, body, code + BODY,
+	                                  CODE_MAX - BODY)) < 0) {
+		printf("'%s' does not assemble\n", body);
+		bad++;
+		return -1;
+	}
+	return BODY + len;
+}
+
+static const char text[] =
+	"The quick brown fox jumps over the lazy dog. 0123456789 ";
+
+static void check_detect(void)
+{
+	struct dis8051_detect d;
+	struct dis8051_region r[4];
+	uint8_t code[CODE_MAX], blob[3*CODE_MAX];
+	size_t i, n;
+	int len;
+
+	if ((len = program(program_body, code)) < 0)
+		return;
+	dis8051_detect_init(&d);
+	check("score", "program", dis8051_detect_score(&d, code, len) >= 800);
+	check("vectors", "program", dis8051_detect_vectors(code, len) == 6);
+
+	for (i = 0; i < 512; i++)
+		blob[i] = text[i % (sizeof(text) - 1)];
+	check("score", "text", dis8051_detect_score(&d, blob, 512) < 200);
+	memset(blob, 0xff, 512);
+	check("score", "erased", dis8051_detect_score(&d, blob, 512) == 0);
+	memset(blob, 0, 512);
+	check("score", "zeroes", dis8051_detect_score(&d, blob, 512) == 0);
+
+	/* the program between text, the region is within it and covers
+	 * most of what follows the vectors */
+	for (i = 0; i < 512; i++)
+		blob[i] = blob[512 + len + i] = text[i % (sizeof(text) - 1)];
+	memcpy(blob + 512, code, len);
+	n = dis8051_detect_regions(&d, blob, 1024 + len, 64, 500, r, 4);
+	check("regions", "program in text",
+	      n == 1 && r[0].start >= 512 && r[0].end <= 512 + (size_t)len &&
+	      r[0].end - r[0].start >= (size_t)(len - BODY)*3/4);
+}
+
+/* --- function fingerprints --- */
+
+static int fingerprint(const uint8_t *code, int len, struct dis8051_flow *f,
+                       struct dis8051_fhashes *h)
+{
+	if (dis8051_flow_init(f, 0, code, len, NULL) < 0 ||
+	    dis8051_flow_add_vectors(f) < 0 || dis8051_flow_run(f) < 0 ||
+	    dis8051_fhash_run(f, h) < 0) {
+		dis8051_flow_free(f);
+		return -1;
+	}
+	return 0;
+}
+
+static void check_fhash(void)
+{
+	struct dis8051_flow fa, fb;
+	struct dis8051_fhashes ha, hb;
+	struct dis8051_fdiff d;
+	uint8_t a[CODE_MAX], b[CODE_MAX];
+	char src[sizeof(program_body) + 8];
+	const char *p;
+	int la, lb;
+	size_t i;
+
+	/* the next build: main moved up a byte, one bit cleared instead
+	 * of toggled */
+	p = strstr(program_body, "main: ");
+	snprintf(src, sizeof(src), "%.*snop; %s", (int)(p - program_body),
+	         program_body, p);
+	memcpy(strstr(src, "cpl 0x90"), "clr", 3);
+
+	if ((la = program(program_body, a)) < 0 || (lb = program(src, b)) < 0)
+		return;
+	if (fingerprint(a, la, &fa, &ha) < 0) {
+		check("fingerprints", "program", 0);
+		return;
+	}
+	if (fingerprint(b, lb, &fb, &hb) < 0) {
+		check("fingerprints", "next build", 0);
+		dis8051_fhash_free(&ha);
+		dis8051_flow_free(&fa);
+		return;
+	}
+
+	/* f, moved, is the same */
+	for (i = 0; i < ha.nfuncs && ha.funcs[i].addr != 0x68; i++)
+		;
+	check("fingerprint", "moved f", i < ha.nfuncs &&
+	      hb.nfuncs == ha.nfuncs && hb.funcs[i].addr == 0x69 &&
+	      ha.funcs[i].exact == hb.funcs[i].exact &&
+	      dis8051_fhash_similarity(&ha.funcs[i], &hb.funcs[i]) == 1000);
+
+	if (dis8051_fhash_diff(&ha, &hb, 600, &d) < 0) {
+		check("diff", "next build", 0);
+	} else {
+		for (i = 0; i < d.nmatches; i++)
+			say("%04x %04x %s; ", d.matches[i].a, d.matches[i].b,
+			    d.matches[i].score == 1000 ? "same" : "changed");
+		expect("diff", "next build",
+		       "0000 0000 changed; 0003 0003 same; 000b 000b same; "
+		       "0013 0013 same; 001b 001b same; 0023 0023 same; "
+		       "002b 002b same; 0068 0069 same; 007f 0080 same; ");
+		dis8051_fdiff_free(&d);
+	}
+	dis8051_fhash_free(&ha);
+	dis8051_fhash_free(&hb);
+	dis8051_flow_free(&fa);
+	dis8051_flow_free(&fb);
+}
+
+/* --- pattern index --- */
+
+static const struct {
+	const char *name;
+	const char *src;
+} pindex_images[] = {
+	/* added out of order, written by name */
+	{"beta", "mov dptr,#0x1234; movx a,@dptr; inc a; "
+	         "mov dptr,#0x2000; movx a,@dptr; ret"},
+	{"alpha", "nop; mov r0,#1; mov dptr,#0x10; movx a,@dptr; "
+	          "mov dptr,#0x10; movx @dptr,a; mov r7,#2; ret"},
+};
+
+static const struct {
+	const char *pattern;
+	const char *matches;     /* "image addr" by image and address */
+} pindex_tests[] = {
+	{"mov dptr,#*; movx a,@dptr",
+	 "alpha 0003; beta 0000; beta 0005; "},
+	{"mov dptr,#0x10",
+	 "alpha 0003; alpha 0007; "},
+	{"mov r*,#*; mov dptr,#*",
+	 "alpha 0001; "},
+	{"movx a,@dptr; ret",
+	 "beta 0008; "},
+	{"mov a,#*",
+	 ""},
+};
+
+static void posting(void *user, const char *image, uint16_t addr)
+{
+	(void)user;
+	say("%s %04x; ", image, addr);
+}
+
+static void check_pindex(void)
+{
+	struct dis8051_pindex_builder b;
+	struct dis8051_pattern pat;
+	struct dis8051_pindex ix;
+	uint8_t code[CODE_MAX];
+	char path[256];
+	size_t i;
+	int len, n;
+
+	if (temp_path(path, sizeof(path)) < 0)
+		return;
+	dis8051_pindex_builder_init(&b);
+	for (i = 0; i < sizeof(pindex_images)/sizeof(pindex_images[0]); i++) {
+		if ((len = assemble(0, pindex_images[i].src, code)) < 0)
+			continue;
+		check("indexing", pindex_images[i].src,
+		      !dis8051_pindex_add(&b, pindex_images[i].name, code,
+		                          len, NULL));
+	}
+	check("writing", "index", !dis8051_pindex_write(&b, path));
+	dis8051_pindex_builder_free(&b);
+
+	if (dis8051_pindex_open(&ix, path) < 0) {
+		check("opening", "index", 0);
+	} else {
+		for (i = 0; i < sizeof(pindex_tests)/sizeof(pindex_tests[0]);
+		     i++) {
+			if (dis8051_pattern_parse(&pat, pindex_tests[i].pattern,
+			                          &n) < 0) {
+				check("parsing", pindex_tests[i].pattern, 0);
+				continue;
+			}
+			dis8051_pindex_find(&ix, &pat, posting, NULL);
+			expect("matches", pindex_tests[i].pattern,
+			       pindex_tests[i].matches);
+		}
+		dis8051_pindex_close(&ix);
+	}
+	check("error statement", "mov dptr,#*; mov q,#*",
+	      dis8051_pattern_parse(&pat, "mov dptr,#*; mov q,#*", &n) < 0 &&
+	      n == 2);
+
+	/* anything else is no index */
+	if ((len = assemble(0, pindex_images[0].src, code)) >= 0) {
+		FILE *f = fopen(path, "wb");
+
+		if (f) {
+			fwrite(code, 1, len, f);
+			fclose(f);
+		}
+		check("opening", "code", dis8051_pindex_open(&ix, path) < 0 &&
+		      errno == EINVAL);
+	}
+	unlink(path);
+}
+
+/* --- superset disassembly --- */
+
+/* the reserved a5 is an immediate, the acall lands in the operand of
+ * an ljmp out of the image, the last instruction is cut off */
+static const char superset_src[] =
+	"mov a,#0xa5; acall 0x0108; sjmp $; ljmp 0x3000; ret; inc a; ret; "
+	"inc a; mov a,#1";
+
+static void check_superset(void)
+{
+	struct dis8051_superset s;
+	uint8_t code[CODE_MAX];
+	uint16_t prev[3];
+	int len, n, i;
+
+	if ((len = assemble(0x100, superset_src, code)) < 0)
+		return;
+	if (dis8051_superset_init(&s, NULL, 0x100, code, len - 1) < 0) {
+		check("superset", superset_src, 0);
+		return;
+	}
+	n = dis8051_superset_prune(&s);
+	for (i = 0; i < s.len; i++)
+		if (s.rec[i].flags & DIS8051_SREC_BAD)
+			say("%04x ", s.base + i);
+	say("of %d", n);
+	expect("bad offsets", superset_src,
+	       "0101 0105 0106 0107 010c 010d of 6");
+
+	say("%x %d %d %x; ", dis8051_superset_next(&s, 0x100),
+	    dis8051_superset_next(&s, 0x104),
+	    dis8051_superset_next(&s, 0x10b),
+	    dis8051_superset_next(&s, 0x107));
+	n = dis8051_superset_prev(&s, 0x104, prev);
+	for (i = 0; i < n; i++)
+		say("%x ", prev[i]);
+	expect("next and previous", superset_src,
+	       "102 -1 -1 10a; 103 102 ");
+	check("outside", superset_src, !dis8051_superset_at(&s, 0xff) &&
+	      !dis8051_superset_at(&s, 0x100 + len - 1) &&
+	      !dis8051_superset_prev(&s, 0xff, prev));
+	dis8051_superset_free(&s);
+}
+
+/* --- analysis cache --- */
+
+static const struct dis8051_cache_match cache_matches[] = {
+	{0x0011, "f0"}, {0x0013, "f2"}
+};
+
+/* the file at 'path' with 'n' bytes, byte 'at' xored with 'x' */
+static void rewrite(const char *path, const uint8_t *buf, size_t n,
+                    size_t at, int x)
+{
+	FILE *f = fopen(path, "wb");
+
+	if (!f)
+		return;
+	fwrite(buf, 1, n, f);
+	if (at < n) {
+		fseek(f, at, SEEK_SET);
+		fputc(buf[at] ^ x, f);
+	}
+	fclose(f);
+}
+
+/* the cross references by target, as the cache keeps them too */
+static void xref_targets(const struct dis8051_xrefs *x)
+{
+	size_t n;
+
+	for (n = 0; n < x->count; n++)
+		say("%04x<%04x ", x->by_to[n].to, x->by_to[n].from);
+	say("; ");
+}
+
+static void check_cache(void)
+{
+	const char *src = flow_tests[0].src, *name;
+	struct dis8051_flow f, g;
+	struct dis8051_xrefs x, y;
+	struct dis8051_cache c;
+	uint8_t code[CODE_MAX], file[1024];
+	char path[256], want[sizeof(got)];
+	uint64_t key;
+	uint32_t addr, i;
+	size_t n = 0;
+	FILE *in;
+	int len;
+
+	if ((len = assemble(0, src, code)) < 0 ||
+	    temp_path(path, sizeof(path)) < 0)
+		return;
+	if (dis8051_flow_init(&f, 0, code, len, NULL) < 0 ||
+	    dis8051_flow_add_entry(&f, 0) < 0 || dis8051_flow_run(&f) < 0 ||
+	    dis8051_xrefs_build(&x, 0, code, len) < 0) {
+		check("cache", src, 0);
+		dis8051_flow_free(&f);
+		unlink(path);
+		return;
+	}
+	key = dis8051_cache_key(0, code, len, 0);
+	check("writing", "cache", !dis8051_cache_write(path, key, &f, &x,
+	      cache_matches, 2));
+
+	/* what was written */
+	flow_summary(&f);
+	xref_summary(&x);
+	xref_targets(&x);
+	for (i = 0; i < 2; i++)
+		say("%s %04x; ", cache_matches[i].name, cache_matches[i].addr);
+	strcpy(want, got);
+	ngot = 0;
+	*got = '\0';
+
+	/* is what is read back */
+	if (dis8051_cache_open(&c, path, key) < 0) {
+		check("opening", "cache", 0);
+	} else {
+		if (!dis8051_cache_flow(&c, &g, code)) {
+			flow_summary(&g);
+			check("code map", "cache",
+			      !memcmp(f.map, g.map, len));
+			dis8051_flow_free(&g);
+		}
+		if (!dis8051_cache_xrefs(&c, &y)) {
+			xref_summary(&y);
+			xref_targets(&y);
+			dis8051_xrefs_free(&y);
+		}
+		for (i = 0; i < c.nmatches; i++) {
+			name = dis8051_cache_match(&c, i, &addr);
+			say("%s %04x; ", name, addr);
+		}
+		expect("read back", "cache", want);
+		dis8051_cache_close(&c);
+	}
+
+	/* another key is stale, a damaged file no cache */
+	check("another key", "cache",
+	      dis8051_cache_open(&c, path, key ^ 1) < 0 && errno == ESTALE);
+	if ((in = fopen(path, "rb"))) {
+		n = fread(file, 1, sizeof(file), in);
+		fclose(in);
+	}
+	check("reading", "cache", n > 44 && n < sizeof(file));
+	rewrite(path, file, n - 1, n, 0);
+	check("truncated", "cache",
+	      dis8051_cache_open(&c, path, key) < 0 && errno == EINVAL);
+	rewrite(path, file, n, 0, 0x20);
+	check("magic", "cache",
+	      dis8051_cache_open(&c, path, key) < 0 && errno == EINVAL);
+	/* the name offset of the last match */
+	rewrite(path, file, n, n - strlen("f0") - strlen("f2") - 2 - 1, 0x80);
+	check("name offset", "cache",
+	      dis8051_cache_open(&c, path, key) < 0 && errno == EINVAL);
+
+	dis8051_xrefs_free(&x);
+	dis8051_flow_free(&f);
+	unlink(path);
+}
+
+int main(void)
+{
+	check_decode();
+	check_xrefs();
+	check_dptr();
+	check_flow();
+	check_stack();
+	check_bank();
+	check_sfrpage();
+	check_codebank();
+	check_sigs();
+	check_detect();
+	check_fhash();
+	check_pindex();
+	check_superset();
+	check_cache();
+
+	printf("%u analysis checks: %s\n", checks, bad ? "FAILED" : "ok");
+	return bad ? 1 : 0;
+}
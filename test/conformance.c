@@ -0,0 +1,508 @@
+/* decoder conformance suite: decodes all 16M three byte inputs at a few
+ * pc values on all cores, compares a digest of the disassembly of each
+ * opcode with the golden reference and assembles every result back;
+ * every derivative and SFR page gets the same for the operand bytes
+ * that name SFRs and bits, with its extra opcodes, against a golden
+ * reference of its own, a few of its results are checked by hand;
+ * statements that must not assemble are tried on every derivative, and
+ * names of the default on the derivatives that lack them
+ *
+ * usage: conformance [-g] golden.txt golden-deriv.txt
+ *   -g  write the golden references instead of checking them */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../8051-insn.h"
+#include "../8051-render.h"
+#include "../8051-asm.h"
+#include "../8051-xref.h"
+#include "../8051-dptr.h"
+
+/* pc values exercised, ajmp / acall pages and 64K wrap around */
+static const uint16_t pcs[] = {0x0000, 0x07fe, 0x1234, 0xfffe};
+#define NPCS (sizeof(pcs)/sizeof(pcs[0]))
+#define NUNITS (NPCS*256)
+
+/* second operand bytes of the derivative pass, all of them for 0x85
+ * whose both operands are direct addresses */
+static const uint8_t seconds[] = {
+	0x00, 0x01, 0x7f, 0x80, 0x81, 0xa8, 0xd0, 0xff
+};
+#define NSECONDS (sizeof(seconds)/sizeof(seconds[0]))
+#define DERIV_PC 0x1234
+
+/* a derivative at one SFR page */
+struct view {
+	const struct dis8051_derivative *deriv;
+	int page;
+};
+
+#define VIEWS_MAX 64
+static struct view views[VIEWS_MAX];
+static unsigned nviews;
+
+struct result {
+	uint64_t digest;      /* of the text and size of each input */
+	uint32_t roundtrip;   /* inputs that do not assemble back */
+	uint32_t first;       /* operand bytes of the first of them */
+};
+
+/* not an instruction on any derivative */
+static const char *const rejects[] = {
+	"anl c,/",        /* empty bit names, which unnamed slots have */
+	"orl c,/",
+	"mov c,.7",
+	"setb .0",
+	"mov a,",
+	"mov ,a",
+};
+#define NREJECTS (sizeof(rejects)/sizeof(rejects[0]))
+
+/* names of the default a derivative does not have */
+static const struct reject_deriv {
+	const char *deriv;
+	int page;
+	const char *stmt;
+} reject_derivs[] = {
+	{"8051",      0,   "mov a, TH2"},
+	{"8051",      0,   "setb ET2"},
+	{"8051",      0,   "setb T2CON.2"},
+	{"cc2530",    0,   "mov TL0, #0x1"},
+	{"ds89c450",  0,   "mov c, TI"},
+	{"c8051f12x", 0,   "mov SBUF, a"},
+	{"c8051f12x", 0xf, "clr RI"},
+};
+#define NREJECT_DERIVS (sizeof(reject_derivs)/sizeof(reject_derivs[0]))
+
+/* derivative results checked by hand */
+static const struct expect {
+	const char *deriv;
+	int page;
+	uint8_t buf[3];
+	const char *text;
+} expects[] = {
+	{"cc2530",    0, {0xa5},             "trap"},
+	{"8052",      0, {0xa5},             "reserved"},
+	{"cc2530",    0, {0x05, 0x92},       "inc DPS"},
+	{"cc2530",    0, {0xe5, 0x84},       "mov a, DPL1"},
+	{"ds89c450",  0, {0x75, 0x86, 0x01}, "mov DPS, #0x1"},
+	{"8052",      0, {0xe5, 0x84},       "mov a, 0x84"},
+	{"c8051f12x", 0, {0xe5, 0x84},       "mov a, SFRPAGE"},
+	{"n76e003",   0, {0xd2, 0xc0},       "setb I2CON.0"},
+};
+#define NEXPECTS (sizeof(expects)/sizeof(expects[0]))
+
+/* DPTR resolved through the second data pointer by hand */
+static const struct expect_dptr {
+	const char *deriv;
+	const char *code;
+	uint16_t pc;          /* of the access */
+	const char *comment;
+} expect_dptrs[] = {
+	{"cc2530", "mov DPS,#0; mov dptr,#0x1234; mov DPS,#1; "
+	           "mov dptr,#0x5678; mov DPS,#0; movx a,@dptr", 15,
+	           "xdata 0x1234"},
+	{"cc2530", "mov dptr,#0x1234; inc DPS; mov dptr,#0x5678; "
+	           "movx a,@dptr", 8, "xdata 0x5678"},
+};
+#define NEXPECT_DPTRS (sizeof(expect_dptrs)/sizeof(expect_dptrs[0]))
+
+static struct result results[NUNITS];
+static struct result deriv_results[VIEWS_MAX*256];
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned next_unit;
+
+static uint64_t fnv(uint64_t h, const char *s, size_t n)
+{
+	while (n--) {
+		h ^= (uint8_t)*s++;
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+/* all operand bytes of one opcode at one pc */
+static void run_unit(unsigned unit)
+{
+	struct result *r = &results[unit];
+	struct dis8051_insn in;
+	uint16_t pc = pcs[unit / 256];
+	uint8_t buf[3], out[DIS8051_MAX_INSN];
+	char s[64];
+	unsigned ops;
+	int len, size;
+
+	r->digest = 0xcbf29ce484222325ULL;
+	buf[0] = unit % 256;
+	for (ops = 0; ops < 0x10000; ops++) {
+		buf[1] = ops >> 8;
+		buf[2] = ops;
+
+		size = dis8051_decode(pc, buf, sizeof(buf), &in);
+		len = dis8051_render(NULL, &in, s, sizeof(s));
+		s[len++] = '0' + size;
+		r->digest = fnv(r->digest, s, len);
+
+		s[len-1] = '\0';
+		if (dis8051_assemble(NULL, pc, s, out) != size ||
+		    memcmp(out, buf, size)) {
+			if (!r->roundtrip++)
+				r->first = ops;
+		}
+	}
+}
+
+/* the operand bytes naming SFRs and bits of one opcode on one view */
+static void run_deriv_unit(unsigned unit)
+{
+	struct result *r = &deriv_results[unit];
+	const struct view *v = &views[unit / 256];
+	struct dis8051_ctx ctx;
+	struct dis8051_insn in;
+	uint8_t buf[3], out[DIS8051_MAX_INSN];
+	char s[64];
+	unsigned ops, n;
+	int len, size;
+
+	dis8051_ctx_init(&ctx);
+	ctx.deriv = v->deriv;
+	ctx.page = v->page;
+	r->digest = 0xcbf29ce484222325ULL;
+	buf[0] = unit % 256;
+	n = buf[0] == 0x85 ? 0x10000 : 256*NSECONDS;
+	for (ops = 0; ops < n; ops++) {
+		buf[1] = ops / (n / 256);
+		buf[2] = n == 0x10000 ? ops : seconds[ops % NSECONDS];
+
+		size = dis8051_decode_deriv(v->deriv, DERIV_PC, buf,
+		                            sizeof(buf), &in);
+		len = dis8051_render(&ctx, &in, s, sizeof(s));
+		s[len++] = '0' + size;
+		r->digest = fnv(r->digest, s, len);
+
+		s[len-1] = '\0';
+		if (dis8051_assemble(&ctx, DERIV_PC, s, out) != size ||
+		    memcmp(out, buf, size)) {
+			if (!r->roundtrip++)
+				r->first = buf[1] << 8 | buf[2];
+		}
+	}
+}
+
+static void *worker(void *arg)
+{
+	unsigned unit;
+
+	(void)arg;
+	for (;;) {
+		pthread_mutex_lock(&lock);
+		unit = next_unit++;
+		pthread_mutex_unlock(&lock);
+		if (unit >= NUNITS + nviews*256)
+			return NULL;
+		if (unit < NUNITS)
+			run_unit(unit);
+		else
+			run_deriv_unit(unit - NUNITS);
+	}
+}
+
+/* every derivative at page 0 and at each of its other pages */
+static void make_views(void)
+{
+	const struct dis8051_derivative *d;
+	unsigned i, k;
+
+	for (i = 0; i < DIS8051_DERIVS; i++) {
+		d = &dis8051_derivatives[i];
+		for (k = 0; k <= d->npages && nviews < VIEWS_MAX; k++) {
+			views[nviews].deriv = d;
+			views[nviews++].page = k ? d->pages[k-1].page : 0;
+		}
+	}
+}
+
+static int run(void)
+{
+	pthread_t *t;
+	long n = sysconf(_SC_NPROCESSORS_ONLN), i;
+
+	if (n < 1)
+		n = 1;
+	if (!(t = calloc(n, sizeof(*t))))
+		return -1;
+	for (i = 0; i < n; i++)
+		if (pthread_create(&t[i], NULL, worker, NULL))
+			break;
+	/* no thread at all, do the work here */
+	if (i == 0)
+		worker(NULL);
+	while (i-- > 0)
+		pthread_join(t[i], NULL);
+	free(t);
+	return 0;
+}
+
+static unsigned check_expects(void)
+{
+	const struct expect *e;
+	const struct expect_dptr *x;
+	struct dis8051_ctx ctx;
+	struct dis8051_insn in;
+	struct dis8051_xrefs xr;
+	uint8_t code[64];
+	char s[64];
+	unsigned i, bad = 0;
+	int len;
+
+	for (i = 0; i < NEXPECTS; i++) {
+		e = &expects[i];
+		dis8051_ctx_init(&ctx);
+		ctx.deriv = dis8051_derivative(e->deriv);
+		ctx.page = e->page;
+		dis8051_decode_deriv(ctx.deriv, DERIV_PC, e->buf,
+		                     sizeof(e->buf), &in);
+		dis8051_render(&ctx, &in, s, sizeof(s));
+		if (strcmp(s, e->text)) {
+			printf("%s: %02x %02x %02x is '%s', not '%s'\n",
+			       e->deriv, e->buf[0], e->buf[1], e->buf[2], s,
+			       e->text);
+			bad++;
+		}
+	}
+
+	for (i = 0; i < NEXPECT_DPTRS; i++) {
+		x = &expect_dptrs[i];
+		dis8051_ctx_init(&ctx);
+		ctx.deriv = dis8051_derivative(x->deriv);
+		*s = '\0';
+		if ((len = dis8051_assemble_block(&ctx, 0, x->code, code,
+		                                  sizeof(code))) < 0 ||
+		    dis8051_xrefs_build(&xr, 0, code, len) < 0) {
+			printf("%s: '%s' does not assemble\n", x->deriv,
+			       x->code);
+			bad++;
+			continue;
+		}
+		if (dis8051_dptr_resolve(ctx.deriv, &xr, 0, code, len) < 0 ||
+		    !dis8051_dptr_comment(&xr, x->pc, s, sizeof(s)) ||
+		    strcmp(s, x->comment)) {
+			printf("%s: '%s' resolves to '%s', not '%s'\n",
+			       x->deriv, x->code, s, x->comment);
+			bad++;
+		}
+		dis8051_xrefs_free(&xr);
+	}
+	return bad;
+}
+
+static unsigned check_rejects(void)
+{
+	struct dis8051_ctx ctx;
+	uint8_t out[DIS8051_MAX_INSN];
+	unsigned d, i, bad = 0;
+
+	dis8051_ctx_init(&ctx);
+	for (d = 0; d < DIS8051_DERIVS; d++) {
+		ctx.deriv = &dis8051_derivatives[d];
+		for (i = 0; i < NREJECTS; i++)
+			if (dis8051_assemble(&ctx, 0, rejects[i], out)) {
+				printf("%s: '%s' assembles\n", ctx.deriv->name,
+				       rejects[i]);
+				bad++;
+			}
+	}
+	for (i = 0; i < NREJECT_DERIVS; i++) {
+		dis8051_ctx_init(&ctx);
+		ctx.deriv = dis8051_derivative(reject_derivs[i].deriv);
+		ctx.page = reject_derivs[i].page;
+		if (dis8051_assemble(&ctx, 0, reject_derivs[i].stmt, out)) {
+			printf("%s: '%s' assembles\n", ctx.deriv->name,
+			       reject_derivs[i].stmt);
+			bad++;
+		}
+	}
+	return bad;
+}
+
+static int write_golden(const char *name)
+{
+	FILE *f;
+	unsigned u;
+
+	if (!(f = fopen(name, "w")))
+		return -1;
+	fprintf(f, "# pc opcode digest, written by 'conformance -g'\n");
+	for (u = 0; u < NUNITS; u++)
+		fprintf(f, "%04x %02x %016llx\n", pcs[u / 256], u % 256,
+		        (unsigned long long)results[u].digest);
+	return fclose(f);
+}
+
+static int check_golden(const char *name)
+{
+	FILE *f;
+	char line[128];
+	unsigned pc, op, u, n = 0, bad = 0, k;
+	unsigned long long digest;
+
+	if (!(f = fopen(name, "r")))
+		return -1;
+	while (fgets(line, sizeof(line), f)) {
+		if (*line == '#')
+			continue;
+		if (sscanf(line, "%x %x %llx", &pc, &op, &digest) != 3)
+			continue;
+		for (k = 0; k < NPCS && pcs[k] != pc; k++)
+			;
+		if (k == NPCS || op > 0xff)
+			continue;
+		u = k*256 + op;
+		n++;
+		if (results[u].digest != digest) {
+			printf("pc 0x%04x opcode 0x%02x: disassembly differs\n",
+			       pc, op);
+			bad++;
+		}
+	}
+	fclose(f);
+
+	if (n != NUNITS) {
+		printf("%s: %u of %u digests\n", name, n, (unsigned)NUNITS);
+		bad++;
+	}
+	return bad;
+}
+
+static int write_deriv_golden(const char *name)
+{
+	FILE *f;
+	unsigned u;
+
+	if (!(f = fopen(name, "w")))
+		return -1;
+	fprintf(f, "# derivative page opcode digest, written by "
+	        "'conformance -g'\n");
+	for (u = 0; u < nviews*256; u++)
+		fprintf(f, "%s %x %02x %016llx\n", views[u / 256].deriv->name,
+		        views[u / 256].page, u % 256,
+		        (unsigned long long)deriv_results[u].digest);
+	return fclose(f);
+}
+
+static int check_deriv_golden(const char *name)
+{
+	FILE *f;
+	char line[128], deriv[32];
+	unsigned page, op, u, n = 0, bad = 0, k;
+	unsigned long long digest;
+
+	if (!(f = fopen(name, "r")))
+		return -1;
+	while (fgets(line, sizeof(line), f)) {
+		if (*line == '#')
+			continue;
+		if (sscanf(line, "%31s %x %x %llx", deriv, &page, &op,
+		           &digest) != 4)
+			continue;
+		for (k = 0; k < nviews; k++)
+			if (!strcmp(views[k].deriv->name, deriv) &&
+			    views[k].page == (int)page)
+				break;
+		if (k == nviews || op > 0xff)
+			continue;
+		u = k*256 + op;
+		n++;
+		if (deriv_results[u].digest != digest) {
+			printf("%s page %x opcode 0x%02x: disassembly differs\n",
+			       deriv, page, op);
+			bad++;
+		}
+	}
+	fclose(f);
+
+	if (n != nviews*256) {
+		printf("%s: %u of %u digests\n", name, n, nviews*256);
+		bad++;
+	}
+	return bad;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned u, bad = 0;
+	int golden = 0;
+
+	if (argc > 1 && !strcmp(argv[1], "-g")) {
+		golden = 1;
+		argc--;
+		argv++;
+	}
+	if (argc != 3) {
+		fprintf(stderr, "usage: conformance [-g] golden.txt "
+		        "golden-deriv.txt\n");
+		return 2;
+	}
+
+	make_views();
+	if (run()) {
+		fprintf(stderr, "out of memory\n");
+		return 2;
+	}
+
+	for (u = 0; u < NUNITS; u++)
+		if (results[u].roundtrip) {
+			printf("pc 0x%04x opcode 0x%02x: %u inputs do not "
+			       "assemble back, first %02x %02x %02x\n",
+			       pcs[u / 256], u % 256, results[u].roundtrip,
+			       u % 256, results[u].first >> 8,
+			       results[u].first & 0xff);
+			bad++;
+		}
+
+	for (u = 0; u < nviews*256; u++)
+		if (deriv_results[u].roundtrip) {
+			printf("%s page %x opcode 0x%02x: %u inputs do not "
+			       "assemble back, first %02x %02x %02x\n",
+			       views[u / 256].deriv->name, views[u / 256].page,
+			       u % 256, deriv_results[u].roundtrip, u % 256,
+			       deriv_results[u].first >> 8,
+			       deriv_results[u].first & 0xff);
+			bad++;
+		}
+
+	bad += check_expects();
+	bad += check_rejects();
+
+	if (golden) {
+		if (write_golden(argv[1])) {
+			perror(argv[1]);
+			return 2;
+		}
+		if (write_deriv_golden(argv[2])) {
+			perror(argv[2]);
+			return 2;
+		}
+	} else {
+		int r = check_golden(argv[1]), rd;
+
+		if (r < 0) {
+			perror(argv[1]);
+			return 2;
+		}
+		if ((rd = check_deriv_golden(argv[2])) < 0) {
+			perror(argv[2]);
+			return 2;
+		}
+		bad += r + rd;
+	}
+
+	printf("%u derivative and SFR page views\n", nviews);
+	printf("%u inputs at %u pc values: %s\n", 0x1000000,
+	       (unsigned)NPCS, bad ? "FAILED" : "ok");
+	return bad ? 1 : 0;
+}
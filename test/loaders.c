@@ -0,0 +1,326 @@
+/* loader tests: loads the Intel HEX, OMF-51 and SDCC files in a fixture
+ * directory, well formed, truncated and corrupt ones, and compares the
+ * errors, images, symbols, segments, lines and spans they give with the
+ * expected output; every Intel HEX file is also fed a byte at a time,
+ * which must give the same as reading it whole
+ *
+ * usage: loaders [-g] dir expected.txt
+ *   -g  write the expected output instead of checking it */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "../8051-image.h"
+#include "../8051-ihex.h"
+#include "../8051-symtab.h"
+#include "../8051-omf.h"
+#include "../8051-span.h"
+#include "../8051-sdcc.h"
+#include "../8051-xref.h"
+
+static const char *const ihex_files[] = {
+	"code.hex", "segment.hex", "linear.hex", "checksum.hex",
+	"truncated.hex", "noeof.hex", "syntax.hex", "type.hex", "missing.hex"
+};
+
+static const char *const omf_files[] = {
+	"main.omf", "truncated.omf", "checksum.omf", "keil.omf",
+	"notomf.omf", "badrec.omf"
+};
+
+/* files loaded into one dis8051_sdcc, separated by ':' */
+static const char *const sdcc_sets[] = {
+	"main.cdb:main.map:main.rst", "broken.cdb", "main.cdb:missing.cdb"
+};
+
+#define N(a) (sizeof(a)/sizeof(a[0]))
+
+static const char *const spaces[] = {"code", "xdata", "iram", "sfr", "bit"};
+static const char *const kinds[] = {"func", "var", "line"};
+
+static void dump_image(FILE *out, const struct dis8051_image *img)
+{
+	const struct dis8051_image_page *p;
+	size_t i, n = 0;
+	uint32_t off;
+
+	for (i = 0; i < img->npages; i++) {
+		p = img->pages[i];
+		for (off = 0; off < DIS8051_IMAGE_PAGE; off++) {
+			if (!(p->valid[off/8] & (1 << (off%8)))) {
+				if (n)
+					fputc('\n', out);
+				n = 0;
+				continue;
+			}
+			if (n == 0)
+				fprintf(out, "  %06x:", p->addr + off);
+			fprintf(out, " %02x", p->data[off]);
+			if (++n == 16) {
+				fputc('\n', out);
+				n = 0;
+			}
+		}
+		if (n)
+			fputc('\n', out);
+		n = 0;
+	}
+	if (img->has_entry)
+		fprintf(out, "  entry %06x\n", img->entry);
+}
+
+static void dump_syms(FILE *out, const struct dis8051_symtab *t)
+{
+	const struct dis8051_sym *s;
+	size_t i;
+
+	for (i = 0; i < t->count; i++) {
+		s = &t->syms[i];
+		fprintf(out, "  sym %s %06x %s\n", spaces[s->space], s->addr,
+		        s->name);
+	}
+}
+
+static void ihex_test(FILE *out, const char *name)
+{
+	struct dis8051_image img, one;
+	struct dis8051_ihex p;
+	unsigned line;
+	int e, c;
+	FILE *f;
+
+	dis8051_image_init(&img);
+	e = dis8051_ihex_load(&img, name, &line);
+	fprintf(out, "ihex %s: %s, line %u\n", name, dis8051_ihex_strerror(e),
+	        line);
+	dump_image(out, &img);
+
+	/* every record split between two feeds */
+	if ((f = fopen(name, "rb"))) {
+		char ch;
+		FILE *a = tmpfile(), *b = tmpfile();
+
+		dis8051_image_init(&one);
+		dis8051_ihex_init(&p, &one);
+		while ((c = fgetc(f)) != EOF) {
+			ch = c;
+			if (dis8051_ihex_feed(&p, &ch, 1) < 0)
+				break;
+		}
+		if (!p.error)
+			dis8051_ihex_finish(&p);
+		fclose(f);
+		if (a && b) {
+			dump_image(a, &img);
+			dump_image(b, &one);
+			rewind(a);
+			rewind(b);
+			while ((c = fgetc(a)) == fgetc(b) && c != EOF)
+				;
+			if (p.error != e || p.line != line || c != EOF)
+				fprintf(out, "  fed a byte at a time: %s, "
+				        "line %u, image %s\n",
+				        dis8051_ihex_strerror(p.error), p.line,
+				        c != EOF ? "differs" : "the same");
+		}
+		if (a)
+			fclose(a);
+		if (b)
+			fclose(b);
+		dis8051_image_free(&one);
+	}
+	dis8051_image_free(&img);
+}
+
+static void omf_test(FILE *out, const char *name)
+{
+	struct dis8051_image img;
+	struct dis8051_symtab syms;
+	const struct dis8051_omf_seg *s;
+	const struct dis8051_omf_line *l;
+	struct dis8051_omf o;
+	size_t i;
+	int e;
+
+	dis8051_image_init(&img);
+	dis8051_symtab_init(&syms);
+	dis8051_omf_init(&o, &img, &syms);
+	e = dis8051_omf_load_file(&o, name);
+	fprintf(out, "omf %s: %s", name, dis8051_omf_strerror(e));
+	if (e)
+		fprintf(out, ", record at 0x%zx", o.offset);
+	fputc('\n', out);
+	for (i = 0; i < o.nsegs; i++) {
+		s = &o.segs[i];
+		fprintf(out, "  seg %u type %u %04x+%x %s\n", s->id, s->type,
+		        s->base, s->size, s->name);
+	}
+	for (i = 0; i < o.nlines; i++) {
+		l = &o.lines[i];
+		fprintf(out, "  line %04x %s:%u\n", l->addr,
+		        l->module < o.nmodules ? o.modules[l->module] : "?",
+		        l->line);
+	}
+	dump_syms(out, &syms);
+	dump_image(out, &img);
+	dis8051_omf_free(&o);
+	dis8051_symtab_free(&syms);
+	dis8051_image_free(&img);
+}
+
+/* all of it, spans that start together are in no set order */
+static int span_cmp(const void *a, const void *b)
+{
+	const struct dis8051_span *x = a, *y = b;
+
+	if (x->space != y->space)
+		return x->space - y->space;
+	if (x->start != y->start)
+		return x->start < y->start ? -1 : 1;
+	if (x->end != y->end)
+		return x->end < y->end ? -1 : 1;
+	if (x->kind != y->kind)
+		return x->kind - y->kind;
+	if (x->line != y->line)
+		return x->line < y->line ? -1 : 1;
+	return strcmp(x->name, y->name);
+}
+
+static void sdcc_test(FILE *out, const char *set)
+{
+	const struct dis8051_span *v;
+	struct dis8051_span *sorted;
+	struct dis8051_sdcc s;
+	const char *p, *q;
+	char path[256];
+	size_t i, n;
+	int r, failed;
+
+	dis8051_sdcc_init(&s);
+	for (p = set; *p; p = *q ? q + 1 : q) {
+		q = strchr(p, ':');
+		q = q ? q : p + strlen(p);
+		if ((n = q - p) >= sizeof(path))
+			n = sizeof(path) - 1;
+		memcpy(path, p, n);
+		path[n] = '\0';
+		if (dis8051_sdcc_add(&s, path) < 0)
+			fprintf(out, "  %s: out of memory\n", path);
+	}
+	r = dis8051_sdcc_reload(&s, &failed);
+	fprintf(out, "sdcc %s: reloaded %d, failed %d", set, r, failed);
+	/* nothing changed since */
+	r = dis8051_sdcc_reload(&s, &failed);
+	fprintf(out, ", then %d, %d\n", r, failed);
+	for (i = 0; i < s.nfiles; i++) {
+		fprintf(out, " %s\n", s.files[i].path);
+		dump_syms(out, &s.files[i].syms);
+	}
+	n = s.index.count;
+	if (!(sorted = malloc((n ? n : 1)*sizeof(*sorted)))) {
+		fprintf(out, "  out of memory\n");
+		n = 0;
+	} else
+		memcpy(sorted, s.index.v, n*sizeof(*sorted));
+	qsort(sorted, n, sizeof(*sorted), span_cmp);
+	for (i = 0; i < n; i++) {
+		v = &sorted[i];
+		fprintf(out, "  span %s %s %06x-%06x", spaces[v->space],
+		        kinds[v->kind], v->start, v->end);
+		if (v->kind == DIS8051_SPAN_LINE)
+			fprintf(out, " %s:%u\n", v->name, v->line);
+		else
+			fprintf(out, " %s\n", v->name);
+	}
+	free(sorted);
+	if ((v = dis8051_spans_find(&s.index, DIS8051_SPACE_CODE,
+	                            DIS8051_SPAN_LINE, 0x104)))
+		fprintf(out, "  line of 000104: %s:%u\n", v->name, v->line);
+	if ((p = dis8051_sdcc_name(&s, DIS8051_SPACE_SFR, 0x90)))
+		fprintf(out, "  name of sfr 90: %s\n", p);
+	dis8051_sdcc_free(&s);
+}
+
+static void run(FILE *out)
+{
+	size_t i;
+
+	for (i = 0; i < N(ihex_files); i++)
+		ihex_test(out, ihex_files[i]);
+	for (i = 0; i < N(omf_files); i++)
+		omf_test(out, omf_files[i]);
+	for (i = 0; i < N(sdcc_sets); i++)
+		sdcc_test(out, sdcc_sets[i]);
+}
+
+/* line by line, the lines that differ are shown */
+static int compare(FILE *got, FILE *want)
+{
+	char a[512], b[512];
+	unsigned line = 0, bad = 0;
+	int ga, gb;
+
+	for (;;) {
+		ga = fgets(a, sizeof(a), got) != NULL;
+		gb = fgets(b, sizeof(b), want) != NULL;
+		if (!ga && !gb)
+			break;
+		line++;
+		if (ga && gb && !strcmp(a, b))
+			continue;
+		if (bad++ < 10)
+			printf("line %u: expected %sgot %s", line,
+			       gb ? b : "nothing\n", ga ? a : "nothing\n");
+	}
+	return bad;
+}
+
+int main(int argc, char **argv)
+{
+	FILE *exp, *got;
+	int golden = 0, bad;
+
+	if (argc > 1 && !strcmp(argv[1], "-g")) {
+		golden = 1;
+		argc--;
+		argv++;
+	}
+	if (argc != 3) {
+		fprintf(stderr, "usage: loaders [-g] dir expected.txt\n");
+		return 2;
+	}
+	if (!(exp = fopen(argv[2], golden ? "w" : "r"))) {
+		perror(argv[2]);
+		return 2;
+	}
+	/* names in the output are relative to the fixtures */
+	if (chdir(argv[1]) < 0) {
+		perror(argv[1]);
+		return 2;
+	}
+
+	if (golden) {
+		run(exp);
+		if (fclose(exp)) {
+			perror(argv[2]);
+			return 2;
+		}
+		return 0;
+	}
+	if (!(got = tmpfile())) {
+		perror("tmpfile");
+		return 2;
+	}
+	run(got);
+	rewind(got);
+	bad = compare(got, exp);
+	fclose(got);
+	fclose(exp);
+
+	printf("%u loads: %s\n",
+	       (unsigned)(N(ihex_files) + N(omf_files) + N(sdcc_sets)),
+	       bad ? "FAILED" : "ok");
+	return bad ? 1 : 0;
+}
@@ -0,0 +1,196 @@
+/* function level diff of two firmware images: every function recovered
+ * from the vectors is fingerprinted and matched to its counterpart in
+ * the other image, wherever the linker put it
+ *
+ * usage: dis8051-diff [-a] [-t threshold] old new
+ *   -a  list unchanged functions too
+ *   -t  least similarity per mille of a match, 500 by default
+ *
+ * .hex and .ihx files are Intel HEX, .abs and .omf OMF-51, anything
+ * else a raw image at address 0; only bank 0 is compared.
+ *
+ * output, one function a line:
+ *   = old new        unchanged
+ *   ~ old new score  changed, similarity per mille
+ *   - old            removed
+ *   + new            added */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "../dis8051.h"
+
+struct side {
+	struct dis8051_image img;
+	uint8_t *code;
+	struct dis8051_flow flow;
+	struct dis8051_fhashes hashes;
+};
+
+static const char *ext(const char *path)
+{
+	const char *p = strrchr(path, '.');
+
+	return p && !strchr(p, '/') ? p : "";
+}
+
+static int load_raw(struct dis8051_image *img, const char *path)
+{
+	uint8_t buf[65536];
+	uint32_t addr = 0;
+	size_t n;
+	FILE *f;
+	int r = 0;
+
+	if (!(f = fopen(path, "rb")))
+		return -1;
+	while (r == 0 && (n = fread(buf, 1, sizeof(buf), f)) > 0) {
+		r = dis8051_image_write(img, addr, buf, n);
+		addr += n;
+	}
+	if (ferror(f))
+		r = -1;
+	fclose(f);
+	return r;
+}
+
+static const char *load(struct dis8051_image *img, const char *path)
+{
+	struct dis8051_symtab syms;
+	struct dis8051_omf o;
+	const char *e = ext(path);
+	int r;
+
+	dis8051_image_init(img);
+	if (!strcasecmp(e, ".hex") || !strcasecmp(e, ".ihx")) {
+		r = dis8051_ihex_load(img, path, NULL);
+		return r ? dis8051_ihex_strerror(r) : NULL;
+	}
+	if (!strcasecmp(e, ".abs") || !strcasecmp(e, ".omf")) {
+		dis8051_symtab_init(&syms);
+		dis8051_omf_init(&o, img, &syms);
+		r = dis8051_omf_load_file(&o, path);
+		dis8051_omf_free(&o);
+		dis8051_symtab_free(&syms);
+		/* the code of the records that were read is used all
+		 * the same */
+		if (r == DIS8051_OMF_EUNSUPPORTED)
+			r = DIS8051_OMF_OK;
+		return r ? dis8051_omf_strerror(r) : NULL;
+	}
+	return load_raw(img, path) < 0 ? "read error" : NULL;
+}
+
+/* load and fingerprint bank 0 */
+static const char *analyse(struct side *s, const char *path)
+{
+	uint32_t first, last, len;
+	const char *e;
+
+	if ((e = load(&s->img, path)))
+		return e;
+	if (!dis8051_image_range(&s->img, &first, &last))
+		return "empty";
+	len = last < 0x10000 ? last + 1 : 0x10000;
+	if (!(s->code = malloc(len)))
+		return "out of memory";
+	dis8051_image_read(&s->img, 0, s->code, len, 0xff);
+	if (dis8051_flow_init(&s->flow, 0, s->code, len, NULL) < 0 ||
+	    dis8051_flow_add_vectors(&s->flow) < 0 ||
+	    dis8051_flow_run(&s->flow) < 0 ||
+	    dis8051_fhash_run(&s->flow, &s->hashes) < 0)
+		return "out of memory";
+	return NULL;
+}
+
+static void side_free(struct side *s)
+{
+	dis8051_fhash_free(&s->hashes);
+	dis8051_flow_free(&s->flow);
+	free(s->code);
+	dis8051_image_free(&s->img);
+}
+
+static int cmp_b(const void *a, const void *b)
+{
+	const struct dis8051_fmatch *x = a, *y = b;
+
+	return (int)x->b - (int)y->b;
+}
+
+int main(int argc, char **argv)
+{
+	struct side old = {0}, new = {0};
+	struct dis8051_fdiff d;
+	const struct dis8051_fhash *h;
+	size_t i, k, same = 0, changed = 0, removed = 0, added = 0;
+	int c, all = 0, threshold = 500;
+	const char *e;
+
+	while ((c = getopt(argc, argv, "at:")) != -1) {
+		switch (c) {
+		case 'a':
+			all = 1;
+			break;
+		case 't':
+			threshold = atoi(optarg);
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (argc - optind != 2)
+		goto usage;
+	for (k = 0; k < 2; k++)
+		if ((e = analyse(k ? &new : &old, argv[optind + k]))) {
+			fprintf(stderr, "%s: %s\n", argv[optind + k], e);
+			return 2;
+		}
+	if (dis8051_fhash_diff(&old.hashes, &new.hashes, threshold, &d) < 0) {
+		fprintf(stderr, "out of memory\n");
+		return 2;
+	}
+
+	/* both are sorted by address, the matches by old */
+	for (i = 0, k = 0; i < old.hashes.nfuncs; i++) {
+		h = &old.hashes.funcs[i];
+		while (k < d.nmatches && d.matches[k].a < h->addr)
+			k++;
+		if (k == d.nmatches || d.matches[k].a != h->addr) {
+			printf("- %04x\n", h->addr);
+			removed++;
+		} else if (d.matches[k].score == 1000) {
+			if (all)
+				printf("= %04x %04x\n", h->addr, d.matches[k].b);
+			same++;
+		} else {
+			printf("~ %04x %04x %d\n", h->addr, d.matches[k].b,
+			       d.matches[k].score);
+			changed++;
+		}
+	}
+	qsort(d.matches, d.nmatches, sizeof(*d.matches), cmp_b);
+	for (i = 0, k = 0; i < new.hashes.nfuncs; i++) {
+		h = &new.hashes.funcs[i];
+		while (k < d.nmatches && d.matches[k].b < h->addr)
+			k++;
+		if (k == d.nmatches || d.matches[k].b != h->addr) {
+			printf("+ %04x\n", h->addr);
+			added++;
+		}
+	}
+	fprintf(stderr, "%zu unchanged, %zu changed, %zu removed, %zu added\n",
+	        same, changed, removed, added);
+
+	dis8051_fdiff_free(&d);
+	side_free(&old);
+	side_free(&new);
+	return 0;
+
+usage:
+	fprintf(stderr, "usage: dis8051-diff [-a] [-t threshold] old new\n");
+	return 2;
+}
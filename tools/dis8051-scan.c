@@ -0,0 +1,852 @@
+/* firmware corpus scanner: walks files and directories and runs each
+ * image through load -> 8051 check -> recursive disassembly ->
+ * signature match -> features, one thread pool per stage with bounded
+ * queues in between, and writes one row per image to a columnar file
+ *
+ * usage: dis8051-scan [-j threads] [-s signatures] [-c cache]
+ *                     [-i out.idx] -o out.col path...
+ *        dis8051-scan -d out.col
+ *        dis8051-scan -q pattern index...
+ *   -j  analysis threads, one per core by default
+ *   -s  signature file, see 8051-sig.h
+ *   -c  directory of analysis caches, see 8051-cache.h, images that
+ *       have one there are not analysed again
+ *   -i  also write an instruction pattern index, see 8051-pindex.h
+ *   -d  print a columnar file as tab separated text
+ *   -q  print image and address of each match of a pattern such as
+ *       "mov dptr,#*; movx a,@dptr" in the given indexes
+ *
+ * .hex and .ihx files are Intel HEX, .abs and .omf OMF-51, anything
+ * else a raw image at address 0. Images larger than 64 KiB are taken as
+ * BL51 banked, see dis8051_codebank_layout_init(); the signatures, the
+ * index and the cache cover bank 0.
+ *
+ * columnar file, little endian:
+ *   "D8SCAN1\n", u32 rows, u32 columns, then per column
+ *   u8 type (0 u32, 1 string), u8 name length, name,
+ *   u32 values, or for strings u32 end offsets and the bytes */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "../dis8051.h"
+
+#define MAGIC "D8SCAN1\n"
+
+/* jobs waiting between two stages */
+#define QUEUE_SIZE 64
+#define LOADERS 2
+
+/* least dis8051_detect_score() of an image that is analysed */
+#define MIN_SCORE 500
+
+/* matched signature names kept per image */
+#define MATCHES_MAX 1024
+
+struct row {
+	char *path;
+	char *error;        /* why it was not analysed, "" if it was */
+	uint32_t size;      /* bytes loaded */
+	uint32_t banks;     /* 64 KiB banks with anything in them */
+	uint32_t score;     /* 8051 likelihood, per mille */
+	uint32_t insns;     /* instructions reached from the vectors */
+	uint32_t funcs;
+	uint32_t jtabs;
+	uint32_t calls;
+	uint32_t farcalls;  /* calls into other code banks */
+	uint32_t xdata;     /* movx */
+	uint32_t sigs;      /* signature matches */
+	char *matches;      /* their names, ',' separated */
+};
+
+enum { U32, STR };
+
+static const struct column {
+	const char *name;
+	int type;
+	size_t off;
+} columns[] = {
+	{"path",    STR, offsetof(struct row, path)},
+	{"error",   STR, offsetof(struct row, error)},
+	{"size",    U32, offsetof(struct row, size)},
+	{"banks",   U32, offsetof(struct row, banks)},
+	{"score",   U32, offsetof(struct row, score)},
+	{"insns",   U32, offsetof(struct row, insns)},
+	{"funcs",   U32, offsetof(struct row, funcs)},
+	{"jtabs",   U32, offsetof(struct row, jtabs)},
+	{"calls",   U32, offsetof(struct row, calls)},
+	{"farcalls", U32, offsetof(struct row, farcalls)},
+	{"xdata",   U32, offsetof(struct row, xdata)},
+	{"sigs",    U32, offsetof(struct row, sigs)},
+	{"matches", STR, offsetof(struct row, matches)},
+};
+#define NCOLUMNS (sizeof(columns)/sizeof(columns[0]))
+
+struct job {
+	struct row row;
+	struct dis8051_image img;
+};
+
+/* bounded queue, pop returns NULL once it is closed and empty */
+struct queue {
+	void *v[QUEUE_SIZE];
+	size_t head, n;
+	int closed;
+	pthread_mutex_t lock;
+	pthread_cond_t not_empty, not_full;
+};
+
+static struct queue to_load, to_analyse, to_write;
+static struct dis8051_sigs sigs;
+static struct dis8051_detect detect;
+
+/* pattern index of the images analysed, if asked for */
+static struct dis8051_pindex_builder pindex;
+static pthread_mutex_t pindex_lock = PTHREAD_MUTEX_INITIALIZER;
+static const char *pindex_out;
+static int pindex_failed;
+
+/* analysis cache directory and the hash of the signature file, which
+ * goes into the keys */
+static const char *cache_dir;
+static uint64_t sigs_key;
+
+static void queue_init(struct queue *q)
+{
+	memset(q, 0, sizeof(*q));
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_cond_init(&q->not_empty, NULL);
+	pthread_cond_init(&q->not_full, NULL);
+}
+
+static void queue_push(struct queue *q, void *p)
+{
+	pthread_mutex_lock(&q->lock);
+	while (q->n == QUEUE_SIZE)
+		pthread_cond_wait(&q->not_full, &q->lock);
+	q->v[(q->head + q->n++) % QUEUE_SIZE] = p;
+	pthread_cond_signal(&q->not_empty);
+	pthread_mutex_unlock(&q->lock);
+}
+
+static void *queue_pop(struct queue *q)
+{
+	void *p = NULL;
+
+	pthread_mutex_lock(&q->lock);
+	while (q->n == 0 && !q->closed)
+		pthread_cond_wait(&q->not_empty, &q->lock);
+	if (q->n > 0) {
+		p = q->v[q->head];
+		q->head = (q->head + 1) % QUEUE_SIZE;
+		q->n--;
+		pthread_cond_signal(&q->not_full);
+	}
+	pthread_mutex_unlock(&q->lock);
+	return p;
+}
+
+static void queue_close(struct queue *q)
+{
+	pthread_mutex_lock(&q->lock);
+	q->closed = 1;
+	pthread_cond_broadcast(&q->not_empty);
+	pthread_mutex_unlock(&q->lock);
+}
+
+static char *copy(const char *s)
+{
+	size_t n = strlen(s) + 1;
+	char *d = malloc(n);
+
+	if (!d) {
+		fprintf(stderr, "out of memory\n");
+		exit(2);
+	}
+	return memcpy(d, s, n);
+}
+
+static void job_free(struct job *j)
+{
+	free(j->row.path);
+	free(j->row.error);
+	free(j->row.matches);
+	free(j);
+}
+
+/* --- walking --- */
+
+static void walk(const char *path)
+{
+	struct dirent *e;
+	struct stat st;
+	struct job *j;
+	char *sub;
+	DIR *d;
+
+	/* no symlinks, they may loop */
+	if (lstat(path, &st) < 0) {
+		perror(path);
+		return;
+	}
+	if (S_ISREG(st.st_mode)) {
+		if (!(j = calloc(1, sizeof(*j)))) {
+			fprintf(stderr, "out of memory\n");
+			exit(2);
+		}
+		j->row.path = copy(path);
+		queue_push(&to_load, j);
+		return;
+	}
+	if (!S_ISDIR(st.st_mode) || !(d = opendir(path)))
+		return;
+	while ((e = readdir(d))) {
+		if (!strcmp(e->d_name, ".") || !strcmp(e->d_name, ".."))
+			continue;
+		if (!(sub = malloc(strlen(path) + strlen(e->d_name) + 2))) {
+			fprintf(stderr, "out of memory\n");
+			exit(2);
+		}
+		sprintf(sub, "%s/%s", path, e->d_name);
+		walk(sub);
+		free(sub);
+	}
+	closedir(d);
+}
+
+/* --- loading --- */
+
+static const char *ext(const char *path)
+{
+	const char *p = strrchr(path, '.');
+
+	return p && !strchr(p, '/') ? p : "";
+}
+
+static int load_raw(struct dis8051_image *img, const char *path)
+{
+	uint8_t buf[65536];
+	uint32_t addr = 0;
+	size_t n;
+	FILE *f;
+	int r = 0;
+
+	if (!(f = fopen(path, "rb")))
+		return -1;
+	while (r == 0 && (n = fread(buf, 1, sizeof(buf), f)) > 0) {
+		r = dis8051_image_write(img, addr, buf, n);
+		addr += n;
+	}
+	if (ferror(f))
+		r = -1;
+	fclose(f);
+	return r;
+}
+
+static const char *load(struct job *j)
+{
+	struct dis8051_symtab syms;
+	struct dis8051_omf o;
+	const char *e = ext(j->row.path);
+	int r;
+
+	dis8051_image_init(&j->img);
+	if (!strcasecmp(e, ".hex") || !strcasecmp(e, ".ihx")) {
+		r = dis8051_ihex_load(&j->img, j->row.path, NULL);
+		return r ? dis8051_ihex_strerror(r) : NULL;
+	}
+	if (!strcasecmp(e, ".abs") || !strcasecmp(e, ".omf")) {
+		dis8051_symtab_init(&syms);
+		dis8051_omf_init(&o, &j->img, &syms);
+		r = dis8051_omf_load_file(&o, j->row.path);
+		dis8051_omf_free(&o);
+		dis8051_symtab_free(&syms);
+		/* the code of the records that were read is used all
+		 * the same */
+		if (r == DIS8051_OMF_EUNSUPPORTED)
+			r = DIS8051_OMF_OK;
+		return r ? dis8051_omf_strerror(r) : NULL;
+	}
+	return load_raw(&j->img, j->row.path) < 0 ? "read error" : NULL;
+}
+
+static void *loader(void *arg)
+{
+	struct job *j;
+	const char *e;
+
+	(void)arg;
+	while ((j = queue_pop(&to_load))) {
+		if ((e = load(j)))
+			j->row.error = copy(e);
+		queue_push(&to_analyse, j);
+	}
+	return NULL;
+}
+
+/* --- analysis --- */
+
+/* signature matches of an image, kept for the cache if there is one */
+struct matches {
+	struct row *r;
+	struct dis8051_cache_match *v;
+	size_t n, a;
+	int failed;
+};
+
+static void add_match(struct row *r, const char *name)
+{
+	size_t n = strlen(r->matches), k = strlen(name);
+
+	r->sigs++;
+	if (n + k + 2 > MATCHES_MAX)
+		return;
+	if (n)
+		r->matches[n++] = ',';
+	memcpy(r->matches + n, name, k + 1);
+}
+
+static void match(void *user, const struct dis8051_sig *s, uint32_t addr)
+{
+	struct matches *m = user;
+	struct dis8051_cache_match *v;
+
+	add_match(m->r, s->name);
+	if (!cache_dir)
+		return;
+	if (m->n == m->a) {
+		m->a = m->a ? m->a*2 : 16;
+		if (!(v = realloc(m->v, m->a*sizeof(*v)))) {
+			m->failed = 1;
+			return;
+		}
+		m->v = v;
+	}
+	m->v[m->n].addr = addr;
+	m->v[m->n++].name = s->name;
+}
+
+/* register accesses as IRAM references, in the bank each runs in */
+static int register_xrefs(const struct dis8051_flow *f,
+                          struct dis8051_xrefs *x)
+{
+	uint8_t *bank;
+	int ret;
+
+	if (!(bank = malloc(f->len ? f->len : 1)))
+		return -1;
+	ret = dis8051_bank_run(f, bank) < 0 ||
+	      dis8051_bank_xrefs(f, bank, x) < 0 ? -1 : 0;
+	free(bank);
+	return ret;
+}
+
+/* the traversal and signature matches of 'code', from the cache if it
+ * has them; returns 0 on success, -1 if out of memory */
+static int traverse(struct row *r, const uint8_t *code, uint32_t len,
+                    struct dis8051_flow *f)
+{
+	struct matches m = {r, NULL, 0, 0, 0};
+	struct dis8051_cache c;
+	struct dis8051_xrefs x;
+	char path[4096];
+	uint64_t key = 0;
+	uint32_t i, addr;
+	const char *name;
+	int ret;
+
+	memset(f, 0, sizeof(*f));
+	if (cache_dir) {
+		key = dis8051_cache_key(0, code, len, sigs_key);
+		snprintf(path, sizeof(path), "%s/%016llx.d8c", cache_dir,
+		         (unsigned long long)key);
+		if (dis8051_cache_open(&c, path, key) == 0) {
+			ret = dis8051_cache_flow(&c, f, code);
+			for (i = 0; !ret && i < c.nmatches; i++) {
+				name = dis8051_cache_match(&c, i, &addr);
+				add_match(r, name);
+			}
+			dis8051_cache_close(&c);
+			return ret;
+		}
+	}
+
+	/* cross references, DPTR targets and the IRAM addresses of the
+	 * registers are only for the cache */
+	memset(&x, 0, sizeof(x));
+	if ((cache_dir && (dis8051_xrefs_build(&x, 0, code, len) < 0)) ||
+	    dis8051_flow_init(f, 0, code, len, cache_dir ? &x : NULL) < 0 ||
+	    dis8051_flow_add_vectors(f) < 0 || dis8051_flow_run(f) < 0 ||
+	    (cache_dir && dis8051_dptr_resolve(NULL, &x, 0, code, len) < 0) ||
+	    (cache_dir && register_xrefs(f, &x) < 0)) {
+		dis8051_xrefs_free(&x);
+		return -1;
+	}
+	dis8051_sigs_scan(&sigs, code, len, 0, match, &m);
+	ret = m.failed ? -1 : 0;
+	if (cache_dir && !ret &&
+	    dis8051_cache_write(path, key, f, &x, m.v, m.n) < 0)
+		perror(path);
+	dis8051_xrefs_free(&x);
+	free(m.v);
+	return ret;
+}
+
+/* what the traversal found between 'from' and 'to' */
+static void count(struct row *r, const struct dis8051_flow *f,
+                  uint32_t from, uint32_t to)
+{
+	struct dis8051_insn in;
+	uint32_t pc;
+
+	for (pc = from; pc < to; pc++) {
+		if (f->map[pc] & DIS8051_MAP_FUNC)
+			r->funcs++;
+		if (!(f->map[pc] & DIS8051_MAP_CODE))
+			continue;
+		dis8051_decode(pc, f->buf + pc, f->len - pc, &in);
+		r->insns++;
+		if (in.flow == DIS8051_FLOW_CALL)
+			r->calls++;
+		if (in.mnem == DIS8051_MOVX)
+			r->xdata++;
+	}
+}
+
+/* the same over every code bank of an image larger than 64 KiB, laid
+ * out as BL51 and banked HEX files have it, with the calls between
+ * them; returns 0 on success, -1 if out of memory */
+static int count_banks(const struct dis8051_image *img, struct row *r,
+                       uint32_t last)
+{
+	struct dis8051_codebank_layout l;
+	struct dis8051_codebank cb;
+	size_t len = (size_t)last + 1, max;
+	uint32_t pc;
+	uint8_t *flat;
+	int b, ret = -1;
+
+	dis8051_codebank_layout_init(&l);
+	max = l.first + (size_t)DIS8051_CODEBANK_MAX*l.stride;
+	len = len < max ? len : max;
+	if (!(flat = malloc(len)))
+		return -1;
+	dis8051_image_read(img, 0, flat, len, 0xff);
+	if (dis8051_codebank_init(&cb, &l, flat, len) == 0 &&
+	    dis8051_codebank_run(&cb) == 0) {
+		/* the common area once, with what any bank reaches of it */
+		for (b = 1; b < cb.nbanks; b++)
+			for (pc = 0; pc < l.window; pc++)
+				cb.views[0].flow.map[pc] |=
+					cb.views[b].flow.map[pc];
+		count(r, &cb.views[0].flow, 0, 0x10000);
+		for (b = 1; b < cb.nbanks; b++)
+			count(r, &cb.views[b].flow, l.window, 0x10000);
+		r->farcalls = cb.ncalls;
+		ret = 0;
+	}
+	dis8051_codebank_free(&cb);
+	free(flat);
+	return ret;
+}
+
+static void analyse(struct job *j)
+{
+	static const uint8_t erased = 0xff;
+	struct row *r = &j->row;
+	struct dis8051_flow f;
+	uint32_t first, last, len;
+	uint8_t *code, v;
+	size_t i, k;
+
+	r->matches = calloc(1, MATCHES_MAX);
+	if (!dis8051_image_range(&j->img, &first, &last)) {
+		r->error = copy("empty");
+		return;
+	}
+	for (i = 0; i < j->img.npages; i++) {
+		for (k = 0; k < sizeof(j->img.pages[i]->valid); k++)
+			for (v = j->img.pages[i]->valid[k]; v; v &= v - 1)
+				r->size++;
+		if (i == 0 || j->img.pages[i]->addr >> 16 !=
+		    j->img.pages[i-1]->addr >> 16)
+			r->banks++;
+	}
+
+	/* bank 0, the part the CPU starts in */
+	len = last < 0x10000 ? last + 1 : 0x10000;
+	if (!r->matches || !(code = malloc(len))) {
+		r->error = copy("out of memory");
+		return;
+	}
+	dis8051_image_read(&j->img, 0, code, len, erased);
+	if ((r->score = dis8051_detect_score(&detect, code, len)) < MIN_SCORE) {
+		r->error = copy("not 8051 code");
+		free(code);
+		return;
+	}
+
+	if (traverse(r, code, len, &f) < 0) {
+		r->error = copy("out of memory");
+	} else {
+		if (last < 0x10000)
+			count(r, &f, 0, len);
+		else if (count_banks(&j->img, r, last) < 0)
+			r->error = copy("out of memory");
+		r->jtabs = f.njtabs;
+		if (pindex_out) {
+			pthread_mutex_lock(&pindex_lock);
+			if (dis8051_pindex_add(&pindex, r->path, code, len,
+			                       f.map) < 0)
+				pindex_failed = 1;
+			pthread_mutex_unlock(&pindex_lock);
+		}
+	}
+	dis8051_flow_free(&f);
+	free(code);
+}
+
+static void *analyser(void *arg)
+{
+	struct job *j;
+
+	(void)arg;
+	while ((j = queue_pop(&to_analyse))) {
+		if (!j->row.error)
+			analyse(j);
+		dis8051_image_free(&j->img);
+		queue_push(&to_write, j);
+	}
+	return NULL;
+}
+
+/* --- writing --- */
+
+static struct job **rows;
+static size_t nrows;
+
+static void *writer(void *arg)
+{
+	struct job *j, **v;
+	size_t a = 0;
+
+	(void)arg;
+	while ((j = queue_pop(&to_write))) {
+		if (nrows == a) {
+			a = a ? a*2 : 1024;
+			if (!(v = realloc(rows, a*sizeof(*v)))) {
+				fprintf(stderr, "out of memory\n");
+				exit(2);
+			}
+			rows = v;
+		}
+		rows[nrows++] = j;
+	}
+	return NULL;
+}
+
+static int by_path(const void *a, const void *b)
+{
+	return strcmp((*(struct job *const *)a)->row.path,
+	              (*(struct job *const *)b)->row.path);
+}
+
+static void put32(FILE *f, uint32_t v)
+{
+	uint8_t b[4] = {v, v >> 8, v >> 16, v >> 24};
+
+	fwrite(b, 1, 4, f);
+}
+
+static const char *str(const struct row *r, const struct column *c)
+{
+	const char *s = *(char *const *)((const char *)r + c->off);
+
+	return s ? s : "";
+}
+
+static int write_columns(const char *name)
+{
+	const struct column *c;
+	uint32_t end;
+	size_t i;
+	FILE *f;
+
+	/* the same corpus gives the same file */
+	qsort(rows, nrows, sizeof(*rows), by_path);
+
+	if (!(f = fopen(name, "wb")))
+		return -1;
+	fwrite(MAGIC, 1, 8, f);
+	put32(f, nrows);
+	put32(f, NCOLUMNS);
+	for (c = columns; c < columns + NCOLUMNS; c++) {
+		fputc(c->type, f);
+		fputc(strlen(c->name), f);
+		fputs(c->name, f);
+		if (c->type == U32) {
+			for (i = 0; i < nrows; i++)
+				put32(f, *(const uint32_t *)((const char *)
+				      &rows[i]->row + c->off));
+			continue;
+		}
+		for (i = 0, end = 0; i < nrows; i++)
+			put32(f, end += strlen(str(&rows[i]->row, c)));
+		for (i = 0; i < nrows; i++)
+			fputs(str(&rows[i]->row, c), f);
+	}
+	return fclose(f);
+}
+
+/* --- reading back --- */
+
+static int get32(FILE *f, uint32_t *v)
+{
+	uint8_t b[4];
+
+	if (fread(b, 1, 4, f) != 4)
+		return -1;
+	*v = b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24;
+	return 0;
+}
+
+static int dump(const char *name)
+{
+	uint32_t nr, nc, c, i, **u;
+	char magic[8], **s;
+	int type, n, r = -1;
+	FILE *f;
+
+	if (!(f = fopen(name, "rb")))
+		return -1;
+	if (fread(magic, 1, 8, f) != 8 || memcmp(magic, MAGIC, 8) ||
+	    get32(f, &nr) < 0 || get32(f, &nc) < 0 || nc > 256) {
+		fclose(f);
+		return -1;
+	}
+	u = calloc(nc, sizeof(*u));
+	s = calloc(nc, sizeof(*s));
+	for (c = 0; u && s && c < nc; c++) {
+		char col[256];
+
+		if ((type = fgetc(f)) < 0 || (n = fgetc(f)) < 0 ||
+		    fread(col, 1, n, f) != (size_t)n)
+			goto out;
+		printf("%s%.*s", c ? "\t" : "", n, col);
+		if (!(u[c] = malloc((nr ? nr : 1)*sizeof(**u))))
+			goto out;
+		for (i = 0; i < nr; i++)
+			if (get32(f, &u[c][i]) < 0)
+				goto out;
+		if (type != STR)
+			continue;
+		/* offsets, then the text */
+		if (!(s[c] = malloc(nr ? u[c][nr-1] + 1 : 1)) ||
+		    fread(s[c], 1, nr ? u[c][nr-1] : 0, f) !=
+		    (nr ? u[c][nr-1] : 0))
+			goto out;
+	}
+	printf("\n");
+	for (i = 0; i < nr; i++) {
+		for (c = 0; c < nc; c++) {
+			printf(c ? "\t" : "");
+			if (s[c])
+				printf("%.*s", (int)(u[c][i] - (i ? u[c][i-1] : 0)),
+				       s[c] + (i ? u[c][i-1] : 0));
+			else
+				printf("%u", u[c][i]);
+		}
+		printf("\n");
+	}
+	r = 0;
+out:
+	for (c = 0; c < nc; c++) {
+		free(u ? u[c] : NULL);
+		free(s ? s[c] : NULL);
+	}
+	free(u);
+	free(s);
+	fclose(f);
+	return r;
+}
+
+static int load_sigs(const char *name)
+{
+	char *buf = NULL, *b;
+	size_t n = 0, a = 0, k;
+	unsigned line;
+	FILE *f;
+	int r;
+
+	if (!(f = fopen(name, "rb")))
+		return -1;
+	do {
+		if (n == a) {
+			a = a ? a*2 : 65536;
+			if (!(b = realloc(buf, a))) {
+				free(buf);
+				fclose(f);
+				return -1;
+			}
+			buf = b;
+		}
+		n += k = fread(buf + n, 1, a - n, f);
+	} while (k > 0);
+	fclose(f);
+	r = dis8051_sigs_parse(&sigs, buf, n, &line);
+	sigs_key = dis8051_cache_hash(sigs_key, buf, n);
+	free(buf);
+	if (r < 0)
+		fprintf(stderr, "%s:%u: bad signature\n", name, line);
+	return r;
+}
+
+static void print_match(void *user, const char *image, uint16_t addr)
+{
+	(void)user;
+	printf("%s\t0x%04x\n", image, addr);
+}
+
+/* the matches of 'pat' in each index file in 'files' */
+static int query(const char *pat, char **files, int n)
+{
+	struct dis8051_pattern p;
+	struct dis8051_pindex ix;
+	int bad, i;
+
+	if (dis8051_pattern_parse(&p, pat, &bad) < 0) {
+		fprintf(stderr, "bad pattern, statement %d\n", bad);
+		return 2;
+	}
+	for (i = 0; i < n; i++) {
+		if (dis8051_pindex_open(&ix, files[i]) < 0) {
+			perror(files[i]);
+			return 2;
+		}
+		if (dis8051_pindex_find(&ix, &p, print_match, NULL) < 0) {
+			fprintf(stderr, "out of memory\n");
+			dis8051_pindex_close(&ix);
+			return 2;
+		}
+		dis8051_pindex_close(&ix);
+	}
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	pthread_t load_t[LOADERS], *analyse_t, write_t;
+	long nthreads = sysconf(_SC_NPROCESSORS_ONLN), i, k;
+	const char *out = NULL, *pat = NULL;
+	size_t r;
+	int c;
+
+	while ((c = getopt(argc, argv, "j:s:c:o:i:d:q:")) != -1) {
+		switch (c) {
+		case 'j':
+			nthreads = atol(optarg);
+			break;
+		case 's':
+			if (load_sigs(optarg) < 0) {
+				perror(optarg);
+				return 2;
+			}
+			break;
+		case 'c':
+			cache_dir = optarg;
+			break;
+		case 'o':
+			out = optarg;
+			break;
+		case 'i':
+			pindex_out = optarg;
+			break;
+		case 'd':
+			if (dump(optarg) < 0) {
+				fprintf(stderr, "%s: not a scan result\n", optarg);
+				return 2;
+			}
+			return 0;
+		case 'q':
+			pat = optarg;
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (pat && optind < argc)
+		return query(pat, argv + optind, argc - optind);
+	if (!out || optind == argc)
+		goto usage;
+	if (nthreads < 1)
+		nthreads = 1;
+	if (!(analyse_t = calloc(nthreads, sizeof(*analyse_t)))) {
+		fprintf(stderr, "out of memory\n");
+		return 2;
+	}
+
+	dis8051_detect_init(&detect);
+	dis8051_pindex_builder_init(&pindex);
+	queue_init(&to_load);
+	queue_init(&to_analyse);
+	queue_init(&to_write);
+	for (i = 0; i < LOADERS; i++)
+		if (pthread_create(&load_t[i], NULL, loader, NULL))
+			goto threads;
+	for (k = 0; k < nthreads; k++)
+		if (pthread_create(&analyse_t[k], NULL, analyser, NULL))
+			goto threads;
+	if (pthread_create(&write_t, NULL, writer, NULL))
+		goto threads;
+
+	for (; optind < argc; optind++)
+		walk(argv[optind]);
+
+	/* drain the stages in order */
+	queue_close(&to_load);
+	for (i = 0; i < LOADERS; i++)
+		pthread_join(load_t[i], NULL);
+	queue_close(&to_analyse);
+	for (k = 0; k < nthreads; k++)
+		pthread_join(analyse_t[k], NULL);
+	queue_close(&to_write);
+	pthread_join(write_t, NULL);
+
+	if (write_columns(out)) {
+		perror(out);
+		return 2;
+	}
+	if (pindex_failed) {
+		fprintf(stderr, "%s: out of memory\n", pindex_out);
+		return 2;
+	}
+	if (pindex_out && dis8051_pindex_write(&pindex, pindex_out) < 0) {
+		perror(pindex_out);
+		return 2;
+	}
+	dis8051_pindex_builder_free(&pindex);
+	for (r = 0; r < nrows; r++)
+		job_free(rows[r]);
+	free(rows);
+	free(analyse_t);
+	dis8051_sigs_free(&sigs);
+	return 0;
+
+threads:
+	fprintf(stderr, "cannot start threads\n");
+	return 2;
+usage:
+	fprintf(stderr, "usage: dis8051-scan [-j threads] [-s signatures] "
+	        "[-c cache]\n"
+	        "                    [-i out.idx] -o out.col path...\n"
+	        "       dis8051-scan -d out.col\n"
+	        "       dis8051-scan -q pattern index...\n");
+	return 2;
+}
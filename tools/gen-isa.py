@@ -0,0 +1,481 @@
+#!/usr/bin/env python3
+# Generates the instruction tables from the ISA description in 8051.isa
+# and the SFR names of each derivative in 8051.sfr:
+#
+#   8051-isa.h       enum dis8051_mnem, derivative names
+#   8051-isa.c       opcode map, mnemonic names, ESIL templates
+#   8051-deriv.c     SFR and bit names, data pointers and extra
+#                    opcodes of each derivative
+#   8051-keywords.h  perfect hash of assembler keywords (mnemonics,
+#                    registers, SFR and bit names of the default
+#                    derivative), of the SFR and bit names of each
+#                    derivative and SFR page, and the opcodes of each
+#                    mnemonic
+#
+# usage: tools/gen-isa.py
+
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+SLOTS = 512
+BUCKETS = 128
+
+# syntax token: operand kind, operand bytes
+OPERANDS = {
+    'a': ('A', 0), 'ab': ('AB', 0), 'c': ('C', 0), 'dptr': ('DPTR', 0),
+    'rN': ('RN', 0), '@rI': ('IRI', 0), '@dptr': ('IDPTR', 0),
+    '@a+dptr': ('IADPTR', 0), '@a+pc': ('IAPC', 0),
+    'direct': ('DIRECT', 1), 'bit': ('BIT', 1), '/bit': ('NBIT', 1),
+    '#imm': ('IMM8', 1), '#imm16': ('IMM16', 2), 'rel': ('REL', 1),
+    'addr11': ('ADDR11', 1), 'addr16': ('ADDR16', 2),
+}
+
+# opcode group suffix: opcodes of the group
+GROUPS = {
+    '': lambda o: [o],
+    '+r': lambda o: [o + n for n in range(8)],
+    '+i': lambda o: [o, o + 1],
+    '+p': lambda o: [o + 0x20*n for n in range(8)],
+}
+
+FLOWS = ('-', 'jmp', 'cjmp', 'call', 'ret', 'reti', 'ijmp', 'ill')
+FLAGS = ('C', 'AC', 'OV')
+
+
+class Opcode:
+    pass
+
+
+def read(name):
+    with open(os.path.join(ROOT, name)) as f:
+        return f.read()
+
+
+def write(name, text):
+    with open(os.path.join(ROOT, name), 'w') as f:
+        f.write(text)
+
+
+def fail(line, msg):
+    sys.exit('8051.isa:%d: %s' % (line, msg))
+
+
+def parse_isa(src):
+    """the 256 opcodes described by 'src' and the (parts, opcode, Opcode)
+    of derivatives with opcodes in reserved slots"""
+    ops, exts = [None] * 256, []
+    for line, text in enumerate(src.splitlines(), 1):
+        if text.startswith('#') or not text.strip():
+            continue
+        parts = None
+        if text.startswith('ext '):
+            parts, text = text[4:].split(None, 1)
+            parts = parts.split(',')
+        if '|' not in text:
+            fail(line, 'missing esil')
+        fields, esil = text.split('|', 1)
+        fields = fields.split(None, 4)
+        if len(fields) < 5:
+            fail(line, 'expected opcode, cycles, flags, flow, syntax')
+        code, cycles, flags, flow, syntax = fields
+
+        m = re.match(r'^([0-9a-f]{2})(\+[rip])?$', code)
+        if not m:
+            fail(line, 'bad opcode %s' % code)
+        if flow not in FLOWS:
+            fail(line, 'bad flow %s' % flow)
+        flags = [] if flags == '-' else flags.split(',')
+        if any(f not in FLAGS for f in flags):
+            fail(line, 'bad flags')
+
+        o = Opcode()
+        o.cycles = int(cycles)
+        o.flags = flags
+        o.flow = 'NONE' if flow == '-' else flow.upper()
+        o.esil = esil.strip()
+        words = syntax.split(None, 1)
+        o.mnem = words[0].upper()
+        o.opnd = []
+        o.size = 1
+        for tok in (words[1].split(',') if len(words) > 1 else []):
+            tok = tok.strip()
+            if tok not in OPERANDS:
+                fail(line, 'bad operand %s' % tok)
+            o.opnd.append(OPERANDS[tok][0])
+            o.size += OPERANDS[tok][1]
+
+        if parts:
+            if m.group(2):
+                fail(line, 'opcode groups are not supported by ext')
+            exts.append((parts, int(m.group(1), 16), o))
+            continue
+        for n in GROUPS[m.group(2) or ''](int(m.group(1), 16)):
+            if ops[n] is not None:
+                fail(line, 'opcode 0x%02x described twice' % n)
+            ops[n] = o
+
+    missing = [n for n in range(256) if ops[n] is None]
+    if missing:
+        sys.exit('8051.isa: opcode 0x%02x not described' % missing[0])
+    for parts, n, o in exts:
+        if ops[n].flow != 'ILL':
+            sys.exit('8051.isa: ext opcode 0x%02x is not reserved' % n)
+    return ops, exts
+
+
+def parse_sfr(src):
+    """SFR and bit names of each part and its pages, in file order"""
+    parts, order, cur, sfrs = {}, [], None, None
+    for line, text in enumerate(src.splitlines(), 1):
+        words = text.split('#', 1)[0].split()
+        if not words:
+            continue
+        if words[0] == 'part':
+            if len(words) not in (2, 3) or words[1] in parts:
+                sys.exit('8051.sfr:%d: bad part' % line)
+            cur = parts[words[1]] = {'base': words[2:], 'pages': {},
+                                     'sfrpage': None, 'dps': None,
+                                     'dptr1': 0}
+            sfrs = cur['sfrs'] = []
+            order.append(words[1])
+            continue
+        if cur is None:
+            sys.exit('8051.sfr:%d: SFR outside a part' % line)
+        if words[0] == 'sfrpage' and len(words) == 3:
+            cur['sfrpage'] = (int(words[1], 16), int(words[2], 16))
+            continue
+        if words[0] == 'dps' and len(words) in (3, 4, 6):
+            dps = [int(w, 16) for w in words[1:]]
+            cur['dps'] = tuple(dps + [0] * (5 - len(dps)))
+            continue
+        if words[0] == 'dptr1' and len(words) == 2:
+            cur['dptr1'] = int(words[1], 16)
+            continue
+        if words[0] == 'page' and len(words) == 2:
+            sfrs = cur['pages'].setdefault(int(words[1], 16), [])
+            continue
+        try:
+            addr = int(words[0], 16)
+        except ValueError:
+            addr = -1
+        if not 0x80 <= addr <= 0xff or len(words) > 10 or \
+           (len(words) > 2 and addr & 0x7):
+            sys.exit('8051.sfr:%d: bad SFR' % line)
+        sfrs.append((addr, words[1:]))
+
+    def apply(names, sfrs):
+        for addr, words in sfrs:
+            if words == ['-']:
+                names.pop(addr, None)
+            else:
+                names[addr] = words
+        return names
+
+    def resolve(name, seen=()):
+        if name not in parts or name in seen:
+            sys.exit('8051.sfr: bad base part %s' % name)
+        names = {}
+        for base in parts[name]['base']:
+            names.update(resolve(base, seen + (name,)))
+        return apply(names, parts[name]['sfrs'])
+
+    def tables(names):
+        sfr, bit = [''] * 128, [''] * 128
+        for addr, words in names.items():
+            sfr[addr - 0x80] = words[0]
+            if addr & 0x7:
+                continue
+            bits = words[1:] + ['-'] * (8 - len(words[1:]))
+            for n, b in enumerate(bits):
+                bit[addr - 0x80 + n] = \
+                    '%s.%d' % (words[0], n) if b == '-' else b
+        return sfr, bit
+
+    derivs = []
+    for name in order:
+        part = parts[name]
+        if part['pages'] and not part['sfrpage']:
+            sys.exit('8051.sfr: part %s has pages but no sfrpage' % name)
+        names = resolve(name)
+        pages = [(n,) + tables(apply(dict(names), sfrs))
+                 for n, sfrs in sorted(part['pages'].items())]
+        derivs.append((name,) + tables(names) +
+                      (part['sfrpage'] or (0, 0), pages,
+                       part['dps'] or (0,) * 5, part['dptr1']))
+    return derivs
+
+
+def c_list(out, items, per_line):
+    for i, item in enumerate(items):
+        out.append('%s%s,' % ('\n\t' if i % per_line == 0 else ' ', item))
+    out.append('\n};\n')
+
+
+def fnv(s, seed):
+    h = 2166136261 ^ seed
+    for c in s.lower().encode():
+        h = ((h ^ c) * 16777619) & 0xffffffff
+    return h
+
+
+def perfect_hash(keys, nbuckets=BUCKETS, nslots=SLOTS):
+    buckets = [[] for _ in range(nbuckets)]
+    for k in keys:
+        buckets[fnv(k, 0) % nbuckets].append(k)
+
+    disp = [0] * nbuckets
+    taken = [None] * nslots
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for d in range(1, 1 << 16):
+            slots = [fnv(k, d) % nslots for k in buckets[b]]
+            if len(set(slots)) == len(slots) and \
+               all(taken[s] is None for s in slots):
+                break
+        else:
+            sys.exit('no displacement for bucket %d' % b)
+        disp[b] = d
+        for k, s in zip(buckets[b], slots):
+            taken[s] = k
+    return disp, taken
+
+
+def gen_header(mnems, derivs):
+    out = ['/* generated by tools/gen-isa.py from 8051.isa and 8051.sfr, '
+           'do not edit */\n\n',
+           '#ifndef DIS8051_ISA_H\n#define DIS8051_ISA_H\n\n',
+           '/* mnemonics */\nenum dis8051_mnem {']
+    c_list(out, ['DIS8051_' + m for m in mnems], 5)
+    out[-1] = '\n\tDIS8051_MNEM_COUNT\n};\n\n'
+    out.append('/* derivatives, see \'dis8051_derivative\' */\n')
+    out.append('#define DIS8051_DERIVS %d\n' % len(derivs))
+    out.append('#define DIS8051_DERIV_NAMES "%s"\n\n#endif\n'
+               % ','.join(d[0] for d in derivs))
+    return ''.join(out)
+
+
+def gen_derivs(derivs, exts):
+    out = ['/* generated by tools/gen-isa.py from 8051.sfr and 8051.isa, '
+           'do not edit */\n\n',
+           '#include <stddef.h>\n#include "8051-render.h"\n']
+
+    def names(array, values):
+        out.append('\nstatic const char *const %s[128] = {\n' % array)
+        for n in range(0, 128, 8):
+            out.append('/* 0x%02x -- 0x%02x */\n\t' % (0x80 + n, 0x87 + n))
+            out.append(', '.join('"%s"' % v for v in values[n:n + 8]))
+            out.append(',\n')
+        out.append('};\n')
+
+    names_of = [d[0] for d in derivs]
+    for parts, n, o in exts:
+        for p in parts:
+            if p not in names_of:
+                sys.exit('8051.isa: ext for unknown part %s' % p)
+    if exts:
+        out.append('\n' + OP_MACRO)
+
+    for name, sfr, bit, sfrpage, pages, dps, dptr1 in derivs:
+        ident = re.sub(r'\W', '_', name)
+        ext = [(n, o) for parts, n, o in exts if name in parts]
+        if ext:
+            out.append('\nstatic const struct dis8051_ext ext_%s[%d] = {\n'
+                       % (ident, len(ext)))
+            for n, o in ext:
+                out.append('\t{0x%02x, %s, "%s"},\n'
+                           % (n, op_entry(o), o.esil))
+            out.append('};\n')
+        names('sfr_' + ident, sfr)
+        names('bit_' + ident, bit)
+        for n, sfr, bit in pages:
+            names('sfr_%s_%x' % (ident, n), sfr)
+            names('bit_%s_%x' % (ident, n), bit)
+        if pages:
+            out.append('\nstatic const struct dis8051_sfr_page '
+                       'pages_%s[%d] = {\n' % (ident, len(pages)))
+            for n, sfr, bit in pages:
+                out.append('\t{0x%02x, sfr_%s_%x, bit_%s_%x},\n'
+                           % (n, ident, n, ident, n))
+            out.append('};\n')
+
+    out.append('\n/* the first is the default */\n'
+               'const struct dis8051_derivative '
+               'dis8051_derivatives[DIS8051_DERIVS] = {\n')
+    for name, sfr, bit, sfrpage, pages, dps, dptr1 in derivs:
+        ident = re.sub(r'\W', '_', name)
+        next = sum(1 for parts, n, o in exts if name in parts)
+        out.append('\t{"%s", sfr_%s, bit_%s,\n'
+                   '\t 0x%02x, 0x%02x, %d, %s,\n'
+                   '\t 0x%02x, 0x%02x, 0x%02x, {0x%02x, 0x%02x}, 0x%02x,\n'
+                   '\t %d, %s},\n'
+                   % (name, ident, ident, sfrpage[0], sfrpage[1],
+                      len(pages), 'pages_' + ident if pages else 'NULL',
+                      dps[0], dps[1], dps[2], dps[3], dps[4], dptr1,
+                      next, 'ext_' + ident if next else 'NULL'))
+    out.append('};\n')
+    if exts:
+        out.append('\n#undef OP\n')
+    return ''.join(out)
+
+
+OP_MACRO = ('#define OP(m, f, s, c, fl, o1, o2, o3) \\\n'
+            '\t{DIS8051_##m, DIS8051_FLOW_##f, s, c, fl, \\\n'
+            '\t {DIS8051_OPND_##o1, DIS8051_OPND_##o2, '
+            'DIS8051_OPND_##o3}}\n')
+
+
+def op_entry(o):
+    flags = '|'.join('DIS8051_FLAG_' + f for f in o.flags) or '0'
+    opnd = (o.opnd + ['NONE'] * 3)[:3]
+    return 'OP(%s, %s, %d, %d, %s, %s)' % (o.mnem, o.flow, o.size, o.cycles,
+                                          flags, ', '.join(opnd))
+
+
+def gen_tables(ops, mnems):
+    out = ['/* generated by tools/gen-isa.py from 8051.isa, do not edit */\n\n',
+           '#include <stdint.h>\n#include "8051-insn.h"\n\n',
+           'const char *const dis8051_mnem_names[DIS8051_MNEM_COUNT] = {']
+    c_list(out, ['"%s"' % m.lower() for m in mnems], 5)
+
+    out.append('\n' + OP_MACRO + '\n')
+    out.append('/* opcode map: mnemonic, control flow, size, cycles, '
+               'flags written, operands */\n')
+    out.append('const struct dis8051_opcode dis8051_opcodes[256] = {\n')
+    for n, o in enumerate(ops):
+        if n % 16 == 0:
+            out.append('/* 0x%02x -- 0x%02x */\n' % (n, n + 15))
+        out.append('\t%s,\n' % op_entry(o))
+    out.append('};\n\n#undef OP\n\n')
+
+    out.append('/* ESIL templates, see \'dis8051_esil\' */\n')
+    out.append('const char *const dis8051_esil_templates[256] = {\n')
+    for n, o in enumerate(ops):
+        if n % 16 == 0:
+            out.append('/* 0x%02x -- 0x%02x */\n' % (n, n + 15))
+        out.append('\t"%s",\n' % o.esil)
+    out.append('};\n')
+    return ''.join(out)
+
+
+def gen_names(out, derivs):
+    """a perfect hash of the SFR and bit names of each derivative, then
+    of each of its pages, slots are 0 or 1 + bit<<7 + address - 0x80"""
+    sets, disp, slots, first = [], [], [], []
+    for d in derivs:
+        first.append(len(sets))
+        for sfr, bit in [d[1:3]] + [p[1:3] for p in d[4]]:
+            names = {}
+            for kind, table in ((0, sfr), (1, bit)):
+                for i, name in enumerate(table):
+                    if not name:
+                        continue
+                    if name.lower() in names:
+                        sys.exit('8051.sfr: %s: %s named twice'
+                                 % (d[0], name))
+                    names[name.lower()] = 1 + (kind << 7) + i
+            n = len(names)
+            bdisp, taken = perfect_hash(sorted(names), max(1, n // 4),
+                                     n + n // 2 + 1)
+            sets.append((len(disp), len(bdisp), len(slots), len(taken)))
+            disp += bdisp
+            slots += [names[k] if k else 0 for k in taken]
+
+    out.append('/* SFR and bit names of each derivative, then of each of '
+               'its SFR pages,\n * see \'names_lookup\' */\n'
+               'static const uint16_t names_disp[%d] = {' % len(disp))
+    c_list(out, disp, 10)
+    out.append('\n/* 0, or 1 + bit<<7 + address - 0x80 */\n'
+               'static const uint16_t names_slots[%d] = {' % len(slots))
+    c_list(out, slots, 10)
+    out.append('\nstatic const struct names_set names_sets[%d] = {\n'
+               % len(sets))
+    for s in sets:
+        out.append('\t{%d, %d, %d, %d},\n' % s)
+    out.append('};\n\n/* the first of each derivative */\n'
+               'static const uint8_t names_first[DIS8051_DERIVS] = {')
+    c_list(out, first, 10)
+    out.append('\n')
+
+
+def gen_keywords(ops, mnems, derivs):
+    deriv = derivs[0]
+    kw = {}
+
+    def add(name, kind, value):
+        key = name.lower()
+        if key in kw:
+            sys.exit('duplicate keyword %s' % name)
+        kw[key] = (kind, value)
+
+    for m in mnems:
+        add(m.lower(), 'KW_MNEM', 'DIS8051_' + m)
+    # generic call, see 'dis8051_assemble'
+    add('call', 'KW_MNEM', 'KW_CALL')
+
+    for name, opnd in (('a', 'A'), ('ab', 'AB'), ('c', 'C'),
+                       ('dptr', 'DPTR'), ('@dptr', 'IDPTR'),
+                       ('@a+dptr', 'IADPTR'), ('@a+pc', 'IAPC')):
+        add(name, 'KW_REG', 'DIS8051_OPND_' + opnd)
+    for n in range(8):
+        add('r%d' % n, 'KW_REG', 'DIS8051_OPND_RN | %d<<8' % n)
+    for n in range(2):
+        add('@r%d' % n, 'KW_REG', 'DIS8051_OPND_IRI | %d<<8' % n)
+
+    for i, name in enumerate(deriv[1]):
+        if name:
+            add(name, 'KW_SFR', '0x%02x' % (0x80 + i))
+    for i, name in enumerate(deriv[2]):
+        if name:
+            add(name, 'KW_BIT', '0x%02x' % (0x80 + i))
+
+    disp, taken = perfect_hash(sorted(kw))
+
+    out = ['/* generated by tools/gen-isa.py from 8051.isa and 8051.sfr, '
+           'do not edit */\n\n',
+           '#ifndef DIS8051_KEYWORDS_H\n#define DIS8051_KEYWORDS_H\n\n',
+           '#define KW_SLOTS %d\n#define KW_BUCKETS %d\n\n'
+           % (SLOTS, BUCKETS),
+           '/* displacement of each bucket, see \'kw_lookup\' */\n',
+           'static const uint16_t kw_disp[KW_BUCKETS] = {']
+    c_list(out, disp, 10)
+    out.append('\nstatic const struct keyword kw_table[KW_SLOTS] = {\n')
+    for s, k in enumerate(taken):
+        if k is not None:
+            kind, value = kw[k]
+            out.append('\t[%d] = {"%s", %d, %s, %s},\n'
+                       % (s, k, len(k), kind, value))
+    out.append('};\n\n')
+    gen_names(out, derivs)
+
+    first, order = [], []
+    for m in mnems:
+        first.append(len(order))
+        order += [n for n in range(256) if ops[n].mnem == m]
+    out.append('/* opcodes of each mnemonic */\n'
+               'static const uint8_t mnem_opcodes[256] = {')
+    c_list(out, ['0x%02x' % n for n in order], 10)
+    out.append('\nstatic const uint16_t mnem_first[DIS8051_MNEM_COUNT + 1] '
+               '= {')
+    c_list(out, first + [256], 10)
+    out.append('\n#endif\n')
+    return ''.join(out)
+
+
+def main():
+    ops, exts = parse_isa(read('8051.isa'))
+    mnems = sorted(set(o.mnem for o in ops) | set(e[2].mnem for e in exts))
+
+    derivs = parse_sfr(read('8051.sfr'))
+
+    write('8051-isa.h', gen_header(mnems, derivs))
+    write('8051-isa.c', gen_tables(ops, mnems))
+    write('8051-deriv.c', gen_derivs(derivs, exts))
+    write('8051-keywords.h', gen_keywords(ops, mnems, derivs))
+
+
+if __name__ == '__main__':
+    main()